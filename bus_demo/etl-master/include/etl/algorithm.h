@@ -86,6 +86,12 @@ namespace etl
   template <typename TIterator, typename TCompare>
   ETL_CONSTEXPR14 void insertion_sort(TIterator first, TIterator last, TCompare compare);
 
+  template <typename TIterator>
+  void pdq_sort(TIterator first, TIterator last);
+
+  template <typename TIterator, typename TCompare>
+  void pdq_sort(TIterator first, TIterator last, TCompare compare);
+
   class algorithm_exception : public etl::exception
   {
   public:
@@ -2136,6 +2142,29 @@ namespace etl
   }
 
 #if ETL_NOT_USING_STL
+  namespace private_algorithm
+  {
+    //*************************************************************************
+    /// Random access iterators use pattern-defeating quicksort.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    typename etl::enable_if<etl::is_random_access_iterator<TIterator>::value, void>::type
+      sort(TIterator first, TIterator last, TCompare compare)
+    {
+      etl::pdq_sort(first, last, compare);
+    }
+
+    //*************************************************************************
+    /// Other iterators fall back to shell sort.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    typename etl::enable_if<!etl::is_random_access_iterator<TIterator>::value, void>::type
+      sort(TIterator first, TIterator last, TCompare compare)
+    {
+      etl::shell_sort(first, last, compare);
+    }
+  }
+
   //***************************************************************************
   /// Sorts the elements.
   /// Uses user defined comparison.
@@ -2144,7 +2173,7 @@ namespace etl
   template <typename TIterator, typename TCompare>
   void sort(TIterator first, TIterator last, TCompare compare)
   {
-    etl::shell_sort(first, last, compare);
+    private_algorithm::sort(first, last, compare);
   }
 
   //***************************************************************************
@@ -2154,7 +2183,7 @@ namespace etl
   template <typename TIterator>
   void sort(TIterator first, TIterator last)
   {
-    etl::shell_sort(first, last, etl::less<typename etl::iterator_traits<TIterator>::value_type>());
+    private_algorithm::sort(first, last, etl::less<typename etl::iterator_traits<TIterator>::value_type>());
   }
 
   //***************************************************************************
@@ -3206,6 +3235,656 @@ namespace etl
     etl::sort_heap(first, last);
   }
 
+  //***************************************************************************
+  namespace private_algorithm
+  {
+    enum
+    {
+      pdq_insertion_sort_threshold     = 24,  ///< Partitions smaller than this are insertion sorted.
+      pdq_ninther_threshold            = 128, ///< Partitions larger than this use the pseudo median of 9.
+      pdq_partial_insertion_sort_limit = 8    ///< Element moves allowed before a partial insertion sort gives up.
+    };
+
+    //*************************************************************************
+    /// Insertion sort used for small partitions.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void pdq_insertion_sort(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename etl::iterator_traits<TIterator>::value_type value_type;
+
+      if (begin == end)
+      {
+        return;
+      }
+
+      for (TIterator cur = begin + 1; cur != end; ++cur)
+      {
+        TIterator sift   = cur;
+        TIterator sift_1 = cur - 1;
+
+        if (compare(*sift, *sift_1))
+        {
+          value_type tmp = ETL_MOVE(*sift);
+
+          do
+          {
+            *sift-- = ETL_MOVE(*sift_1);
+          } while ((sift != begin) && compare(tmp, *--sift_1));
+
+          *sift = ETL_MOVE(tmp);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Insertion sort that assumes *(begin - 1) is not greater than any
+    /// element in [begin, end), so needs no bounds check.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void pdq_unguarded_insertion_sort(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename etl::iterator_traits<TIterator>::value_type value_type;
+
+      if (begin == end)
+      {
+        return;
+      }
+
+      for (TIterator cur = begin + 1; cur != end; ++cur)
+      {
+        TIterator sift   = cur;
+        TIterator sift_1 = cur - 1;
+
+        if (compare(*sift, *sift_1))
+        {
+          value_type tmp = ETL_MOVE(*sift);
+
+          do
+          {
+            *sift-- = ETL_MOVE(*sift_1);
+          } while (compare(tmp, *--sift_1));
+
+          *sift = ETL_MOVE(tmp);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Insertion sort that gives up after pdq_partial_insertion_sort_limit
+    /// element moves. Returns true if the range is now sorted.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    bool pdq_partial_insertion_sort(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename etl::iterator_traits<TIterator>::value_type value_type;
+
+      if (begin == end)
+      {
+        return true;
+      }
+
+      size_t limit = 0U;
+
+      for (TIterator cur = begin + 1; cur != end; ++cur)
+      {
+        TIterator sift   = cur;
+        TIterator sift_1 = cur - 1;
+
+        if (compare(*sift, *sift_1))
+        {
+          value_type tmp = ETL_MOVE(*sift);
+
+          do
+          {
+            *sift-- = ETL_MOVE(*sift_1);
+          } while ((sift != begin) && compare(tmp, *--sift_1));
+
+          *sift = ETL_MOVE(tmp);
+          limit += static_cast<size_t>(cur - sift);
+        }
+
+        if (limit > static_cast<size_t>(pdq_partial_insertion_sort_limit))
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void pdq_sort2(TIterator a, TIterator b, TCompare compare)
+    {
+      if (compare(*b, *a))
+      {
+        etl::iter_swap(a, b);
+      }
+    }
+
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void pdq_sort3(TIterator a, TIterator b, TIterator c, TCompare compare)
+    {
+      pdq_sort2(a, b, compare);
+      pdq_sort2(b, c, compare);
+      pdq_sort2(a, b, compare);
+    }
+
+    //*************************************************************************
+    /// Partitions [begin, end) around the pivot *begin. Elements equal to the
+    /// pivot go to the right. Returns the pivot position and whether the range
+    /// was already partitioned.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    ETL_OR_STD::pair<TIterator, bool> pdq_partition_right(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename etl::iterator_traits<TIterator>::value_type value_type;
+
+      value_type pivot(ETL_MOVE(*begin));
+
+      TIterator first = begin;
+      TIterator last  = end;
+
+      // Find the first element not less than the pivot. The median of 3
+      // guarantees one exists.
+      while (compare(*++first, pivot))
+      {
+      }
+
+      // Find the last element less than the pivot. Guarded only if no element
+      // was skipped above.
+      if ((first - 1) == begin)
+      {
+        while ((first < last) && !compare(*--last, pivot))
+        {
+        }
+      }
+      else
+      {
+        while (!compare(*--last, pivot))
+        {
+        }
+      }
+
+      const bool already_partitioned = (first >= last);
+
+      while (first < last)
+      {
+        etl::iter_swap(first, last);
+
+        while (compare(*++first, pivot))
+        {
+        }
+
+        while (!compare(*--last, pivot))
+        {
+        }
+      }
+
+      TIterator pivot_pos = first - 1;
+      *begin     = ETL_MOVE(*pivot_pos);
+      *pivot_pos = ETL_MOVE(pivot);
+
+      return ETL_OR_STD::pair<TIterator, bool>(pivot_pos, already_partitioned);
+    }
+
+    //*************************************************************************
+    /// Partitions [begin, end) around the pivot *begin. Elements equal to the
+    /// pivot go to the left. Used when many elements equal the pivot.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    TIterator pdq_partition_left(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename etl::iterator_traits<TIterator>::value_type value_type;
+
+      value_type pivot(ETL_MOVE(*begin));
+
+      TIterator first = begin;
+      TIterator last  = end;
+
+      while (compare(pivot, *--last))
+      {
+      }
+
+      if ((last + 1) == end)
+      {
+        while ((first < last) && !compare(pivot, *++first))
+        {
+        }
+      }
+      else
+      {
+        while (!compare(pivot, *++first))
+        {
+        }
+      }
+
+      while (first < last)
+      {
+        etl::iter_swap(first, last);
+
+        while (compare(pivot, *--last))
+        {
+        }
+
+        while (!compare(pivot, *++first))
+        {
+        }
+      }
+
+      TIterator pivot_pos = last;
+      *begin     = ETL_MOVE(*pivot_pos);
+      *pivot_pos = ETL_MOVE(pivot);
+
+      return pivot_pos;
+    }
+
+    //*************************************************************************
+    /// The main loop. Recurses on the left partition and loops on the right.
+    /// After bad_allowed highly unbalanced partitions it falls back to heap
+    /// sort, which bounds the worst case to O(N log N).
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void pdq_sort_loop(TIterator begin, TIterator end, TCompare compare, int bad_allowed, bool leftmost)
+    {
+      typedef typename etl::iterator_traits<TIterator>::difference_type difference_t;
+
+      while (true)
+      {
+        const difference_t size = end - begin;
+
+        if (size < static_cast<difference_t>(pdq_insertion_sort_threshold))
+        {
+          if (leftmost)
+          {
+            pdq_insertion_sort(begin, end, compare);
+          }
+          else
+          {
+            pdq_unguarded_insertion_sort(begin, end, compare);
+          }
+
+          return;
+        }
+
+        // Choose the pivot as the median of 3, or the pseudo median of 9 for
+        // large partitions, and move it to *begin.
+        const difference_t s2 = size / 2;
+
+        if (size > static_cast<difference_t>(pdq_ninther_threshold))
+        {
+          pdq_sort3(begin, begin + s2, end - 1, compare);
+          pdq_sort3(begin + 1, begin + (s2 - 1), end - 2, compare);
+          pdq_sort3(begin + 2, begin + (s2 + 1), end - 3, compare);
+          pdq_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare);
+          etl::iter_swap(begin, begin + s2);
+        }
+        else
+        {
+          pdq_sort3(begin + s2, begin, end - 1, compare);
+        }
+
+        // If the element before this partition equals the pivot then every
+        // element equal to the pivot can be put to the left and skipped.
+        if (!leftmost && !compare(*(begin - 1), *begin))
+        {
+          begin = pdq_partition_left(begin, end, compare) + 1;
+          continue;
+        }
+
+        ETL_OR_STD::pair<TIterator, bool> part = pdq_partition_right(begin, end, compare);
+        TIterator  pivot_pos           = part.first;
+        const bool already_partitioned = part.second;
+
+        const difference_t l_size = pivot_pos - begin;
+        const difference_t r_size = end - (pivot_pos + 1);
+        const bool highly_unbalanced = (l_size < (size / 8)) || (r_size < (size / 8));
+
+        if (highly_unbalanced)
+        {
+          if (--bad_allowed == 0)
+          {
+            etl::make_heap(begin, end, compare);
+            etl::sort_heap(begin, end, compare);
+            return;
+          }
+
+          // Break up patterns that may be causing the bad partitions.
+          if (l_size >= static_cast<difference_t>(pdq_insertion_sort_threshold))
+          {
+            etl::iter_swap(begin, begin + l_size / 4);
+            etl::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+
+            if (l_size > static_cast<difference_t>(pdq_ninther_threshold))
+            {
+              etl::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+              etl::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+              etl::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+              etl::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+            }
+          }
+
+          if (r_size >= static_cast<difference_t>(pdq_insertion_sort_threshold))
+          {
+            etl::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+            etl::iter_swap(end - 1, end - r_size / 4);
+
+            if (r_size > static_cast<difference_t>(pdq_ninther_threshold))
+            {
+              etl::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+              etl::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+              etl::iter_swap(end - 2, end - (1 + r_size / 4));
+              etl::iter_swap(end - 3, end - (2 + r_size / 4));
+            }
+          }
+        }
+        else
+        {
+          // A well balanced partition that needed no swaps is probably
+          // already sorted. Try a bounded insertion sort on both halves.
+          if (already_partitioned &&
+              pdq_partial_insertion_sort(begin, pivot_pos, compare) &&
+              pdq_partial_insertion_sort(pivot_pos + 1, end, compare))
+          {
+            return;
+          }
+        }
+
+        pdq_sort_loop(begin, pivot_pos, compare, bad_allowed, leftmost);
+        begin    = pivot_pos + 1;
+        leftmost = false;
+      }
+    }
+  }
+
+  //***************************************************************************
+  /// Sorts the elements using pattern-defeating quicksort.
+  /// Requires random access iterators. Not stable. O(N log N) worst case,
+  /// O(N) for sorted, reverse sorted and many equal inputs. Does not allocate.
+  /// Uses user defined comparison.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename TCompare>
+  void pdq_sort(TIterator first, TIterator last, TCompare compare)
+  {
+    ETL_STATIC_ASSERT(etl::is_random_access_iterator<TIterator>::value, "pdq_sort requires random access iterators");
+
+    typedef typename etl::iterator_traits<TIterator>::difference_type difference_t;
+
+    difference_t n = last - first;
+
+    if (n < 2)
+    {
+      return;
+    }
+
+    // Allow log2(n) bad partitions before switching to heap sort.
+    int bad_allowed = 0;
+
+    while (n > 1)
+    {
+      n >>= 1;
+      ++bad_allowed;
+    }
+
+    private_algorithm::pdq_sort_loop(first, last, compare, bad_allowed, true);
+  }
+
+  //***************************************************************************
+  /// Sorts the elements using pattern-defeating quicksort.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator>
+  void pdq_sort(TIterator first, TIterator last)
+  {
+    etl::pdq_sort(first, last, etl::less<typename etl::iterator_traits<TIterator>::value_type>());
+  }
+
+  namespace private_algorithm
+  {
+    //*************************************************************************
+    /// Maps a radix sort key onto an unsigned integral of the same width,
+    /// such that the unsigned order matches the key's natural order.
+    //*************************************************************************
+    template <typename TKey, typename TEnable = void>
+    struct radix_key;
+
+    //*************************************************************************
+    /// Unsigned integral keys are used as is.
+    //*************************************************************************
+    template <typename TKey>
+    struct radix_key<TKey, typename etl::enable_if<etl::is_integral<TKey>::value && etl::is_unsigned<TKey>::value>::type>
+    {
+      typedef TKey type;
+
+      static type get(TKey key)
+      {
+        return key;
+      }
+    };
+
+    //*************************************************************************
+    /// Signed integral keys have the sign bit flipped.
+    //*************************************************************************
+    template <typename TKey>
+    struct radix_key<TKey, typename etl::enable_if<etl::is_integral<TKey>::value && etl::is_signed<TKey>::value>::type>
+    {
+      typedef typename etl::make_unsigned<TKey>::type type;
+
+      static type get(TKey key)
+      {
+        return static_cast<type>(static_cast<type>(key) ^ (type(1) << ((sizeof(type) * CHAR_BIT) - 1U)));
+      }
+    };
+
+    //*************************************************************************
+    /// IEEE-754 keys. Negative values have all bits inverted, positive values
+    /// have the sign bit set. -0.0 sorts before +0.0, NaNs sort to the ends.
+    //*************************************************************************
+    template <typename TKey, typename TUnsigned>
+    struct radix_key_floating_point
+    {
+      ETL_STATIC_ASSERT(sizeof(TKey) == sizeof(TUnsigned), "Floating point key size mismatch");
+
+      typedef TUnsigned type;
+
+      static type get(TKey key)
+      {
+        static const type sign_bit = type(1) << ((sizeof(type) * CHAR_BIT) - 1U);
+
+        type bits;
+        memcpy(&bits, &key, sizeof(bits));
+
+        return (bits & sign_bit) ? static_cast<type>(~bits) : static_cast<type>(bits | sign_bit);
+      }
+    };
+
+    template <>
+    struct radix_key<float> : public radix_key_floating_point<float, uint32_t>
+    {
+    };
+
+#if ETL_USING_64BIT_TYPES
+    template <>
+    struct radix_key<double> : public radix_key_floating_point<double, uint64_t>
+    {
+    };
+#endif
+
+    //*************************************************************************
+    /// The key extractor used when the elements are the keys.
+    //*************************************************************************
+    template <typename T>
+    struct radix_identity
+    {
+      const T& operator()(const T& value) const
+      {
+        return value;
+      }
+    };
+
+    //*************************************************************************
+    /// One stable counting sort pass over the digit at 'shift'.
+    //*************************************************************************
+    template <size_t Radix_Bits, typename TKey, typename TSource, typename TDestination, typename TKeyExtractor>
+    void radix_sort_pass(TSource first, TSource last, TDestination destination, TKeyExtractor key, size_t shift)
+    {
+      typedef radix_key<TKey> key_traits;
+
+      const size_t Buckets = size_t(1U) << Radix_Bits;
+      const size_t Mask    = Buckets - 1U;
+
+      size_t count[Buckets];
+
+      for (size_t i = 0U; i < Buckets; ++i)
+      {
+        count[i] = 0U;
+      }
+
+      for (TSource itr = first; itr != last; ++itr)
+      {
+        ++count[static_cast<size_t>(key_traits::get(key(*itr)) >> shift) & Mask];
+      }
+
+      // Convert the histogram into bucket start offsets.
+      size_t offset = 0U;
+
+      for (size_t i = 0U; i < Buckets; ++i)
+      {
+        const size_t n = count[i];
+        count[i] = offset;
+        offset += n;
+      }
+
+      for (TSource itr = first; itr != last; ++itr)
+      {
+        const size_t digit = static_cast<size_t>(key_traits::get(key(*itr)) >> shift) & Mask;
+        *(destination + count[digit]++) = ETL_MOVE(*itr);
+      }
+    }
+
+    //*************************************************************************
+    /// LSD radix sort, ping-ponging between the range and the buffer.
+    //*************************************************************************
+    template <size_t Radix_Bits, typename TKey, typename TIterator, typename TBufferIterator, typename TKeyExtractor>
+    void radix_sort(TIterator first, TIterator last, TBufferIterator buffer, TKeyExtractor key)
+    {
+      ETL_STATIC_ASSERT(etl::is_random_access_iterator<TIterator>::value, "radix_sort requires random access iterators");
+      ETL_STATIC_ASSERT(etl::is_random_access_iterator<TBufferIterator>::value, "radix_sort requires a random access buffer");
+      // The per-pass counters live on the stack; 11 bits is 2048 counters (16 KB with 64 bit size_t).
+      ETL_STATIC_ASSERT((Radix_Bits >= 1U) && (Radix_Bits <= 11U), "radix_sort supports 1 to 11 bit passes");
+
+      typedef radix_key<TKey>              key_traits;
+      typedef typename key_traits::type    ukey_t;
+      typedef typename etl::iterator_traits<TIterator>::difference_type difference_t;
+
+      const difference_t n = last - first;
+
+      if (n < 2)
+      {
+        return;
+      }
+
+      // Bits that are the same in every key need no pass.
+      ukey_t all_or  = ukey_t(0);
+      ukey_t all_and = static_cast<ukey_t>(~ukey_t(0));
+
+      for (TIterator itr = first; itr != last; ++itr)
+      {
+        const ukey_t k = key_traits::get(key(*itr));
+        all_or  = static_cast<ukey_t>(all_or | k);
+        all_and = static_cast<ukey_t>(all_and & k);
+      }
+
+      const ukey_t differ   = static_cast<ukey_t>(all_or ^ all_and);
+      const size_t Mask     = (size_t(1U) << Radix_Bits) - 1U;
+      const size_t Key_Bits = sizeof(ukey_t) * CHAR_BIT;
+
+      bool in_buffer = false;
+
+      for (size_t shift = 0U; shift < Key_Bits; shift += Radix_Bits)
+      {
+        if ((static_cast<size_t>(differ >> shift) & Mask) == 0U)
+        {
+          continue;
+        }
+
+        if (in_buffer)
+        {
+          radix_sort_pass<Radix_Bits, TKey>(buffer, buffer + n, first, key, shift);
+        }
+        else
+        {
+          radix_sort_pass<Radix_Bits, TKey>(first, last, buffer, key, shift);
+        }
+
+        in_buffer = !in_buffer;
+      }
+
+      if (in_buffer)
+      {
+        etl::move(buffer, buffer + n, first);
+      }
+    }
+  }
+
+  //***************************************************************************
+  /// Sorts the elements using an LSD radix sort on the element values.
+  /// Integral, float and double elements are supported.
+  /// Radix_Bits sets the digit width of each pass, from 1 to 11; 8 or 11 are typical.
+  /// 'buffer' must have room for at least (last - first) elements.
+  /// Stable. O(N * passes). Passes whose digit is the same for every element
+  /// are skipped. Uses 2^Radix_Bits counters on the stack. Does not allocate.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <size_t Radix_Bits, typename TIterator, typename TBufferIterator>
+  void radix_sort(TIterator first, TIterator last, TBufferIterator buffer)
+  {
+    typedef typename etl::iterator_traits<TIterator>::value_type value_type;
+
+    private_algorithm::radix_sort<Radix_Bits, value_type>(first, last, buffer, private_algorithm::radix_identity<value_type>());
+  }
+
+  //***************************************************************************
+  /// Sorts the elements using an LSD radix sort on the element values,
+  /// with 8 bit passes.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename TBufferIterator>
+  void radix_sort(TIterator first, TIterator last, TBufferIterator buffer)
+  {
+    etl::radix_sort<8U>(first, last, buffer);
+  }
+
+#if ETL_USING_CPP11
+  //***************************************************************************
+  /// Sorts the elements using an LSD radix sort on the key returned by 'key'.
+  /// The key must be integral, float or double. Radix_Bits is 1 to 11.
+  /// 'buffer' must have room for at least (last - first) elements.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <size_t Radix_Bits, typename TIterator, typename TBufferIterator, typename TKeyExtractor>
+  void radix_sort(TIterator first, TIterator last, TBufferIterator buffer, TKeyExtractor key)
+  {
+    typedef typename etl::decay<decltype(key(*first))>::type key_type;
+
+    private_algorithm::radix_sort<Radix_Bits, key_type>(first, last, buffer, key);
+  }
+
+  //***************************************************************************
+  /// Sorts the elements using an LSD radix sort on the key returned by 'key',
+  /// with 8 bit passes.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename TBufferIterator, typename TKeyExtractor>
+  void radix_sort(TIterator first, TIterator last, TBufferIterator buffer, TKeyExtractor key)
+  {
+    etl::radix_sort<8U>(first, last, buffer, key);
+  }
+#endif
+
   //***************************************************************************
   /// Returns the maximum value.
   //***************************************************************************
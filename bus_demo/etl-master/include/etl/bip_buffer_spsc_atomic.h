@@ -49,6 +49,7 @@ SOFTWARE.
 #include "error_handler.h"
 #include "span.h"
 #include "file_error_numbers.h"
+#include "futex.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -534,6 +535,97 @@ namespace etl
 
   template <typename T, const size_t Size, const size_t Memory_Model> 
   ETL_CONSTANT typename bip_buffer_spsc_atomic<T, Size, Memory_Model>::size_type bip_buffer_spsc_atomic<T, Size, Memory_Model>::Reserved_Size;
+
+#if ETL_HAS_FUTEX
+  //***************************************************************************
+  /// A fixed capacity bipartite buffer with a reader that can block until data arrives.
+  /// A write commit only makes a system call when the reader is blocked on an
+  /// empty buffer. Otherwise it costs a fence and a load more than a commit to
+  /// bip_buffer_spsc_atomic. Commit through this class, not an
+  /// ibip_buffer_spsc_atomic reference, or a blocked reader will not be woken.
+  /// \tparam T            The type this buffer should support.
+  /// \tparam Size         The maximum capacity of the buffer.
+  /// \tparam Memory_Model The memory model for the buffer. Determines the type of the internal counter variables.
+  //***************************************************************************
+  template <typename T, const size_t Size, const size_t Memory_Model = etl::memory_model::MEMORY_MODEL_LARGE>
+  class bip_buffer_spsc_atomic_blocking : public bip_buffer_spsc_atomic<T, Size, Memory_Model>
+  {
+  private:
+
+    typedef typename etl::bip_buffer_spsc_atomic<T, Size, Memory_Model> base_t;
+
+  public:
+
+    typedef typename base_t::size_type size_type;
+
+    //*************************************************************************
+    // Commits the previously reserved write memory area, waking a waiting reader.
+    // Throws bip_buffer_reserve_invalid
+    //*************************************************************************
+    void write_commit(const span<T> &reserve)
+    {
+      base_t::write_commit(reserve);
+
+      if (reserve.size() > 0)
+      {
+        not_empty.notify();
+      }
+    }
+
+    //*************************************************************************
+    // Reserves a memory area for reading (up to the max_reserve_size),
+    // blocking while the buffer is empty.
+    //*************************************************************************
+    span<T> read_reserve_wait(size_type max_reserve_size = numeric_limits<size_type>::max())
+    {
+      span<T> reserve = base_t::read_reserve(max_reserve_size);
+
+      while ((reserve.size() == 0) && (max_reserve_size != 0))
+      {
+        uint32_t key = not_empty.prepare_wait();
+
+        reserve = base_t::read_reserve(max_reserve_size);
+
+        if (reserve.size() == 0)
+        {
+          not_empty.wait(key);
+        }
+      }
+
+      return reserve;
+    }
+
+    //*************************************************************************
+    // Reserves a memory area for reading (up to the max_reserve_size),
+    // blocking while the buffer is empty for up to 'timeout_ms' milliseconds.
+    // Returns an empty span if the wait timed out.
+    //*************************************************************************
+    span<T> read_reserve_wait_for(uint32_t timeout_ms, size_type max_reserve_size = numeric_limits<size_type>::max())
+    {
+      struct timespec deadline = etl::futex_event::get_deadline(timeout_ms);
+
+      span<T> reserve = base_t::read_reserve(max_reserve_size);
+
+      while ((reserve.size() == 0) && (max_reserve_size != 0))
+      {
+        uint32_t key = not_empty.prepare_wait();
+
+        reserve = base_t::read_reserve(max_reserve_size);
+
+        if ((reserve.size() == 0) && !not_empty.wait(key, &deadline))
+        {
+          return base_t::read_reserve(max_reserve_size);
+        }
+      }
+
+      return reserve;
+    }
+
+  private:
+
+    etl::futex_event not_empty; ///< Signalled when the buffer may have become non-empty.
+  };
+#endif
 }
 
 #endif /* ETL_HAS_ATOMIC && ETL_USING_CPP11 */
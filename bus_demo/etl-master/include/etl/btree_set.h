@@ -0,0 +1,403 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_BTREE_SET_INCLUDED
+#define ETL_BTREE_SET_INCLUDED
+
+#include "platform.h"
+#include "private/btree_base.h"
+#include "utility.h"
+#include "functional.h"
+#include "algorithm.h"
+#include "pool.h"
+#include "nth_type.h"
+#include "initializer_list.h"
+
+//*****************************************************************************
+///\defgroup btree_set btree_set
+/// A btree_set with the capacity defined at compile time.
+/// Keys are held in a B+tree of wide nodes, so that searches and range
+/// scans touch far fewer cache lines than the red/black tree in etl::set.
+/// Insert and erase move keys between nodes and therefore invalidate
+/// all iterators, pointers and references into the container.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// A templated base for all etl::btree_set types.
+  ///\ingroup btree_set
+  //***************************************************************************
+  template <typename TKey, typename TCompare = etl::less<TKey> >
+  class ibtree_set : public etl::private_btree::btree<TKey, TKey, etl::private_btree::set_key_of<TKey>, TCompare>
+  {
+  private:
+
+    typedef etl::private_btree::btree<TKey, TKey, etl::private_btree::set_key_of<TKey>, TCompare> base;
+
+  public:
+
+    typedef typename base::key_type        key_type;
+    typedef typename base::value_type      value_type;
+    typedef TCompare                       key_compare;
+    typedef TCompare                       value_compare;
+    typedef typename base::reference       reference;
+    typedef typename base::const_reference const_reference;
+#if ETL_USING_CPP11
+    typedef typename base::rvalue_reference rvalue_reference;
+#endif
+    typedef typename base::pointer         pointer;
+    typedef typename base::const_pointer   const_pointer;
+    typedef typename base::size_type       size_type;
+    typedef typename base::iterator        iterator;
+    typedef typename base::const_iterator  const_iterator;
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    ibtree_set& operator = (const ibtree_set& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        this->assign(rhs.cbegin(), rhs.cend());
+      }
+
+      return *this;
+    }
+
+#if ETL_USING_CPP11
+    //*************************************************************************
+    /// Move assignment operator.
+    //*************************************************************************
+    ibtree_set& operator = (ibtree_set&& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        this->move_from(rhs);
+      }
+
+      return *this;
+    }
+#endif
+
+    //*************************************************************************
+    /// How to compare two value elements.
+    //*************************************************************************
+    value_compare value_comp() const
+    {
+      return this->kcompare;
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    ibtree_set(etl::ipool& leaf_pool, etl::ipool& branch_pool, size_t max_size_)
+      : base(leaf_pool, branch_pool, max_size_)
+    {
+    }
+
+#if ETL_USING_CPP11
+    //*************************************************************************
+    /// Moves the elements of another set into this one.
+    //*************************************************************************
+    void move_from(ibtree_set& other)
+    {
+      this->clear();
+
+      iterator from = other.begin();
+
+      while (from != other.end())
+      {
+        this->insert(etl::move(*from));
+        ++from;
+      }
+
+      other.clear();
+    }
+#endif
+
+  private:
+
+    // Disable copy construction.
+    ibtree_set(const ibtree_set&);
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_BTREE_SET) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~ibtree_set()
+    {
+    }
+#else
+  protected:
+    ~ibtree_set()
+    {
+    }
+#endif
+  };
+
+  //*************************************************************************
+  /// A templated btree_set implementation that uses fixed size node pools.
+  ///\ingroup btree_set
+  //*************************************************************************
+  template <typename TKey, const size_t MAX_SIZE_, typename TCompare = etl::less<TKey> >
+  class btree_set : public etl::ibtree_set<TKey, TCompare>
+  {
+  private:
+
+    typedef etl::ibtree_set<TKey, TCompare> base;
+
+  public:
+
+    static ETL_CONSTANT size_t MAX_SIZE = MAX_SIZE_;
+
+    /// The number of leaves and branches needed to hold MAX_SIZE elements.
+    static ETL_CONSTANT size_t LEAF_COUNT   = ((MAX_SIZE / base::Leaf_Min) > 1U) ? (MAX_SIZE / base::Leaf_Min) : 1U;
+    static ETL_CONSTANT size_t BRANCH_COUNT = ((etl::private_btree::branch_count<LEAF_COUNT, base::Branch_Min>::value) > 1U) ? etl::private_btree::branch_count<LEAF_COUNT, base::Branch_Min>::value : 1U;
+
+    ETL_STATIC_ASSERT((etl::private_btree::branch_count<LEAF_COUNT, base::Branch_Min>::levels < etl::private_btree::Max_Height), "btree_set is too deep");
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    btree_set()
+      : base(leaf_pool, branch_pool, MAX_SIZE)
+    {
+    }
+
+    //*************************************************************************
+    /// Copy constructor.
+    //*************************************************************************
+    btree_set(const btree_set& other)
+      : base(leaf_pool, branch_pool, MAX_SIZE)
+    {
+      this->assign(other.cbegin(), other.cend());
+    }
+
+#if ETL_USING_CPP11
+    //*************************************************************************
+    /// Move constructor.
+    //*************************************************************************
+    btree_set(btree_set&& other)
+      : base(leaf_pool, branch_pool, MAX_SIZE)
+    {
+      this->move_from(other);
+    }
+#endif
+
+    //*************************************************************************
+    /// Constructor, from an iterator range.
+    ///\tparam TIterator The iterator type.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*************************************************************************
+    template <typename TIterator>
+    btree_set(TIterator first, TIterator last)
+      : base(leaf_pool, branch_pool, MAX_SIZE)
+    {
+      this->assign(first, last);
+    }
+
+#if ETL_HAS_INITIALIZER_LIST
+    //*************************************************************************
+    /// Constructor, from an initializer_list.
+    //*************************************************************************
+    btree_set(std::initializer_list<typename base::value_type> init)
+      : base(leaf_pool, branch_pool, MAX_SIZE)
+    {
+      this->assign(init.begin(), init.end());
+    }
+#endif
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~btree_set()
+    {
+      this->initialise();
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    btree_set& operator = (const btree_set& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        this->assign(rhs.cbegin(), rhs.cend());
+      }
+
+      return *this;
+    }
+
+#if ETL_USING_CPP11
+    //*************************************************************************
+    /// Move assignment operator.
+    //*************************************************************************
+    btree_set& operator = (btree_set&& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        this->move_from(rhs);
+      }
+
+      return *this;
+    }
+#endif
+
+  private:
+
+    /// The pools of nodes used for the btree_set.
+    etl::pool<typename base::leaf_node, LEAF_COUNT>     leaf_pool;
+    etl::pool<typename base::branch_node, BRANCH_COUNT> branch_pool;
+  };
+
+  template <typename TKey, const size_t MAX_SIZE_, typename TCompare>
+  ETL_CONSTANT size_t btree_set<TKey, MAX_SIZE_, TCompare>::MAX_SIZE;
+
+  template <typename TKey, const size_t MAX_SIZE_, typename TCompare>
+  ETL_CONSTANT size_t btree_set<TKey, MAX_SIZE_, TCompare>::LEAF_COUNT;
+
+  template <typename TKey, const size_t MAX_SIZE_, typename TCompare>
+  ETL_CONSTANT size_t btree_set<TKey, MAX_SIZE_, TCompare>::BRANCH_COUNT;
+
+  //*************************************************************************
+  /// Template deduction guides.
+  //*************************************************************************
+#if ETL_USING_CPP17 && ETL_HAS_INITIALIZER_LIST
+  template <typename... T>
+  btree_set(T...) -> btree_set<etl::nth_type_t<0, T...>, sizeof...(T)>;
+#endif
+
+  //*************************************************************************
+  /// Make
+  //*************************************************************************
+#if ETL_USING_CPP11 && ETL_HAS_INITIALIZER_LIST
+  template <typename TKey, typename TCompare = etl::less<TKey>, typename... T>
+  constexpr auto make_btree_set(T&&... keys) -> etl::btree_set<TKey, sizeof...(T), TCompare>
+  {
+    return { etl::forward<T>(keys)... };
+  }
+#endif
+
+  //***************************************************************************
+  /// Equal operator.
+  ///\param lhs Reference to the first btree_set.
+  ///\param rhs Reference to the second btree_set.
+  ///\return <b>true</b> if the sets are equal, otherwise <b>false</b>
+  ///\ingroup btree_set
+  //***************************************************************************
+  template <typename TKey, typename TCompare>
+  bool operator ==(const etl::ibtree_set<TKey, TCompare>& lhs, const etl::ibtree_set<TKey, TCompare>& rhs)
+  {
+    return (lhs.size() == rhs.size()) && etl::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  //***************************************************************************
+  /// Not equal operator.
+  ///\param lhs Reference to the first btree_set.
+  ///\param rhs Reference to the second btree_set.
+  ///\return <b>true</b> if the sets are not equal, otherwise <b>false</b>
+  ///\ingroup btree_set
+  //***************************************************************************
+  template <typename TKey, typename TCompare>
+  bool operator !=(const etl::ibtree_set<TKey, TCompare>& lhs, const etl::ibtree_set<TKey, TCompare>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  //*************************************************************************
+  /// Less than operator.
+  ///\param lhs Reference to the first btree_set.
+  ///\param rhs Reference to the second btree_set.
+  ///\return <b>true</b> if the first btree_set is lexicographically less than the
+  /// second, otherwise <b>false</b>.
+  ///\ingroup btree_set
+  //*************************************************************************
+  template <typename TKey, typename TCompare>
+  bool operator <(const etl::ibtree_set<TKey, TCompare>& lhs, const etl::ibtree_set<TKey, TCompare>& rhs)
+  {
+    return etl::lexicographical_compare(lhs.begin(), lhs.end(),
+                                        rhs.begin(), rhs.end(),
+                                        lhs.value_comp());
+  }
+
+  //*************************************************************************
+  /// Greater than operator.
+  ///\param lhs Reference to the first btree_set.
+  ///\param rhs Reference to the second btree_set.
+  ///\return <b>true</b> if the first btree_set is lexicographically greater than the
+  /// second, otherwise <b>false</b>.
+  ///\ingroup btree_set
+  //*************************************************************************
+  template <typename TKey, typename TCompare>
+  bool operator >(const etl::ibtree_set<TKey, TCompare>& lhs, const etl::ibtree_set<TKey, TCompare>& rhs)
+  {
+    return (rhs < lhs);
+  }
+
+  //*************************************************************************
+  /// Less than or equal operator.
+  ///\param lhs Reference to the first btree_set.
+  ///\param rhs Reference to the second btree_set.
+  ///\return <b>true</b> if the first btree_set is lexicographically less than or equal
+  /// to the second, otherwise <b>false</b>.
+  ///\ingroup btree_set
+  //*************************************************************************
+  template <typename TKey, typename TCompare>
+  bool operator <=(const etl::ibtree_set<TKey, TCompare>& lhs, const etl::ibtree_set<TKey, TCompare>& rhs)
+  {
+    return !(lhs > rhs);
+  }
+
+  //*************************************************************************
+  /// Greater than or equal operator.
+  ///\param lhs Reference to the first btree_set.
+  ///\param rhs Reference to the second btree_set.
+  ///\return <b>true</b> if the first btree_set is lexicographically greater than or
+  /// equal to the second, otherwise <b>false</b>.
+  ///\ingroup btree_set
+  //*************************************************************************
+  template <typename TKey, typename TCompare>
+  bool operator >=(const etl::ibtree_set<TKey, TCompare>& lhs, const etl::ibtree_set<TKey, TCompare>& rhs)
+  {
+    return !(lhs < rhs);
+  }
+}
+
+#endif
@@ -0,0 +1,390 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_CONST_HASH_SET_INCLUDED
+#define ETL_CONST_HASH_SET_INCLUDED
+
+#include "platform.h"
+
+#if ETL_NOT_USING_CPP11
+  #error NOT SUPPORTED FOR C++03 OR BELOW
+#endif
+
+#include "algorithm.h"
+#include "type_traits.h"
+#include "functional.h"
+#include "nth_type.h"
+#include "utility.h"
+
+#include "private/perfect_hash.h"
+
+#include <stdint.h>
+
+///\defgroup const_hash_set const_hash_set
+/// A constexpr set that finds keys with a minimal perfect hash.
+/// The hash tables are built by the constructor, at compile time when the
+/// map is declared constexpr, so a lookup is a fixed number of steps
+/// whatever the size of the set.
+///\ingroup containers
+
+namespace etl
+{
+  template <typename TKey, typename THash, typename TKeyEqual>
+  class iconst_hash_set
+  {
+  public:
+
+    using key_type        = TKey;
+    using value_type      = TKey;
+    using hasher          = THash;
+    using key_equal       = TKeyEqual;
+    using const_reference = const value_type&;
+    using const_pointer   = const value_type*;
+    using const_iterator  = const value_type*;
+    using size_type       = size_t;
+
+    //*************************************************************************
+    /// Check that the elements are valid for a set.
+    /// The elements must contain no duplicates and no two keys may have the
+    /// same hash.
+    /// \return <b>true</b> if the elements are valid for the set.
+    //*************************************************************************
+    ETL_CONSTEXPR14 bool is_valid() const ETL_NOEXCEPT
+    {
+      return valid;
+    }
+
+    //*************************************************************************
+    ///\brief Returns a <code>const_iterator</code> to the beginning of the set.
+    /// The elements are in the order that they were given to the constructor.
+    //*************************************************************************
+    ETL_CONSTEXPR14 const_iterator begin() const ETL_NOEXCEPT
+    {
+      return element_list;
+    }
+
+    //*************************************************************************
+    ///\brief Returns a <code>const_iterator</code> to the beginning of the set.
+    //*************************************************************************
+    ETL_CONSTEXPR14 const_iterator cbegin() const ETL_NOEXCEPT
+    {
+      return element_list;
+    }
+
+    //*************************************************************************
+    ///\brief Returns a <code>const_iterator</code> to the end of the set.
+    //*************************************************************************
+    ETL_CONSTEXPR14 const_iterator end() const ETL_NOEXCEPT
+    {
+      return element_list_end;
+    }
+
+    //*************************************************************************
+    ///\brief Returns a <code>const_iterator</code> to the end of the set.
+    //*************************************************************************
+    ETL_CONSTEXPR14 const_iterator cend() const ETL_NOEXCEPT
+    {
+      return element_list_end;
+    }
+
+    //*************************************************************************
+    ///\brief Returns a <code>const_pointer</code> to the beginning of the set.
+    //*************************************************************************
+    ETL_CONSTEXPR14 const_pointer data() const ETL_NOEXCEPT
+    {
+      return element_list;
+    }
+
+    //*************************************************************************
+    ///\brief Gets a const_iterator to the setped value at the key index.
+    ///\param key The key of the element to find.
+    ///\return A <code>const_iterator</code> to the setped value at the index,
+    /// or end() if not found.
+    //*************************************************************************
+    ETL_CONSTEXPR14 const_iterator find(const key_type& key) const ETL_NOEXCEPT
+    {
+      if (!valid || empty())
+      {
+        return end();
+      }
+
+      const uint32_t slot = private_perfect_hash::lookup(static_cast<uint32_t>(hasher()(key)), 
+                                                         displacement, 
+                                                         number_of_buckets, 
+                                                         static_cast<uint32_t>(size()));
+
+      const_iterator itr = element_list + index[slot];
+
+      return key_equal()(*itr, key) ? itr : end();
+    }
+
+    //*************************************************************************
+    ///\brief Checks if the set contains an element with key.
+    ///\param key The key of the element to check.
+    ///\return <b>true</b> if the set contains an element with key.
+    //*************************************************************************
+    ETL_CONSTEXPR14 bool contains(const key_type& key) const ETL_NOEXCEPT
+    {
+      return find(key) != end();
+    }
+
+    //*************************************************************************
+    ///\brief Counts the numbeer elements with key.
+    ///\param key The key of the element to count.
+    ///\return 0 or 1
+    //*************************************************************************
+    ETL_CONSTEXPR14 size_type count(const key_type& key) const ETL_NOEXCEPT
+    {
+      return contains(key) ? 1 : 0;
+    }
+
+    //*************************************************************************
+    ///\brief Returns a range containing all elements with the key.
+    /// The range will contain either 1 or 0 elements.
+    ///\param key The key of the element to find.
+    ///\return A <code>pair</code> of <code>const_iterator</code>.
+    //*************************************************************************
+    ETL_CONSTEXPR14 ETL_OR_STD::pair<const_iterator, const_iterator> equal_range(const key_type& key) const ETL_NOEXCEPT
+    {
+      const_iterator itr = find(key);
+
+      return ETL_OR_STD::pair<const_iterator, const_iterator>(itr, (itr == end()) ? itr : itr + 1);
+    }
+
+    //*************************************************************************
+    /// Checks if the set is empty.
+    ///\return <b>true</b> if the set is empty.
+    //*************************************************************************
+    ETL_CONSTEXPR14 bool empty() const ETL_NOEXCEPT
+    {
+      return size() == 0U;
+    }
+
+    //*************************************************************************
+    /// Checks if the set is full.
+    ///\return <b>true</b> if the set is full.
+    //*************************************************************************
+    ETL_CONSTEXPR14 bool full() const ETL_NOEXCEPT
+    {
+      return (max_elements != 0) && (size() == max_elements);
+    }
+
+    //*************************************************************************
+    /// Gets the size of the set.
+    ///\return The size of the set.
+    //*************************************************************************
+    ETL_CONSTEXPR14 size_type size() const ETL_NOEXCEPT
+    {
+      return size_type(element_list_end - element_list);
+    }
+
+    //*************************************************************************
+    /// Gets the maximum size of the set.
+    ///\return The maximum size of the set.
+    //*************************************************************************
+    ETL_CONSTEXPR14 size_type max_size() const ETL_NOEXCEPT
+    {
+      return max_elements;
+    }
+
+    //*************************************************************************
+    /// Gets the capacity of the set.
+    /// This is always equal to max_size().
+    ///\return The capacity of the set.
+    //*************************************************************************
+    ETL_CONSTEXPR14 size_type capacity() const ETL_NOEXCEPT
+    {
+      return max_elements;
+    }
+
+    //*************************************************************************
+    /// Gets the number of hash buckets.
+    //*************************************************************************
+    ETL_CONSTEXPR14 size_type bucket_count() const ETL_NOEXCEPT
+    {
+      return number_of_buckets;
+    }
+
+    //*************************************************************************
+    /// Returns the function that hashes the keys.
+    //*************************************************************************
+    ETL_CONSTEXPR14 hasher hash_function() const ETL_NOEXCEPT
+    {
+      return hasher();
+    }
+
+    //*************************************************************************
+    /// Returns the function that compares the keys.
+    //*************************************************************************
+    ETL_CONSTEXPR14 key_equal key_eq() const ETL_NOEXCEPT
+    {
+      return key_equal();
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    ETL_CONSTEXPR14 explicit iconst_hash_set(const value_type* element_list_, 
+                                             const uint32_t*   displacement_, 
+                                             const uint32_t*   index_, 
+                                             size_type         size_, 
+                                             size_type         max_elements_) ETL_NOEXCEPT
+      : element_list(element_list_)
+      , element_list_end{element_list_ + size_}
+      , displacement(displacement_)
+      , index(index_)
+      , max_elements(max_elements_)
+      , number_of_buckets(private_perfect_hash::bucket_count(size_))
+      , valid(false)
+    {
+    }
+
+    //*************************************************************************
+    /// Builds the hash tables for the elements.
+    /// Works on the derived class storage, as the base pointers may not be
+    /// read while a constexpr object is being constructed.
+    //*************************************************************************
+    template <size_t Capacity>
+    ETL_CONSTEXPR14 void build(const value_type* elements, uint32_t* displacement_, uint32_t* index_) ETL_NOEXCEPT
+    {
+      uint32_t hashes[Capacity] = {};
+
+      for (size_type i = 0U; i < size(); ++i)
+      {
+        hashes[i] = static_cast<uint32_t>(hasher()(elements[i]));
+      }
+
+      valid = private_perfect_hash::build<Capacity>(hashes, size(), displacement_, index_);
+    }
+
+  private:
+
+    const value_type* element_list;
+    const value_type* element_list_end;
+    const uint32_t*   displacement;
+    const uint32_t*   index;
+    size_type         max_elements;
+    uint32_t          number_of_buckets;
+    bool              valid;
+  };
+
+  //*********************************************************************
+  /// Hash set type designed for constexpr.
+  //*********************************************************************
+  template <typename TKey, size_t Size, typename THash = etl::const_hash<TKey>, typename TKeyEqual = etl::equal_to<TKey>>
+  class const_hash_set : public iconst_hash_set<TKey, THash, TKeyEqual>
+  {
+  public:
+
+    using base_t = iconst_hash_set<TKey, THash, TKeyEqual>;
+
+    using key_type        = typename base_t::key_type;
+    using value_type      = typename base_t::value_type;
+    using hasher          = typename base_t::hasher;
+    using key_equal       = typename base_t::key_equal;
+    using const_reference = typename base_t::const_reference;
+    using const_pointer   = typename base_t::const_pointer;
+    using const_iterator  = typename base_t::const_iterator;
+    using size_type       = typename base_t::size_type;
+
+    static_assert((etl::is_default_constructible<key_type>::value), "key_type must be default constructible");
+    static_assert(Size < private_perfect_hash::Direct,              "Size is too large");
+
+    //*************************************************************************
+    ///\brief Construct a const_hash_set from a variadic list of elements.
+    /// Static asserts if the elements are not of type <code>value_type</code>.
+    /// Static asserts if the number of elements is greater than the capacity of the const_hash_set.
+    //*************************************************************************
+    template <typename... TElements>
+    ETL_CONSTEXPR14 explicit const_hash_set(TElements&&... elements) ETL_NOEXCEPT
+      : iconst_hash_set<TKey, THash, TKeyEqual>(element_list, displacement, index, sizeof...(elements), Size)
+      , element_list{etl::forward<TElements>(elements)...}
+      , displacement{}
+      , index{}
+    {
+      static_assert((etl::are_all_same<value_type, etl::decay_t<TElements>...>::value), "All elements must be value_type");
+      static_assert(sizeof...(elements) <= Size,                                        "Number of elements exceeds capacity");
+
+      this->template build<Size>(element_list, displacement, index);
+    }
+
+  private:
+
+    value_type element_list[Size];
+    uint32_t   displacement[(Size + 2U) / 2U];
+    uint32_t   index[Size];
+  };
+
+  //*************************************************************************
+  /// Template deduction guides.
+  //*************************************************************************
+#if ETL_USING_CPP17
+  template <typename... TElements>
+  const_hash_set(TElements...) -> const_hash_set<etl::nth_type_t<0, TElements...>, sizeof...(TElements)>;
+#endif
+
+  //*************************************************************************
+  /// Equality test.
+  /// The sets are equal if they hold the same elements, in any order.
+  //*************************************************************************
+  template <typename TKey, typename THash, typename TKeyEqual>
+  ETL_CONSTEXPR14 bool operator ==(const etl::iconst_hash_set<TKey, THash, TKeyEqual>& lhs,
+                                   const etl::iconst_hash_set<TKey, THash, TKeyEqual>& rhs) ETL_NOEXCEPT
+  {
+    if (lhs.size() != rhs.size())
+    {
+      return false;
+    }
+
+    for (auto itr = lhs.begin(); itr != lhs.end(); ++itr)
+    {
+      if (!rhs.contains(*itr))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  //*************************************************************************
+  /// Inequality test.
+  //*************************************************************************
+  template <typename TKey, typename THash, typename TKeyEqual>
+  ETL_CONSTEXPR14 bool operator !=(const etl::iconst_hash_set<TKey, THash, TKeyEqual>& lhs,
+                                   const etl::iconst_hash_set<TKey, THash, TKeyEqual>& rhs) ETL_NOEXCEPT
+  {
+    return !(lhs == rhs);
+  }
+}
+
+#endif
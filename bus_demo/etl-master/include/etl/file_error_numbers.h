@@ -109,4 +109,7 @@ SOFTWARE.
 #define ETL_ALGORITHM_FILE_ID "76"
 #define ETL_NOT_NULL_FILE_ID "77"
 #define ETL_SIGNAL_FILE_ID "78"
+#define ETL_FLAT_HASH_MAP_FILE_ID "79"
+#define ETL_BTREE_FILE_ID "80"
+#define ETL_WORK_STEALING_SCHEDULER_FILE_ID "81"
 #endif
@@ -0,0 +1,1651 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_FLAT_HASH_MAP_INCLUDED
+#define ETL_FLAT_HASH_MAP_INCLUDED
+
+#include "platform.h"
+#include "algorithm.h"
+#include "iterator.h"
+#include "functional.h"
+#include "utility.h"
+#include "hash.h"
+#include "bit.h"
+#include "power.h"
+#include "memory.h"
+#include "type_traits.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "debug_count.h"
+#include "placement_new.h"
+#include "initializer_list.h"
+
+#include "private/comparator_is_transparent.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+//*****************************************************************************
+// Control byte group probing.
+// SSE2 or NEON are used when the compiler targets them, unless
+// ETL_FLAT_HASH_MAP_FORCE_SCALAR is defined.
+//*****************************************************************************
+#if !defined(ETL_FLAT_HASH_MAP_FORCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+  #define ETL_FLAT_HASH_MAP_USING_SSE2 1
+  #define ETL_FLAT_HASH_MAP_USING_NEON 0
+  #include <emmintrin.h>
+#elif !defined(ETL_FLAT_HASH_MAP_FORCE_SCALAR) && (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+  #define ETL_FLAT_HASH_MAP_USING_SSE2 0
+  #define ETL_FLAT_HASH_MAP_USING_NEON 1
+  #include <arm_neon.h>
+#else
+  #define ETL_FLAT_HASH_MAP_USING_SSE2 0
+  #define ETL_FLAT_HASH_MAP_USING_NEON 0
+#endif
+
+//*****************************************************************************
+///\defgroup flat_hash_map flat_hash_map
+/// An open addressing hash map with the capacity defined at compile time.
+/// Elements are stored inline in a slot array. Each slot has a control byte
+/// that is either 'empty' or holds 7 bits of the element's hash. Lookups
+/// compare a group of 16 control bytes at a time and only touch the slots
+/// whose control byte matches.
+/// Erase does not leave tombstones. Each group keeps a count of the elements
+/// that probed past it while it was full, and a lookup stops at the first
+/// group that does not contain the key and has a zero count.
+/// Counts saturate at 255. Once erases have passed 255 saturated counts, the
+/// counts are recalculated from the elements, so a count that has fallen back
+/// below the limit stops a lookup again.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// Exception for the flat_hash_map.
+  ///\ingroup flat_hash_map
+  //***************************************************************************
+  class flat_hash_map_exception : public etl::exception
+  {
+  public:
+
+    flat_hash_map_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : etl::exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Full exception for the flat_hash_map.
+  ///\ingroup flat_hash_map
+  //***************************************************************************
+  class flat_hash_map_full : public etl::flat_hash_map_exception
+  {
+  public:
+
+    flat_hash_map_full(string_type file_name_, numeric_type line_number_)
+      : etl::flat_hash_map_exception(ETL_ERROR_TEXT("flat_hash_map:full", ETL_FLAT_HASH_MAP_FILE_ID"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Out of range exception for the flat_hash_map.
+  ///\ingroup flat_hash_map
+  //***************************************************************************
+  class flat_hash_map_out_of_range : public etl::flat_hash_map_exception
+  {
+  public:
+
+    flat_hash_map_out_of_range(string_type file_name_, numeric_type line_number_)
+      : etl::flat_hash_map_exception(ETL_ERROR_TEXT("flat_hash_map:range", ETL_FLAT_HASH_MAP_FILE_ID"B"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Iterator exception for the flat_hash_map.
+  ///\ingroup flat_hash_map
+  //***************************************************************************
+  class flat_hash_map_iterator : public etl::flat_hash_map_exception
+  {
+  public:
+
+    flat_hash_map_iterator(string_type file_name_, numeric_type line_number_)
+      : etl::flat_hash_map_exception(ETL_ERROR_TEXT("flat_hash_map:iterator", ETL_FLAT_HASH_MAP_FILE_ID"C"), file_name_, line_number_)
+    {
+    }
+  };
+
+  namespace private_flat_hash_map
+  {
+    enum
+    {
+      Group_Width  = 16,    ///< Control bytes compared per probe.
+      Ctrl_Empty   = 0x80,  ///< Control byte of an empty slot. Full slots hold a 7 bit hash.
+      Overflow_Max = 0xFF   ///< A saturated group overflow count is not decremented; see iflat_hash_map::erase_slot.
+    };
+
+    //*************************************************************************
+    /// Mixes the user hash so that the group index and the 7 bit control hash
+    /// are both well distributed, even for identity hashes of integers.
+    //*************************************************************************
+    template <size_t Size>
+    struct hash_mixer;
+
+    template <>
+    struct hash_mixer<4U>
+    {
+      static size_t mix(size_t h)
+      {
+        uint32_t x = static_cast<uint32_t>(h);
+        x ^= x >> 16U;
+        x *= 0x85EBCA6BUL;
+        x ^= x >> 13U;
+        x *= 0xC2B2AE35UL;
+        x ^= x >> 16U;
+
+        return static_cast<size_t>(x);
+      }
+    };
+
+#if ETL_USING_64BIT_TYPES
+    template <>
+    struct hash_mixer<8U>
+    {
+      static size_t mix(size_t h)
+      {
+        uint64_t x = static_cast<uint64_t>(h);
+        x ^= x >> 33U;
+        x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33U;
+        x *= 0xC4CEB9FE1A85EC53ULL;
+        x ^= x >> 33U;
+
+        return static_cast<size_t>(x);
+      }
+    };
+#endif
+
+    //*************************************************************************
+    /// The index of the lowest set bit of a non-zero mask.
+    /// Uses the compiler intrinsic where available, as the generic
+    /// etl::countr_zero is branchy and dominates the lookup time.
+    //*************************************************************************
+    inline size_t lowest_bit(uint32_t mask)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<size_t>(__builtin_ctz(mask));
+#else
+      return static_cast<size_t>(etl::countr_zero(mask));
+#endif
+    }
+
+#if ETL_USING_64BIT_TYPES
+    inline size_t lowest_bit(uint64_t mask)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<size_t>(__builtin_ctzll(mask));
+#else
+      return static_cast<size_t>(etl::countr_zero(mask));
+#endif
+    }
+#endif
+
+    //*************************************************************************
+    /// A group of Group_Width control bytes.
+    /// Each match returns a mask with one set bit per matching lane.
+    /// The lane index of a set bit is lowest_bit(mask) >> Lane_Shift.
+    /// The portable version, using 64 bit arithmetic on two halves of the group.
+    /// It is always defined, so it can be tested on targets that use SSE2 or NEON.
+    //*************************************************************************
+    class group_scalar
+    {
+    public:
+
+      typedef uint32_t mask_type;
+
+      enum
+      {
+        Lane_Shift = 0
+      };
+
+      explicit group_scalar(const uint8_t* ctrl)
+        : low(load(ctrl))
+        , high(load(ctrl + 8))
+      {
+      }
+
+      mask_type match(uint8_t h2) const
+      {
+        const uint64_t pattern = Lsb * h2;
+
+        return compress(zero_bytes(low ^ pattern)) | (compress(zero_bytes(high ^ pattern)) << 8U);
+      }
+
+      mask_type match_empty() const
+      {
+        return compress(low & Msb) | (compress(high & Msb) << 8U);
+      }
+
+    private:
+
+      static const uint64_t Lsb = 0x0101010101010101ULL;
+      static const uint64_t Msb = 0x8080808080808080ULL;
+
+      // Little endian load, whatever the platform.
+      static uint64_t load(const uint8_t* p)
+      {
+        uint64_t v = 0U;
+
+        for (int i = 7; i >= 0; --i)
+        {
+          v = (v << 8U) | p[i];
+        }
+
+        return v;
+      }
+
+      // Sets the top bit of each byte that is zero. Exact, with no carries between bytes.
+      static uint64_t zero_bytes(uint64_t v)
+      {
+        const uint64_t low7 = ~Msb;
+
+        return ~(((v & low7) + low7) | v | low7);
+      }
+
+      // Gathers the top bit of each byte into the low 8 bits.
+      static mask_type compress(uint64_t v)
+      {
+        return static_cast<mask_type>(((v >> 7U) * 0x0102040810204080ULL) >> 56U);
+      }
+
+      uint64_t low;
+      uint64_t high;
+    };
+
+#if ETL_FLAT_HASH_MAP_USING_SSE2
+    //*************************************************************************
+    /// A group compared with SSE2.
+    //*************************************************************************
+    class group_sse2
+    {
+    public:
+
+      typedef uint32_t mask_type;
+
+      enum
+      {
+        Lane_Shift = 0
+      };
+
+      explicit group_sse2(const uint8_t* ctrl)
+        : value(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+      {
+      }
+
+      mask_type match(uint8_t h2) const
+      {
+        return static_cast<mask_type>(_mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_set1_epi8(static_cast<char>(h2)))));
+      }
+
+      mask_type match_empty() const
+      {
+        // Only empty control bytes have the top bit set.
+        return static_cast<mask_type>(_mm_movemask_epi8(value));
+      }
+
+    private:
+
+      __m128i value;
+    };
+
+    typedef group_sse2 group;
+
+#elif ETL_FLAT_HASH_MAP_USING_NEON
+    //*************************************************************************
+    /// A group compared with NEON.
+    //*************************************************************************
+    class group_neon
+    {
+    public:
+
+      typedef uint64_t mask_type;
+
+      enum
+      {
+        Lane_Shift = 2
+      };
+
+      explicit group_neon(const uint8_t* ctrl)
+        : value(vld1q_u8(ctrl))
+      {
+      }
+
+      mask_type match(uint8_t h2) const
+      {
+        return to_mask(vceqq_u8(value, vdupq_n_u8(h2)));
+      }
+
+      mask_type match_empty() const
+      {
+        return to_mask(vtstq_u8(value, vdupq_n_u8(static_cast<uint8_t>(Ctrl_Empty))));
+      }
+
+    private:
+
+      // Narrows the 0x00/0xFF lanes to one nibble each, keeping one bit per nibble.
+      static mask_type to_mask(uint8x16_t lanes)
+      {
+        const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(lanes), 4);
+
+        return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ULL;
+      }
+
+      uint8x16_t value;
+    };
+
+    typedef group_neon group;
+
+#else
+
+    typedef group_scalar group;
+
+#endif
+  }
+
+  //***************************************************************************
+  /// The base class for specifically sized flat_hash_map.
+  /// Can be used as a reference type for all flat_hash_map containing a specific type.
+  ///\ingroup flat_hash_map
+  //***************************************************************************
+  template <typename TKey, typename T, typename THash = etl::hash<TKey>, typename TKeyEqual = etl::equal_to<TKey> >
+  class iflat_hash_map
+  {
+  public:
+
+    typedef ETL_OR_STD::pair<const TKey, T> value_type;
+
+    typedef TKey              key_type;
+    typedef T                 mapped_type;
+    typedef THash             hasher;
+    typedef TKeyEqual         key_equal;
+    typedef value_type&       reference;
+    typedef const value_type& const_reference;
+#if ETL_USING_CPP11
+    typedef value_type&&      rvalue_reference;
+#endif
+    typedef value_type*       pointer;
+    typedef const value_type* const_pointer;
+    typedef size_t            size_type;
+
+    /// Defines the parameter types
+    typedef const key_type&    const_key_reference;
+#if ETL_USING_CPP11
+    typedef key_type&&         rvalue_key_reference;
+#endif
+    typedef mapped_type&       mapped_reference;
+    typedef const mapped_type& const_mapped_reference;
+
+    class const_iterator;
+
+    //*********************************************************************
+    class iterator : public etl::iterator<ETL_OR_STD::forward_iterator_tag, value_type>
+    {
+    public:
+
+      friend class iflat_hash_map;
+      friend class const_iterator;
+
+      //*********************************
+      iterator()
+        : pctrl(ETL_NULLPTR)
+        , pslots(ETL_NULLPTR)
+        , index(0U)
+        , slot_count(0U)
+      {
+      }
+
+      //*********************************
+      iterator& operator ++()
+      {
+        ++index;
+
+        while ((index != slot_count) && (pctrl[index] == private_flat_hash_map::Ctrl_Empty))
+        {
+          ++index;
+        }
+
+        return *this;
+      }
+
+      //*********************************
+      iterator operator ++(int)
+      {
+        iterator temp(*this);
+        operator++();
+        return temp;
+      }
+
+      //*********************************
+      reference operator *() const
+      {
+        return pslots[index];
+      }
+
+      //*********************************
+      pointer operator &() const
+      {
+        return &pslots[index];
+      }
+
+      //*********************************
+      pointer operator ->() const
+      {
+        return &pslots[index];
+      }
+
+      //*********************************
+      friend bool operator == (const iterator& lhs, const iterator& rhs)
+      {
+        return (lhs.pslots == rhs.pslots) && (lhs.index == rhs.index);
+      }
+
+      //*********************************
+      friend bool operator != (const iterator& lhs, const iterator& rhs)
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+
+      //*********************************
+      iterator(const uint8_t* pctrl_, pointer pslots_, size_t index_, size_t slot_count_)
+        : pctrl(pctrl_)
+        , pslots(pslots_)
+        , index(index_)
+        , slot_count(slot_count_)
+      {
+      }
+
+      const uint8_t* pctrl;
+      pointer        pslots;
+      size_t         index;
+      size_t         slot_count;
+    };
+
+    //*********************************************************************
+    class const_iterator : public etl::iterator<ETL_OR_STD::forward_iterator_tag, const value_type>
+    {
+    public:
+
+      friend class iflat_hash_map;
+      friend class iterator;
+
+      //*********************************
+      const_iterator()
+        : pctrl(ETL_NULLPTR)
+        , pslots(ETL_NULLPTR)
+        , index(0U)
+        , slot_count(0U)
+      {
+      }
+
+      //*********************************
+      const_iterator(const typename iflat_hash_map::iterator& other)
+        : pctrl(other.pctrl)
+        , pslots(other.pslots)
+        , index(other.index)
+        , slot_count(other.slot_count)
+      {
+      }
+
+      //*********************************
+      const_iterator& operator ++()
+      {
+        ++index;
+
+        while ((index != slot_count) && (pctrl[index] == private_flat_hash_map::Ctrl_Empty))
+        {
+          ++index;
+        }
+
+        return *this;
+      }
+
+      //*********************************
+      const_iterator operator ++(int)
+      {
+        const_iterator temp(*this);
+        operator++();
+        return temp;
+      }
+
+      //*********************************
+      const_reference operator *() const
+      {
+        return pslots[index];
+      }
+
+      //*********************************
+      const_pointer operator &() const
+      {
+        return &pslots[index];
+      }
+
+      //*********************************
+      const_pointer operator ->() const
+      {
+        return &pslots[index];
+      }
+
+      //*********************************
+      friend bool operator == (const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return (lhs.pslots == rhs.pslots) && (lhs.index == rhs.index);
+      }
+
+      //*********************************
+      friend bool operator != (const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+
+      //*********************************
+      const_iterator(const uint8_t* pctrl_, const_pointer pslots_, size_t index_, size_t slot_count_)
+        : pctrl(pctrl_)
+        , pslots(pslots_)
+        , index(index_)
+        , slot_count(slot_count_)
+      {
+      }
+
+      const uint8_t* pctrl;
+      const_pointer  pslots;
+      size_t         index;
+      size_t         slot_count;
+    };
+
+    typedef typename etl::iterator_traits<iterator>::difference_type difference_type;
+
+    //*********************************************************************
+    /// Returns an iterator to the beginning of the flat_hash_map.
+    ///\return An iterator to the beginning of the flat_hash_map.
+    //*********************************************************************
+    iterator begin()
+    {
+      return iterator(pctrl, pslots, first_full(), slot_count());
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the beginning of the flat_hash_map.
+    ///\return A const iterator to the beginning of the flat_hash_map.
+    //*********************************************************************
+    const_iterator begin() const
+    {
+      return const_iterator(pctrl, pslots, first_full(), slot_count());
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the beginning of the flat_hash_map.
+    ///\return A const iterator to the beginning of the flat_hash_map.
+    //*********************************************************************
+    const_iterator cbegin() const
+    {
+      return const_iterator(pctrl, pslots, first_full(), slot_count());
+    }
+
+    //*********************************************************************
+    /// Returns an iterator to the end of the flat_hash_map.
+    ///\return An iterator to the end of the flat_hash_map.
+    //*********************************************************************
+    iterator end()
+    {
+      return iterator(pctrl, pslots, slot_count(), slot_count());
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the end of the flat_hash_map.
+    ///\return A const iterator to the end of the flat_hash_map.
+    //*********************************************************************
+    const_iterator end() const
+    {
+      return const_iterator(pctrl, pslots, slot_count(), slot_count());
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the end of the flat_hash_map.
+    ///\return A const iterator to the end of the flat_hash_map.
+    //*********************************************************************
+    const_iterator cend() const
+    {
+      return const_iterator(pctrl, pslots, slot_count(), slot_count());
+    }
+
+#if ETL_USING_CPP11
+    //*********************************************************************
+    /// Returns a reference to the value at index 'key'
+    ///\param key The key.
+    ///\return A reference to the value at index 'key'
+    //*********************************************************************
+    mapped_reference operator [](rvalue_key_reference key)
+    {
+      const size_t h = hash_of(key);
+      size_t index   = find_slot(key, h);
+
+      if (index == slot_count())
+      {
+        index = prepare_insert(h);
+        ::new (static_cast<void*>(pslots + index)) value_type(etl::move(key), mapped_type());
+        ETL_INCREMENT_DEBUG_COUNT;
+      }
+
+      return pslots[index].second;
+    }
+#endif
+
+    //*********************************************************************
+    /// Returns a reference to the value at index 'key'
+    ///\param key The key.
+    ///\return A reference to the value at index 'key'
+    //*********************************************************************
+    mapped_reference operator [](const_key_reference key)
+    {
+      const size_t h = hash_of(key);
+      size_t index   = find_slot(key, h);
+
+      if (index == slot_count())
+      {
+        index = prepare_insert(h);
+        ::new (static_cast<void*>(pslots + index)) value_type(key, mapped_type());
+        ETL_INCREMENT_DEBUG_COUNT;
+      }
+
+      return pslots[index].second;
+    }
+
+    //*********************************************************************
+    /// Returns a reference to the value at index 'key'
+    /// If asserts or exceptions are enabled, emits an etl::flat_hash_map_out_of_range if the key is not in the range.
+    ///\param key The key.
+    ///\return A reference to the value at index 'key'
+    //*********************************************************************
+    mapped_reference at(const_key_reference key)
+    {
+      const size_t index = find_slot(key, hash_of(key));
+
+      ETL_ASSERT(index != slot_count(), ETL_ERROR(flat_hash_map_out_of_range));
+
+      return pslots[index].second;
+    }
+
+    //*********************************************************************
+    /// Returns a const reference to the value at index 'key'
+    /// If asserts or exceptions are enabled, emits an etl::flat_hash_map_out_of_range if the key is not in the range.
+    ///\param key The key.
+    ///\return A const reference to the value at index 'key'
+    //*********************************************************************
+    const_mapped_reference at(const_key_reference key) const
+    {
+      const size_t index = find_slot(key, hash_of(key));
+
+      ETL_ASSERT(index != slot_count(), ETL_ERROR(flat_hash_map_out_of_range));
+
+      return pslots[index].second;
+    }
+
+    //*********************************************************************
+    /// Assigns values to the flat_hash_map.
+    /// If asserts or exceptions are enabled, emits flat_hash_map_full if the flat_hash_map does not have enough free space.
+    /// If asserts or exceptions are enabled, emits flat_hash_map_iterator if the iterators are reversed.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*********************************************************************
+    template <typename TIterator>
+    void assign(TIterator first_, TIterator last_)
+    {
+#if ETL_IS_DEBUG_BUILD
+      difference_type d = etl::distance(first_, last_);
+      ETL_ASSERT(d >= 0, ETL_ERROR(flat_hash_map_iterator));
+      ETL_ASSERT(size_t(d) <= max_size(), ETL_ERROR(flat_hash_map_full));
+#endif
+
+      clear();
+
+      while (first_ != last_)
+      {
+        insert(*first_);
+        ++first_;
+      }
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the flat_hash_map.
+    /// If asserts or exceptions are enabled, emits flat_hash_map_full if the flat_hash_map is already full.
+    ///\param key_value_pair The value to insert.
+    //*********************************************************************
+    ETL_OR_STD::pair<iterator, bool> insert(const_reference key_value_pair)
+    {
+      const size_t h = hash_of(key_value_pair.first);
+      size_t index   = find_slot(key_value_pair.first, h);
+
+      if (index != slot_count())
+      {
+        return ETL_OR_STD::pair<iterator, bool>(make_iterator(index), false);
+      }
+
+      ETL_ASSERT_OR_RETURN_VALUE(!full(), ETL_ERROR(flat_hash_map_full), (ETL_OR_STD::pair<iterator, bool>(end(), false)));
+
+      index = prepare_insert(h);
+      ::new (static_cast<void*>(pslots + index)) value_type(key_value_pair);
+      ETL_INCREMENT_DEBUG_COUNT;
+
+      return ETL_OR_STD::pair<iterator, bool>(make_iterator(index), true);
+    }
+
+#if ETL_USING_CPP11
+    //*********************************************************************
+    /// Inserts a value to the flat_hash_map.
+    /// If asserts or exceptions are enabled, emits flat_hash_map_full if the flat_hash_map is already full.
+    ///\param key_value_pair The value to insert.
+    //*********************************************************************
+    ETL_OR_STD::pair<iterator, bool> insert(rvalue_reference key_value_pair)
+    {
+      const size_t h = hash_of(key_value_pair.first);
+      size_t index   = find_slot(key_value_pair.first, h);
+
+      if (index != slot_count())
+      {
+        return ETL_OR_STD::pair<iterator, bool>(make_iterator(index), false);
+      }
+
+      ETL_ASSERT_OR_RETURN_VALUE(!full(), ETL_ERROR(flat_hash_map_full), (ETL_OR_STD::pair<iterator, bool>(end(), false)));
+
+      index = prepare_insert(h);
+      ::new (static_cast<void*>(pslots + index)) value_type(etl::move(key_value_pair));
+      ETL_INCREMENT_DEBUG_COUNT;
+
+      return ETL_OR_STD::pair<iterator, bool>(make_iterator(index), true);
+    }
+#endif
+
+    //*********************************************************************
+    /// Inserts a value to the flat_hash_map.
+    /// If asserts or exceptions are enabled, emits flat_hash_map_full if the flat_hash_map is already full.
+    ///\param position The position to insert at. Ignored.
+    ///\param key_value_pair The value to insert.
+    //*********************************************************************
+    iterator insert(const_iterator, const_reference key_value_pair)
+    {
+      return insert(key_value_pair).first;
+    }
+
+    //*********************************************************************
+    /// Inserts a range of values to the flat_hash_map.
+    /// If asserts or exceptions are enabled, emits flat_hash_map_full if the flat_hash_map does not have enough free space.
+    ///\param first The first element to add.
+    ///\param last  The last + 1 element to add.
+    //*********************************************************************
+    template <class TIterator>
+    void insert(TIterator first_, TIterator last_)
+    {
+      while (first_ != last_)
+      {
+        insert(*first_);
+        ++first_;
+      }
+    }
+
+    //*********************************************************************
+    /// Erases an element.
+    ///\param key The key to erase.
+    ///\return The number of elements erased. 0 or 1.
+    //*********************************************************************
+    size_t erase(const_key_reference key)
+    {
+      const size_t h     = hash_of(key);
+      const size_t index = find_slot(key, h);
+
+      if (index == slot_count())
+      {
+        return 0U;
+      }
+
+      erase_slot(index, h);
+
+      return 1U;
+    }
+
+    //*********************************************************************
+    /// Erases an element.
+    ///\param ielement Iterator to the element.
+    ///\return An iterator to the next element.
+    //*********************************************************************
+    iterator erase(const_iterator ielement)
+    {
+      const size_t index = ielement.index;
+
+      erase_slot(index, hash_of(pslots[index].first));
+
+      // Erase does not move other elements, so the next element is simply the next full slot.
+      iterator inext = make_iterator(index);
+      ++inext;
+
+      return inext;
+    }
+
+    //*********************************************************************
+    /// Erases a range of elements.
+    /// The range includes all the elements between first and last, including the
+    /// element pointed by first, but not the one pointed to by last.
+    ///\param first Iterator to the first element.
+    ///\param last  Iterator to the last element.
+    ///\return An iterator to the next element.
+    //*********************************************************************
+    iterator erase(const_iterator first_, const_iterator last_)
+    {
+      while (first_ != last_)
+      {
+        first_ = erase(first_);
+      }
+
+      return make_iterator(last_.index);
+    }
+
+    //*************************************************************************
+    /// Clears the flat_hash_map.
+    //*************************************************************************
+    void clear()
+    {
+      initialise();
+    }
+
+    //*********************************************************************
+    /// Counts an element.
+    ///\param key The key to search for.
+    ///\return 1 if the key exists, otherwise 0.
+    //*********************************************************************
+    size_t count(const_key_reference key) const
+    {
+      return (find_slot(key, hash_of(key)) == slot_count()) ? 0U : 1U;
+    }
+
+#if ETL_USING_CPP11
+    //*********************************************************************
+    /// Counts an element.
+    ///\param key The key to search for.
+    ///\return 1 if the key exists, otherwise 0.
+    //*********************************************************************
+    template <typename K, typename KE = TKeyEqual, etl::enable_if_t<comparator_is_transparent<KE>::value, int> = 0>
+    size_t count(const K& key) const
+    {
+      return (find_slot(key, hash_of(key)) == slot_count()) ? 0U : 1U;
+    }
+#endif
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator to the element if the key exists, otherwise end().
+    //*********************************************************************
+    iterator find(const_key_reference key)
+    {
+      return make_iterator(find_slot(key, hash_of(key)));
+    }
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator to the element if the key exists, otherwise end().
+    //*********************************************************************
+    const_iterator find(const_key_reference key) const
+    {
+      return make_const_iterator(find_slot(key, hash_of(key)));
+    }
+
+#if ETL_USING_CPP11
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator to the element if the key exists, otherwise end().
+    //*********************************************************************
+    template <typename K, typename KE = TKeyEqual, etl::enable_if_t<comparator_is_transparent<KE>::value, int> = 0>
+    iterator find(const K& key)
+    {
+      return make_iterator(find_slot(key, hash_of(key)));
+    }
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator to the element if the key exists, otherwise end().
+    //*********************************************************************
+    template <typename K, typename KE = TKeyEqual, etl::enable_if_t<comparator_is_transparent<KE>::value, int> = 0>
+    const_iterator find(const K& key) const
+    {
+      return make_const_iterator(find_slot(key, hash_of(key)));
+    }
+#endif
+
+    //*********************************************************************
+    /// Returns a range containing all elements with key 'key' in the container.
+    /// The range is defined by two iterators, the first pointing to the first
+    /// element of the wanted range and the second pointing past the last
+    /// element of the range.
+    ///\param key The key to search for.
+    ///\return An iterator pair to the range of elements if the key exists, otherwise end().
+    //*********************************************************************
+    ETL_OR_STD::pair<iterator, iterator> equal_range(const_key_reference key)
+    {
+      iterator f = find(key);
+      iterator l = f;
+
+      if (l != end())
+      {
+        ++l;
+      }
+
+      return ETL_OR_STD::pair<iterator, iterator>(f, l);
+    }
+
+    //*********************************************************************
+    /// Returns a range containing all elements with key 'key' in the container.
+    ///\param key The key to search for.
+    ///\return A const iterator pair to the range of elements if the key exists, otherwise end().
+    //*********************************************************************
+    ETL_OR_STD::pair<const_iterator, const_iterator> equal_range(const_key_reference key) const
+    {
+      const_iterator f = find(key);
+      const_iterator l = f;
+
+      if (l != end())
+      {
+        ++l;
+      }
+
+      return ETL_OR_STD::pair<const_iterator, const_iterator>(f, l);
+    }
+
+    //*************************************************************************
+    /// Gets the size of the flat_hash_map.
+    //*************************************************************************
+    size_type size() const
+    {
+      return current_size;
+    }
+
+    //*************************************************************************
+    /// Gets the maximum possible size of the flat_hash_map.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return max_elements;
+    }
+
+    //*************************************************************************
+    /// Gets the maximum possible size of the flat_hash_map.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return max_elements;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the flat_hash_map is empty.
+    //*************************************************************************
+    bool empty() const
+    {
+      return current_size == 0U;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the flat_hash_map is full.
+    //*************************************************************************
+    bool full() const
+    {
+      return current_size == max_elements;
+    }
+
+    //*************************************************************************
+    /// Returns the remaining capacity.
+    ///\return The remaining capacity.
+    //*************************************************************************
+    size_t available() const
+    {
+      return max_elements - current_size;
+    }
+
+    //*************************************************************************
+    /// Returns the number of slots.
+    /// Always a power of two multiple of the group width, and at least 8/7 of max_size().
+    //*************************************************************************
+    size_type slot_count() const
+    {
+      return number_of_groups * private_flat_hash_map::Group_Width;
+    }
+
+    //*************************************************************************
+    /// Returns the load factor = size / slot_count.
+    ///\return The load factor = size / slot_count.
+    //*************************************************************************
+    float load_factor() const
+    {
+      return static_cast<float>(size()) / static_cast<float>(slot_count());
+    }
+
+    //*************************************************************************
+    /// Returns the function that hashes the keys.
+    ///\return The function that hashes the keys..
+    //*************************************************************************
+    hasher hash_function() const
+    {
+      return key_hash_function;
+    }
+
+    //*************************************************************************
+    /// Returns the function that compares the keys.
+    ///\return The function that compares the keys..
+    //*************************************************************************
+    key_equal key_eq() const
+    {
+      return key_equal_function;
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    iflat_hash_map& operator = (const iflat_hash_map& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        key_hash_function  = rhs.hash_function();
+        key_equal_function = rhs.key_eq();
+        assign(rhs.cbegin(), rhs.cend());
+      }
+
+      return *this;
+    }
+
+#if ETL_USING_CPP11
+    //*************************************************************************
+    /// Move assignment operator.
+    //*************************************************************************
+    iflat_hash_map& operator = (iflat_hash_map&& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        clear();
+        key_hash_function  = rhs.hash_function();
+        key_equal_function = rhs.key_eq();
+        this->move(rhs.begin(), rhs.end());
+      }
+
+      return *this;
+    }
+#endif
+
+    //*************************************************************************
+    /// Check if the flat_hash_map contains the key.
+    //*************************************************************************
+    bool contains(const_key_reference key) const
+    {
+      return find_slot(key, hash_of(key)) != slot_count();
+    }
+
+#if ETL_USING_CPP11
+    //*************************************************************************
+    /// Check if the flat_hash_map contains the key.
+    //*************************************************************************
+    template <typename K, typename KE = TKeyEqual, etl::enable_if_t<comparator_is_transparent<KE>::value, int> = 0>
+    bool contains(const K& key) const
+    {
+      return find_slot(key, hash_of(key)) != slot_count();
+    }
+#endif
+
+  protected:
+
+    //*********************************************************************
+    /// Constructor.
+    //*********************************************************************
+    iflat_hash_map(pointer pslots_, uint8_t* pctrl_, uint8_t* poverflow_, size_t number_of_groups_, size_t max_elements_, hasher key_hash_function_, key_equal key_equal_function_)
+      : pslots(pslots_)
+      , pctrl(pctrl_)
+      , poverflow(poverflow_)
+      , number_of_groups(number_of_groups_)
+      , max_elements(max_elements_)
+      , current_size(0U)
+      , stale_overflow(0U)
+      , key_hash_function(key_hash_function_)
+      , key_equal_function(key_equal_function_)
+    {
+      memset(pctrl, private_flat_hash_map::Ctrl_Empty, slot_count());
+      memset(poverflow, 0, number_of_groups);
+    }
+
+    //*********************************************************************
+    /// Initialise the flat_hash_map.
+    //*********************************************************************
+    void initialise()
+    {
+      if (!empty())
+      {
+        if ETL_IF_CONSTEXPR(!etl::is_trivially_destructible<value_type>::value)
+        {
+          for (size_t i = 0U; i < slot_count(); ++i)
+          {
+            if (pctrl[i] != private_flat_hash_map::Ctrl_Empty)
+            {
+              pslots[i].~value_type();
+            }
+          }
+        }
+
+        ETL_SUBTRACT_DEBUG_COUNT(int32_t(current_size));
+
+        memset(pctrl, private_flat_hash_map::Ctrl_Empty, slot_count());
+        memset(poverflow, 0, number_of_groups);
+        current_size   = 0U;
+        stale_overflow = 0U;
+      }
+    }
+
+#if ETL_USING_CPP11
+    //*************************************************************************
+    /// Move from a range
+    //*************************************************************************
+    void move(iterator b, iterator e)
+    {
+      while (b != e)
+      {
+        iterator temp = b;
+        ++temp;
+        insert(etl::move(*b));
+        b = temp;
+      }
+    }
+#endif
+
+  private:
+
+    //*********************************************************************
+    /// The mixed hash of a key. The low 7 bits are stored in the control
+    /// byte, the remaining bits select the home group.
+    //*********************************************************************
+    template <typename K>
+    size_t hash_of(const K& key) const
+    {
+      return private_flat_hash_map::hash_mixer<sizeof(size_t)>::mix(key_hash_function(key));
+    }
+
+    //*********************************************************************
+    static uint8_t control_hash(size_t h)
+    {
+      return static_cast<uint8_t>(h & 0x7FU);
+    }
+
+    //*********************************************************************
+    size_t home_group(size_t h) const
+    {
+      return (h >> 7U) & (number_of_groups - 1U);
+    }
+
+    //*********************************************************************
+    /// Triangular probing visits every group once when the group count is a power of 2.
+    //*********************************************************************
+    size_t next_group(size_t g, size_t probe) const
+    {
+      return (g + probe + 1U) & (number_of_groups - 1U);
+    }
+
+    //*********************************************************************
+    /// Finds the slot holding the key.
+    ///\return The slot index, or slot_count() if not found.
+    //*********************************************************************
+    template <typename K>
+    size_t find_slot(const K& key, size_t h) const
+    {
+      typedef private_flat_hash_map::group group_t;
+
+      const uint8_t h2 = control_hash(h);
+      size_t g         = home_group(h);
+
+      for (size_t probe = 0U; probe < number_of_groups; ++probe)
+      {
+        const size_t base = g * private_flat_hash_map::Group_Width;
+
+        typename group_t::mask_type mask = group_t(pctrl + base).match(h2);
+
+        while (mask != 0U)
+        {
+          const size_t index = base + (private_flat_hash_map::lowest_bit(mask) >> group_t::Lane_Shift);
+
+          if (key_equal_function(pslots[index].first, key))
+          {
+            return index;
+          }
+
+          mask &= mask - 1U;
+        }
+
+        // Nothing with this home group has ever been pushed past here.
+        if (poverflow[g] == 0U)
+        {
+          break;
+        }
+
+        g = next_group(g, probe);
+      }
+
+      return slot_count();
+    }
+
+    //*********************************************************************
+    /// Finds an empty slot for a key that is not in the map and marks it as
+    /// full. Each full group that is passed has its overflow count raised.
+    ///\return The slot index.
+    //*********************************************************************
+    size_t prepare_insert(size_t h)
+    {
+      typedef private_flat_hash_map::group group_t;
+
+      size_t g = home_group(h);
+
+      for (size_t probe = 0U; probe < number_of_groups; ++probe)
+      {
+        const size_t base = g * private_flat_hash_map::Group_Width;
+
+        typename group_t::mask_type mask = group_t(pctrl + base).match_empty();
+
+        if (mask != 0U)
+        {
+          const size_t index = base + (private_flat_hash_map::lowest_bit(mask) >> group_t::Lane_Shift);
+
+          pctrl[index] = control_hash(h);
+          ++current_size;
+
+          return index;
+        }
+
+        if (poverflow[g] != private_flat_hash_map::Overflow_Max)
+        {
+          ++poverflow[g];
+        }
+
+        g = next_group(g, probe);
+      }
+
+      // Unreachable while the load factor is limited to 7/8.
+      return slot_count();
+    }
+
+    //*********************************************************************
+    /// Destroys the element in a slot and marks it as empty.
+    /// The overflow counts raised when it was inserted are lowered.
+    /// A saturated count cannot be lowered, as the true count is unknown.
+    /// Those skipped decrements are counted, and after Overflow_Max of them
+    /// the counts are recalculated, so churn does not leave groups that
+    /// lookups must probe past forever.
+    //*********************************************************************
+    void erase_slot(size_t index, size_t h)
+    {
+      const size_t target = index / private_flat_hash_map::Group_Width;
+      size_t g            = home_group(h);
+      bool   saturated    = false;
+
+      for (size_t probe = 0U; g != target; ++probe)
+      {
+        if (poverflow[g] != private_flat_hash_map::Overflow_Max)
+        {
+          --poverflow[g];
+        }
+        else
+        {
+          saturated = true;
+        }
+
+        g = next_group(g, probe);
+      }
+
+      pslots[index].~value_type();
+      pctrl[index] = private_flat_hash_map::Ctrl_Empty;
+      --current_size;
+      ETL_DECREMENT_DEBUG_COUNT;
+
+      if (current_size == 0U)
+      {
+        memset(poverflow, 0, number_of_groups);
+        stale_overflow = 0U;
+      }
+      else if (saturated && (++stale_overflow >= size_t(private_flat_hash_map::Overflow_Max)))
+      {
+        recalculate_overflow();
+      }
+    }
+
+    //*********************************************************************
+    /// Rebuilds every overflow count by walking each element's probe
+    /// sequence from its home group to the group that holds it.
+    //*********************************************************************
+    void recalculate_overflow()
+    {
+      memset(poverflow, 0, number_of_groups);
+
+      for (size_t index = 0U; index < slot_count(); ++index)
+      {
+        if (pctrl[index] != private_flat_hash_map::Ctrl_Empty)
+        {
+          const size_t target = index / private_flat_hash_map::Group_Width;
+          size_t g            = home_group(hash_of(pslots[index].first));
+
+          for (size_t probe = 0U; g != target; ++probe)
+          {
+            if (poverflow[g] != private_flat_hash_map::Overflow_Max)
+            {
+              ++poverflow[g];
+            }
+
+            g = next_group(g, probe);
+          }
+        }
+      }
+
+      stale_overflow = 0U;
+    }
+
+    //*********************************************************************
+    size_t first_full() const
+    {
+      size_t index = 0U;
+
+      if (!empty())
+      {
+        while (pctrl[index] == private_flat_hash_map::Ctrl_Empty)
+        {
+          ++index;
+        }
+      }
+      else
+      {
+        index = slot_count();
+      }
+
+      return index;
+    }
+
+    //*********************************************************************
+    iterator make_iterator(size_t index)
+    {
+      return iterator(pctrl, pslots, index, slot_count());
+    }
+
+    //*********************************************************************
+    const_iterator make_const_iterator(size_t index) const
+    {
+      return const_iterator(pctrl, pslots, index, slot_count());
+    }
+
+    // Disable copy construction.
+    iflat_hash_map(const iflat_hash_map&);
+
+    /// The element slots.
+    pointer pslots;
+
+    /// One control byte per slot.
+    uint8_t* pctrl;
+
+    /// One overflow count per group.
+    uint8_t* poverflow;
+
+    /// The number of groups. A power of 2.
+    const size_t number_of_groups;
+
+    /// The maximum number of elements.
+    const size_t max_elements;
+
+    /// The current number of elements.
+    size_t current_size;
+
+    /// Decrements skipped at saturated overflow counts since the last recalculation.
+    size_t stale_overflow;
+
+    /// The function that creates the hashes.
+    hasher key_hash_function;
+
+    /// The function that compares the keys for equality.
+    key_equal key_equal_function;
+
+    /// For library debugging purposes only.
+    ETL_DECLARE_DEBUG_COUNT;
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_FLAT_HASH_MAP) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~iflat_hash_map()
+    {
+    }
+#else
+  protected:
+    ~iflat_hash_map()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  /// Equal operator.
+  ///\param lhs Reference to the first flat_hash_map.
+  ///\param rhs Reference to the second flat_hash_map.
+  ///\return <b>true</b> if the maps are equal, otherwise <b>false</b>
+  ///\ingroup flat_hash_map
+  //***************************************************************************
+  template <typename TKey, typename T, typename THash, typename TKeyEqual>
+  bool operator ==(const etl::iflat_hash_map<TKey, T, THash, TKeyEqual>& lhs,
+                   const etl::iflat_hash_map<TKey, T, THash, TKeyEqual>& rhs)
+  {
+    typedef typename etl::iflat_hash_map<TKey, T, THash, TKeyEqual>::const_iterator itr_t;
+
+    if (lhs.size() != rhs.size())
+    {
+      return false;
+    }
+
+    for (itr_t l = lhs.begin(); l != lhs.end(); ++l)
+    {
+      itr_t r = rhs.find(l->first);
+
+      if ((r == rhs.end()) || !(r->second == l->second))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  //***************************************************************************
+  /// Not equal operator.
+  ///\param lhs Reference to the first flat_hash_map.
+  ///\param rhs Reference to the second flat_hash_map.
+  ///\return <b>true</b> if the maps are not equal, otherwise <b>false</b>
+  ///\ingroup flat_hash_map
+  //***************************************************************************
+  template <typename TKey, typename T, typename THash, typename TKeyEqual>
+  bool operator !=(const etl::iflat_hash_map<TKey, T, THash, TKeyEqual>& lhs,
+                   const etl::iflat_hash_map<TKey, T, THash, TKeyEqual>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  //*************************************************************************
+  /// A templated flat_hash_map implementation that uses a fixed size buffer.
+  /// The slot count is MAX_SIZE_ * 8/7 rounded up to a power of 2, with a
+  /// minimum of one group of 16 slots.
+  //*************************************************************************
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename THash = etl::hash<TKey>, typename TKeyEqual = etl::equal_to<TKey> >
+  class flat_hash_map : public etl::iflat_hash_map<TKey, TValue, THash, TKeyEqual>
+  {
+  private:
+
+    typedef etl::iflat_hash_map<TKey, TValue, THash, TKeyEqual> base;
+
+    static ETL_CONSTANT size_t MIN_SLOTS = MAX_SIZE_ + ((MAX_SIZE_ + 6U) / 7U);
+    static ETL_CONSTANT size_t POW2_SLOTS = etl::power_of_2_round_up<MIN_SLOTS>::value;
+
+  public:
+
+    static ETL_CONSTANT size_t MAX_SIZE   = MAX_SIZE_;
+    static ETL_CONSTANT size_t SLOT_COUNT = (POW2_SLOTS < size_t(private_flat_hash_map::Group_Width)) ? size_t(private_flat_hash_map::Group_Width) : POW2_SLOTS;
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    flat_hash_map(const THash& hash = THash(), const TKeyEqual& equal = TKeyEqual())
+      : base(slots, ctrl, overflow, GROUP_COUNT, MAX_SIZE, hash, equal)
+    {
+    }
+
+    //*************************************************************************
+    /// Copy constructor.
+    //*************************************************************************
+    flat_hash_map(const flat_hash_map& other)
+      : base(slots, ctrl, overflow, GROUP_COUNT, MAX_SIZE, other.hash_function(), other.key_eq())
+    {
+      base::assign(other.cbegin(), other.cend());
+    }
+
+#if ETL_USING_CPP11
+    //*************************************************************************
+    /// Move constructor.
+    //*************************************************************************
+    flat_hash_map(flat_hash_map&& other)
+      : base(slots, ctrl, overflow, GROUP_COUNT, MAX_SIZE, other.hash_function(), other.key_eq())
+    {
+      if (this != &other)
+      {
+        base::move(other.begin(), other.end());
+      }
+    }
+#endif
+
+    //*************************************************************************
+    /// Constructor, from an iterator range.
+    ///\tparam TIterator The iterator type.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*************************************************************************
+    template <typename TIterator>
+    flat_hash_map(TIterator first_, TIterator last_, const THash& hash = THash(), const TKeyEqual& equal = TKeyEqual())
+      : base(slots, ctrl, overflow, GROUP_COUNT, MAX_SIZE, hash, equal)
+    {
+      base::assign(first_, last_);
+    }
+
+#if ETL_HAS_INITIALIZER_LIST
+    //*************************************************************************
+    /// Construct from initializer_list.
+    //*************************************************************************
+    flat_hash_map(std::initializer_list<ETL_OR_STD::pair<TKey, TValue>> init, const THash& hash = THash(), const TKeyEqual& equal = TKeyEqual())
+      : base(slots, ctrl, overflow, GROUP_COUNT, MAX_SIZE, hash, equal)
+    {
+      base::assign(init.begin(), init.end());
+    }
+#endif
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~flat_hash_map()
+    {
+      base::initialise();
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    flat_hash_map& operator = (const flat_hash_map& rhs)
+    {
+      base::operator=(rhs);
+
+      return *this;
+    }
+
+#if ETL_USING_CPP11
+    //*************************************************************************
+    /// Move assignment operator.
+    //*************************************************************************
+    flat_hash_map& operator = (flat_hash_map&& rhs)
+    {
+      base::operator=(etl::move(rhs));
+
+      return *this;
+    }
+#endif
+
+  private:
+
+    static ETL_CONSTANT size_t GROUP_COUNT = SLOT_COUNT / private_flat_hash_map::Group_Width;
+
+    /// The element slots.
+    etl::uninitialized_buffer_of<typename base::value_type, SLOT_COUNT> slots;
+
+    /// One control byte per slot.
+    uint8_t ctrl[SLOT_COUNT];
+
+    /// One overflow count per group.
+    uint8_t overflow[GROUP_COUNT];
+  };
+
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename THash, typename TKeyEqual>
+  ETL_CONSTANT size_t flat_hash_map<TKey, TValue, MAX_SIZE_, THash, TKeyEqual>::MAX_SIZE;
+
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename THash, typename TKeyEqual>
+  ETL_CONSTANT size_t flat_hash_map<TKey, TValue, MAX_SIZE_, THash, TKeyEqual>::SLOT_COUNT;
+
+  //*************************************************************************
+  /// Make
+  //*************************************************************************
+#if ETL_USING_CPP11 && ETL_HAS_INITIALIZER_LIST
+  template <typename TKey, typename T, typename THash = etl::hash<TKey>, typename TKeyEqual = etl::equal_to<TKey>, typename... TPairs>
+  constexpr auto make_flat_hash_map(TPairs&&... pairs) -> etl::flat_hash_map<TKey, T, sizeof...(TPairs), THash, TKeyEqual>
+  {
+    return { etl::forward<TPairs>(pairs)... };
+  }
+#endif
+}
+
+#endif
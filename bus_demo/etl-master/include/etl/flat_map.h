@@ -971,13 +971,42 @@ namespace etl
       return refmap_t::available();
     }
 
+    //*************************************************************************
+    /// Builds a search index over the current elements.
+    /// Until the next insert or erase, lookups search the index instead of
+    /// the sorted elements. Any insert, erase or clear discards the index, so
+    /// freeze again after a batch of changes.
+    ///\return <b>true</b> if the index was built, <b>false</b> if the map was declared without one.
+    //*************************************************************************
+    bool freeze()
+    {
+      return refmap_t::freeze();
+    }
+
+    //*************************************************************************
+    /// Discards the search index.
+    //*************************************************************************
+    void thaw()
+    {
+      refmap_t::thaw();
+    }
+
+    //*************************************************************************
+    /// Checks whether lookups are using the search index.
+    //*************************************************************************
+    bool is_frozen() const
+    {
+      return refmap_t::is_frozen();
+    }
+
   protected:
 
     //*********************************************************************
     /// Constructor.
+    /// The index storage must hold capacity() + 1 keys and ranks, or be null.
     //*********************************************************************
-    iflat_map(lookup_t& lookup_, storage_t& storage_)
-      : refmap_t(lookup_),
+    iflat_map(lookup_t& lookup_, storage_t& storage_, key_type* p_index_keys = ETL_NULLPTR, size_t* p_index_ranks = ETL_NULLPTR)
+      : refmap_t(lookup_, p_index_keys, p_index_ranks),
         storage(storage_)
     {
     }
@@ -1122,9 +1151,10 @@ namespace etl
   ///\tparam TValue   The value type.
   ///\tparam TCompare The type to compare keys. Default = etl::less<TKey>
   ///\tparam MAX_SIZE_ The maximum number of elements that can be stored.
+  ///\tparam INDEXED_  Reserves storage for the search index built by freeze(). Default = false
   ///\ingroup flat_map
   //***************************************************************************
-  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = etl::less<TKey> >
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = etl::less<TKey>, const bool INDEXED_ = false>
   class flat_map : public etl::iflat_map<TKey, TValue, TCompare>
   {
   public:
@@ -1135,7 +1165,7 @@ namespace etl
     /// Constructor.
     //*************************************************************************
     flat_map()
-      : etl::iflat_map<TKey, TValue, TCompare>(lookup, storage)
+      : etl::iflat_map<TKey, TValue, TCompare>(lookup, storage, index_storage.keys(), index_storage.ranks())
     {
     }
 
@@ -1143,7 +1173,7 @@ namespace etl
     /// Copy constructor.
     //*************************************************************************
     flat_map(const flat_map& other)
-      : etl::iflat_map<TKey, TValue, TCompare>(lookup, storage)
+      : etl::iflat_map<TKey, TValue, TCompare>(lookup, storage, index_storage.keys(), index_storage.ranks())
     {
       this->assign(other.cbegin(), other.cend());
     }
@@ -1153,7 +1183,7 @@ namespace etl
     /// Move constructor.
     //*************************************************************************
     flat_map(flat_map&& other)
-      : etl::iflat_map<TKey, TValue, TCompare>(lookup, storage)
+      : etl::iflat_map<TKey, TValue, TCompare>(lookup, storage, index_storage.keys(), index_storage.ranks())
     {
       if (&other != this)
       {
@@ -1170,7 +1200,7 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     flat_map(TIterator first, TIterator last)
-      : etl::iflat_map<TKey, TValue, TCompare>(lookup, storage)
+      : etl::iflat_map<TKey, TValue, TCompare>(lookup, storage, index_storage.keys(), index_storage.ranks())
     {
       this->assign(first, last);
     }
@@ -1180,7 +1210,7 @@ namespace etl
     /// Construct from initializer_list.
     //*************************************************************************
     flat_map(std::initializer_list<typename etl::iflat_map<TKey, TValue, TCompare>::value_type> init)
-      : etl::iflat_map<TKey, TValue, TCompare>(lookup, storage)
+      : etl::iflat_map<TKey, TValue, TCompare>(lookup, storage, index_storage.keys(), index_storage.ranks())
     {
       this->assign(init.begin(), init.end());
     }
@@ -1231,10 +1261,13 @@ namespace etl
 
     /// The vector that stores pointers to the nodes.
     etl::vector<node_t*, MAX_SIZE> lookup;
+
+    /// The storage for the search index.
+    etl::private_eytzinger::eytzinger_storage<TKey, MAX_SIZE, INDEXED_> index_storage;
   };
 
-  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare>
-  ETL_CONSTANT size_t flat_map<TKey, TValue, MAX_SIZE_, TCompare>::MAX_SIZE;
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare, const bool INDEXED_>
+  ETL_CONSTANT size_t flat_map<TKey, TValue, MAX_SIZE_, TCompare, INDEXED_>::MAX_SIZE;
 
   //*************************************************************************
   /// Template deduction guides.
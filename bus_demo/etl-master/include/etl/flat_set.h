@@ -798,7 +798,7 @@ namespace etl
     //*********************************************************************
     ETL_OR_STD::pair<const_iterator, const_iterator> equal_range(key_parameter_t key) const
     {
-      return refset_t::upper_bound(key);
+      return refset_t::equal_range(key);
     }
 
 #if ETL_USING_CPP11
@@ -806,7 +806,7 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     ETL_OR_STD::pair<const_iterator, const_iterator> equal_range(const K& key) const
     {
-      return refset_t::upper_bound(key);
+      return refset_t::equal_range(key);
     }
 #endif
 
@@ -906,13 +906,42 @@ namespace etl
       return refset_t::available();
     }
 
+    //*************************************************************************
+    /// Builds a search index over the current elements.
+    /// Until the next insert or erase, lookups search the index instead of
+    /// the sorted elements. Any insert, erase or clear discards the index, so
+    /// freeze again after a batch of changes.
+    ///\return <b>true</b> if the index was built, <b>false</b> if the set was declared without one.
+    //*************************************************************************
+    bool freeze()
+    {
+      return refset_t::freeze();
+    }
+
+    //*************************************************************************
+    /// Discards the search index.
+    //*************************************************************************
+    void thaw()
+    {
+      refset_t::thaw();
+    }
+
+    //*************************************************************************
+    /// Checks whether lookups are using the search index.
+    //*************************************************************************
+    bool is_frozen() const
+    {
+      return refset_t::is_frozen();
+    }
+
   protected:
 
     //*********************************************************************
     /// Constructor.
+    /// The index storage must hold capacity() + 1 keys and ranks, or be null.
     //*********************************************************************
-    iflat_set(lookup_t& lookup_, storage_t& storage_)
-      : refset_t(lookup_),
+    iflat_set(lookup_t& lookup_, storage_t& storage_, key_type* p_index_keys = ETL_NULLPTR, size_t* p_index_ranks = ETL_NULLPTR)
+      : refset_t(lookup_, p_index_keys, p_index_ranks),
         storage(storage_)
     {
     }
@@ -1003,9 +1032,10 @@ namespace etl
   ///\tparam T        The value type.
   ///\tparam TCompare The type to compare keys. Default = etl::less<T>
   ///\tparam MAX_SIZE_ The maximum number of elements that can be stored.
+  ///\tparam INDEXED_  Reserves storage for the search index built by freeze(). Default = false
   ///\ingroup flat_set
   //***************************************************************************
-  template <typename T, const size_t MAX_SIZE_, typename TCompare = etl::less<T> >
+  template <typename T, const size_t MAX_SIZE_, typename TCompare = etl::less<T>, const bool INDEXED_ = false>
   class flat_set : public etl::iflat_set<T, TCompare>
   {
   public:
@@ -1016,7 +1046,7 @@ namespace etl
     /// Constructor.
     //*************************************************************************
     flat_set()
-      : etl::iflat_set<T, TCompare>(lookup, storage)
+      : etl::iflat_set<T, TCompare>(lookup, storage, index_storage.keys(), index_storage.ranks())
     {
     }
 
@@ -1024,7 +1054,7 @@ namespace etl
     /// Copy constructor.
     //*************************************************************************
     flat_set(const flat_set& other)
-      : etl::iflat_set<T, TCompare>(lookup, storage)
+      : etl::iflat_set<T, TCompare>(lookup, storage, index_storage.keys(), index_storage.ranks())
     {
       this->assign(other.cbegin(), other.cend());
     }
@@ -1034,7 +1064,7 @@ namespace etl
     /// Move constructor.
     //*************************************************************************
     flat_set(flat_set&& other)
-      : etl::iflat_set<T, TCompare>(lookup, storage)
+      : etl::iflat_set<T, TCompare>(lookup, storage, index_storage.keys(), index_storage.ranks())
     {
       if (&other != this)
       {
@@ -1051,7 +1081,7 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     flat_set(TIterator first, TIterator last)
-      : etl::iflat_set<T, TCompare>(lookup, storage)
+      : etl::iflat_set<T, TCompare>(lookup, storage, index_storage.keys(), index_storage.ranks())
     {
       this->assign(first, last);
     }
@@ -1061,7 +1091,7 @@ namespace etl
     /// Construct from initializer_list.
     //*************************************************************************
     flat_set(std::initializer_list<T> init)
-      : etl::iflat_set<T, TCompare>(lookup, storage)
+      : etl::iflat_set<T, TCompare>(lookup, storage, index_storage.keys(), index_storage.ranks())
     {
       this->assign(init.begin(), init.end());
     }
@@ -1112,10 +1142,13 @@ namespace etl
 
     // The vector that stores pointers to the nodes.
     etl::vector<node_t*, MAX_SIZE> lookup;
+
+    // The storage for the search index.
+    etl::private_eytzinger::eytzinger_storage<T, MAX_SIZE, INDEXED_> index_storage;
   };
 
-  template <typename T, const size_t MAX_SIZE_, typename TCompare>
-  ETL_CONSTANT size_t flat_set<T, MAX_SIZE_, TCompare>::MAX_SIZE;
+  template <typename T, const size_t MAX_SIZE_, typename TCompare, const bool INDEXED_>
+  ETL_CONSTANT size_t flat_set<T, MAX_SIZE_, TCompare, INDEXED_>::MAX_SIZE;
 
   //*************************************************************************
   /// Template deduction guides.
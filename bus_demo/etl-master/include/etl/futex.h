@@ -0,0 +1,186 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_FUTEX_INCLUDED
+#define ETL_FUTEX_INCLUDED
+
+#include "platform.h"
+
+#if !defined(ETL_NO_FUTEX) && (defined(ETL_TARGET_OS_LINUX) || defined(__linux__)) && (defined(ETL_COMPILER_GCC) || defined(ETL_COMPILER_CLANG))
+  #define ETL_HAS_FUTEX 1
+#else
+  #define ETL_HAS_FUTEX 0
+#endif
+
+namespace etl
+{
+  namespace traits
+  {
+    static ETL_CONSTANT bool has_futex = (ETL_HAS_FUTEX == 1);
+  }
+}
+
+#if ETL_HAS_FUTEX
+
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+namespace etl
+{
+  //***************************************************************************
+  ///\ingroup futex
+  ///\brief An event that threads can block on until another thread notifies it.
+  ///\details Built on a Linux futex. Used to add blocking operations to the
+  /// lock free containers without slowing down their non-blocking paths.
+  /// notify() is a fence and a load unless a thread is waiting, and only
+  /// then makes a system call.
+  /// A waiting thread follows this pattern.
+  ///\code
+  /// while (!try_operation())
+  /// {
+  ///   uint32_t key = event.prepare_wait();
+  ///
+  ///   if (try_operation())  // Check again now that the wait is announced.
+  ///   {
+  ///     break;
+  ///   }
+  ///
+  ///   event.wait(key);
+  /// }
+  ///\endcode
+  /// The notifying thread calls notify() after making its change visible.
+  //***************************************************************************
+  class futex_event
+  {
+  public:
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    futex_event()
+      : state(0U)
+    {
+    }
+
+    //*************************************************************************
+    /// Announces that the calling thread is about to wait.
+    /// The condition must be checked again before calling wait().
+    ///\return The key to pass to wait().
+    //*************************************************************************
+    uint32_t prepare_wait()
+    {
+      uint32_t key = __atomic_fetch_or(&state, Waiting, __ATOMIC_SEQ_CST) | Waiting;
+
+      // Orders the announcement before the caller's second check.
+      __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+      return key;
+    }
+
+    //*************************************************************************
+    /// Blocks until notified, or until the deadline passes.
+    /// Returns immediately if there has been a notification since prepare_wait().
+    /// May return spuriously, so the caller must check its condition again.
+    ///\param key        The value returned by prepare_wait().
+    ///\param p_deadline The CLOCK_MONOTONIC time to give up at, or null to wait forever.
+    ///\return <b>false</b> if the deadline passed, otherwise <b>true</b>.
+    //*************************************************************************
+    bool wait(uint32_t key, const struct timespec* p_deadline = ETL_NULLPTR)
+    {
+      long result = syscall(SYS_futex, &state, FUTEX_WAIT_BITSET_PRIVATE, key, p_deadline, ETL_NULLPTR, FUTEX_BITSET_MATCH_ANY);
+
+      return !((result != 0) && (errno == ETIMEDOUT));
+    }
+
+    //*************************************************************************
+    /// Wakes all waiting threads.
+    /// Only makes a system call if a thread has announced that it is waiting.
+    //*************************************************************************
+    void notify()
+    {
+      // Orders the caller's change before the check for waiters.
+      __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+      uint32_t value = __atomic_load_n(&state, __ATOMIC_RELAXED);
+
+      // Adding one clears the waiting flag and advances the count, so that
+      // a thread that has not yet blocked sees the change and does not block.
+      do
+      {
+        if ((value & Waiting) == 0U)
+        {
+          return;
+        }
+      } while (!__atomic_compare_exchange_n(&state, &value, value + 1U, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+      syscall(SYS_futex, &state, FUTEX_WAKE_PRIVATE, INT_MAX, ETL_NULLPTR, ETL_NULLPTR, 0);
+    }
+
+    //*************************************************************************
+    /// Gets the CLOCK_MONOTONIC time a number of milliseconds from now.
+    //*************************************************************************
+    static struct timespec get_deadline(uint32_t timeout_ms)
+    {
+      struct timespec deadline;
+
+      clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+      deadline.tv_sec  += time_t(timeout_ms / 1000U);
+      deadline.tv_nsec += long(timeout_ms % 1000U) * 1000000L;
+
+      if (deadline.tv_nsec >= 1000000000L)
+      {
+        deadline.tv_sec  += 1;
+        deadline.tv_nsec -= 1000000000L;
+      }
+
+      return deadline;
+    }
+
+  private:
+
+    static ETL_CONSTANT uint32_t Waiting = 1U; ///< Set while a thread may be waiting.
+
+    // Disable copy construction and assignment.
+    futex_event(const futex_event&) ETL_DELETE;
+    futex_event& operator =(const futex_event&) ETL_DELETE;
+
+    uint32_t state; ///< The waiting flag in bit 0 and the notification count above it.
+  };
+}
+
+#endif
+
+#endif
@@ -538,6 +538,14 @@ SOFTWARE.
   #endif
 #endif
 
+//*************************************
+// The size of a data cache line.
+// Used to keep data written by different threads on separate cache lines.
+// Define as 1 for targets without a data cache to minimise the padding.
+#if !defined(ETL_CACHE_LINE_SIZE)
+  #define ETL_CACHE_LINE_SIZE 64
+#endif
+
 //*************************************
 // Determine if the ETL should use std::initializer_list.
 #if (defined(ETL_FORCE_ETL_INITIALIZER_LIST) && defined(ETL_FORCE_STD_INITIALIZER_LIST))
@@ -0,0 +1,1881 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_BTREE_BASE_INCLUDED
+#define ETL_BTREE_BASE_INCLUDED
+
+#include "../platform.h"
+#include "../algorithm.h"
+#include "../iterator.h"
+#include "../functional.h"
+#include "../pool.h"
+#include "../memory.h"
+#include "../exception.h"
+#include "../error_handler.h"
+#include "../debug_count.h"
+#include "../nullptr.h"
+#include "../type_traits.h"
+#include "../utility.h"
+#include "../placement_new.h"
+#include "../static_assert.h"
+
+#include "comparator_is_transparent.h"
+
+#include <stddef.h>
+
+//*****************************************************************************
+// The target size of a btree node, in bytes.
+// Leaves hold as many elements, and branches as many keys, as fit in this
+// size, with a minimum of 4 and a maximum of 64.
+//*****************************************************************************
+#ifndef ETL_BTREE_NODE_SIZE
+  #define ETL_BTREE_NODE_SIZE 256
+#endif
+
+namespace etl
+{
+  //***************************************************************************
+  /// Exception for the btree containers.
+  ///\ingroup btree
+  //***************************************************************************
+  class btree_exception : public etl::exception
+  {
+  public:
+
+    btree_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Full exception for the btree containers.
+  ///\ingroup btree
+  //***************************************************************************
+  class btree_full : public etl::btree_exception
+  {
+  public:
+
+    btree_full(string_type file_name_, numeric_type line_number_)
+      : etl::btree_exception(ETL_ERROR_TEXT("btree:full", ETL_BTREE_FILE_ID"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Out of bounds exception for the btree containers.
+  ///\ingroup btree
+  //***************************************************************************
+  class btree_out_of_bounds : public etl::btree_exception
+  {
+  public:
+
+    btree_out_of_bounds(string_type file_name_, numeric_type line_number_)
+      : etl::btree_exception(ETL_ERROR_TEXT("btree:bounds", ETL_BTREE_FILE_ID"B"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Iterator exception for the btree containers.
+  ///\ingroup btree
+  //***************************************************************************
+  class btree_iterator : public etl::btree_exception
+  {
+  public:
+
+    btree_iterator(string_type file_name_, numeric_type line_number_)
+      : etl::btree_exception(ETL_ERROR_TEXT("btree:iterator", ETL_BTREE_FILE_ID"C"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The base class for all btree containers.
+  ///\ingroup btree
+  //***************************************************************************
+  class btree_base
+  {
+  public:
+
+    typedef size_t size_type; ///< The type used for determining the size of the container.
+
+    //*************************************************************************
+    /// Gets the size of the container.
+    //*************************************************************************
+    size_type size() const
+    {
+      return current_size;
+    }
+
+    //*************************************************************************
+    /// Gets the maximum possible size of the container.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the container is empty.
+    //*************************************************************************
+    bool empty() const
+    {
+      return current_size == 0U;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the container is full.
+    //*************************************************************************
+    bool full() const
+    {
+      return current_size == CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the capacity of the container.
+    ///\return The capacity of the container.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the remaining capacity.
+    ///\return The remaining capacity.
+    //*************************************************************************
+    size_t available() const
+    {
+      return max_size() - size();
+    }
+
+    //*************************************************************************
+    /// Returns the number of branch levels above the leaves.
+    //*************************************************************************
+    size_type height() const
+    {
+      return tree_height;
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    btree_base(size_type max_size_)
+      : current_size(0U)
+      , CAPACITY(max_size_)
+      , tree_height(0U)
+    {
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~btree_base()
+    {
+    }
+
+    size_type       current_size; ///< The number of elements.
+    const size_type CAPACITY;     ///< The maximum number of elements.
+    size_type       tree_height;  ///< The number of branch levels.
+    ETL_DECLARE_DEBUG_COUNT;
+  };
+
+  namespace private_btree
+  {
+    //*************************************************************************
+    /// The deepest tree that the search paths can record.
+    //*************************************************************************
+    static ETL_CONSTANT size_t Max_Height = 16U;
+
+    //*************************************************************************
+    /// Clamps a size to a range.
+    //*************************************************************************
+    template <size_t Value, size_t Min_Value, size_t Max_Value>
+    struct clamp_size
+    {
+      static ETL_CONSTANT size_t value = (Value < Min_Value) ? Min_Value : ((Value > Max_Value) ? Max_Value : Value);
+    };
+
+    //*************************************************************************
+    /// The number of branch nodes, and branch levels, needed above 'Nodes'
+    /// nodes when every branch other than the root has at least
+    /// 'Min_Children' children.
+    //*************************************************************************
+    template <size_t Nodes, size_t Min_Children>
+    struct branch_count
+    {
+      static ETL_CONSTANT size_t parents = ((Nodes / Min_Children) > 1U) ? (Nodes / Min_Children) : 1U;
+      static ETL_CONSTANT size_t value   = parents + branch_count<parents, Min_Children>::value;
+      static ETL_CONSTANT size_t levels  = 1U + branch_count<parents, Min_Children>::levels;
+    };
+
+    template <size_t Min_Children>
+    struct branch_count<1U, Min_Children>
+    {
+      static ETL_CONSTANT size_t value  = 0U;
+      static ETL_CONSTANT size_t levels = 0U;
+    };
+
+    template <size_t Min_Children>
+    struct branch_count<0U, Min_Children>
+    {
+      static ETL_CONSTANT size_t value  = 0U;
+      static ETL_CONSTANT size_t levels = 0U;
+    };
+
+    //*************************************************************************
+    /// Gets the key from a map element.
+    //*************************************************************************
+    template <typename TValue, typename TKey>
+    struct map_key_of
+    {
+      const TKey& operator ()(const TValue& value) const
+      {
+        return value.first;
+      }
+    };
+
+    //*************************************************************************
+    /// Gets the key from a set element.
+    //*************************************************************************
+    template <typename TKey>
+    struct set_key_of
+    {
+      const TKey& operator ()(const TKey& value) const
+      {
+        return value;
+      }
+    };
+
+    //*************************************************************************
+    /// A B+tree of unique keys.
+    /// Elements are stored in sorted order in leaves, which are linked in
+    /// both directions. Branches hold copies of separator keys and pointers
+    /// to their children. Every node except the root is at least half full.
+    /// Nodes are allocated from two pools that are owned by the derived class.
+    /// Insert and erase move elements within and between leaves, so they
+    /// invalidate all iterators, pointers and references.
+    //*************************************************************************
+    template <typename TValue, typename TKey, typename TKeyOf, typename TKeyCompare>
+    class btree : public etl::btree_base
+    {
+    public:
+
+      typedef TValue            value_type;
+      typedef TKey              key_type;
+      typedef TKeyCompare       key_compare;
+      typedef value_type&       reference;
+      typedef const value_type& const_reference;
+#if ETL_USING_CPP11
+      typedef value_type&&      rvalue_reference;
+#endif
+      typedef value_type*       pointer;
+      typedef const value_type* const_pointer;
+      typedef size_t            size_type;
+
+      typedef const key_type&   const_key_reference;
+#if ETL_USING_CPP11
+      typedef key_type&&        rvalue_key_reference;
+#endif
+
+      /// The number of elements in a leaf.
+      static ETL_CONSTANT size_t Leaf_Capacity = clamp_size<ETL_BTREE_NODE_SIZE / sizeof(TValue), 4U, 64U>::value;
+
+      /// The number of children of a branch.
+      static ETL_CONSTANT size_t Branch_Capacity = clamp_size<ETL_BTREE_NODE_SIZE / (sizeof(TKey) + sizeof(void*)), 4U, 64U>::value;
+
+      /// The least number of elements in a leaf that is not the root.
+      static ETL_CONSTANT size_t Leaf_Min = (Leaf_Capacity + 1U) / 2U;
+
+      /// The least number of children of a branch that is not the root.
+      static ETL_CONSTANT size_t Branch_Min = (Branch_Capacity + 1U) / 2U;
+
+    protected:
+
+      //*************************************************************************
+      /// A leaf node.
+      //*************************************************************************
+      struct leaf_node
+      {
+        leaf_node* prev;
+        leaf_node* next;
+        size_t     count;
+        etl::uninitialized_buffer_of<TValue, Leaf_Capacity> values;
+      };
+
+      //*************************************************************************
+      /// A branch node.
+      /// keys[i] is greater than every key in children[i] and not greater than
+      /// any key in children[i + 1].
+      //*************************************************************************
+      struct branch_node
+      {
+        size_t count;
+        void*  children[Branch_Capacity];
+        etl::uninitialized_buffer_of<TKey, Branch_Capacity - 1U> keys;
+      };
+
+      //*************************************************************************
+      /// An element position.
+      //*************************************************************************
+      struct position
+      {
+        position()
+          : p_leaf(ETL_NULLPTR)
+          , index(0U)
+        {
+        }
+
+        position(leaf_node* p_leaf_, size_t index_)
+          : p_leaf(p_leaf_)
+          , index(index_)
+        {
+          // Step over the end of a leaf.
+          if ((p_leaf != ETL_NULLPTR) && (index == p_leaf->count))
+          {
+            p_leaf = p_leaf->next;
+            index  = 0U;
+          }
+        }
+
+        leaf_node* p_leaf;
+        size_t     index;
+      };
+
+      //*************************************************************************
+      /// One step of a search path.
+      //*************************************************************************
+      struct path_entry
+      {
+        branch_node* p_branch;
+        size_t       index;
+      };
+
+    public:
+
+      class const_iterator;
+
+      //*************************************************************************
+      /// iterator.
+      //*************************************************************************
+      class iterator : public etl::iterator<ETL_OR_STD::bidirectional_iterator_tag, value_type>
+      {
+      public:
+
+        friend class btree;
+        friend class const_iterator;
+
+        iterator()
+          : p_tree(ETL_NULLPTR)
+          , p_leaf(ETL_NULLPTR)
+          , index(0U)
+        {
+        }
+
+        iterator& operator ++()
+        {
+          if (++index == p_leaf->count)
+          {
+            p_leaf = p_leaf->next;
+            index  = 0U;
+          }
+
+          return *this;
+        }
+
+        iterator operator ++(int)
+        {
+          iterator temp(*this);
+          operator++();
+          return temp;
+        }
+
+        iterator& operator --()
+        {
+          if (p_leaf == ETL_NULLPTR)
+          {
+            p_leaf = p_tree->p_tail;
+            index  = p_leaf->count - 1U;
+          }
+          else if (index == 0U)
+          {
+            p_leaf = p_leaf->prev;
+            index  = p_leaf->count - 1U;
+          }
+          else
+          {
+            --index;
+          }
+
+          return *this;
+        }
+
+        iterator operator --(int)
+        {
+          iterator temp(*this);
+          operator--();
+          return temp;
+        }
+
+        reference operator *() const
+        {
+          return p_leaf->values.begin()[index];
+        }
+
+        pointer operator &() const
+        {
+          return &p_leaf->values.begin()[index];
+        }
+
+        pointer operator ->() const
+        {
+          return &p_leaf->values.begin()[index];
+        }
+
+        friend bool operator == (const iterator& lhs, const iterator& rhs)
+        {
+          return (lhs.p_leaf == rhs.p_leaf) && (lhs.index == rhs.index);
+        }
+
+        friend bool operator != (const iterator& lhs, const iterator& rhs)
+        {
+          return !(lhs == rhs);
+        }
+
+      private:
+
+        iterator(btree& tree, const position& pos)
+          : p_tree(&tree)
+          , p_leaf(pos.p_leaf)
+          , index(pos.index)
+        {
+        }
+
+        btree*     p_tree;
+        leaf_node* p_leaf;
+        size_t     index;
+      };
+
+      friend class iterator;
+
+      //*************************************************************************
+      /// const_iterator
+      //*************************************************************************
+      class const_iterator : public etl::iterator<ETL_OR_STD::bidirectional_iterator_tag, const value_type>
+      {
+      public:
+
+        friend class btree;
+
+        const_iterator()
+          : p_tree(ETL_NULLPTR)
+          , p_leaf(ETL_NULLPTR)
+          , index(0U)
+        {
+        }
+
+        const_iterator(const typename btree::iterator& other)
+          : p_tree(other.p_tree)
+          , p_leaf(other.p_leaf)
+          , index(other.index)
+        {
+        }
+
+        const_iterator& operator ++()
+        {
+          if (++index == p_leaf->count)
+          {
+            p_leaf = p_leaf->next;
+            index  = 0U;
+          }
+
+          return *this;
+        }
+
+        const_iterator operator ++(int)
+        {
+          const_iterator temp(*this);
+          operator++();
+          return temp;
+        }
+
+        const_iterator& operator --()
+        {
+          if (p_leaf == ETL_NULLPTR)
+          {
+            p_leaf = p_tree->p_tail;
+            index  = p_leaf->count - 1U;
+          }
+          else if (index == 0U)
+          {
+            p_leaf = p_leaf->prev;
+            index  = p_leaf->count - 1U;
+          }
+          else
+          {
+            --index;
+          }
+
+          return *this;
+        }
+
+        const_iterator operator --(int)
+        {
+          const_iterator temp(*this);
+          operator--();
+          return temp;
+        }
+
+        const_reference operator *() const
+        {
+          return p_leaf->values.begin()[index];
+        }
+
+        const_pointer operator &() const
+        {
+          return &p_leaf->values.begin()[index];
+        }
+
+        const_pointer operator ->() const
+        {
+          return &p_leaf->values.begin()[index];
+        }
+
+        friend bool operator == (const const_iterator& lhs, const const_iterator& rhs)
+        {
+          return (lhs.p_leaf == rhs.p_leaf) && (lhs.index == rhs.index);
+        }
+
+        friend bool operator != (const const_iterator& lhs, const const_iterator& rhs)
+        {
+          return !(lhs == rhs);
+        }
+
+      private:
+
+        const_iterator(const btree& tree, const position& pos)
+          : p_tree(&tree)
+          , p_leaf(pos.p_leaf)
+          , index(pos.index)
+        {
+        }
+
+        const btree* p_tree;
+        leaf_node*   p_leaf;
+        size_t       index;
+      };
+
+      friend class const_iterator;
+
+      typedef typename etl::iterator_traits<iterator>::difference_type difference_type;
+
+      typedef ETL_OR_STD::reverse_iterator<iterator>       reverse_iterator;
+      typedef ETL_OR_STD::reverse_iterator<const_iterator> const_reverse_iterator;
+
+      //*************************************************************************
+      /// Gets the beginning of the container.
+      //*************************************************************************
+      iterator begin()
+      {
+        return iterator(*this, position(p_head, 0U));
+      }
+
+      //*************************************************************************
+      /// Gets the beginning of the container.
+      //*************************************************************************
+      const_iterator begin() const
+      {
+        return const_iterator(*this, position(p_head, 0U));
+      }
+
+      //*************************************************************************
+      /// Gets the end of the container.
+      //*************************************************************************
+      iterator end()
+      {
+        return iterator(*this, position());
+      }
+
+      //*************************************************************************
+      /// Gets the end of the container.
+      //*************************************************************************
+      const_iterator end() const
+      {
+        return const_iterator(*this, position());
+      }
+
+      //*************************************************************************
+      /// Gets the beginning of the container.
+      //*************************************************************************
+      const_iterator cbegin() const
+      {
+        return const_iterator(*this, position(p_head, 0U));
+      }
+
+      //*************************************************************************
+      /// Gets the end of the container.
+      //*************************************************************************
+      const_iterator cend() const
+      {
+        return const_iterator(*this, position());
+      }
+
+      //*************************************************************************
+      /// Gets the reverse beginning of the container.
+      //*************************************************************************
+      reverse_iterator rbegin()
+      {
+        return reverse_iterator(end());
+      }
+
+      //*************************************************************************
+      /// Gets the reverse beginning of the container.
+      //*************************************************************************
+      const_reverse_iterator rbegin() const
+      {
+        return const_reverse_iterator(end());
+      }
+
+      //*************************************************************************
+      /// Gets the reverse end of the container.
+      //*************************************************************************
+      reverse_iterator rend()
+      {
+        return reverse_iterator(begin());
+      }
+
+      //*************************************************************************
+      /// Gets the reverse end of the container.
+      //*************************************************************************
+      const_reverse_iterator rend() const
+      {
+        return const_reverse_iterator(begin());
+      }
+
+      //*************************************************************************
+      /// Gets the reverse beginning of the container.
+      //*************************************************************************
+      const_reverse_iterator crbegin() const
+      {
+        return const_reverse_iterator(cend());
+      }
+
+      //*************************************************************************
+      /// Gets the reverse end of the container.
+      //*************************************************************************
+      const_reverse_iterator crend() const
+      {
+        return const_reverse_iterator(cbegin());
+      }
+
+      //*********************************************************************
+      /// Assigns values to the container.
+      /// If asserts or exceptions are enabled, emits btree_full if the container does not have enough free space.
+      ///\param first The iterator to the first element.
+      ///\param last  The iterator to the last element + 1.
+      //*********************************************************************
+      template <typename TIterator>
+      void assign(TIterator first, TIterator last)
+      {
+        initialise();
+        insert(first, last);
+      }
+
+      //*************************************************************************
+      /// Clears the container.
+      //*************************************************************************
+      void clear()
+      {
+        initialise();
+      }
+
+      //*********************************************************************
+      /// Counts the number of elements that contain the key specified.
+      ///\param key The key to search for.
+      ///\return 1 if element was found, 0 otherwise.
+      //*********************************************************************
+      size_type count(const_key_reference key) const
+      {
+        return (find_position(key).p_leaf != ETL_NULLPTR) ? 1U : 0U;
+      }
+
+#if ETL_USING_CPP11
+      //*********************************************************************
+      template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
+      size_type count(const K& key) const
+      {
+        return (find_position(key).p_leaf != ETL_NULLPTR) ? 1U : 0U;
+      }
+#endif
+
+      //*************************************************************************
+      /// Returns two iterators with bounding (lower bound, upper bound) the key
+      /// provided.
+      //*************************************************************************
+      ETL_OR_STD::pair<iterator, iterator> equal_range(const_key_reference key)
+      {
+        return ETL_OR_STD::make_pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+      }
+
+#if ETL_USING_CPP11
+      //*************************************************************************
+      template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
+      ETL_OR_STD::pair<iterator, iterator> equal_range(const K& key)
+      {
+        return ETL_OR_STD::make_pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+      }
+#endif
+
+      //*************************************************************************
+      /// Returns two const iterators with bounding (lower bound, upper bound)
+      /// the key provided.
+      //*************************************************************************
+      ETL_OR_STD::pair<const_iterator, const_iterator> equal_range(const_key_reference key) const
+      {
+        return ETL_OR_STD::make_pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+      }
+
+#if ETL_USING_CPP11
+      //*************************************************************************
+      template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
+      ETL_OR_STD::pair<const_iterator, const_iterator> equal_range(const K& key) const
+      {
+        return ETL_OR_STD::make_pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+      }
+#endif
+
+      //*************************************************************************
+      /// Erases the value at the specified position.
+      ///\return An iterator to the element after the erased one.
+      //*************************************************************************
+      iterator erase(const_iterator position_)
+      {
+        path_entry path[Max_Height];
+
+        descend(key_of(*position_), path);
+
+        return iterator(*this, erase_at(path, position_.p_leaf, position_.index));
+      }
+
+      //*************************************************************************
+      /// Erases the element with the key.
+      ///\return The number of elements erased. 0 or 1.
+      //*************************************************************************
+      size_type erase(const_key_reference key)
+      {
+        return erase_key(key);
+      }
+
+#if ETL_USING_CPP11
+      //*************************************************************************
+      template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
+      size_type erase(K&& key)
+      {
+        return erase_key(etl::forward<K>(key));
+      }
+#endif
+
+      //*************************************************************************
+      /// Erases a range of elements.
+      ///\return An iterator to the element after the last one erased.
+      //*************************************************************************
+      iterator erase(const_iterator first, const_iterator last)
+      {
+        // Erase moves the elements, so 'last' cannot be compared against
+        // after the first erase. Count the elements instead.
+        size_t n = static_cast<size_t>(etl::distance(first, last));
+
+        iterator itr(*this, position(first.p_leaf, first.index));
+
+        while (n-- != 0U)
+        {
+          itr = erase(const_iterator(itr));
+        }
+
+        return itr;
+      }
+
+      //*********************************************************************
+      /// Finds an element.
+      ///\param key The key to search for.
+      ///\return An iterator pointing to the element or end() if not found.
+      //*********************************************************************
+      iterator find(const_key_reference key)
+      {
+        return iterator(*this, find_position(key));
+      }
+
+#if ETL_USING_CPP11
+      //*********************************************************************
+      template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
+      iterator find(const K& key)
+      {
+        return iterator(*this, find_position(key));
+      }
+#endif
+
+      //*********************************************************************
+      /// Finds an element.
+      ///\param key The key to search for.
+      ///\return An iterator pointing to the element or end() if not found.
+      //*********************************************************************
+      const_iterator find(const_key_reference key) const
+      {
+        return const_iterator(*this, find_position(key));
+      }
+
+#if ETL_USING_CPP11
+      //*********************************************************************
+      template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
+      const_iterator find(const K& key) const
+      {
+        return const_iterator(*this, find_position(key));
+      }
+#endif
+
+      //*********************************************************************
+      /// Inserts a value.
+      /// If asserts or exceptions are enabled, emits btree_full if the container is already full.
+      ///\param value The value to insert.
+      //*********************************************************************
+      ETL_OR_STD::pair<iterator, bool> insert(const_reference value)
+      {
+        position    pos;
+        value_type* p_gap = make_gap(key_of(value), pos);
+
+        if (p_gap == ETL_NULLPTR)
+        {
+          return ETL_OR_STD::make_pair(iterator(*this, pos), false);
+        }
+
+        ::new (static_cast<void*>(p_gap)) value_type(value);
+        gap_filled();
+
+        return ETL_OR_STD::make_pair(iterator(*this, pos), true);
+      }
+
+#if ETL_USING_CPP11
+      //*********************************************************************
+      /// Inserts a value.
+      /// If asserts or exceptions are enabled, emits btree_full if the container is already full.
+      ///\param value The value to insert.
+      //*********************************************************************
+      ETL_OR_STD::pair<iterator, bool> insert(rvalue_reference value)
+      {
+        position    pos;
+        value_type* p_gap = make_gap(key_of(value), pos);
+
+        if (p_gap == ETL_NULLPTR)
+        {
+          return ETL_OR_STD::make_pair(iterator(*this, pos), false);
+        }
+
+        ::new (static_cast<void*>(p_gap)) value_type(etl::move(value));
+        gap_filled();
+
+        return ETL_OR_STD::make_pair(iterator(*this, pos), true);
+      }
+#endif
+
+      //*********************************************************************
+      /// Inserts a value.
+      /// If asserts or exceptions are enabled, emits btree_full if the container is already full.
+      ///\param position The position that would precede the value to insert. Ignored.
+      ///\param value    The value to insert.
+      //*********************************************************************
+      iterator insert(const_iterator /*position*/, const_reference value)
+      {
+        return insert(value).first;
+      }
+
+#if ETL_USING_CPP11
+      //*********************************************************************
+      /// Inserts a value.
+      /// If asserts or exceptions are enabled, emits btree_full if the container is already full.
+      ///\param position The position that would precede the value to insert. Ignored.
+      ///\param value    The value to insert.
+      //*********************************************************************
+      iterator insert(const_iterator /*position*/, rvalue_reference value)
+      {
+        return insert(etl::move(value)).first;
+      }
+#endif
+
+      //*********************************************************************
+      /// Inserts a range of values.
+      /// If asserts or exceptions are enabled, emits btree_full if the container does not have enough free space.
+      ///\param first The first element to add.
+      ///\param last  The last + 1 element to add.
+      //*********************************************************************
+      template <class TIterator>
+      void insert(TIterator first, TIterator last)
+      {
+        while (first != last)
+        {
+          insert(*first);
+          ++first;
+        }
+      }
+
+      //*********************************************************************
+      /// Finds the lower bound of a key.
+      ///\param key The key to search for.
+      ///\return An iterator to the first element not less than the key, or end().
+      //*********************************************************************
+      iterator lower_bound(const_key_reference key)
+      {
+        return iterator(*this, lower_position(key));
+      }
+
+#if ETL_USING_CPP11
+      //*********************************************************************
+      template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
+      iterator lower_bound(const K& key)
+      {
+        return iterator(*this, lower_position(key));
+      }
+#endif
+
+      //*********************************************************************
+      /// Finds the lower bound of a key.
+      ///\param key The key to search for.
+      ///\return An iterator to the first element not less than the key, or end().
+      //*********************************************************************
+      const_iterator lower_bound(const_key_reference key) const
+      {
+        return const_iterator(*this, lower_position(key));
+      }
+
+#if ETL_USING_CPP11
+      //*********************************************************************
+      template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
+      const_iterator lower_bound(const K& key) const
+      {
+        return const_iterator(*this, lower_position(key));
+      }
+#endif
+
+      //*********************************************************************
+      /// Finds the upper bound of a key.
+      ///\param key The key to search for.
+      ///\return An iterator to the first element greater than the key, or end().
+      //*********************************************************************
+      iterator upper_bound(const_key_reference key)
+      {
+        return iterator(*this, upper_position(key));
+      }
+
+#if ETL_USING_CPP11
+      //*********************************************************************
+      template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
+      iterator upper_bound(const K& key)
+      {
+        return iterator(*this, upper_position(key));
+      }
+#endif
+
+      //*********************************************************************
+      /// Finds the upper bound of a key.
+      ///\param key The key to search for.
+      ///\return An iterator to the first element greater than the key, or end().
+      //*********************************************************************
+      const_iterator upper_bound(const_key_reference key) const
+      {
+        return const_iterator(*this, upper_position(key));
+      }
+
+#if ETL_USING_CPP11
+      //*********************************************************************
+      template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
+      const_iterator upper_bound(const K& key) const
+      {
+        return const_iterator(*this, upper_position(key));
+      }
+#endif
+
+      //*************************************************************************
+      /// How to compare two key elements.
+      //*************************************************************************
+      key_compare key_comp() const
+      {
+        return kcompare;
+      }
+
+      //*************************************************************************
+      /// Check if the container contains the key.
+      //*************************************************************************
+      bool contains(const_key_reference key) const
+      {
+        return find_position(key).p_leaf != ETL_NULLPTR;
+      }
+
+#if ETL_USING_CPP11
+      //*************************************************************************
+      template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
+      bool contains(const K& key) const
+      {
+        return find_position(key).p_leaf != ETL_NULLPTR;
+      }
+#endif
+
+    protected:
+
+      //*************************************************************************
+      /// Constructor.
+      //*************************************************************************
+      btree(etl::ipool& leaf_pool, etl::ipool& branch_pool, size_t max_size_)
+        : etl::btree_base(max_size_)
+        , p_root(ETL_NULLPTR)
+        , p_head(ETL_NULLPTR)
+        , p_tail(ETL_NULLPTR)
+        , p_leaf_pool(&leaf_pool)
+        , p_branch_pool(&branch_pool)
+      {
+      }
+
+      //*************************************************************************
+      /// Destructor.
+      //*************************************************************************
+      ~btree()
+      {
+      }
+
+      //*************************************************************************
+      /// Destroys all of the elements and releases all of the nodes.
+      //*************************************************************************
+      void initialise()
+      {
+        if (p_root != ETL_NULLPTR)
+        {
+          release_subtree(p_root, tree_height);
+        }
+
+        ETL_SUBTRACT_DEBUG_COUNT(int32_t(current_size));
+
+        p_root       = ETL_NULLPTR;
+        p_head       = ETL_NULLPTR;
+        p_tail       = ETL_NULLPTR;
+        tree_height  = 0U;
+        current_size = 0U;
+      }
+
+      //*********************************************************************
+      /// Finds the key or makes a gap in a leaf for it.
+      ///\return A pointer to the gap, or null if the key exists or the
+      /// container is full. 'pos' is set to the element or gap.
+      //*********************************************************************
+      value_type* make_gap(const_key_reference key, position& pos)
+      {
+        path_entry path[Max_Height];
+
+        leaf_node* p_leaf = (p_root != ETL_NULLPTR) ? descend(key, path) : ETL_NULLPTR;
+        size_t     index  = 0U;
+
+        if (p_leaf != ETL_NULLPTR)
+        {
+          index = leaf_lower(p_leaf, key);
+
+          if ((index != p_leaf->count) && !kcompare(key, key_of(value_at(p_leaf, index))))
+          {
+            pos = position(p_leaf, index);
+            return ETL_NULLPTR;
+          }
+        }
+
+        ETL_ASSERT_OR_RETURN_VALUE(!full(), ETL_ERROR(btree_full), ETL_NULLPTR);
+
+        if (p_leaf == ETL_NULLPTR)
+        {
+          p_leaf = allocate_leaf();
+          p_root = p_head = p_tail = p_leaf;
+        }
+
+        if (p_leaf->count == Leaf_Capacity)
+        {
+          // Split so that both leaves are at least half full after the insert.
+          const size_t left_count = (index < Leaf_Min) ? (Leaf_Min - 1U) : Leaf_Min;
+
+          leaf_node* p_right = allocate_leaf();
+
+          relocate(&value_at(p_right, 0U), &value_at(p_leaf, left_count), Leaf_Capacity - left_count);
+          p_right->count = Leaf_Capacity - left_count;
+          p_leaf->count  = left_count;
+
+          p_right->prev = p_leaf;
+          p_right->next = p_leaf->next;
+
+          if (p_leaf->next != ETL_NULLPTR)
+          {
+            p_leaf->next->prev = p_right;
+          }
+          else
+          {
+            p_tail = p_right;
+          }
+
+          p_leaf->next = p_right;
+
+          bool gap_in_right = false;
+
+          if (index >= Leaf_Min)
+          {
+            p_leaf       = p_right;
+            index       -= left_count;
+            gap_in_right = true;
+          }
+
+          open_leaf(p_leaf, index);
+
+          if (gap_in_right && (index == 0U))
+          {
+            insert_in_parent(path, tree_height, key, p_right);
+          }
+          else
+          {
+            insert_in_parent(path, tree_height, key_of(value_at(p_right, 0U)), p_right);
+          }
+        }
+        else
+        {
+          open_leaf(p_leaf, index);
+        }
+
+        pos.p_leaf = p_leaf;
+        pos.index  = index;
+
+        return &value_at(p_leaf, index);
+      }
+
+      //*********************************************************************
+      /// Counts an element constructed in a gap from make_gap.
+      //*********************************************************************
+      void gap_filled()
+      {
+        ++current_size;
+        ETL_INCREMENT_DEBUG_COUNT;
+      }
+
+      //*********************************************************************
+      /// Finds an element.
+      //*********************************************************************
+      template <typename K>
+      position find_position(const K& key) const
+      {
+        if (p_root == ETL_NULLPTR)
+        {
+          return position();
+        }
+
+        leaf_node*   p_leaf = descend(key);
+        const size_t index  = leaf_lower(p_leaf, key);
+
+        if ((index != p_leaf->count) && !kcompare(key, key_of(value_at(p_leaf, index))))
+        {
+          return position(p_leaf, index);
+        }
+
+        return position();
+      }
+
+      //*********************************************************************
+      /// Finds the first element not less than the key.
+      //*********************************************************************
+      template <typename K>
+      position lower_position(const K& key) const
+      {
+        if (p_root == ETL_NULLPTR)
+        {
+          return position();
+        }
+
+        leaf_node* p_leaf = descend(key);
+
+        return position(p_leaf, leaf_lower(p_leaf, key));
+      }
+
+      //*********************************************************************
+      /// Finds the first element greater than the key.
+      //*********************************************************************
+      template <typename K>
+      position upper_position(const K& key) const
+      {
+        if (p_root == ETL_NULLPTR)
+        {
+          return position();
+        }
+
+        leaf_node* p_leaf = descend(key);
+
+        return position(p_leaf, leaf_upper(p_leaf, key));
+      }
+
+      //*************************************************************************
+      /// Makes an iterator from a position.
+      //*************************************************************************
+      iterator to_iterator(const position& pos)
+      {
+        return iterator(*this, pos);
+      }
+
+      //*************************************************************************
+      /// Gets the key of an element.
+      //*************************************************************************
+      static const key_type& key_of(const value_type& value)
+      {
+        return TKeyOf()(value);
+      }
+
+      key_compare kcompare;
+
+    private:
+
+      //*************************************************************************
+      /// Element access.
+      //*************************************************************************
+      static value_type& value_at(leaf_node* p_leaf, size_t index)
+      {
+        return p_leaf->values.begin()[index];
+      }
+
+      //*************************************************************************
+      /// Separator key access.
+      //*************************************************************************
+      static key_type& key_at(branch_node* p_branch, size_t index)
+      {
+        return p_branch->keys.begin()[index];
+      }
+
+      //*************************************************************************
+      /// Moves n objects to uninitialised storage that does not overlap the
+      /// source, or that starts below it.
+      //*************************************************************************
+      template <typename T>
+      static void relocate(T* p_destination, T* p_source, size_t n)
+      {
+        for (size_t i = 0U; i < n; ++i)
+        {
+          ::new (static_cast<void*>(p_destination + i)) T(ETL_MOVE(p_source[i]));
+          p_source[i].~T();
+        }
+      }
+
+      //*************************************************************************
+      /// Moves n objects to uninitialised storage that starts above the source.
+      //*************************************************************************
+      template <typename T>
+      static void relocate_backward(T* p_destination, T* p_source, size_t n)
+      {
+        while (n-- != 0U)
+        {
+          ::new (static_cast<void*>(p_destination + n)) T(ETL_MOVE(p_source[n]));
+          p_source[n].~T();
+        }
+      }
+
+      //*************************************************************************
+      /// Replaces a separator key.
+      //*************************************************************************
+      static void replace_key(branch_node* p_branch, size_t index, const key_type& key)
+      {
+        key_at(p_branch, index).~key_type();
+        ::new (static_cast<void*>(&key_at(p_branch, index))) key_type(key);
+      }
+
+      //*************************************************************************
+      /// Moves a separator key into uninitialised storage.
+      //*************************************************************************
+      static void move_key(key_type* p_destination, key_type& source)
+      {
+        ::new (static_cast<void*>(p_destination)) key_type(ETL_MOVE(source));
+        source.~key_type();
+      }
+
+      //*************************************************************************
+      /// Index of the first element in the leaf not less than the key.
+      //*************************************************************************
+      template <typename K>
+      size_t leaf_lower(leaf_node* p_leaf, const K& key) const
+      {
+        const value_type* p_values = p_leaf->values.begin();
+        size_t first = 0U;
+        size_t count = p_leaf->count;
+
+        while (count != 0U)
+        {
+          const size_t step = count / 2U;
+
+          if (kcompare(key_of(p_values[first + step]), key))
+          {
+            first += step + 1U;
+            count -= step + 1U;
+          }
+          else
+          {
+            count = step;
+          }
+        }
+
+        return first;
+      }
+
+      //*************************************************************************
+      /// Index of the first element in the leaf greater than the key.
+      //*************************************************************************
+      template <typename K>
+      size_t leaf_upper(leaf_node* p_leaf, const K& key) const
+      {
+        const value_type* p_values = p_leaf->values.begin();
+        size_t first = 0U;
+        size_t count = p_leaf->count;
+
+        while (count != 0U)
+        {
+          const size_t step = count / 2U;
+
+          if (!kcompare(key, key_of(p_values[first + step])))
+          {
+            first += step + 1U;
+            count -= step + 1U;
+          }
+          else
+          {
+            count = step;
+          }
+        }
+
+        return first;
+      }
+
+      //*************************************************************************
+      /// Index of the child of the branch that may contain the key.
+      /// This is the upper bound of the key in the separators.
+      //*************************************************************************
+      template <typename K>
+      size_t branch_child(branch_node* p_branch, const K& key) const
+      {
+        const key_type* p_keys = p_branch->keys.begin();
+        size_t first = 0U;
+        size_t count = p_branch->count - 1U;
+
+        while (count != 0U)
+        {
+          const size_t step = count / 2U;
+
+          if (!kcompare(key, p_keys[first + step]))
+          {
+            first += step + 1U;
+            count -= step + 1U;
+          }
+          else
+          {
+            count = step;
+          }
+        }
+
+        return first;
+      }
+
+      //*************************************************************************
+      /// Finds the leaf that may contain the key.
+      //*************************************************************************
+      template <typename K>
+      leaf_node* descend(const K& key) const
+      {
+        void* p_node = p_root;
+
+        for (size_t level = 0U; level < tree_height; ++level)
+        {
+          branch_node* p_branch = static_cast<branch_node*>(p_node);
+          p_node = p_branch->children[branch_child(p_branch, key)];
+        }
+
+        return static_cast<leaf_node*>(p_node);
+      }
+
+      //*************************************************************************
+      /// Finds the leaf that may contain the key and records the path to it.
+      //*************************************************************************
+      template <typename K>
+      leaf_node* descend(const K& key, path_entry* path) const
+      {
+        void* p_node = p_root;
+
+        for (size_t level = 0U; level < tree_height; ++level)
+        {
+          branch_node* p_branch = static_cast<branch_node*>(p_node);
+          const size_t index    = branch_child(p_branch, key);
+
+          path[level].p_branch = p_branch;
+          path[level].index    = index;
+
+          p_node = p_branch->children[index];
+        }
+
+        return static_cast<leaf_node*>(p_node);
+      }
+
+      //*************************************************************************
+      /// Allocates an empty leaf.
+      //*************************************************************************
+      leaf_node* allocate_leaf()
+      {
+        leaf_node* p_leaf = p_leaf_pool->template allocate<leaf_node>();
+
+        p_leaf->prev  = ETL_NULLPTR;
+        p_leaf->next  = ETL_NULLPTR;
+        p_leaf->count = 0U;
+
+        return p_leaf;
+      }
+
+      //*************************************************************************
+      /// Allocates an empty branch.
+      //*************************************************************************
+      branch_node* allocate_branch()
+      {
+        branch_node* p_branch = p_branch_pool->template allocate<branch_node>();
+
+        p_branch->count = 0U;
+
+        return p_branch;
+      }
+
+      //*************************************************************************
+      /// Opens a gap in a leaf that is not full.
+      //*************************************************************************
+      static void open_leaf(leaf_node* p_leaf, size_t index)
+      {
+        relocate_backward(&value_at(p_leaf, index + 1U), &value_at(p_leaf, index), p_leaf->count - index);
+        ++p_leaf->count;
+      }
+
+      //*************************************************************************
+      /// Adds a new child to the parent of a node that has split.
+      /// 'level' is the number of branches above the node that split.
+      //*************************************************************************
+      void insert_in_parent(path_entry* path, size_t level, const key_type& separator, void* p_child)
+      {
+        if (level == 0U)
+        {
+          // The root has split.
+          ETL_ASSERT(tree_height < Max_Height, ETL_ERROR(btree_full));
+
+          branch_node* p_new_root = allocate_branch();
+
+          p_new_root->children[0] = p_root;
+          p_new_root->children[1] = p_child;
+          ::new (static_cast<void*>(&key_at(p_new_root, 0U))) key_type(separator);
+          p_new_root->count = 2U;
+
+          p_root = p_new_root;
+          ++tree_height;
+          return;
+        }
+
+        branch_node* p_branch = path[level - 1U].p_branch;
+        const size_t index    = path[level - 1U].index + 1U;
+
+        if (p_branch->count < Branch_Capacity)
+        {
+          open_branch(p_branch, index);
+          ::new (static_cast<void*>(&key_at(p_branch, index - 1U))) key_type(separator);
+          p_branch->children[index] = p_child;
+          return;
+        }
+
+        // Split the branch. The left keeps Branch_Min children.
+        const size_t left_count = Branch_Min;
+        branch_node* p_right    = allocate_branch();
+
+        if (index < left_count)
+        {
+          // The new child goes to the left.
+          // Right: children [left_count - 1, Capacity), keys [left_count - 1, Capacity - 1).
+          const size_t moved = Branch_Capacity - (left_count - 1U);
+
+          etl::copy_n(p_branch->children + (left_count - 1U), moved, p_right->children);
+          relocate(&key_at(p_right, 0U), &key_at(p_branch, left_count - 1U), moved - 1U);
+          p_right->count = moved;
+
+          key_type promoted(ETL_MOVE(key_at(p_branch, left_count - 2U)));
+          key_at(p_branch, left_count - 2U).~key_type();
+          p_branch->count = left_count - 1U;
+
+          open_branch(p_branch, index);
+          ::new (static_cast<void*>(&key_at(p_branch, index - 1U))) key_type(separator);
+          p_branch->children[index] = p_child;
+
+          insert_in_parent(path, level - 1U, promoted, p_right);
+        }
+        else if (index > left_count)
+        {
+          // The new child goes to the right.
+          // Right: children [left_count, Capacity), keys [left_count, Capacity - 1).
+          const size_t moved = Branch_Capacity - left_count;
+
+          etl::copy_n(p_branch->children + left_count, moved, p_right->children);
+          relocate(&key_at(p_right, 0U), &key_at(p_branch, left_count), moved - 1U);
+          p_right->count = moved;
+
+          key_type promoted(ETL_MOVE(key_at(p_branch, left_count - 1U)));
+          key_at(p_branch, left_count - 1U).~key_type();
+          p_branch->count = left_count;
+
+          const size_t right_index = index - left_count;
+
+          open_branch(p_right, right_index);
+          ::new (static_cast<void*>(&key_at(p_right, right_index - 1U))) key_type(separator);
+          p_right->children[right_index] = p_child;
+
+          insert_in_parent(path, level - 1U, promoted, p_right);
+        }
+        else
+        {
+          // The new child is the first child of the right, and the separator is promoted.
+          // Right: new child + children [left_count, Capacity), keys [left_count - 1, Capacity - 1).
+          const size_t moved = Branch_Capacity - left_count;
+
+          p_right->children[0] = p_child;
+          etl::copy_n(p_branch->children + left_count, moved, p_right->children + 1U);
+          relocate(&key_at(p_right, 0U), &key_at(p_branch, left_count - 1U), moved);
+          p_right->count  = moved + 1U;
+          p_branch->count = left_count;
+
+          insert_in_parent(path, level - 1U, separator, p_right);
+        }
+      }
+
+      //*************************************************************************
+      /// Opens a gap for a child at 'index' and its key at 'index - 1'.
+      //*************************************************************************
+      static void open_branch(branch_node* p_branch, size_t index)
+      {
+        const size_t n = p_branch->count - index;
+
+        etl::copy_backward(p_branch->children + index, p_branch->children + p_branch->count, p_branch->children + p_branch->count + 1U);
+        relocate_backward(&key_at(p_branch, index), &key_at(p_branch, index - 1U), n);
+        ++p_branch->count;
+      }
+
+      //*************************************************************************
+      /// Removes the child at 'index' and its key at 'index - 1'.
+      //*************************************************************************
+      static void close_branch(branch_node* p_branch, size_t index)
+      {
+        const size_t n = p_branch->count - index - 1U;
+
+        key_at(p_branch, index - 1U).~key_type();
+        relocate(&key_at(p_branch, index - 1U), &key_at(p_branch, index), n);
+        etl::copy(p_branch->children + index + 1U, p_branch->children + p_branch->count, p_branch->children + index);
+        --p_branch->count;
+      }
+
+      //*************************************************************************
+      /// Erases the element with the key.
+      //*************************************************************************
+      template <typename K>
+      size_type erase_key(const K& key)
+      {
+        if (p_root == ETL_NULLPTR)
+        {
+          return 0U;
+        }
+
+        path_entry path[Max_Height];
+
+        leaf_node*   p_leaf = descend(key, path);
+        const size_t index  = leaf_lower(p_leaf, key);
+
+        if ((index == p_leaf->count) || kcompare(key, key_of(value_at(p_leaf, index))))
+        {
+          return 0U;
+        }
+
+        erase_at(path, p_leaf, index);
+
+        return 1U;
+      }
+
+      //*************************************************************************
+      /// Erases an element and rebalances the tree.
+      ///\return The position of the next element.
+      //*************************************************************************
+      position erase_at(path_entry* path, leaf_node* p_leaf, size_t index)
+      {
+        value_at(p_leaf, index).~value_type();
+        relocate(&value_at(p_leaf, index), &value_at(p_leaf, index + 1U), p_leaf->count - index - 1U);
+        --p_leaf->count;
+        --current_size;
+        ETL_DECREMENT_DEBUG_COUNT;
+
+        if (tree_height == 0U)
+        {
+          if (p_leaf->count == 0U)
+          {
+            p_leaf_pool->release(p_leaf);
+            p_root = p_head = p_tail = ETL_NULLPTR;
+
+            return position();
+          }
+
+          return position(p_leaf, index);
+        }
+
+        if (p_leaf->count >= Leaf_Min)
+        {
+          return position(p_leaf, index);
+        }
+
+        branch_node* p_parent = path[tree_height - 1U].p_branch;
+        const size_t child    = path[tree_height - 1U].index;
+
+        leaf_node* p_left  = (child > 0U)                    ? static_cast<leaf_node*>(p_parent->children[child - 1U]) : ETL_NULLPTR;
+        leaf_node* p_right = ((child + 1U) < p_parent->count) ? static_cast<leaf_node*>(p_parent->children[child + 1U]) : ETL_NULLPTR;
+
+        if ((p_left != ETL_NULLPTR) && (p_left->count > Leaf_Min))
+        {
+          // Borrow the last element of the left sibling.
+          open_leaf(p_leaf, 0U);
+          relocate(&value_at(p_leaf, 0U), &value_at(p_left, p_left->count - 1U), 1U);
+          --p_left->count;
+          replace_key(p_parent, child - 1U, key_of(value_at(p_leaf, 0U)));
+
+          return position(p_leaf, index + 1U);
+        }
+
+        if ((p_right != ETL_NULLPTR) && (p_right->count > Leaf_Min))
+        {
+          // Borrow the first element of the right sibling.
+          relocate(&value_at(p_leaf, p_leaf->count), &value_at(p_right, 0U), 1U);
+          ++p_leaf->count;
+          relocate(&value_at(p_right, 0U), &value_at(p_right, 1U), p_right->count - 1U);
+          --p_right->count;
+          replace_key(p_parent, child, key_of(value_at(p_right, 0U)));
+
+          return position(p_leaf, index);
+        }
+
+        position next;
+
+        if (p_left != ETL_NULLPTR)
+        {
+          const size_t left_count = p_left->count;
+
+          merge_leaves(p_left, p_leaf);
+          close_branch(p_parent, child);
+          next = position(p_left, left_count + index);
+        }
+        else
+        {
+          merge_leaves(p_leaf, p_right);
+          close_branch(p_parent, child + 1U);
+          next = position(p_leaf, index);
+        }
+
+        rebalance_branch(path, tree_height - 1U);
+
+        return next;
+      }
+
+      //*************************************************************************
+      /// Moves the elements of the right leaf to the left and releases it.
+      //*************************************************************************
+      void merge_leaves(leaf_node* p_left, leaf_node* p_right)
+      {
+        relocate(&value_at(p_left, p_left->count), &value_at(p_right, 0U), p_right->count);
+        p_left->count += p_right->count;
+
+        p_left->next = p_right->next;
+
+        if (p_right->next != ETL_NULLPTR)
+        {
+          p_right->next->prev = p_left;
+        }
+        else
+        {
+          p_tail = p_left;
+        }
+
+        p_leaf_pool->release(p_right);
+      }
+
+      //*************************************************************************
+      /// Restores the minimum fill of a branch that has lost a child.
+      /// 'level' is the branch's index in the path.
+      //*************************************************************************
+      void rebalance_branch(path_entry* path, size_t level)
+      {
+        branch_node* p_branch = path[level].p_branch;
+
+        if (level == 0U)
+        {
+          // A root with one child is removed.
+          if (p_branch->count == 1U)
+          {
+            p_root = p_branch->children[0];
+            p_branch_pool->release(p_branch);
+            --tree_height;
+          }
+
+          return;
+        }
+
+        if (p_branch->count >= Branch_Min)
+        {
+          return;
+        }
+
+        branch_node* p_parent = path[level - 1U].p_branch;
+        const size_t child    = path[level - 1U].index;
+
+        branch_node* p_left  = (child > 0U)                    ? static_cast<branch_node*>(p_parent->children[child - 1U]) : ETL_NULLPTR;
+        branch_node* p_right = ((child + 1U) < p_parent->count) ? static_cast<branch_node*>(p_parent->children[child + 1U]) : ETL_NULLPTR;
+
+        if ((p_left != ETL_NULLPTR) && (p_left->count > Branch_Min))
+        {
+          // Rotate the last child of the left sibling through the parent.
+          open_branch(p_branch, 1U);
+          p_branch->children[1] = p_branch->children[0];
+          p_branch->children[0] = p_left->children[p_left->count - 1U];
+          move_key(&key_at(p_branch, 0U), key_at(p_parent, child - 1U));
+          move_key(&key_at(p_parent, child - 1U), key_at(p_left, p_left->count - 2U));
+          --p_left->count;
+          return;
+        }
+
+        if ((p_right != ETL_NULLPTR) && (p_right->count > Branch_Min))
+        {
+          // Rotate the first child of the right sibling through the parent.
+          p_branch->children[p_branch->count] = p_right->children[0];
+          move_key(&key_at(p_branch, p_branch->count - 1U), key_at(p_parent, child));
+          ++p_branch->count;
+          move_key(&key_at(p_parent, child), key_at(p_right, 0U));
+          relocate(&key_at(p_right, 0U), &key_at(p_right, 1U), p_right->count - 2U);
+          etl::copy(p_right->children + 1U, p_right->children + p_right->count, p_right->children);
+          --p_right->count;
+          return;
+        }
+
+        if (p_left != ETL_NULLPTR)
+        {
+          merge_branches(p_left, p_branch, p_parent, child - 1U);
+          close_branch(p_parent, child);
+        }
+        else
+        {
+          merge_branches(p_branch, p_right, p_parent, child);
+          close_branch(p_parent, child + 1U);
+        }
+
+        rebalance_branch(path, level - 1U);
+      }
+
+      //*************************************************************************
+      /// Moves the separator and the contents of the right branch to the left
+      /// and releases it. The parent's key is left for close_branch.
+      //*************************************************************************
+      void merge_branches(branch_node* p_left, branch_node* p_right, branch_node* p_parent, size_t key_index)
+      {
+        ::new (static_cast<void*>(&key_at(p_left, p_left->count - 1U))) key_type(key_at(p_parent, key_index));
+        relocate(&key_at(p_left, p_left->count), &key_at(p_right, 0U), p_right->count - 1U);
+        etl::copy_n(p_right->children, p_right->count, p_left->children + p_left->count);
+        p_left->count += p_right->count;
+
+        p_branch_pool->release(p_right);
+      }
+
+      //*************************************************************************
+      /// Destroys the elements and keys below a node and releases the nodes.
+      //*************************************************************************
+      void release_subtree(void* p_node, size_t level)
+      {
+        if (level == 0U)
+        {
+          leaf_node* p_leaf = static_cast<leaf_node*>(p_node);
+
+          if ETL_IF_CONSTEXPR(!etl::is_trivially_destructible<value_type>::value)
+          {
+            for (size_t i = 0U; i < p_leaf->count; ++i)
+            {
+              value_at(p_leaf, i).~value_type();
+            }
+          }
+
+          p_leaf_pool->release(p_leaf);
+        }
+        else
+        {
+          branch_node* p_branch = static_cast<branch_node*>(p_node);
+
+          for (size_t i = 0U; i < p_branch->count; ++i)
+          {
+            release_subtree(p_branch->children[i], level - 1U);
+          }
+
+          if ETL_IF_CONSTEXPR(!etl::is_trivially_destructible<key_type>::value)
+          {
+            for (size_t i = 0U; i < (p_branch->count - 1U); ++i)
+            {
+              key_at(p_branch, i).~key_type();
+            }
+          }
+
+          p_branch_pool->release(p_branch);
+        }
+      }
+
+      // Disable copy construction.
+      btree(const btree&);
+
+      void*       p_root;        ///< The root node. A leaf if the height is zero.
+      leaf_node*  p_head;        ///< The first leaf.
+      leaf_node*  p_tail;        ///< The last leaf.
+      etl::ipool* p_leaf_pool;   ///< The pool of leaves.
+      etl::ipool* p_branch_pool; ///< The pool of branches.
+    };
+
+    template <typename TValue, typename TKey, typename TKeyOf, typename TKeyCompare>
+    ETL_CONSTANT size_t btree<TValue, TKey, TKeyOf, TKeyCompare>::Leaf_Capacity;
+
+    template <typename TValue, typename TKey, typename TKeyOf, typename TKeyCompare>
+    ETL_CONSTANT size_t btree<TValue, TKey, TKeyOf, TKeyCompare>::Branch_Capacity;
+
+    template <typename TValue, typename TKey, typename TKeyOf, typename TKeyCompare>
+    ETL_CONSTANT size_t btree<TValue, TKey, TKeyOf, TKeyCompare>::Leaf_Min;
+
+    template <typename TValue, typename TKey, typename TKeyOf, typename TKeyCompare>
+    ETL_CONSTANT size_t btree<TValue, TKey, TKeyOf, TKeyCompare>::Branch_Min;
+  }
+}
+
+#endif
@@ -0,0 +1,297 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_EYTZINGER_INDEX_INCLUDED
+#define ETL_EYTZINGER_INDEX_INCLUDED
+
+#include "../platform.h"
+#include "../memory.h"
+#include "../placement_new.h"
+#include "../type_traits.h"
+#include "../nullptr.h"
+
+#include <stddef.h>
+
+namespace etl
+{
+  namespace private_eytzinger
+  {
+    //*************************************************************************
+    /// A search index over a sorted sequence of keys, for the flat containers.
+    /// The keys are copied into breadth first (Eytzinger) order, so that the
+    /// first levels of every search share the same few cache lines, and the
+    /// children of a node are adjacent.
+    /// The search is branch free, and prefetches the keys a few levels ahead.
+    /// keys[0] and ranks[0] are unused. ranks[k] is the position of keys[k]
+    /// in the sorted sequence.
+    //*************************************************************************
+    template <typename TKey>
+    class eytzinger_index
+    {
+    public:
+
+      //***********************************************************************
+      /// Constructor. The storage must hold at least capacity + 1 entries.
+      /// Null storage gives an index that can never be built.
+      //***********************************************************************
+      eytzinger_index(TKey* p_keys_, size_t* p_ranks_)
+        : p_keys(p_keys_)
+        , p_ranks(p_ranks_)
+        , count(0U)
+        , built(false)
+      {
+      }
+
+      //***********************************************************************
+      /// Destructor.
+      //***********************************************************************
+      ~eytzinger_index()
+      {
+        clear();
+      }
+
+      //***********************************************************************
+      /// Returns true if the index has storage.
+      //***********************************************************************
+      bool has_storage() const
+      {
+        return p_keys != ETL_NULLPTR;
+      }
+
+      //***********************************************************************
+      /// Returns true if the index has been built.
+      //***********************************************************************
+      bool is_built() const
+      {
+        return built;
+      }
+
+      //***********************************************************************
+      /// Builds the index from n keys, in sorted order.
+      /// TKeyOf gets the key from the value referenced by the iterator.
+      //***********************************************************************
+      template <typename TIterator, typename TKeyOf>
+      void build(TIterator first, size_t n, TKeyOf key_of)
+      {
+        clear();
+
+        // Visit the nodes of the implicit tree in order, starting with the leftmost.
+        size_t k = 1U;
+
+        while ((2U * k) <= n)
+        {
+          k *= 2U;
+        }
+
+        for (size_t rank = 0U; rank < n; ++rank)
+        {
+          ::new (static_cast<void*>(p_keys + k)) TKey(key_of(*first));
+          p_ranks[k] = rank;
+          ++first;
+
+          if (((2U * k) + 1U) <= n)
+          {
+            // Leftmost node of the right subtree.
+            k = (2U * k) + 1U;
+
+            while ((2U * k) <= n)
+            {
+              k *= 2U;
+            }
+          }
+          else
+          {
+            // Up past the right children, then up once more.
+            while ((k & 1U) != 0U)
+            {
+              k >>= 1U;
+            }
+
+            k >>= 1U;
+          }
+        }
+
+        count = n;
+        built = true;
+      }
+
+      //***********************************************************************
+      /// Destroys the keys and marks the index as not built.
+      //***********************************************************************
+      void clear()
+      {
+        if ETL_IF_CONSTEXPR(!etl::is_trivially_destructible<TKey>::value)
+        {
+          if (built)
+          {
+            for (size_t k = 1U; k <= count; ++k)
+            {
+              p_keys[k].~TKey();
+            }
+          }
+        }
+
+        count = 0U;
+        built = false;
+      }
+
+      //***********************************************************************
+      /// The sorted position of the first key not less than 'key', or the
+      /// number of keys if there is none.
+      //***********************************************************************
+      template <typename K, typename TCompare>
+      size_t lower_bound(const K& key, const TCompare& compare) const
+      {
+        size_t k = 1U;
+
+        while (k <= count)
+        {
+          prefetch(k);
+          k = (2U * k) + (compare(p_keys[k], key) ? 1U : 0U);
+        }
+
+        return rank_of(k);
+      }
+
+      //***********************************************************************
+      /// The sorted position of the first key greater than 'key', or the
+      /// number of keys if there is none.
+      //***********************************************************************
+      template <typename K, typename TCompare>
+      size_t upper_bound(const K& key, const TCompare& compare) const
+      {
+        size_t k = 1U;
+
+        while (k <= count)
+        {
+          prefetch(k);
+          k = (2U * k) + (compare(key, p_keys[k]) ? 0U : 1U);
+        }
+
+        return rank_of(k);
+      }
+
+    private:
+
+      //***********************************************************************
+      /// The number of nodes between a node and its descendants that share a
+      /// 64 byte cache line, a power of two.
+      //***********************************************************************
+      static ETL_CONSTANT size_t Prefetch_Stride = (sizeof(TKey) <= 4U) ? 16U :
+                                                   (sizeof(TKey) <= 8U) ? 8U  :
+                                                   (sizeof(TKey) <= 16U) ? 4U : 2U;
+
+      //***********************************************************************
+      /// Hints that the descendants of node k will be needed soon.
+      /// The address may be past the end of the keys. It is never read.
+      //***********************************************************************
+      void prefetch(size_t k) const
+      {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(reinterpret_cast<const char*>(p_keys) + (k * Prefetch_Stride * sizeof(TKey)));
+#else
+        (void)k;
+#endif
+      }
+
+      //***********************************************************************
+      /// Converts the node index at the end of a search to a sorted position.
+      /// The answer is the last node at which the search went left, which is
+      /// found by removing the trailing right turns and the final left turn.
+      //***********************************************************************
+      size_t rank_of(size_t k) const
+      {
+#if defined(__GNUC__) || defined(__clang__)
+        k >>= (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1U);
+#else
+        while ((k & 1U) != 0U)
+        {
+          k >>= 1U;
+        }
+
+        k >>= 1U;
+#endif
+
+        return (k == 0U) ? count : p_ranks[k];
+      }
+
+      // Disable copy construction and assignment.
+      eytzinger_index(const eytzinger_index&);
+      eytzinger_index& operator =(const eytzinger_index&);
+
+      TKey*   p_keys;
+      size_t* p_ranks;
+      size_t  count;
+      bool    built;
+    };
+
+    template <typename TKey>
+    ETL_CONSTANT size_t eytzinger_index<TKey>::Prefetch_Stride;
+
+    //*************************************************************************
+    /// Storage for an index of up to Size keys.
+    //*************************************************************************
+    template <typename TKey, size_t Size, bool Enabled>
+    struct eytzinger_storage
+    {
+      TKey* keys()
+      {
+        return key_buffer.begin();
+      }
+
+      size_t* ranks()
+      {
+        return rank_buffer;
+      }
+
+      etl::uninitialized_buffer_of<TKey, Size + 1U> key_buffer;
+      size_t rank_buffer[Size + 1U];
+    };
+
+    //*************************************************************************
+    /// No storage when the index is not enabled.
+    //*************************************************************************
+    template <typename TKey, size_t Size>
+    struct eytzinger_storage<TKey, Size, false>
+    {
+      TKey* keys()
+      {
+        return ETL_NULLPTR;
+      }
+
+      size_t* ranks()
+      {
+        return ETL_NULLPTR;
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,292 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_PERFECT_HASH_INCLUDED
+#define ETL_PERFECT_HASH_INCLUDED
+
+#include "../platform.h"
+#include "../type_traits.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace etl
+{
+  //***************************************************************************
+  /// A hash function that may be evaluated at compile time.
+  /// Used as the default hasher for const_hash_map and const_hash_set.
+  /// Defined for integral types, enums and C strings.
+  //***************************************************************************
+  template <typename TKey, typename TEnable = void>
+  struct const_hash;
+
+  //***************************************************************************
+  /// Integral and enum keys.
+  /// The key is folded to 32 bits. The mixing is done by the table.
+  //***************************************************************************
+  template <typename TKey>
+  struct const_hash<TKey, typename etl::enable_if<etl::is_integral<TKey>::value || etl::is_enum<TKey>::value>::type>
+  {
+    ETL_CONSTEXPR uint32_t operator ()(TKey key) const ETL_NOEXCEPT
+    {
+      return static_cast<uint32_t>(static_cast<uint64_t>(key) ^ (static_cast<uint64_t>(key) >> 32U));
+    }
+  };
+
+  //***************************************************************************
+  /// C string keys. 32 bit FNV-1a.
+  //***************************************************************************
+  template <>
+  struct const_hash<const char*, void>
+  {
+    ETL_CONSTEXPR14 uint32_t operator ()(const char* key) const ETL_NOEXCEPT
+    {
+      uint32_t hash = 2166136261UL;
+
+      while (*key != '\0')
+      {
+        hash ^= static_cast<uint8_t>(*key++);
+        hash *= 16777619UL;
+      }
+
+      return hash;
+    }
+  };
+
+  namespace private_perfect_hash
+  {
+    //*************************************************************************
+    /// A 'hash and displace' minimal perfect hash table.
+    ///
+    /// Keys are first hashed into (N + 1) / 2 buckets. Each bucket holds a
+    /// displacement word that maps its keys onto N slots with no collisions.
+    /// Buckets with more than one key search for a seed for a second hash,
+    /// largest bucket first, while the table is still mostly empty.
+    /// Buckets with one key are placed last, directly into the remaining
+    /// free slots, and store the slot number with the 'direct' flag set.
+    /// A lookup is one bucket read, one index read and one key compare.
+    //*************************************************************************
+    enum : uint32_t
+    {
+      Direct    = 0x80000000UL,
+      Max_Seeds = 0x10000UL
+    };
+
+    //*************************************************************************
+    /// 32 bit finaliser from MurmurHash3.
+    //*************************************************************************
+    inline ETL_CONSTEXPR14 uint32_t mix(uint32_t h) ETL_NOEXCEPT
+    {
+      h ^= h >> 16U;
+      h *= 0x85EBCA6BUL;
+      h ^= h >> 13U;
+      h *= 0xC2B2AE35UL;
+      h ^= h >> 16U;
+
+      return h;
+    }
+
+    //*************************************************************************
+    /// Maps a 32 bit hash onto [0, n) without a division.
+    //*************************************************************************
+    inline ETL_CONSTEXPR14 uint32_t reduce(uint32_t h, uint32_t n) ETL_NOEXCEPT
+    {
+      return static_cast<uint32_t>((static_cast<uint64_t>(h) * n) >> 32U);
+    }
+
+    //*************************************************************************
+    /// The number of buckets for n keys.
+    //*************************************************************************
+    inline ETL_CONSTEXPR14 uint32_t bucket_count(size_t n) ETL_NOEXCEPT
+    {
+      return static_cast<uint32_t>((n + 1U) / 2U);
+    }
+
+    //*************************************************************************
+    /// The bucket that a hash belongs to.
+    //*************************************************************************
+    inline ETL_CONSTEXPR14 uint32_t bucket_of(uint32_t h, uint32_t buckets) ETL_NOEXCEPT
+    {
+      return reduce(mix(h), buckets);
+    }
+
+    //*************************************************************************
+    /// The slot that a hash maps to for a seed.
+    //*************************************************************************
+    inline ETL_CONSTEXPR14 uint32_t slot_of(uint32_t h, uint32_t seed, uint32_t slots) ETL_NOEXCEPT
+    {
+      return reduce(mix(h ^ (seed * 0x9E3779B9UL)), slots);
+    }
+
+    //*************************************************************************
+    /// Finds the slot for a hash.
+    /// The table must not be empty.
+    //*************************************************************************
+    inline ETL_CONSTEXPR14 uint32_t lookup(uint32_t h, const uint32_t* displacement, uint32_t buckets, uint32_t slots) ETL_NOEXCEPT
+    {
+      const uint32_t d = displacement[bucket_of(h, buckets)];
+
+      return ((d & Direct) != 0U) ? (d & ~static_cast<uint32_t>(Direct)) : slot_of(h, d, slots);
+    }
+
+    //*************************************************************************
+    /// Tries to find a seed that places every key of a bucket in a free slot.
+    //*************************************************************************
+    inline ETL_CONSTEXPR14 bool place_bucket(const uint32_t* hashes,
+                                             const uint32_t* members,
+                                             uint32_t        count,
+                                             uint32_t        slots,
+                                             const bool*     taken,
+                                             uint32_t*       trial,
+                                             uint32_t&       seed_out) ETL_NOEXCEPT
+    {
+      for (uint32_t seed = 1U; seed <= Max_Seeds; ++seed)
+      {
+        bool fits = true;
+
+        for (uint32_t k = 0U; fits && (k < count); ++k)
+        {
+          const uint32_t slot = slot_of(hashes[members[k]], seed, slots);
+
+          fits = !taken[slot];
+
+          for (uint32_t j = 0U; fits && (j < k); ++j)
+          {
+            fits = (trial[j] != slot);
+          }
+
+          trial[k] = slot;
+        }
+
+        if (fits)
+        {
+          seed_out = seed;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    //*************************************************************************
+    /// Builds the displacement and index tables for n hashes.
+    /// 'displacement' must hold bucket_count(n) entries and 'index' n entries.
+    /// The scratch space is on the stack, so large tables should be built
+    /// at compile time.
+    /// \return <b>false</b> if no perfect hash could be found. This will
+    /// happen if two keys are equal or have the same 32 bit hash.
+    //*************************************************************************
+    template <size_t Capacity>
+    ETL_CONSTEXPR14 bool build(const uint32_t* hashes, size_t n, uint32_t* displacement, uint32_t* index) ETL_NOEXCEPT
+    {
+      if (n == 0U)
+      {
+        return true;
+      }
+
+      const uint32_t slots   = static_cast<uint32_t>(n);
+      const uint32_t buckets = bucket_count(n);
+
+      uint32_t bucket_size[Capacity]      = {};
+      uint32_t bucket_start[Capacity + 1] = {};
+      uint32_t members[Capacity]          = {};
+      uint32_t trial[Capacity]            = {};
+      bool     taken[Capacity]            = {};
+
+      // Group the keys by bucket.
+      for (uint32_t i = 0U; i < slots; ++i)
+      {
+        ++bucket_size[bucket_of(hashes[i], buckets)];
+      }
+
+      uint32_t largest = 0U;
+
+      for (uint32_t b = 0U; b < buckets; ++b)
+      {
+        bucket_start[b + 1U] = bucket_start[b] + bucket_size[b];
+        largest = (bucket_size[b] > largest) ? bucket_size[b] : largest;
+        trial[b] = bucket_start[b];
+      }
+
+      for (uint32_t i = 0U; i < slots; ++i)
+      {
+        members[trial[bucket_of(hashes[i], buckets)]++] = i;
+      }
+
+      // Place the multi-key buckets, largest first.
+      for (uint32_t count = largest; count > 1U; --count)
+      {
+        for (uint32_t b = 0U; b < buckets; ++b)
+        {
+          if (bucket_size[b] == count)
+          {
+            const uint32_t* bucket_members = members + bucket_start[b];
+            uint32_t        seed           = 0U;
+
+            if (!place_bucket(hashes, bucket_members, count, slots, taken, trial, seed))
+            {
+              return false;
+            }
+
+            displacement[b] = seed;
+
+            for (uint32_t k = 0U; k < count; ++k)
+            {
+              taken[trial[k]] = true;
+              index[trial[k]] = bucket_members[k];
+            }
+          }
+        }
+      }
+
+      // Drop the single key buckets into the free slots.
+      uint32_t free_slot = 0U;
+
+      for (uint32_t b = 0U; b < buckets; ++b)
+      {
+        if (bucket_size[b] == 1U)
+        {
+          while (taken[free_slot])
+          {
+            ++free_slot;
+          }
+
+          taken[free_slot] = true;
+          index[free_slot] = members[bucket_start[b]];
+          displacement[b]  = Direct | free_slot;
+        }
+      }
+
+      return true;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,646 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_MPMC_QUEUE_ATOMIC_INCLUDED
+#define ETL_MPMC_QUEUE_ATOMIC_INCLUDED
+
+#include "platform.h"
+#include "alignment.h"
+#include "parameter_type.h"
+#include "atomic.h"
+#include "memory_model.h"
+#include "integral_limits.h"
+#include "utility.h"
+#include "placement_new.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if ETL_HAS_ATOMIC
+
+namespace etl
+{
+  template <size_t Memory_Model = etl::memory_model::MEMORY_MODEL_LARGE>
+  class queue_mpmc_atomic_base
+  {
+  public:
+
+    /// The type used for determining the size of queue.
+    typedef typename etl::size_type_lookup<Memory_Model>::type size_type;
+
+    //*************************************************************************
+    /// Is the queue empty?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool empty() const
+    {
+      return size() == 0;
+    }
+
+    //*************************************************************************
+    /// Is the queue full?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool full() const
+    {
+      return size() == MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// How many items in the queue?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type size() const
+    {
+      size_t read_index  = read_position.load(etl::memory_order_acquire);
+      size_t write_index = write_position.load(etl::memory_order_acquire);
+
+      ptrdiff_t n = get_difference(write_index, read_index);
+
+      // The positions are read separately, so may be momentarily inconsistent.
+      if (n < 0)
+      {
+        n = 0;
+      }
+      else if (size_t(n) > MAX_SIZE)
+      {
+        n = ptrdiff_t(MAX_SIZE);
+      }
+
+      return size_type(n);
+    }
+
+    //*************************************************************************
+    /// How much free space available in the queue.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type available() const
+    {
+      return MAX_SIZE - size();
+    }
+
+    //*************************************************************************
+    /// How many items can the queue hold.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// How many items can the queue hold.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return MAX_SIZE;
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Positions count up to the largest multiple of the size that fits in a
+    /// size_t, so that a position always maps to the same slot after wrapping.
+    //*************************************************************************
+    queue_mpmc_atomic_base(size_type max_size_)
+      : write_position(0),
+        read_position(0),
+        MAX_SIZE(max_size_),
+        Wrap(size_t(max_size_) * (etl::integral_limits<size_t>::max / size_t(max_size_))),
+        Mask(((max_size_ & (max_size_ - 1)) == 0) ? size_t(max_size_ - 1) : 0)
+    {
+    }
+
+    //*************************************************************************
+    /// Calculate the position 'n' after 'position'.
+    //*************************************************************************
+    size_t get_next_position(size_t position, size_t n) const
+    {
+      return (position >= (Wrap - n)) ? (position - (Wrap - n)) : (position + n);
+    }
+
+    //*************************************************************************
+    /// Calculate the signed distance from 'from' to 'to'.
+    /// Positions never differ by more than a couple of laps of the buffer.
+    //*************************************************************************
+    ptrdiff_t get_difference(size_t to, size_t from) const
+    {
+      size_t n = (to >= from) ? (to - from) : (to + (Wrap - from));
+
+      return (n < (Wrap / 2U)) ? ptrdiff_t(n) : -ptrdiff_t(Wrap - n);
+    }
+
+    //*************************************************************************
+    /// Calculate the buffer index of a position.
+    //*************************************************************************
+    size_t get_index(size_t position) const
+    {
+      return (Mask != 0) ? (position & Mask) : (position % MAX_SIZE);
+    }
+
+    // The positions claimed by producers and consumers are kept on separate cache lines.
+    etl::atomic<size_t> write_position; ///< The position of the next push.
+    char                write_padding[ETL_CACHE_LINE_SIZE];
+    etl::atomic<size_t> read_position;  ///< The position of the next pop.
+    char                read_padding[ETL_CACHE_LINE_SIZE];
+    const size_type     MAX_SIZE;       ///< The maximum number of items in the queue.
+    const size_t        Wrap;           ///< The position at which the positions wrap to zero.
+    const size_t        Mask;           ///< The index mask if the size is a power of two, otherwise zero.
+
+  private:
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_MPMC_QUEUE_ATOMIC) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~queue_mpmc_atomic_base()
+    {
+    }
+#else
+  protected:
+    ~queue_mpmc_atomic_base()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  ///\ingroup queue_mpmc_atomic
+  ///\brief This is the base for all queue_mpmc_atomics that contain a particular type.
+  ///\details Normally a reference to this type will be taken from a derived queue_mpmc_atomic.
+  ///\code
+  /// etl::queue_mpmc_atomic<int, 10> myQueue;
+  /// etl::iqueue_mpmc_atomic<int>& iQueue = myQueue;
+  ///\endcode
+  /// This queue supports concurrent access by any number of producers and consumers.
+  /// Each slot holds a sequence number that says whether it is ready to be
+  /// pushed to or popped from on the current lap of the buffer. Producers and
+  /// consumers claim positions with a compare and swap and never wait for a lock.
+  /// A push may report 'full' while a consumer is still moving out the oldest
+  /// item, and a pop may report 'empty' while a producer is still constructing one.
+  /// \tparam T The type of value that the queue_mpmc_atomic holds.
+  //***************************************************************************
+  template <typename T, const size_t Memory_Model = etl::memory_model::MEMORY_MODEL_LARGE>
+  class iqueue_mpmc_atomic : public queue_mpmc_atomic_base<Memory_Model>
+  {
+  private:
+
+    typedef typename etl::queue_mpmc_atomic_base<Memory_Model> base_t;
+
+  public:
+
+    typedef T                          value_type;      ///< The type stored in the queue.
+    typedef T&                         reference;       ///< A reference to the type used in the queue.
+    typedef const T&                   const_reference; ///< A const reference to the type used in the queue.
+#if ETL_USING_CPP11
+    typedef T&&                        rvalue_reference;///< An rvalue_reference to the type used in the queue.
+#endif
+    typedef typename base_t::size_type size_type;       ///< The type used for determining the size of the queue.
+
+    using base_t::MAX_SIZE;
+    using base_t::get_next_position;
+    using base_t::get_difference;
+    using base_t::get_index;
+
+    //*************************************************************************
+    /// Push a value to the queue.
+    //*************************************************************************
+    bool push(const_reference value)
+    {
+      size_t position;
+      cell_t* p_cell = claim_push(position);
+
+      if (p_cell != ETL_NULLPTR)
+      {
+        ::new (&p_cell->value) T(value);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+#if ETL_USING_CPP11 && ETL_NOT_USING_STLPORT && !defined(ETL_QUEUE_ATOMIC_FORCE_CPP03_IMPLEMENTATION)
+    //*************************************************************************
+    /// Push a value to the queue.
+    //*************************************************************************
+    bool push(rvalue_reference value)
+    {
+      size_t position;
+      cell_t* p_cell = claim_push(position);
+
+      if (p_cell != ETL_NULLPTR)
+      {
+        ::new (&p_cell->value) T(etl::move(value));
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+#endif
+
+#if ETL_USING_CPP11 && ETL_NOT_USING_STLPORT && !defined(ETL_QUEUE_ATOMIC_FORCE_CPP03_IMPLEMENTATION)
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename ... Args>
+    bool emplace(Args&&... args)
+    {
+      size_t position;
+      cell_t* p_cell = claim_push(position);
+
+      if (p_cell != ETL_NULLPTR)
+      {
+        ::new (&p_cell->value) T(etl::forward<Args>(args)...);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+#else
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    bool emplace()
+    {
+      size_t position;
+      cell_t* p_cell = claim_push(position);
+
+      if (p_cell != ETL_NULLPTR)
+      {
+        ::new (&p_cell->value) T();
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1>
+    bool emplace(const T1& value1)
+    {
+      size_t position;
+      cell_t* p_cell = claim_push(position);
+
+      if (p_cell != ETL_NULLPTR)
+      {
+        ::new (&p_cell->value) T(value1);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2>
+    bool emplace(const T1& value1, const T2& value2)
+    {
+      size_t position;
+      cell_t* p_cell = claim_push(position);
+
+      if (p_cell != ETL_NULLPTR)
+      {
+        ::new (&p_cell->value) T(value1, value2);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3)
+    {
+      size_t position;
+      cell_t* p_cell = claim_push(position);
+
+      if (p_cell != ETL_NULLPTR)
+      {
+        ::new (&p_cell->value) T(value1, value2, value3);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3, typename T4>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      size_t position;
+      cell_t* p_cell = claim_push(position);
+
+      if (p_cell != ETL_NULLPTR)
+      {
+        ::new (&p_cell->value) T(value1, value2, value3, value4);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+#endif
+
+    //*************************************************************************
+    /// Pop a value from the queue.
+    //*************************************************************************
+    bool pop(reference value)
+    {
+      size_t position;
+      cell_t* p_cell = claim_pop(position);
+
+      if (p_cell == ETL_NULLPTR)
+      {
+        // Queue is empty
+        return false;
+      }
+
+      T* p_value = reinterpret_cast<T*>(&p_cell->value);
+
+#if ETL_USING_CPP11 && ETL_NOT_USING_STLPORT && !defined(ETL_QUEUE_ATOMIC_FORCE_CPP03_IMPLEMENTATION)
+      value = etl::move(*p_value);
+#else
+      value = *p_value;
+#endif
+
+      p_value->~T();
+      publish_pop(p_cell, position);
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Pop a value from the queue and discard.
+    //*************************************************************************
+    bool pop()
+    {
+      size_t position;
+      cell_t* p_cell = claim_pop(position);
+
+      if (p_cell == ETL_NULLPTR)
+      {
+        // Queue is empty
+        return false;
+      }
+
+      reinterpret_cast<T*>(&p_cell->value)->~T();
+      publish_pop(p_cell, position);
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Clear the queue.
+    /// Pops and destroys every item that is in the queue when it is called.
+    //*************************************************************************
+    void clear()
+    {
+      while (pop())
+      {
+        // Do nothing.
+      }
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// A slot in the buffer.
+    //*************************************************************************
+    struct cell_t
+    {
+      etl::atomic<size_t> sequence; ///< The position this slot is ready for.
+      typename etl::aligned_storage<sizeof(T), etl::alignment_of<T>::value>::type value;
+    };
+
+    //*************************************************************************
+    /// The constructor that is called from derived classes.
+    //*************************************************************************
+    iqueue_mpmc_atomic(cell_t* p_buffer_, size_type max_size_)
+      : base_t(max_size_),
+        p_buffer(p_buffer_)
+    {
+      for (size_t i = 0UL; i < max_size_; ++i)
+      {
+        ::new (&p_buffer[i]) cell_t;
+        p_buffer[i].sequence.store(i, etl::memory_order_relaxed);
+      }
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Claims the next position to push to.
+    /// Returns the slot, or null if the queue is full.
+    //*************************************************************************
+    cell_t* claim_push(size_t& position)
+    {
+      position = this->write_position.load(etl::memory_order_relaxed);
+
+      while (true)
+      {
+        cell_t&   cell       = p_buffer[get_index(position)];
+        size_t    sequence   = cell.sequence.load(etl::memory_order_acquire);
+        ptrdiff_t difference = get_difference(sequence, position);
+
+        if (difference == 0)
+        {
+          // The slot is free on this lap. Try to claim it.
+          if (this->write_position.compare_exchange_weak(position, get_next_position(position, 1U), etl::memory_order_relaxed))
+          {
+            return &cell;
+          }
+        }
+        else if (difference < 0)
+        {
+          // The slot still holds the item from the previous lap.
+          return ETL_NULLPTR;
+        }
+        else
+        {
+          // Another producer has claimed this position.
+          position = this->write_position.load(etl::memory_order_relaxed);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Makes the pushed item visible to consumers.
+    //*************************************************************************
+    void publish_push(cell_t* p_cell, size_t position)
+    {
+      p_cell->sequence.store(get_next_position(position, 1U), etl::memory_order_release);
+    }
+
+    //*************************************************************************
+    /// Claims the next position to pop from.
+    /// Returns the slot, or null if the queue is empty.
+    //*************************************************************************
+    cell_t* claim_pop(size_t& position)
+    {
+      position = this->read_position.load(etl::memory_order_relaxed);
+
+      while (true)
+      {
+        cell_t&   cell       = p_buffer[get_index(position)];
+        size_t    sequence   = cell.sequence.load(etl::memory_order_acquire);
+        ptrdiff_t difference = get_difference(sequence, get_next_position(position, 1U));
+
+        if (difference == 0)
+        {
+          // The slot holds an item on this lap. Try to claim it.
+          if (this->read_position.compare_exchange_weak(position, get_next_position(position, 1U), etl::memory_order_relaxed))
+          {
+            return &cell;
+          }
+        }
+        else if (difference < 0)
+        {
+          // The slot has not been pushed to on this lap.
+          return ETL_NULLPTR;
+        }
+        else
+        {
+          // Another consumer has claimed this position.
+          position = this->read_position.load(etl::memory_order_relaxed);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Releases the slot to the producers on the next lap.
+    //*************************************************************************
+    void publish_pop(cell_t* p_cell, size_t position)
+    {
+      p_cell->sequence.store(get_next_position(position, MAX_SIZE), etl::memory_order_release);
+    }
+
+    // Disable copy construction and assignment.
+    iqueue_mpmc_atomic(const iqueue_mpmc_atomic&) ETL_DELETE;
+    iqueue_mpmc_atomic& operator =(const iqueue_mpmc_atomic&) ETL_DELETE;
+
+#if ETL_USING_CPP11
+    iqueue_mpmc_atomic(iqueue_mpmc_atomic&&) = delete;
+    iqueue_mpmc_atomic& operator =(iqueue_mpmc_atomic&&) = delete;
+#endif
+
+    cell_t* p_buffer; ///< The internal buffer.
+  };
+
+  //***************************************************************************
+  ///\ingroup queue_mpmc_atomic
+  /// A fixed capacity lock free mpmc queue.
+  /// This queue supports concurrent access by any number of producers and consumers.
+  /// \tparam T            The type this queue should support.
+  /// \tparam Size         The maximum capacity of the queue.
+  /// \tparam Memory_Model The memory model for the queue. Determines the type of the internal counter variables.
+  //***************************************************************************
+  template <typename T, size_t Size, const size_t Memory_Model = etl::memory_model::MEMORY_MODEL_LARGE>
+  class queue_mpmc_atomic : public iqueue_mpmc_atomic<T, Memory_Model>
+  {
+  private:
+
+    typedef typename etl::iqueue_mpmc_atomic<T, Memory_Model> base_t;
+
+  public:
+
+    typedef typename base_t::size_type size_type;
+
+    ETL_STATIC_ASSERT((Size > 0), "Size must be greater than zero");
+    ETL_STATIC_ASSERT((Size <= etl::integral_limits<size_type>::max), "Size too large for memory model");
+
+    static ETL_CONSTANT size_type MAX_SIZE = size_type(Size);
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    queue_mpmc_atomic()
+      : base_t(reinterpret_cast<typename base_t::cell_t*>(&buffer[0]), MAX_SIZE)
+    {
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~queue_mpmc_atomic()
+    {
+      base_t::clear();
+    }
+
+  private:
+
+    queue_mpmc_atomic(const queue_mpmc_atomic&) ETL_DELETE;
+    queue_mpmc_atomic& operator = (const queue_mpmc_atomic&) ETL_DELETE;
+
+#if ETL_USING_CPP11
+    queue_mpmc_atomic(queue_mpmc_atomic&&) = delete;
+    queue_mpmc_atomic& operator = (queue_mpmc_atomic&&) = delete;
+#endif
+
+    /// The uninitialised buffer of slots used in the queue_mpmc_atomic.
+    typename etl::aligned_storage<sizeof(typename base_t::cell_t), etl::alignment_of<typename base_t::cell_t>::value>::type buffer[MAX_SIZE];
+  };
+
+  template <typename T, size_t Size, const size_t Memory_Model>
+  ETL_CONSTANT typename queue_mpmc_atomic<T, Size, Memory_Model>::size_type queue_mpmc_atomic<T, Size, Memory_Model>::MAX_SIZE;
+}
+
+#endif
+
+#endif
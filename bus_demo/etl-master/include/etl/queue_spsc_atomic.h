@@ -39,6 +39,7 @@ SOFTWARE.
 #include "integral_limits.h"
 #include "utility.h"
 #include "placement_new.h"
+#include "futex.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -86,18 +87,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_acquire);
       size_type read_index = read.load(etl::memory_order_acquire);
 
-      size_type n;
-
-      if (write_index >= read_index)
-      {
-        n = write_index - read_index;
-      }
-      else
-      {
-        n = Reserved - read_index + write_index;
-      }
-
-      return n;
+      return get_used(write_index, read_index);
     }
 
     //*************************************************************************
@@ -129,7 +119,9 @@ namespace etl
 
     queue_spsc_atomic_base(size_type reserved_)
       : write(0),
+        read_cache(0),
         read(0),
+        write_cache(0),
         Reserved(reserved_)
     {
     }
@@ -149,9 +141,100 @@ namespace etl
       return index;
     }
 
-    etl::atomic<size_type> write; ///< Where to input new data.
-    etl::atomic<size_type> read;  ///< Where to get the oldest data.
-    const size_type Reserved;     ///< The maximum number of items in the queue.
+    //*************************************************************************
+    /// Calculate the number of items between the indexes.
+    //*************************************************************************
+    size_type get_used(size_type write_index, size_type read_index) const
+    {
+      size_type n;
+
+      if (write_index >= read_index)
+      {
+        n = write_index - read_index;
+      }
+      else
+      {
+        n = Reserved - read_index + write_index;
+      }
+
+      return n;
+    }
+
+    //*************************************************************************
+    /// Checks whether 'write' may advance to 'next_index'.
+    /// Only reloads 'read' when the cached copy says that the queue is full.
+    /// Call from the 'push' thread.
+    //*************************************************************************
+    bool can_push(size_type next_index)
+    {
+      if (next_index == read_cache)
+      {
+        read_cache = read.load(etl::memory_order_acquire);
+      }
+
+      return (next_index != read_cache);
+    }
+
+    //*************************************************************************
+    /// Checks whether there is an item at 'read_index'.
+    /// Only reloads 'write' when the cached copy says that the queue is empty.
+    /// Call from the 'pop' thread.
+    //*************************************************************************
+    bool can_pop(size_type read_index)
+    {
+      if (read_index == write_cache)
+      {
+        write_cache = write.load(etl::memory_order_acquire);
+      }
+
+      return (read_index != write_cache);
+    }
+
+    //*************************************************************************
+    /// How many items may be pushed, reloading 'read' if the cached copy
+    /// leaves room for fewer than 'wanted'.
+    /// Call from the 'push' thread.
+    //*************************************************************************
+    size_type get_push_count(size_type write_index, size_type wanted)
+    {
+      size_type n = Reserved - 1 - get_used(write_index, read_cache);
+
+      if (n < wanted)
+      {
+        read_cache = read.load(etl::memory_order_acquire);
+        n = Reserved - 1 - get_used(write_index, read_cache);
+      }
+
+      return (n < wanted) ? n : wanted;
+    }
+
+    //*************************************************************************
+    /// How many items may be popped, reloading 'write' if the cached copy
+    /// holds fewer than 'wanted'.
+    /// Call from the 'pop' thread.
+    //*************************************************************************
+    size_type get_pop_count(size_type read_index, size_type wanted)
+    {
+      size_type n = get_used(write_cache, read_index);
+
+      if (n < wanted)
+      {
+        write_cache = write.load(etl::memory_order_acquire);
+        n = get_used(write_cache, read_index);
+      }
+
+      return (n < wanted) ? n : wanted;
+    }
+
+    // The indexes written by the 'push' and 'pop' threads are kept on separate
+    // cache lines, each with that thread's private copy of the other index.
+    etl::atomic<size_type> write;       ///< Where to input new data.
+    size_type              read_cache;  ///< The 'push' thread's copy of 'read'.
+    char                   write_padding[ETL_CACHE_LINE_SIZE];
+    etl::atomic<size_type> read;        ///< Where to get the oldest data.
+    size_type              write_cache; ///< The 'pop' thread's copy of 'write'.
+    char                   read_padding[ETL_CACHE_LINE_SIZE];
+    const size_type        Reserved;    ///< The maximum number of items in the queue.
 
   private:
 
@@ -201,8 +284,14 @@ namespace etl
 
     using base_t::write;
     using base_t::read;
+    using base_t::read_cache;
+    using base_t::write_cache;
     using base_t::Reserved;
     using base_t::get_next_index;
+    using base_t::can_push;
+    using base_t::can_pop;
+    using base_t::get_push_count;
+    using base_t::get_pop_count;
 
     //*************************************************************************
     /// Push a value to the queue.
@@ -212,7 +301,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, Reserved);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(value);
 
@@ -234,7 +323,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index = get_next_index(write_index, Reserved);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(etl::move(value));
 
@@ -259,7 +348,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, Reserved);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(etl::forward<Args>(args)...);
 
@@ -281,7 +370,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index = get_next_index(write_index, Reserved);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T();
 
@@ -304,7 +393,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, Reserved);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1);
 
@@ -327,7 +416,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, Reserved);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1, value2);
 
@@ -350,7 +439,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, Reserved);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1, value2, value3);
 
@@ -373,7 +462,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, Reserved);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1, value2, value3, value4);
 
@@ -387,6 +476,69 @@ namespace etl
     }
 #endif
 
+    //*************************************************************************
+    /// Push up to 'n' values to the queue.
+    /// The values are published to the 'pop' thread together.
+    ///\param first The start of the values to push.
+    ///\param n     The number of values to push.
+    ///\return The number of values pushed. Less than 'n' if the queue filled.
+    //*************************************************************************
+    template <typename TIterator>
+    size_type push_n(TIterator first, size_type n)
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed);
+
+      n = get_push_count(write_index, n);
+
+      for (size_type i = 0; i < n; ++i)
+      {
+        ::new (&p_buffer[write_index]) T(*first);
+        ++first;
+        write_index = get_next_index(write_index, Reserved);
+      }
+
+      if (n != 0)
+      {
+        write.store(write_index, etl::memory_order_release);
+      }
+
+      return n;
+    }
+
+    //*************************************************************************
+    /// Pop up to 'n' values from the queue.
+    /// The space is released to the 'push' thread together.
+    ///\param first The start of the destination for the values.
+    ///\param n     The number of values to pop.
+    ///\return The number of values popped. Less than 'n' if the queue emptied.
+    //*************************************************************************
+    template <typename TOutputIterator>
+    size_type pop_n(TOutputIterator first, size_type n)
+    {
+      size_type read_index = read.load(etl::memory_order_relaxed);
+
+      n = get_pop_count(read_index, n);
+
+      for (size_type i = 0; i < n; ++i)
+      {
+#if ETL_USING_CPP11 && ETL_NOT_USING_STLPORT && !defined(ETL_QUEUE_LOCKABLE_FORCE_CPP03_IMPLEMENTATION)
+        *first = etl::move(p_buffer[read_index]);
+#else
+        *first = p_buffer[read_index];
+#endif
+        ++first;
+        p_buffer[read_index].~T();
+        read_index = get_next_index(read_index, Reserved);
+      }
+
+      if (n != 0)
+      {
+        read.store(read_index, etl::memory_order_release);
+      }
+
+      return n;
+    }
+
     //*************************************************************************
     /// Peek the next value in the queue without removing it.
     //*************************************************************************
@@ -394,7 +546,7 @@ namespace etl
     {
       size_type read_index = read.load(etl::memory_order_relaxed);
 
-      if (read_index == write.load(etl::memory_order_acquire))
+      if (!can_pop(read_index))
       {
         // Queue is empty
         return false;
@@ -412,7 +564,7 @@ namespace etl
     {
       size_type read_index = read.load(etl::memory_order_relaxed);
 
-      if (read_index == write.load(etl::memory_order_acquire))
+      if (!can_pop(read_index))
       {
         // Queue is empty
         return false;
@@ -440,7 +592,7 @@ namespace etl
     {
       size_type read_index = read.load(etl::memory_order_relaxed);
 
-      if (read_index == write.load(etl::memory_order_acquire))
+      if (!can_pop(read_index))
       {
         // Queue is empty
         return false;
@@ -484,8 +636,10 @@ namespace etl
     {
       if ETL_IF_CONSTEXPR(etl::is_trivially_destructible<T>::value)
       {
-        write = 0;
-        read  = 0;
+        write       = 0;
+        read        = 0;
+        read_cache  = 0;
+        write_cache = 0;
       }
       else
       {
@@ -574,6 +728,207 @@ namespace etl
 
   template <typename T, size_t Size, const size_t Memory_Model>
   ETL_CONSTANT typename queue_spsc_atomic<T, Size, Memory_Model>::size_type queue_spsc_atomic<T, Size, Memory_Model>::MAX_SIZE;
+
+#if ETL_HAS_FUTEX
+  //***************************************************************************
+  ///\ingroup queue_spsc
+  /// A fixed capacity spsc queue with a consumer that can block until an item arrives.
+  /// A push only makes a system call when the consumer is blocked on an
+  /// empty queue. Otherwise it costs a fence and a load more than a push to
+  /// queue_spsc_atomic. Push through this class, not an iqueue_spsc_atomic
+  /// reference, or a blocked consumer will not be woken.
+  /// \tparam T            The type this queue should support.
+  /// \tparam Size         The maximum capacity of the queue.
+  /// \tparam Memory_Model The memory model for the queue. Determines the type of the internal counter variables.
+  //***************************************************************************
+  template <typename T, size_t Size, const size_t Memory_Model = etl::memory_model::MEMORY_MODEL_LARGE>
+  class queue_spsc_atomic_blocking : public queue_spsc_atomic<T, Size, Memory_Model>
+  {
+  private:
+
+    typedef typename etl::queue_spsc_atomic<T, Size, Memory_Model> base_t;
+
+  public:
+
+    typedef typename base_t::reference       reference;
+    typedef typename base_t::const_reference const_reference;
+#if ETL_USING_CPP11
+    typedef typename base_t::rvalue_reference rvalue_reference;
+#endif
+    typedef typename base_t::size_type       size_type;
+
+    //*************************************************************************
+    /// Push a value to the queue, waking a waiting consumer.
+    //*************************************************************************
+    bool push(const_reference value)
+    {
+      return notify_if(base_t::push(value));
+    }
+
+#if ETL_USING_CPP11 && ETL_NOT_USING_STLPORT && !defined(ETL_QUEUE_ATOMIC_FORCE_CPP03_IMPLEMENTATION)
+    //*************************************************************************
+    /// Push a value to the queue, waking a waiting consumer.
+    //*************************************************************************
+    bool push(rvalue_reference value)
+    {
+      return notify_if(base_t::push(etl::move(value)));
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place', waking a waiting consumer.
+    //*************************************************************************
+    template <typename ... Args>
+    bool emplace(Args&&... args)
+    {
+      return notify_if(base_t::emplace(etl::forward<Args>(args)...));
+    }
+#else
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place', waking a waiting consumer.
+    //*************************************************************************
+    bool emplace()
+    {
+      return notify_if(base_t::emplace());
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place', waking a waiting consumer.
+    //*************************************************************************
+    template <typename T1>
+    bool emplace(const T1& value1)
+    {
+      return notify_if(base_t::emplace(value1));
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place', waking a waiting consumer.
+    //*************************************************************************
+    template <typename T1, typename T2>
+    bool emplace(const T1& value1, const T2& value2)
+    {
+      return notify_if(base_t::emplace(value1, value2));
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place', waking a waiting consumer.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3)
+    {
+      return notify_if(base_t::emplace(value1, value2, value3));
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place', waking a waiting consumer.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3, typename T4>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      return notify_if(base_t::emplace(value1, value2, value3, value4));
+    }
+#endif
+
+    //*************************************************************************
+    /// Push up to 'n' values to the queue, waking a waiting consumer.
+    ///\return The number of values pushed.
+    //*************************************************************************
+    template <typename TIterator>
+    size_type push_n(TIterator first, size_type n)
+    {
+      n = base_t::push_n(first, n);
+
+      notify_if(n != 0);
+
+      return n;
+    }
+
+    //*************************************************************************
+    /// Pop a value from the queue, blocking while the queue is empty.
+    //*************************************************************************
+    void pop_wait(reference value)
+    {
+      while (!base_t::pop(value))
+      {
+        uint32_t key = not_empty.prepare_wait();
+
+        if (base_t::pop(value))
+        {
+          break;
+        }
+
+        not_empty.wait(key);
+      }
+    }
+
+    //*************************************************************************
+    /// Pop a value from the queue, blocking while the queue is empty for up
+    /// to 'timeout_ms' milliseconds.
+    ///\return <b>true</b> if a value was popped, <b>false</b> if the wait timed out.
+    //*************************************************************************
+    bool pop_wait_for(reference value, uint32_t timeout_ms)
+    {
+      struct timespec deadline = etl::futex_event::get_deadline(timeout_ms);
+
+      while (!base_t::pop(value))
+      {
+        uint32_t key = not_empty.prepare_wait();
+
+        if (base_t::pop(value))
+        {
+          break;
+        }
+
+        if (!not_empty.wait(key, &deadline))
+        {
+          return base_t::pop(value);
+        }
+      }
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Pop up to 'n' values from the queue, blocking while the queue is empty.
+    ///\return The number of values popped. At least one unless 'n' is zero.
+    //*************************************************************************
+    template <typename TOutputIterator>
+    size_type pop_n_wait(TOutputIterator first, size_type n)
+    {
+      size_type count = base_t::pop_n(first, n);
+
+      while ((count == 0) && (n != 0))
+      {
+        uint32_t key = not_empty.prepare_wait();
+
+        count = base_t::pop_n(first, n);
+
+        if (count == 0)
+        {
+          not_empty.wait(key);
+        }
+      }
+
+      return count;
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Wakes the consumer if 'pushed' and the consumer is waiting.
+    //*************************************************************************
+    bool notify_if(bool pushed)
+    {
+      if (pushed)
+      {
+        not_empty.notify();
+      }
+
+      return pushed;
+    }
+
+    etl::futex_event not_empty; ///< Signalled when the queue may have become non-empty.
+  };
+#endif
 }
 
 #endif
@@ -45,6 +45,7 @@ SOFTWARE.
 #include "optional.h"
 
 #include "private/comparator_is_transparent.h"
+#include "private/eytzinger_index.h"
 
 #include <stddef.h>
 
@@ -598,6 +599,7 @@ namespace etl
       }
       else
       {
+        search_index.clear();
         lookup.erase(i_element.ilookup);
         return 1U;
       }
@@ -616,6 +618,7 @@ namespace etl
       }
       else
       {
+        search_index.clear();
         lookup.erase(i_element.ilookup);
         return 1U;
       }
@@ -628,6 +631,7 @@ namespace etl
     //*********************************************************************
     iterator erase(iterator i_element)
     {
+      search_index.clear();
       return lookup.erase(i_element.ilookup);
     }
 
@@ -637,6 +641,7 @@ namespace etl
     //*********************************************************************
     iterator erase(const_iterator i_element)
     {
+      search_index.clear();
       return lookup.erase(i_element.ilookup);
     }
 
@@ -649,6 +654,7 @@ namespace etl
     //*********************************************************************
     iterator erase(const_iterator first, const_iterator last)
     {
+      search_index.clear();
       return lookup.erase(first.ilookup, last.ilookup);
     }
 
@@ -657,6 +663,7 @@ namespace etl
     //*************************************************************************
     void clear()
     {
+      search_index.clear();
       lookup.clear();
     }
 
@@ -780,6 +787,11 @@ namespace etl
     //*********************************************************************
     iterator lower_bound(key_parameter_t key)
     {
+      if (search_index.is_built())
+      {
+        return iterator(lookup.begin() + search_index.lower_bound(key, compare.comp));
+      }
+
       return etl::lower_bound(begin(), end(), key, compare);
     }
 
@@ -788,6 +800,11 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     iterator lower_bound(const K& key)
     {
+      if (search_index.is_built())
+      {
+        return iterator(lookup.begin() + search_index.lower_bound(key, compare.comp));
+      }
+
       return etl::lower_bound(begin(), end(), key, compare);
     }
 #endif
@@ -799,6 +816,11 @@ namespace etl
     //*********************************************************************
     const_iterator lower_bound(key_parameter_t key) const
     {
+      if (search_index.is_built())
+      {
+        return const_iterator(lookup.cbegin() + search_index.lower_bound(key, compare.comp));
+      }
+
       return etl::lower_bound(cbegin(), cend(), key, compare);
     }
 
@@ -807,6 +829,11 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     const_iterator lower_bound(const K& key) const
     {
+      if (search_index.is_built())
+      {
+        return const_iterator(lookup.cbegin() + search_index.lower_bound(key, compare.comp));
+      }
+
       return etl::lower_bound(cbegin(), cend(), key, compare);
     }
 #endif
@@ -818,6 +845,11 @@ namespace etl
     //*********************************************************************
     iterator upper_bound(key_parameter_t key)
     {
+      if (search_index.is_built())
+      {
+        return iterator(lookup.begin() + search_index.upper_bound(key, compare.comp));
+      }
+
       return etl::upper_bound(begin(), end(), key, compare);
     }
 
@@ -826,6 +858,11 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     iterator upper_bound(const K& key)
     {
+      if (search_index.is_built())
+      {
+        return iterator(lookup.begin() + search_index.upper_bound(key, compare.comp));
+      }
+
       return etl::upper_bound(begin(), end(), key, compare);
     }
 #endif
@@ -837,6 +874,11 @@ namespace etl
     //*********************************************************************
     const_iterator upper_bound(key_parameter_t key) const
     {
+      if (search_index.is_built())
+      {
+        return const_iterator(lookup.cbegin() + search_index.upper_bound(key, compare.comp));
+      }
+
       return etl::upper_bound(begin(), end(), key, compare);
     }
 
@@ -845,6 +887,11 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     const_iterator upper_bound(const K& key) const
     {
+      if (search_index.is_built())
+      {
+        return const_iterator(lookup.cbegin() + search_index.upper_bound(key, compare.comp));
+      }
+
       return etl::upper_bound(begin(), end(), key, compare);
     }
 #endif
@@ -856,6 +903,11 @@ namespace etl
     //*********************************************************************
     ETL_OR_STD::pair<iterator, iterator> equal_range(key_parameter_t key)
     {
+      if (search_index.is_built())
+      {
+        return ETL_OR_STD::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       iterator i_lower = etl::lower_bound(begin(), end(), key, compare);
 
       return ETL_OR_STD::make_pair(i_lower, etl::upper_bound(i_lower, end(), key, compare));
@@ -866,6 +918,11 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     ETL_OR_STD::pair<iterator, iterator> equal_range(const K& key)
     {
+      if (search_index.is_built())
+      {
+        return ETL_OR_STD::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       iterator i_lower = etl::lower_bound(begin(), end(), key, compare);
 
       return ETL_OR_STD::make_pair(i_lower, etl::upper_bound(i_lower, end(), key, compare));
@@ -879,6 +936,11 @@ namespace etl
     //*********************************************************************
     ETL_OR_STD::pair<const_iterator, const_iterator> equal_range(key_parameter_t key) const
     {
+      if (search_index.is_built())
+      {
+        return ETL_OR_STD::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       const_iterator i_lower = etl::lower_bound(cbegin(), cend(), key, compare);
 
       return ETL_OR_STD::make_pair(i_lower, etl::upper_bound(i_lower, cend(), key, compare));
@@ -889,6 +951,11 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     ETL_OR_STD::pair<const_iterator, const_iterator> equal_range(const K& key) const
     {
+      if (search_index.is_built())
+      {
+        return ETL_OR_STD::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       const_iterator i_lower = etl::lower_bound(cbegin(), cend(), key, compare);
 
       return ETL_OR_STD::make_pair(i_lower, etl::upper_bound(i_lower, cend(), key, compare));
@@ -966,13 +1033,50 @@ namespace etl
       return lookup.available();
     }
 
+    //*************************************************************************
+    /// Builds a search index over the current elements.
+    /// Until the next insert or erase, lookups search the index instead of
+    /// the sorted elements. Any insert, erase or clear discards the index, so
+    /// freeze again after a batch of changes.
+    ///\return <b>true</b> if the index was built, <b>false</b> if the map was declared without one.
+    //*************************************************************************
+    bool freeze()
+    {
+      if (!search_index.has_storage())
+      {
+        return false;
+      }
+
+      search_index.build(lookup.cbegin(), lookup.size(), index_key_of());
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Discards the search index.
+    //*************************************************************************
+    void thaw()
+    {
+      search_index.clear();
+    }
+
+    //*************************************************************************
+    /// Checks whether lookups are using the search index.
+    //*************************************************************************
+    bool is_frozen() const
+    {
+      return search_index.is_built();
+    }
+
   protected:
 
     //*********************************************************************
     /// Constructor.
+    /// The index storage must hold capacity() + 1 keys and ranks, or be null.
     //*********************************************************************
-    ireference_flat_map(lookup_t& lookup_)
-      : lookup(lookup_)
+    ireference_flat_map(lookup_t& lookup_, key_type* p_index_keys = ETL_NULLPTR, size_t* p_index_ranks = ETL_NULLPTR)
+      : lookup(lookup_),
+        search_index(p_index_keys, p_index_ranks)
     {
     }
 
@@ -990,6 +1094,7 @@ namespace etl
         // At the end.
         ETL_ASSERT(!lookup.full(), ETL_ERROR(flat_map_full));
 
+        search_index.clear();
         lookup.push_back(&value);
         result.first = --end();
         result.second = true;
@@ -1004,6 +1109,7 @@ namespace etl
         {
           // A new one.
           ETL_ASSERT(!lookup.full(), ETL_ERROR(flat_map_full));
+          search_index.clear();
           lookup.insert(i_element.ilookup, &value);
           result.second = true;
         }
@@ -1035,10 +1141,24 @@ namespace etl
     ireference_flat_map(const ireference_flat_map&);
     ireference_flat_map& operator = (const ireference_flat_map&);
 
+    //*********************************************************************
+    /// Gets the key for the index from an element pointer.
+    //*********************************************************************
+    struct index_key_of
+    {
+      const key_type& operator ()(const value_type* p_value) const
+      {
+        return p_value->first;
+      }
+    };
+
     lookup_t& lookup;
 
     Compare compare;
 
+    /// The optional search index.
+    etl::private_eytzinger::eytzinger_index<key_type> search_index;
+
     //*************************************************************************
     /// Destructor.
     //*************************************************************************
@@ -1087,9 +1207,10 @@ namespace etl
   ///\tparam TValue   The value type.
   ///\tparam TCompare The type to compare keys. Default = etl::less<TKey>
   ///\tparam MAX_SIZE_ The maximum number of elements that can be stored.
+  ///\tparam INDEXED_  Reserves storage for the search index built by freeze(). Default = false
   ///\ingroup reference_flat_map
   //***************************************************************************
-  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = etl::less<TKey> >
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = etl::less<TKey>, const bool INDEXED_ = false>
   class reference_flat_map : public ireference_flat_map<TKey, TValue, TCompare>
   {
   public:
@@ -1100,7 +1221,7 @@ namespace etl
     /// Constructor.
     //*************************************************************************
     reference_flat_map()
-      : ireference_flat_map<TKey, TValue, TCompare>(lookup)
+      : ireference_flat_map<TKey, TValue, TCompare>(lookup, index_storage.keys(), index_storage.ranks())
     {
     }
 
@@ -1112,7 +1233,7 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     reference_flat_map(TIterator first, TIterator last)
-      : ireference_flat_map<TKey, TValue, TCompare>(lookup)
+      : ireference_flat_map<TKey, TValue, TCompare>(lookup, index_storage.keys(), index_storage.ranks())
     {
       ireference_flat_map<TKey, TValue, TCompare>::assign(first, last);
     }
@@ -1146,10 +1267,13 @@ namespace etl
 
     // The vector that stores pointers to the nodes.
     etl::vector<node_t*, MAX_SIZE> lookup;
+
+    // The storage for the search index.
+    etl::private_eytzinger::eytzinger_storage<TKey, MAX_SIZE, INDEXED_> index_storage;
   };
 
-  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare>
-  ETL_CONSTANT size_t reference_flat_map< TKey, TValue, MAX_SIZE_, TCompare>::MAX_SIZE;
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare, const bool INDEXED_>
+  ETL_CONSTANT size_t reference_flat_map<TKey, TValue, MAX_SIZE_, TCompare, INDEXED_>::MAX_SIZE;
 
   //*************************************************************************
   /// Template deduction guides.
@@ -45,6 +45,7 @@ SOFTWARE.
 #include "iterator.h"
 
 #include "private/comparator_is_transparent.h"
+#include "private/eytzinger_index.h"
 
 #include <stddef.h>
 
@@ -492,6 +493,7 @@ namespace etl
       }
       else
       {
+        search_index.clear();
         lookup.erase(i_element.ilookup);
         return 1;
       }
@@ -510,6 +512,7 @@ namespace etl
       }
       else
       {
+        search_index.clear();
         lookup.erase(i_element.ilookup);
         return 1;
       }
@@ -522,6 +525,7 @@ namespace etl
     //*********************************************************************
     iterator erase(iterator i_element)
     {
+      search_index.clear();
       return lookup.erase(i_element.ilookup);
     }
 
@@ -531,6 +535,7 @@ namespace etl
     //*********************************************************************
     iterator erase(const_iterator i_element)
     {
+      search_index.clear();
       return lookup.erase(i_element.ilookup);
     }
 
@@ -543,6 +548,7 @@ namespace etl
     //*********************************************************************
     iterator erase(const_iterator first, const_iterator last)
     {
+      search_index.clear();
       return lookup.erase(first.ilookup, last.ilookup);
     }
 
@@ -551,6 +557,7 @@ namespace etl
     //*************************************************************************
     void clear()
     {
+      search_index.clear();
       lookup.clear();
     }
 
@@ -561,7 +568,7 @@ namespace etl
     //*********************************************************************
     iterator find(parameter_t key)
     {
-      iterator itr = etl::lower_bound(begin(), end(), key, compare);
+      iterator itr = lower_bound(key);
 
       if (itr != end())
       {
@@ -583,7 +590,7 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     iterator find(const K& key)
     {
-      iterator itr = etl::lower_bound(begin(), end(), key, compare);
+      iterator itr = lower_bound(key);
 
       if (itr != end())
       {
@@ -608,7 +615,7 @@ namespace etl
     //*********************************************************************
     const_iterator find(parameter_t key) const
     {
-      const_iterator itr = etl::lower_bound(begin(), end(), key, compare);
+      const_iterator itr = lower_bound(key);
 
       if (itr != end())
       {
@@ -630,7 +637,7 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     const_iterator find(const K& key) const
     {
-      const_iterator itr = etl::lower_bound(begin(), end(), key, compare);
+      const_iterator itr = lower_bound(key);
 
       if (itr != end())
       {
@@ -674,6 +681,11 @@ namespace etl
     //*********************************************************************
     iterator lower_bound(parameter_t key)
     {
+      if (search_index.is_built())
+      {
+        return iterator(lookup.begin() + search_index.lower_bound(key, compare));
+      }
+
       return etl::lower_bound(begin(), end(), key, compare);
     }
 
@@ -682,6 +694,11 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     iterator lower_bound(const K& key)
     {
+      if (search_index.is_built())
+      {
+        return iterator(lookup.begin() + search_index.lower_bound(key, compare));
+      }
+
       return etl::lower_bound(begin(), end(), key, compare);
     }
 #endif
@@ -693,6 +710,11 @@ namespace etl
     //*********************************************************************
     const_iterator lower_bound(parameter_t key) const
     {
+      if (search_index.is_built())
+      {
+        return const_iterator(lookup.cbegin() + search_index.lower_bound(key, compare));
+      }
+
       return etl::lower_bound(cbegin(), cend(), key, compare);
     }
 
@@ -701,6 +723,11 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     const_iterator lower_bound(const K& key) const
     {
+      if (search_index.is_built())
+      {
+        return const_iterator(lookup.cbegin() + search_index.lower_bound(key, compare));
+      }
+
       return etl::lower_bound(cbegin(), cend(), key, compare);
     }
 #endif
@@ -712,6 +739,11 @@ namespace etl
     //*********************************************************************
     iterator upper_bound(parameter_t key)
     {
+      if (search_index.is_built())
+      {
+        return iterator(lookup.begin() + search_index.upper_bound(key, compare));
+      }
+
       return etl::upper_bound(begin(), end(), key, compare);
     }
 
@@ -720,6 +752,11 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     iterator upper_bound(const K& key)
     {
+      if (search_index.is_built())
+      {
+        return iterator(lookup.begin() + search_index.upper_bound(key, compare));
+      }
+
       return etl::upper_bound(begin(), end(), key, compare);
     }
 #endif
@@ -731,6 +768,11 @@ namespace etl
     //*********************************************************************
     const_iterator upper_bound(parameter_t key) const
     {
+      if (search_index.is_built())
+      {
+        return const_iterator(lookup.cbegin() + search_index.upper_bound(key, compare));
+      }
+
       return etl::upper_bound(cbegin(), cend(), key, compare);
     }
 
@@ -739,6 +781,11 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     const_iterator upper_bound(const K& key) const
     {
+      if (search_index.is_built())
+      {
+        return const_iterator(lookup.cbegin() + search_index.upper_bound(key, compare));
+      }
+
       return etl::upper_bound(cbegin(), cend(), key, compare);
     }
 #endif
@@ -750,6 +797,11 @@ namespace etl
     //*********************************************************************
     ETL_OR_STD::pair<iterator, iterator> equal_range(parameter_t key)
     {
+      if (search_index.is_built())
+      {
+        return ETL_OR_STD::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       return etl::equal_range(begin(), end(), key, compare);
     }
 
@@ -758,6 +810,11 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     ETL_OR_STD::pair<iterator, iterator> equal_range(const K& key)
     {
+      if (search_index.is_built())
+      {
+        return ETL_OR_STD::make_pair(lower_bound(key), upper_bound(key));
+      }
+
       return etl::equal_range(begin(), end(), key, compare);
     }
 #endif
@@ -769,7 +826,12 @@ namespace etl
     //*********************************************************************
     ETL_OR_STD::pair<const_iterator, const_iterator> equal_range(parameter_t key) const
     {
-      return etl::upper_bound(cbegin(), cend(), key, compare);
+      if (search_index.is_built())
+      {
+        return ETL_OR_STD::make_pair(lower_bound(key), upper_bound(key));
+      }
+
+      return etl::equal_range(cbegin(), cend(), key, compare);
     }
 
 #if ETL_USING_CPP11
@@ -777,7 +839,12 @@ namespace etl
     template <typename K, typename KC = TKeyCompare, etl::enable_if_t<comparator_is_transparent<KC>::value, int> = 0>
     ETL_OR_STD::pair<const_iterator, const_iterator> equal_range(const K& key) const
     {
-      return etl::upper_bound(cbegin(), cend(), key, compare);
+      if (search_index.is_built())
+      {
+        return ETL_OR_STD::make_pair(lower_bound(key), upper_bound(key));
+      }
+
+      return etl::equal_range(cbegin(), cend(), key, compare);
     }
 #endif
 
@@ -852,13 +919,50 @@ namespace etl
       return lookup.available();
     }
 
+    //*************************************************************************
+    /// Builds a search index over the current elements.
+    /// Until the next insert or erase, lookups search the index instead of
+    /// the sorted elements. Any insert, erase or clear discards the index, so
+    /// freeze again after a batch of changes.
+    ///\return <b>true</b> if the index was built, <b>false</b> if the set was declared without one.
+    //*************************************************************************
+    bool freeze()
+    {
+      if (!search_index.has_storage())
+      {
+        return false;
+      }
+
+      search_index.build(lookup.cbegin(), lookup.size(), index_key_of());
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Discards the search index.
+    //*************************************************************************
+    void thaw()
+    {
+      search_index.clear();
+    }
+
+    //*************************************************************************
+    /// Checks whether lookups are using the search index.
+    //*************************************************************************
+    bool is_frozen() const
+    {
+      return search_index.is_built();
+    }
+
   protected:
 
     //*********************************************************************
     /// Constructor.
+    /// The index storage must hold capacity() + 1 keys and ranks, or be null.
     //*********************************************************************
-    ireference_flat_set(lookup_t& lookup_)
-      : lookup(lookup_)
+    ireference_flat_set(lookup_t& lookup_, key_type* p_index_keys = ETL_NULLPTR, size_t* p_index_ranks = ETL_NULLPTR)
+      : lookup(lookup_),
+        search_index(p_index_keys, p_index_ranks)
     {
     }
 
@@ -876,6 +980,7 @@ namespace etl
         // At the end.
         ETL_ASSERT(!lookup.full(), ETL_ERROR(flat_set_full));
 
+        search_index.clear();
         lookup.push_back(&value);
         result.first = --end();
         result.second = true;
@@ -890,6 +995,7 @@ namespace etl
         {
           // A new one.
           ETL_ASSERT(!lookup.full(), ETL_ERROR(flat_set_full));
+          search_index.clear();
           lookup.insert(i_element.ilookup, &value);
           result.second = true;
         }
@@ -904,10 +1010,24 @@ namespace etl
     ireference_flat_set(const ireference_flat_set&);
     ireference_flat_set& operator =(const ireference_flat_set&);
 
+    //*********************************************************************
+    /// Gets the key for the index from an element pointer.
+    //*********************************************************************
+    struct index_key_of
+    {
+      const key_type& operator ()(const value_type* p_value) const
+      {
+        return *p_value;
+      }
+    };
+
     lookup_t& lookup;
 
     TKeyCompare compare;
 
+    /// The optional search index.
+    etl::private_eytzinger::eytzinger_index<key_type> search_index;
+
     //*************************************************************************
     /// Destructor.
     //*************************************************************************
@@ -926,9 +1046,10 @@ namespace etl
 
   //***************************************************************************
   /// An reference flat set
+  ///\tparam INDEXED_ Reserves storage for the search index built by freeze(). Default = false
   ///\ingroup reference_flat_set
   //***************************************************************************
-  template <typename TKey, const size_t MAX_SIZE_, typename TKeyCompare = etl::less<TKey> >
+  template <typename TKey, const size_t MAX_SIZE_, typename TKeyCompare = etl::less<TKey>, const bool INDEXED_ = false>
   class reference_flat_set : public ireference_flat_set<TKey, TKeyCompare>
   {
   public:
@@ -941,7 +1062,7 @@ namespace etl
     /// Constructor.
     //*************************************************************************
     reference_flat_set()
-      : ireference_flat_set<TKey, TKeyCompare>(lookup)
+      : ireference_flat_set<TKey, TKeyCompare>(lookup, index_storage.keys(), index_storage.ranks())
     {
     }
 
@@ -949,7 +1070,7 @@ namespace etl
     /// Copy constructor.
     //*************************************************************************
     reference_flat_set(const reference_flat_set& other)
-      : ireference_flat_set<TKey, TKeyCompare>(lookup)
+      : ireference_flat_set<TKey, TKeyCompare>(lookup, index_storage.keys(), index_storage.ranks())
     {
       ireference_flat_set<TKey, TKeyCompare>::assign(other.cbegin(), other.cend());
     }
@@ -962,7 +1083,7 @@ namespace etl
     //*************************************************************************
     template <typename TIterator>
     reference_flat_set(TIterator first, TIterator last)
-      : ireference_flat_set<TKey, TKeyCompare>(lookup)
+      : ireference_flat_set<TKey, TKeyCompare>(lookup, index_storage.keys(), index_storage.ranks())
     {
       ireference_flat_set<TKey, TKeyCompare>::assign(first, last);
     }
@@ -979,10 +1100,13 @@ namespace etl
 
     // The vector that stores pointers to the nodes.
     etl::vector<value_type*, MAX_SIZE> lookup;
+
+    // The storage for the search index.
+    etl::private_eytzinger::eytzinger_storage<TKey, MAX_SIZE, INDEXED_> index_storage;
   };
 
-  template <typename TKey, const size_t MAX_SIZE_, typename TCompare>
-  ETL_CONSTANT size_t reference_flat_set<TKey, MAX_SIZE_, TCompare>::MAX_SIZE;
+  template <typename TKey, const size_t MAX_SIZE_, typename TCompare, const bool INDEXED_>
+  ETL_CONSTANT size_t reference_flat_set<TKey, MAX_SIZE_, TCompare, INDEXED_>::MAX_SIZE;
 
   //*************************************************************************
   /// Template deduction guides.
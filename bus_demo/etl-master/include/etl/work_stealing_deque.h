@@ -0,0 +1,338 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_WORK_STEALING_DEQUE_INCLUDED
+#define ETL_WORK_STEALING_DEQUE_INCLUDED
+
+#include "platform.h"
+#include "alignment.h"
+#include "atomic.h"
+#include "power.h"
+#include "placement_new.h"
+#include "static_assert.h"
+
+#include <stddef.h>
+
+#if ETL_HAS_ATOMIC
+
+namespace etl
+{
+  //***************************************************************************
+  ///\ingroup work_stealing_deque
+  ///\brief This is the base for all work_stealing_deques that contain a particular type.
+  ///\details Normally a reference to this type will be taken from a derived work_stealing_deque.
+  ///\code
+  /// etl::work_stealing_deque<etl::task*, 16> myDeque;
+  /// etl::iwork_stealing_deque<etl::task*>& iDeque = myDeque;
+  ///\endcode
+  /// A Chase-Lev deque. One thread, the owner, pushes and pops at the bottom.
+  /// Any number of other threads may steal from the top.
+  /// The owner only contends with thieves when a single item remains.
+  /// A steal may fail while another thread is taking the same item. The thief
+  /// should then try elsewhere, or try again.
+  /// \tparam T The type held. It must be a type that etl::atomic supports, such as a pointer.
+  //***************************************************************************
+  template <typename T>
+  class iwork_stealing_deque
+  {
+  public:
+
+    typedef T      value_type; ///< The type stored in the deque.
+    typedef size_t size_type;  ///< The type used for determining the size of the deque.
+
+    //*************************************************************************
+    /// Push a value to the bottom of the deque.
+    /// Must only be called by the owner.
+    /// Returns <b>false</b> if the deque is full.
+    //*************************************************************************
+    bool push(T value)
+    {
+      size_t b = bottom.load(etl::memory_order_relaxed);
+      size_t t = top.load(etl::memory_order_acquire);
+
+      if ((b - t) >= MAX_SIZE)
+      {
+        // Deque is full.
+        return false;
+      }
+
+      p_buffer[b & Mask].store(value, etl::memory_order_relaxed);
+      bottom.store(b + 1U, etl::memory_order_release);
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Pop a value from the bottom of the deque.
+    /// Must only be called by the owner.
+    /// Returns <b>false</b> if the deque is empty.
+    //*************************************************************************
+    bool pop(T& value)
+    {
+      size_t b = bottom.load(etl::memory_order_relaxed) - 1U;
+
+      // Reserve the bottom item before looking at the top, so that a thief
+      // either sees the reservation or is seen by the owner.
+      bottom.store(b, etl::memory_order_seq_cst);
+      size_t t = top.load(etl::memory_order_seq_cst);
+
+      ptrdiff_t n = ptrdiff_t(b - t);
+
+      if (n < 0)
+      {
+        // Deque is empty.
+        bottom.store(b + 1U, etl::memory_order_relaxed);
+        return false;
+      }
+
+      value = p_buffer[b & Mask].load(etl::memory_order_relaxed);
+
+      if (n > 0)
+      {
+        // More than one item, so no thief can reach this one.
+        return true;
+      }
+
+      // The last item. Race any thieves for it.
+      bool success = top.compare_exchange_strong(t, t + 1U, etl::memory_order_seq_cst, etl::memory_order_relaxed);
+      bottom.store(b + 1U, etl::memory_order_relaxed);
+
+      return success;
+    }
+
+    //*************************************************************************
+    /// Steal a value from the top of the deque.
+    /// May be called by any thread.
+    /// Returns <b>false</b> if the deque is empty or another thread took the item first.
+    //*************************************************************************
+    bool steal(T& value)
+    {
+      size_t t = top.load(etl::memory_order_seq_cst);
+      size_t b = bottom.load(etl::memory_order_seq_cst);
+
+      if (ptrdiff_t(b - t) <= 0)
+      {
+        // Deque is empty.
+        return false;
+      }
+
+      value = p_buffer[t & Mask].load(etl::memory_order_relaxed);
+
+      return top.compare_exchange_strong(t, t + 1U, etl::memory_order_seq_cst, etl::memory_order_relaxed);
+    }
+
+    //*************************************************************************
+    /// Clear the deque.
+    /// Must only be called by the owner.
+    //*************************************************************************
+    void clear()
+    {
+      T value;
+
+      while (pop(value))
+      {
+        // Do nothing.
+      }
+    }
+
+    //*************************************************************************
+    /// Is the deque empty?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool empty() const
+    {
+      return size() == 0U;
+    }
+
+    //*************************************************************************
+    /// Is the deque full?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool full() const
+    {
+      return size() == MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// How many items in the deque?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type size() const
+    {
+      size_t t = top.load(etl::memory_order_acquire);
+      size_t b = bottom.load(etl::memory_order_acquire);
+
+      ptrdiff_t n = ptrdiff_t(b - t);
+
+      // The positions are read separately, so may be momentarily inconsistent.
+      if (n < 0)
+      {
+        n = 0;
+      }
+      else if (size_t(n) > MAX_SIZE)
+      {
+        n = ptrdiff_t(MAX_SIZE);
+      }
+
+      return size_type(n);
+    }
+
+    //*************************************************************************
+    /// How much free space available in the deque.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type available() const
+    {
+      return MAX_SIZE - size();
+    }
+
+    //*************************************************************************
+    /// How many items can the deque hold.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// How many items can the deque hold.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return MAX_SIZE;
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// The constructor that is called from derived classes.
+    /// The size must be a power of two, so that positions map to the same slot
+    /// after wrapping.
+    //*************************************************************************
+    iwork_stealing_deque(etl::atomic<T>* p_buffer_, size_type max_size_)
+      : bottom(0U),
+        top(0U),
+        p_buffer(p_buffer_),
+        MAX_SIZE(max_size_),
+        Mask(max_size_ - 1U)
+    {
+      for (size_t i = 0UL; i < max_size_; ++i)
+      {
+        ::new (&p_buffer[i]) etl::atomic<T>();
+      }
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_WORK_STEALING_DEQUE) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~iwork_stealing_deque()
+    {
+    }
+#else
+  protected:
+    ~iwork_stealing_deque()
+    {
+    }
+#endif
+
+  private:
+
+    // Disable copy construction and assignment.
+    iwork_stealing_deque(const iwork_stealing_deque&) ETL_DELETE;
+    iwork_stealing_deque& operator =(const iwork_stealing_deque&) ETL_DELETE;
+
+#if ETL_USING_CPP11
+    iwork_stealing_deque(iwork_stealing_deque&&) = delete;
+    iwork_stealing_deque& operator =(iwork_stealing_deque&&) = delete;
+#endif
+
+    // The owner's position and the thieves' position are kept on separate cache lines.
+    etl::atomic<size_t> bottom;         ///< The position of the next push. Written only by the owner.
+    char                bottom_padding[ETL_CACHE_LINE_SIZE];
+    etl::atomic<size_t> top;            ///< The position of the next steal.
+    char                top_padding[ETL_CACHE_LINE_SIZE];
+    etl::atomic<T>*     p_buffer;       ///< The internal buffer.
+    const size_type     MAX_SIZE;       ///< The maximum number of items in the deque.
+    const size_t        Mask;           ///< The index mask.
+  };
+
+  //***************************************************************************
+  ///\ingroup work_stealing_deque
+  /// A fixed capacity lock free work stealing deque.
+  /// \tparam T    The type this deque should support.
+  /// \tparam Size The maximum capacity of the deque. Must be a power of two.
+  //***************************************************************************
+  template <typename T, size_t Size>
+  class work_stealing_deque : public iwork_stealing_deque<T>
+  {
+  private:
+
+    typedef typename etl::iwork_stealing_deque<T> base_t;
+
+  public:
+
+    typedef typename base_t::size_type size_type;
+
+    ETL_STATIC_ASSERT((Size > 0), "Size must be greater than zero");
+    ETL_STATIC_ASSERT((etl::is_power_of_2<Size>::value), "Size must be a power of two");
+
+    static ETL_CONSTANT size_type MAX_SIZE = size_type(Size);
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    work_stealing_deque()
+      : base_t(reinterpret_cast<etl::atomic<T>*>(&buffer[0]), MAX_SIZE)
+    {
+    }
+
+  private:
+
+    work_stealing_deque(const work_stealing_deque&) ETL_DELETE;
+    work_stealing_deque& operator = (const work_stealing_deque&) ETL_DELETE;
+
+#if ETL_USING_CPP11
+    work_stealing_deque(work_stealing_deque&&) = delete;
+    work_stealing_deque& operator = (work_stealing_deque&&) = delete;
+#endif
+
+    /// The uninitialised buffer of slots used in the work_stealing_deque.
+    typename etl::aligned_storage<sizeof(etl::atomic<T>), etl::alignment_of<etl::atomic<T> >::value>::type buffer[MAX_SIZE];
+  };
+
+  template <typename T, size_t Size>
+  ETL_CONSTANT typename work_stealing_deque<T, Size>::size_type work_stealing_deque<T, Size>::MAX_SIZE;
+}
+
+#endif
+
+#endif
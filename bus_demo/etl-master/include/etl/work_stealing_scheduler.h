@@ -0,0 +1,542 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_WORK_STEALING_SCHEDULER_INCLUDED
+#define ETL_WORK_STEALING_SCHEDULER_INCLUDED
+
+#include "platform.h"
+#include "algorithm.h"
+#include "atomic.h"
+#include "vector.h"
+#include "nullptr.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "task.h"
+#include "scheduler.h"
+#include "function.h"
+#include "power.h"
+#include "work_stealing_deque.h"
+
+#include <stdint.h>
+
+#if ETL_HAS_ATOMIC
+
+namespace etl
+{
+  //***************************************************************************
+  /// 'Invalid worker' exception.
+  //***************************************************************************
+  class scheduler_invalid_worker_exception : public etl::scheduler_exception
+  {
+  public:
+
+    scheduler_invalid_worker_exception(string_type file_name_, numeric_type line_number_)
+      : etl::scheduler_exception(ETL_ERROR_TEXT("scheduler:invalid worker", ETL_WORK_STEALING_SCHEDULER_FILE_ID"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The statistics for one worker of a work_stealing_scheduler.
+  /// The counters wrap, so utilisation over an interval is best calculated
+  /// from the difference between two snapshots.
+  //***************************************************************************
+  struct scheduler_worker_statistics
+  {
+    scheduler_worker_statistics()
+      : busy_passes(0U),
+        idle_passes(0U),
+        busy_ticks(0U),
+        idle_ticks(0U),
+        tasks_stolen(0U),
+        tasks_owned(0U)
+    {
+    }
+
+    //*******************************************
+    /// Get the percentage of time spent doing work.
+    /// Based on clock ticks if a clock has been set, otherwise on passes.
+    //*******************************************
+    uint32_t get_utilisation() const
+    {
+      uint64_t busy  = busy_ticks;
+      uint64_t total = uint64_t(busy_ticks) + idle_ticks;
+
+      if (total == 0U)
+      {
+        busy  = busy_passes;
+        total = uint64_t(busy_passes) + idle_passes;
+      }
+
+      return (total == 0U) ? 0U : uint32_t((busy * 100U) / total);
+    }
+
+    uint32_t busy_passes;  ///< Passes in which the policy found work.
+    uint32_t idle_passes;  ///< Passes in which the policy found no work.
+    uint32_t busy_ticks;   ///< Clock ticks spent in busy passes.
+    uint32_t idle_ticks;   ///< Clock ticks spent in idle passes, including the idle callback.
+    uint32_t tasks_stolen; ///< Tasks taken from other workers.
+    size_t   tasks_owned;  ///< Tasks owned by the worker at the end of its last pass.
+  };
+
+  //***************************************************************************
+  /// Work stealing scheduler.
+  /// Runs tasks on MAX_WORKERS threads. The threads are created by the user,
+  /// and each calls start() with its own worker id.
+  /// Each task is owned by one worker at a time, and is only ever called by
+  /// that worker. Each worker applies the scheduler policy to its own tasks.
+  /// A worker that finds no work signals that it is idle and steals an offered
+  /// task from another worker, and keeps it. While any worker is signalling idle,
+  /// a worker that had work offers those of its tasks that have work, other than
+  /// the highest priority one, on its work stealing deque. Offered tasks that are
+  /// not stolen during the next pass are taken back. While no worker is idle,
+  /// nothing is offered and every worker's policy sees all of its tasks.
+  /// Tasks, callbacks and the clock must be set before any worker is started.
+  /// Nothing is allocated.
+  /// \tparam TSchedulerPolicy The policy that each worker uses to run its tasks.
+  /// \tparam MAX_WORKERS_     The number of worker threads.
+  /// \tparam MAX_TASKS_       The maximum number of tasks.
+  //***************************************************************************
+  template <typename TSchedulerPolicy, size_t MAX_WORKERS_, size_t MAX_TASKS_>
+  class work_stealing_scheduler
+  {
+  public:
+
+    enum
+    {
+      MAX_WORKERS = MAX_WORKERS_,
+      MAX_TASKS   = MAX_TASKS_
+    };
+
+    ETL_STATIC_ASSERT((MAX_WORKERS_ > 0), "MAX_WORKERS must be greater than zero");
+    ETL_STATIC_ASSERT((MAX_TASKS_ > 0), "MAX_TASKS must be greater than zero");
+
+    /// The type of a function that returns the current clock tick.
+    typedef uint32_t (*clock_function_t)();
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    work_stealing_scheduler()
+      : scheduler_running(false),
+        scheduler_exit(false),
+        p_idle_callback(ETL_NULLPTR),
+        p_watchdog_callback(ETL_NULLPTR),
+        p_clock(ETL_NULLPTR),
+        task_count(0U),
+        idle_workers(0U)
+    {
+    }
+
+    //*******************************************
+    /// Set the idle callback.
+    /// Called with the worker id when a worker has no work and nothing to steal.
+    //*******************************************
+    void set_idle_callback(etl::ifunction<size_t>& callback)
+    {
+      p_idle_callback = &callback;
+    }
+
+    //*******************************************
+    /// Set the watchdog callback.
+    /// Called with the worker id after every pass.
+    //*******************************************
+    void set_watchdog_callback(etl::ifunction<size_t>& callback)
+    {
+      p_watchdog_callback = &callback;
+    }
+
+    //*******************************************
+    /// Set the clock used to measure utilisation.
+    //*******************************************
+    void set_clock(clock_function_t p_clock_)
+    {
+      p_clock = p_clock_;
+    }
+
+    //*******************************************
+    /// Set the running state for the scheduler.
+    //*******************************************
+    void set_scheduler_running(bool scheduler_running_)
+    {
+      scheduler_running.store(scheduler_running_, etl::memory_order_relaxed);
+    }
+
+    //*******************************************
+    /// Get the running state for the scheduler.
+    //*******************************************
+    bool scheduler_is_running() const
+    {
+      return scheduler_running.load(etl::memory_order_relaxed);
+    }
+
+    //*******************************************
+    /// Force all of the workers to exit.
+    //*******************************************
+    void exit_scheduler()
+    {
+      scheduler_exit.store(true, etl::memory_order_relaxed);
+    }
+
+    //*******************************************
+    /// Add a task to the worker with the fewest tasks.
+    //*******************************************
+    void add_task(etl::task& task)
+    {
+      size_t worker_id = 0U;
+
+      for (size_t i = 1U; i < MAX_WORKERS; ++i)
+      {
+        if (workers[i].task_list.size() < workers[worker_id].task_list.size())
+        {
+          worker_id = i;
+        }
+      }
+
+      add_task(task, worker_id);
+    }
+
+    //*******************************************
+    /// Add a task to a particular worker.
+    /// The task may later be stolen by another worker.
+    //*******************************************
+    void add_task(etl::task& task, size_t worker_id)
+    {
+      ETL_ASSERT(worker_id < MAX_WORKERS, ETL_ERROR(etl::scheduler_invalid_worker_exception));
+      ETL_ASSERT(task_count < MAX_TASKS, ETL_ERROR(etl::scheduler_too_many_tasks_exception));
+
+      if ((worker_id < MAX_WORKERS) && (task_count < MAX_TASKS))
+      {
+        insert_task(workers[worker_id], task);
+        workers[worker_id].tasks_owned.store(workers[worker_id].task_list.size(), etl::memory_order_relaxed);
+        ++task_count;
+
+        task.on_task_added();
+      }
+    }
+
+    //*******************************************
+    /// Add a task list.
+    /// Each task is added to the worker with the fewest tasks.
+    //*******************************************
+    template <typename TSize>
+    void add_task_list(etl::task** p_tasks, TSize size)
+    {
+      for (TSize i = 0; i < size; ++i)
+      {
+        ETL_ASSERT((p_tasks[i] != ETL_NULLPTR), ETL_ERROR(etl::scheduler_null_task_exception));
+        add_task(*(p_tasks[i]));
+      }
+    }
+
+    //*******************************************
+    /// Run a worker on the calling thread.
+    /// Returns when exit_scheduler() is called.
+    //*******************************************
+    void start(size_t worker_id)
+    {
+      ETL_ASSERT(task_count > 0, ETL_ERROR(etl::scheduler_no_tasks_exception));
+      ETL_ASSERT(worker_id < MAX_WORKERS, ETL_ERROR(etl::scheduler_invalid_worker_exception));
+
+      if (worker_id >= MAX_WORKERS)
+      {
+        return;
+      }
+
+      worker_t& worker = workers[worker_id];
+
+      scheduler_running.store(true, etl::memory_order_relaxed);
+
+      uint32_t mark = (p_clock != ETL_NULLPTR) ? p_clock() : 0U;
+
+      while (!scheduler_exit.load(etl::memory_order_relaxed))
+      {
+        if (scheduler_running.load(etl::memory_order_relaxed))
+        {
+          bool idle      = worker.policy.schedule_tasks(worker.task_list);
+          bool reclaimed = reclaim_tasks(worker);
+          bool acquired  = reclaimed;
+
+          if (!idle)
+          {
+            set_idle(worker, false);
+
+            // Only offer when a thief is waiting, and give tasks that were offered
+            // on the last pass a turn before offering again.
+            if (!reclaimed && (idle_workers.load(etl::memory_order_relaxed) != 0U))
+            {
+              offer_tasks(worker);
+            }
+          }
+          else if (!reclaimed)
+          {
+            // Signal before looking, so that busy workers offer on their next pass.
+            set_idle(worker, true);
+            acquired = steal_task(worker_id);
+          }
+
+          if (p_watchdog_callback)
+          {
+            (*p_watchdog_callback)(worker_id);
+          }
+
+          if (idle && !acquired && p_idle_callback)
+          {
+            (*p_idle_callback)(worker_id);
+          }
+
+          update_statistics(worker, idle, mark);
+        }
+        else if (p_clock != ETL_NULLPTR)
+        {
+          // Time spent stopped is not counted.
+          mark = p_clock();
+        }
+      }
+    }
+
+    //*******************************************
+    /// Get the statistics for a worker.
+    /// May be called from any thread.
+    //*******************************************
+    scheduler_worker_statistics get_statistics(size_t worker_id) const
+    {
+      scheduler_worker_statistics statistics;
+
+      ETL_ASSERT(worker_id < MAX_WORKERS, ETL_ERROR(etl::scheduler_invalid_worker_exception));
+
+      if (worker_id < MAX_WORKERS)
+      {
+        const worker_t& worker = workers[worker_id];
+
+        statistics.busy_passes  = worker.busy_passes.load(etl::memory_order_relaxed);
+        statistics.idle_passes  = worker.idle_passes.load(etl::memory_order_relaxed);
+        statistics.busy_ticks   = worker.busy_ticks.load(etl::memory_order_relaxed);
+        statistics.idle_ticks   = worker.idle_ticks.load(etl::memory_order_relaxed);
+        statistics.tasks_stolen = worker.tasks_stolen.load(etl::memory_order_relaxed);
+        statistics.tasks_owned  = worker.tasks_owned.load(etl::memory_order_relaxed);
+      }
+
+      return statistics;
+    }
+
+  private:
+
+    typedef etl::vector<etl::task*, MAX_TASKS> task_list_t;
+    typedef etl::work_stealing_deque<etl::task*, etl::power_of_2_round_up<MAX_TASKS>::value> offered_list_t;
+
+    //*******************************************
+    /// The state of one worker.
+    /// The statistics are only written by the worker that owns them.
+    //*******************************************
+    struct worker_t
+    {
+      worker_t()
+        : busy_passes(0U),
+          idle_passes(0U),
+          busy_ticks(0U),
+          idle_ticks(0U),
+          tasks_stolen(0U),
+          tasks_owned(0U),
+          signalling_idle(false)
+      {
+      }
+
+      task_list_t           task_list;    ///< The tasks run by this worker, in descending priority.
+      offered_list_t        offered_list; ///< The tasks this worker is offering to others.
+      TSchedulerPolicy      policy;       ///< The policy used to run this worker's tasks.
+      etl::atomic<uint32_t> busy_passes;
+      etl::atomic<uint32_t> idle_passes;
+      etl::atomic<uint32_t> busy_ticks;
+      etl::atomic<uint32_t> idle_ticks;
+      etl::atomic<uint32_t> tasks_stolen;
+      etl::atomic<size_t>   tasks_owned;
+      bool                  signalling_idle; ///< Whether this worker is counted in idle_workers. Only accessed by the worker.
+      char                  padding[ETL_CACHE_LINE_SIZE]; ///< Keeps workers' statistics off each other's cache lines.
+    };
+
+    //*******************************************
+    // Used to order tasks in descending priority.
+    //*******************************************
+    struct compare_priority
+    {
+      bool operator()(etl::task_priority_t priority, etl::task* ptask) const
+      {
+        return priority > ptask->get_task_priority();
+      }
+    };
+
+    //*******************************************
+    /// Add a task to a worker's list in priority order.
+    //*******************************************
+    static void insert_task(worker_t& worker, etl::task& task)
+    {
+      typename task_list_t::iterator itask = etl::upper_bound(worker.task_list.begin(),
+                                                              worker.task_list.end(),
+                                                              task.get_task_priority(),
+                                                              compare_priority());
+
+      worker.task_list.insert(itask, &task);
+    }
+
+    //*******************************************
+    /// Count the worker in, or out of, the workers waiting to steal.
+    //*******************************************
+    void set_idle(worker_t& worker, bool idle)
+    {
+      if (worker.signalling_idle != idle)
+      {
+        worker.signalling_idle = idle;
+
+        if (idle)
+        {
+          idle_workers.fetch_add(1U, etl::memory_order_relaxed);
+        }
+        else
+        {
+          idle_workers.fetch_sub(1U, etl::memory_order_relaxed);
+        }
+      }
+    }
+
+    //*******************************************
+    /// Take back the tasks that no other worker stole.
+    //*******************************************
+    static bool reclaim_tasks(worker_t& worker)
+    {
+      bool reclaimed = false;
+      etl::task* ptask;
+
+      while (worker.offered_list.pop(ptask))
+      {
+        insert_task(worker, *ptask);
+        reclaimed = true;
+      }
+
+      return reclaimed;
+    }
+
+    //*******************************************
+    /// Offer every task that has work, apart from the highest priority one.
+    //*******************************************
+    static void offer_tasks(worker_t& worker)
+    {
+      if (MAX_WORKERS == 1U)
+      {
+        return;
+      }
+
+      bool   keep  = true;
+      size_t index = 0U;
+
+      while (index < worker.task_list.size())
+      {
+        etl::task* ptask = worker.task_list[index];
+
+        if (ptask->task_request_work() > 0)
+        {
+          if (keep)
+          {
+            keep = false;
+          }
+          else if (worker.offered_list.push(ptask))
+          {
+            worker.task_list.erase(worker.task_list.begin() + index);
+            continue;
+          }
+        }
+
+        ++index;
+      }
+    }
+
+    //*******************************************
+    /// Steal a task from one of the other workers.
+    //*******************************************
+    bool steal_task(size_t worker_id)
+    {
+      worker_t& worker = workers[worker_id];
+
+      for (size_t i = 1U; i < MAX_WORKERS; ++i)
+      {
+        size_t victim_id = (worker_id + i) % MAX_WORKERS;
+        etl::task* ptask;
+
+        if (workers[victim_id].offered_list.steal(ptask))
+        {
+          insert_task(worker, *ptask);
+          worker.tasks_stolen.store(worker.tasks_stolen.load(etl::memory_order_relaxed) + 1U, etl::memory_order_relaxed);
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    //*******************************************
+    /// Update the worker's statistics at the end of a pass.
+    //*******************************************
+    void update_statistics(worker_t& worker, bool idle, uint32_t& mark)
+    {
+      etl::atomic<uint32_t>& passes = idle ? worker.idle_passes : worker.busy_passes;
+      passes.store(passes.load(etl::memory_order_relaxed) + 1U, etl::memory_order_relaxed);
+
+      if (p_clock != ETL_NULLPTR)
+      {
+        uint32_t now = p_clock();
+
+        etl::atomic<uint32_t>& ticks = idle ? worker.idle_ticks : worker.busy_ticks;
+        ticks.store(ticks.load(etl::memory_order_relaxed) + (now - mark), etl::memory_order_relaxed);
+
+        mark = now;
+      }
+
+      worker.tasks_owned.store(worker.task_list.size(), etl::memory_order_relaxed);
+    }
+
+    // Disable copy construction and assignment.
+    work_stealing_scheduler(const work_stealing_scheduler&) ETL_DELETE;
+    work_stealing_scheduler& operator =(const work_stealing_scheduler&) ETL_DELETE;
+
+    etl::atomic<bool>       scheduler_running;
+    etl::atomic<bool>       scheduler_exit;
+    etl::ifunction<size_t>* p_idle_callback;
+    etl::ifunction<size_t>* p_watchdog_callback;
+    clock_function_t        p_clock;
+    size_t                  task_count;
+    etl::atomic<uint32_t>   idle_workers; ///< The number of workers that found no work on their last pass.
+    worker_t                workers[MAX_WORKERS];
+  };
+}
+
+#endif
+
+#endif
@@ -0,0 +1,186 @@
+//*****************************************************************************
+// B-tree map benchmark.
+// Compares etl::btree_map with etl::map for random inserts, lookups,
+// in-order iteration, lower_bound range queries and erases.
+//
+// Build:
+//   cmake -S . -B build && cmake --build build && ./build/btree_map_benchmark
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "etl/btree_map.h"
+#include "etl/map.h"
+
+namespace
+{
+  //***************************************************************************
+  struct Timer
+  {
+    Timer()
+      : start(std::chrono::steady_clock::now())
+    {
+    }
+
+    double ns() const
+    {
+      return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::chrono::steady_clock::time_point start;
+  };
+
+  //***************************************************************************
+  // Times for one container, in ns per operation.
+  //***************************************************************************
+  struct Result
+  {
+    double insert;
+    double find;
+    double iterate;
+    double range;
+    double erase;
+  };
+
+  static volatile uint32_t sink;
+
+  //***************************************************************************
+  template <typename TMap>
+  Result run(TMap& map, const std::vector<uint32_t>& keys, const std::vector<uint32_t>& queries)
+  {
+    Result   result;
+    uint32_t sum = 0U;
+
+    map.clear();
+
+    {
+      Timer timer;
+
+      for (size_t i = 0UL; i < keys.size(); ++i)
+      {
+        map.insert(ETL_OR_STD::make_pair(keys[i], keys[i]));
+      }
+
+      result.insert = timer.ns() / double(keys.size());
+    }
+
+    {
+      Timer timer;
+
+      for (size_t i = 0UL; i < queries.size(); ++i)
+      {
+        typename TMap::const_iterator itr = map.find(queries[i]);
+
+        if (itr != map.end())
+        {
+          sum += itr->second;
+        }
+      }
+
+      result.find = timer.ns() / double(queries.size());
+    }
+
+    {
+      Timer timer;
+
+      for (int pass = 0; pass < 10; ++pass)
+      {
+        for (typename TMap::const_iterator itr = map.begin(); itr != map.end(); ++itr)
+        {
+          sum += itr->second;
+        }
+      }
+
+      result.iterate = timer.ns() / double(10UL * map.size());
+    }
+
+    {
+      // Each query visits the 32 elements following the lower bound.
+      Timer timer;
+
+      for (size_t i = 0UL; i < queries.size(); ++i)
+      {
+        typename TMap::const_iterator itr = map.lower_bound(queries[i]);
+
+        for (int n = 0; (n < 32) && (itr != map.end()); ++n, ++itr)
+        {
+          sum += itr->second;
+        }
+      }
+
+      result.range = timer.ns() / double(queries.size());
+    }
+
+    {
+      Timer timer;
+
+      for (size_t i = 0UL; i < keys.size(); ++i)
+      {
+        map.erase(keys[i]);
+      }
+
+      result.erase = timer.ns() / double(keys.size());
+    }
+
+    sink = sum;
+
+    return result;
+  }
+
+  //***************************************************************************
+  template <size_t Size>
+  void benchmark()
+  {
+    static etl::btree_map<uint32_t, uint32_t, Size> btree_map;
+    static etl::map<uint32_t, uint32_t, Size>       map;
+
+    std::mt19937 rng(12345U);
+
+    std::vector<uint32_t> keys(Size);
+
+    for (size_t i = 0UL; i < Size; ++i)
+    {
+      keys[i] = uint32_t(i * 2U);
+    }
+
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    std::vector<uint32_t> queries(100000UL);
+
+    for (size_t i = 0UL; i < queries.size(); ++i)
+    {
+      queries[i] = rng() % uint32_t(Size * 2U);
+    }
+
+    Result b = run(btree_map, keys, queries);
+    Result m = run(map, keys, queries);
+
+    printf("%8zu  insert %7.1f %7.1f  find %7.1f %7.1f  iterate %6.2f %6.2f  range32 %7.1f %7.1f  erase %7.1f %7.1f\n",
+           Size,
+           b.insert, m.insert,
+           b.find, m.find,
+           b.iterate, m.iterate,
+           b.range, m.range,
+           b.erase, m.erase);
+    fflush(stdout);
+  }
+}
+
+//*****************************************************************************
+int main()
+{
+  printf("ns per operation, etl::btree_map then etl::map\n");
+
+  benchmark<1000UL>();
+  benchmark<10000UL>();
+  benchmark<100000UL>();
+  benchmark<1000000UL>();
+
+  return 0;
+}
@@ -0,0 +1,145 @@
+//*****************************************************************************
+// Constant map benchmark.
+// Compares etl::const_hash_map, etl::const_map and etl::flat_map for looking
+// up CAN style identifiers in fixed tables, half hits and half misses.
+// The two const maps are built at compile time.
+//
+// Build:
+//   cmake -S . -B build && cmake --build build && ./build/const_map_benchmark
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "etl/const_hash_map.h"
+#include "etl/const_map.h"
+#include "etl/flat_map.h"
+
+namespace
+{
+  //***************************************************************************
+  struct Timer
+  {
+    Timer()
+      : start(std::chrono::steady_clock::now())
+    {
+    }
+
+    double ns() const
+    {
+      return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::chrono::steady_clock::time_point start;
+  };
+
+  //***************************************************************************
+  // Extended CAN identifiers, in ascending order.
+  //***************************************************************************
+  constexpr uint32_t can_id(size_t i)
+  {
+    return static_cast<uint32_t>(0x18FF0000UL + (i * 0x131UL));
+  }
+
+  //***************************************************************************
+  // A compile time table of can_id(i) -> i.
+  //***************************************************************************
+  template <typename TMap, typename TIndices>
+  struct Table;
+
+  template <typename TMap, size_t... Indices>
+  struct Table<TMap, std::index_sequence<Indices...>>
+  {
+    static constexpr TMap data{ typename TMap::value_type{ can_id(Indices), static_cast<uint16_t>(Indices) }... };
+  };
+
+  template <typename TMap, size_t... Indices>
+  constexpr TMap Table<TMap, std::index_sequence<Indices...>>::data;
+
+  //***************************************************************************
+  // Returns the average time per lookup.
+  //***************************************************************************
+  template <typename TMap>
+  double run(const TMap& map, const std::vector<uint32_t>& queries, size_t iterations)
+  {
+    size_t found = 0U;
+    Timer  timer;
+
+    for (size_t i = 0UL; i < iterations; ++i)
+    {
+      for (size_t j = 0UL; j < queries.size(); ++j)
+      {
+        typename TMap::const_iterator itr = map.find(queries[j]);
+
+        if (itr != map.end())
+        {
+          found += itr->second;
+        }
+      }
+    }
+
+    double ns = timer.ns() / double(iterations * queries.size());
+
+    static volatile size_t sink;
+    sink = found;
+
+    return ns;
+  }
+
+  //***************************************************************************
+  template <size_t Size>
+  void benchmark(size_t iterations)
+  {
+    using HashMap = etl::const_hash_map<uint32_t, uint16_t, Size>;
+    using Map     = etl::const_map<uint32_t, uint16_t, Size>;
+    using FlatMap = etl::flat_map<uint32_t, uint16_t, Size>;
+
+    const HashMap& hash_map = Table<HashMap, std::make_index_sequence<Size>>::data;
+    const Map&     map      = Table<Map, std::make_index_sequence<Size>>::data;
+
+    static FlatMap flat_map;
+    flat_map.clear();
+
+    for (size_t i = 0UL; i < Size; ++i)
+    {
+      flat_map.insert(ETL_OR_STD::make_pair(can_id(i), static_cast<uint16_t>(i)));
+    }
+
+    if (!hash_map.is_valid() || !map.is_valid())
+    {
+      printf("ERROR: invalid table\n");
+    }
+
+    std::mt19937 rng(12345U);
+    std::vector<uint32_t> queries(4096U);
+
+    for (size_t i = 0UL; i < queries.size(); ++i)
+    {
+      const uint32_t id = can_id(rng() % Size);
+
+      queries[i] = ((i & 1U) == 0U) ? id : id + 1U;
+    }
+
+    printf("%6zu %18.2f %18.2f %18.2f\n", Size, run(hash_map, queries, iterations), run(map, queries, iterations), run(flat_map, queries, iterations));
+    fflush(stdout);
+  }
+}
+
+//*****************************************************************************
+int main()
+{
+  printf("%6s %18s %18s %18s\n", "ns", "const_hash_map", "const_map", "flat_map");
+
+  benchmark<8UL>(20000UL);
+  benchmark<32UL>(10000UL);
+  benchmark<128UL>(5000UL);
+  benchmark<512UL>(2000UL);
+  benchmark<1024UL>(1000UL);
+
+  return 0;
+}
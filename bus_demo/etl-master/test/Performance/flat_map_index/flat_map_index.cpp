@@ -0,0 +1,199 @@
+//*****************************************************************************
+// Flat map search index benchmark.
+// Compares lookups in an etl::flat_map and etl::flat_set before and after
+// freeze() builds the search index, and reports the cost of freeze() itself.
+//
+// Build:
+//   cmake -S . -B build && cmake --build build && ./build/flat_map_index_benchmark
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "etl/flat_map.h"
+#include "etl/flat_set.h"
+
+namespace
+{
+  //***************************************************************************
+  struct Timer
+  {
+    Timer()
+      : start(std::chrono::steady_clock::now())
+    {
+    }
+
+    double ns() const
+    {
+      return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::chrono::steady_clock::time_point start;
+  };
+
+  //***************************************************************************
+  // Times for one container, in ns per operation.
+  //***************************************************************************
+  struct Result
+  {
+    double find;
+    double lower_bound;
+  };
+
+  static volatile uint32_t sink;
+
+  //***************************************************************************
+  template <typename TMap>
+  Result run_map(const TMap& map, const std::vector<uint32_t>& queries)
+  {
+    Result   result;
+    uint32_t sum = 0U;
+
+    {
+      Timer timer;
+
+      for (size_t i = 0UL; i < queries.size(); ++i)
+      {
+        typename TMap::const_iterator itr = map.find(queries[i]);
+
+        if (itr != map.end())
+        {
+          sum += itr->second;
+        }
+      }
+
+      result.find = timer.ns() / double(queries.size());
+    }
+
+    {
+      Timer timer;
+
+      for (size_t i = 0UL; i < queries.size(); ++i)
+      {
+        typename TMap::const_iterator itr = map.lower_bound(queries[i]);
+
+        if (itr != map.end())
+        {
+          sum += itr->second;
+        }
+      }
+
+      result.lower_bound = timer.ns() / double(queries.size());
+    }
+
+    sink = sum;
+
+    return result;
+  }
+
+  //***************************************************************************
+  template <typename TSet>
+  Result run_set(const TSet& set, const std::vector<uint32_t>& queries)
+  {
+    Result   result;
+    uint32_t sum = 0U;
+
+    {
+      Timer timer;
+
+      for (size_t i = 0UL; i < queries.size(); ++i)
+      {
+        typename TSet::const_iterator itr = set.find(queries[i]);
+
+        if (itr != set.end())
+        {
+          sum += *itr;
+        }
+      }
+
+      result.find = timer.ns() / double(queries.size());
+    }
+
+    {
+      Timer timer;
+
+      for (size_t i = 0UL; i < queries.size(); ++i)
+      {
+        typename TSet::const_iterator itr = set.lower_bound(queries[i]);
+
+        if (itr != set.end())
+        {
+          sum += *itr;
+        }
+      }
+
+      result.lower_bound = timer.ns() / double(queries.size());
+    }
+
+    sink = sum;
+
+    return result;
+  }
+
+  //***************************************************************************
+  template <size_t Size>
+  void benchmark()
+  {
+    static etl::flat_map<uint32_t, uint32_t, Size, etl::less<uint32_t>, true> map;
+    static etl::flat_set<uint32_t, Size, etl::less<uint32_t>, true>           set;
+
+    std::mt19937 rng(12345U);
+
+    // Inserting in order keeps the fill linear; lookups are what is measured.
+    for (size_t i = 0UL; i < Size; ++i)
+    {
+      map.insert(ETL_OR_STD::make_pair(uint32_t(i * 2U), uint32_t(i)));
+      set.insert(uint32_t(i * 2U));
+    }
+
+    std::vector<uint32_t> queries(1000000UL);
+
+    for (size_t i = 0UL; i < queries.size(); ++i)
+    {
+      queries[i] = rng() % uint32_t(Size * 2U);
+    }
+
+    Result map_sorted = run_map(map, queries);
+    Result set_sorted = run_set(set, queries);
+
+    double freeze_ns;
+
+    {
+      Timer timer;
+      map.freeze();
+      freeze_ns = timer.ns() / double(Size);
+    }
+
+    set.freeze();
+
+    Result map_frozen = run_map(map, queries);
+    Result set_frozen = run_set(set, queries);
+
+    printf("%8zu  map find %6.1f %6.1f  lower_bound %6.1f %6.1f  set find %6.1f %6.1f  lower_bound %6.1f %6.1f  freeze %5.2f\n",
+           Size,
+           map_sorted.find, map_frozen.find,
+           map_sorted.lower_bound, map_frozen.lower_bound,
+           set_sorted.find, set_frozen.find,
+           set_sorted.lower_bound, set_frozen.lower_bound,
+           freeze_ns);
+    fflush(stdout);
+  }
+}
+
+//*****************************************************************************
+int main()
+{
+  printf("ns per operation, sorted search then frozen index; freeze in ns per element\n");
+
+  benchmark<1000UL>();
+  benchmark<10000UL>();
+  benchmark<100000UL>();
+  benchmark<1000000UL>();
+
+  return 0;
+}
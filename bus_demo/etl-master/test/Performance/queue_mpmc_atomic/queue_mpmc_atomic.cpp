@@ -0,0 +1,150 @@
+//*****************************************************************************
+// MPMC queue contention benchmark.
+// Passes integers from N producer threads to N consumer threads through an
+// etl::queue_mpmc_atomic and an etl::queue_mpmc_mutex, for N from 1 to 16,
+// and reports the throughput of each.
+// Run on a machine with several cores for meaningful results.
+//
+// Build:
+//   cmake -S . -B build && cmake --build build && ./build/queue_mpmc_atomic_benchmark
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "etl/queue_mpmc_atomic.h"
+#include "etl/queue_mpmc_mutex.h"
+
+namespace
+{
+  static const uint32_t Items = 4000000UL;
+
+  static etl::queue_mpmc_atomic<uint32_t, 1024> atomic_queue;
+  static etl::queue_mpmc_mutex<uint32_t, 1024>  mutex_queue;
+
+  //***************************************************************************
+  struct Timer
+  {
+    Timer()
+      : start(std::chrono::steady_clock::now())
+    {
+    }
+
+    double seconds() const
+    {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::chrono::steady_clock::time_point start;
+  };
+
+  //***************************************************************************
+  // Returns millions of items per second.
+  //***************************************************************************
+  template <typename TQueue>
+  double run(TQueue& queue, uint32_t threads)
+  {
+    const uint32_t per_thread = Items / threads;
+
+    std::atomic<bool>     go(false);
+    std::atomic<uint64_t> total(0U);
+
+    std::vector<std::thread> workers;
+
+    for (uint32_t t = 0U; t < threads; ++t)
+    {
+      workers.push_back(std::thread([&queue, &go, per_thread]()
+      {
+        while (!go.load())
+        {
+          std::this_thread::yield();
+        }
+
+        for (uint32_t i = 0U; i < per_thread;)
+        {
+          if (queue.push(i))
+          {
+            ++i;
+          }
+          else
+          {
+            std::this_thread::yield();
+          }
+        }
+      }));
+
+      workers.push_back(std::thread([&queue, &go, &total, per_thread]()
+      {
+        uint64_t sum = 0U;
+
+        while (!go.load())
+        {
+          std::this_thread::yield();
+        }
+
+        for (uint32_t i = 0U; i < per_thread;)
+        {
+          uint32_t value;
+
+          if (queue.pop(value))
+          {
+            sum += value;
+            ++i;
+          }
+          else
+          {
+            std::this_thread::yield();
+          }
+        }
+
+        total += sum;
+      }));
+    }
+
+    Timer timer;
+
+    go.store(true);
+
+    for (size_t i = 0UL; i < workers.size(); ++i)
+    {
+      workers[i].join();
+    }
+
+    double seconds = timer.seconds();
+
+    // Every producer pushes 0 to per_thread - 1.
+    uint64_t expected = uint64_t(threads) * (uint64_t(per_thread) * (per_thread - 1U) / 2U);
+
+    if (total.load() != expected)
+    {
+      printf("Checksum mismatch\n");
+    }
+
+    return (double(per_thread) * threads) / seconds / 1.0e6;
+  }
+}
+
+//*****************************************************************************
+int main()
+{
+  printf("Millions of items per second, etl::queue_mpmc_atomic then etl::queue_mpmc_mutex\n");
+  printf("producers/consumers\n");
+
+  const uint32_t threads[] = { 1U, 2U, 4U, 8U, 16U };
+
+  for (size_t i = 0UL; i < (sizeof(threads) / sizeof(threads[0])); ++i)
+  {
+    double a = run(atomic_queue, threads[i]);
+    double m = run(mutex_queue, threads[i]);
+
+    printf("%2u/%-2u  %7.1f %7.1f\n", unsigned(threads[i]), unsigned(threads[i]), a, m);
+    fflush(stdout);
+  }
+
+  return 0;
+}
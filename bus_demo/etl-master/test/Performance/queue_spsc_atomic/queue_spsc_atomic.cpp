@@ -0,0 +1,228 @@
+//*****************************************************************************
+// SPSC atomic queue benchmark.
+// Passes integers from a producer thread to a consumer thread through an
+// etl::queue_spsc_atomic, one item at a time with push/pop and in batches
+// with push_n/pop_n, and reports the throughput of each. Where futexes are
+// available it also times etl::queue_spsc_atomic_blocking with a consumer
+// that blocks in pop_wait instead of spinning.
+// Run on a machine with at least two cores for meaningful results.
+//
+// Build:
+//   cmake -S . -B build && cmake --build build && ./build/queue_spsc_atomic_benchmark
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <thread>
+
+#include "etl/queue_spsc_atomic.h"
+
+namespace
+{
+  typedef etl::queue_spsc_atomic<uint32_t, 1024> Queue;
+
+  static Queue queue;
+
+#if ETL_HAS_FUTEX
+  typedef etl::queue_spsc_atomic_blocking<uint32_t, 1024> BlockingQueue;
+
+  static BlockingQueue blocking_queue;
+#endif
+
+  static const uint32_t Items = 20000000UL;
+
+  //***************************************************************************
+  struct Timer
+  {
+    Timer()
+      : start(std::chrono::steady_clock::now())
+    {
+    }
+
+    double seconds() const
+    {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::chrono::steady_clock::time_point start;
+  };
+
+  //***************************************************************************
+  // Returns millions of items per second.
+  //***************************************************************************
+  double run_single()
+  {
+    Timer timer;
+
+    std::thread producer([]()
+    {
+      uint32_t next = 0U;
+
+      while (next < Items)
+      {
+        if (queue.push(next))
+        {
+          ++next;
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    uint32_t expected = 0U;
+    uint32_t value;
+
+    while (expected < Items)
+    {
+      if (queue.pop(value))
+      {
+        if (value != expected)
+        {
+          printf("Out of order: %u != %u\n", unsigned(value), unsigned(expected));
+        }
+
+        ++expected;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    producer.join();
+
+    return Items / timer.seconds() / 1.0e6;
+  }
+
+  //***************************************************************************
+  // Returns millions of items per second.
+  //***************************************************************************
+  double run_batch(size_t batch)
+  {
+    Timer timer;
+
+    std::thread producer([batch]()
+    {
+      uint32_t values[256];
+      uint32_t next = 0U;
+
+      while (next < Items)
+      {
+        size_t count = ((Items - next) < batch) ? (Items - next) : batch;
+
+        for (size_t i = 0UL; i < count; ++i)
+        {
+          values[i] = next + uint32_t(i);
+        }
+
+        size_t pushed = queue.push_n(values, Queue::size_type(count));
+
+        if (pushed == 0UL)
+        {
+          std::this_thread::yield();
+        }
+
+        next += uint32_t(pushed);
+      }
+    });
+
+    uint32_t values[256];
+    uint32_t expected = 0U;
+
+    while (expected < Items)
+    {
+      size_t popped = queue.pop_n(values, Queue::size_type(batch));
+
+      if (popped == 0UL)
+      {
+        std::this_thread::yield();
+      }
+
+      for (size_t i = 0UL; i < popped; ++i)
+      {
+        if (values[i] != expected)
+        {
+          printf("Out of order: %u != %u\n", unsigned(values[i]), unsigned(expected));
+        }
+
+        ++expected;
+      }
+    }
+
+    producer.join();
+
+    return Items / timer.seconds() / 1.0e6;
+  }
+
+#if ETL_HAS_FUTEX
+  //***************************************************************************
+  // Returns millions of items per second.
+  //***************************************************************************
+  double run_blocking()
+  {
+    Timer timer;
+
+    std::thread producer([]()
+    {
+      uint32_t next = 0U;
+
+      while (next < Items)
+      {
+        if (blocking_queue.push(next))
+        {
+          ++next;
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    uint32_t expected = 0U;
+    uint32_t value;
+
+    while (expected < Items)
+    {
+      blocking_queue.pop_wait(value);
+
+      if (value != expected)
+      {
+        printf("Out of order: %u != %u\n", unsigned(value), unsigned(expected));
+      }
+
+      ++expected;
+    }
+
+    producer.join();
+
+    return Items / timer.seconds() / 1.0e6;
+  }
+#endif
+}
+
+//*****************************************************************************
+int main()
+{
+  printf("Millions of items per second through etl::queue_spsc_atomic<uint32_t, 1024>\n");
+
+  printf("push/pop          %7.1f\n", run_single());
+
+#if ETL_HAS_FUTEX
+  printf("push/pop_wait     %7.1f\n", run_blocking());
+#endif
+
+  const size_t batches[] = { 8UL, 32UL, 128UL, 256UL };
+
+  for (size_t i = 0UL; i < (sizeof(batches) / sizeof(batches[0])); ++i)
+  {
+    printf("push_n/pop_n %4zu %7.1f\n", batches[i], run_batch(batches[i]));
+    fflush(stdout);
+  }
+
+  return 0;
+}
@@ -0,0 +1,176 @@
+//*****************************************************************************
+// Sort benchmark.
+// Compares etl::pdq_sort, etl::radix_sort (8 and 11 bit passes),
+// etl::shell_sort and std::sort on random, sorted and sawtooth inputs, for
+// plain integers and for CAN log style records keyed on the timestamp.
+//
+// Build:
+//   cmake -S . -B build && cmake --build build && ./build/sort_benchmark
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "etl/algorithm.h"
+
+namespace
+{
+  //***************************************************************************
+  struct Record
+  {
+    uint64_t timestamp;
+    uint32_t id;
+    uint8_t  dlc;
+    uint8_t  data[8];
+
+    friend bool operator <(const Record& lhs, const Record& rhs)
+    {
+      return lhs.timestamp < rhs.timestamp;
+    }
+  };
+
+  enum Pattern
+  {
+    Random,
+    Sorted,
+    Sawtooth
+  };
+
+  const char* pattern_name(Pattern pattern)
+  {
+    switch (pattern)
+    {
+      case Random: return "random";
+      case Sorted: return "sorted";
+      default:     return "sawtooth";
+    }
+  }
+
+  //***************************************************************************
+  uint64_t key_for(Pattern pattern, size_t i, std::mt19937_64& rng)
+  {
+    switch (pattern)
+    {
+      case Random: return rng();
+      case Sorted: return i;
+      default:     return i % 256U;
+    }
+  }
+
+  void fill(std::vector<int>& data, Pattern pattern, std::mt19937_64& rng)
+  {
+    for (size_t i = 0U; i < data.size(); ++i)
+    {
+      data[i] = static_cast<int>(key_for(pattern, i, rng));
+    }
+  }
+
+  void fill(std::vector<Record>& data, Pattern pattern, std::mt19937_64& rng)
+  {
+    for (size_t i = 0U; i < data.size(); ++i)
+    {
+      data[i].timestamp = key_for(pattern, i, rng);
+      data[i].id        = static_cast<uint32_t>(i);
+      data[i].dlc       = 8U;
+    }
+  }
+
+  //***************************************************************************
+  // Radix sorts. The scratch buffer is kept between runs so that only the
+  // sort itself is timed.
+  //***************************************************************************
+  template <size_t Radix_Bits>
+  void radix(std::vector<int>& data)
+  {
+    static std::vector<int> buffer;
+    buffer.resize(data.size());
+
+    etl::radix_sort<Radix_Bits>(data.begin(), data.end(), buffer.begin());
+  }
+
+  template <size_t Radix_Bits>
+  void radix(std::vector<Record>& data)
+  {
+    static std::vector<Record> buffer;
+    buffer.resize(data.size());
+
+    etl::radix_sort<Radix_Bits>(data.begin(), data.end(), buffer.begin(), [](const Record& r) { return r.timestamp; });
+  }
+
+  //***************************************************************************
+  // Returns the best time in microseconds over a number of runs.
+  //***************************************************************************
+  template <typename T, typename TSort>
+  double time_sort(const std::vector<T>& input, TSort sorter, int runs)
+  {
+    double best = 1e30;
+
+    for (int r = 0; r < runs; ++r)
+    {
+      std::vector<T> data(input);
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      sorter(data);
+      std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+      if (!std::is_sorted(data.begin(), data.end()))
+      {
+        printf("ERROR: output not sorted\n");
+      }
+
+      double us = std::chrono::duration<double, std::micro>(stop - start).count();
+      best = std::min(best, us);
+    }
+
+    return best;
+  }
+
+  //***************************************************************************
+  template <typename T>
+  void run(const char* type_name, size_t size, Pattern pattern, std::mt19937_64& rng)
+  {
+    std::vector<T> input(size);
+    fill(input, pattern, rng);
+
+    // shell_sort is too slow for many repeats at the larger sizes.
+    const int runs       = (size > 4000U) ? 5 : 20;
+    const int shell_runs = (size > 4000U) ? 1 : 5;
+
+    double pdq     = time_sort(input, [](std::vector<T>& d) { etl::pdq_sort(d.begin(), d.end()); }, runs);
+    double radix8  = time_sort(input, [](std::vector<T>& d) { radix<8>(d); }, runs);
+    double radix11 = time_sort(input, [](std::vector<T>& d) { radix<11>(d); }, runs);
+    double shell   = time_sort(input, [](std::vector<T>& d) { etl::shell_sort(d.begin(), d.end()); }, shell_runs);
+    double stdsort = time_sort(input, [](std::vector<T>& d) { std::sort(d.begin(), d.end()); }, runs);
+
+    printf("%-8s %8zu %-9s %12.1f %12.1f %12.1f %13.1f %12.1f\n",
+           type_name, size, pattern_name(pattern), pdq, radix8, radix11, shell, stdsort);
+    fflush(stdout);
+  }
+}
+
+//*****************************************************************************
+int main()
+{
+  std::mt19937_64 rng(12345U);
+
+  const size_t  sizes[]    = { 1000U, 4000U, 16000U };
+  const Pattern patterns[] = { Random, Sorted, Sawtooth };
+
+  printf("%-8s %8s %-9s %12s %12s %12s %13s %12s\n", "type", "size", "input", "pdq_sort us", "radix8 us", "radix11 us", "shell_sort us", "std::sort us");
+
+  for (size_t s = 0U; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    for (size_t p = 0U; p < sizeof(patterns) / sizeof(patterns[0]); ++p)
+    {
+      run<int>("int", sizes[s], patterns[p], rng);
+      run<Record>("record", sizes[s], patterns[p], rng);
+    }
+  }
+
+  return 0;
+}
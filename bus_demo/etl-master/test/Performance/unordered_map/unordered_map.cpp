@@ -0,0 +1,156 @@
+//*****************************************************************************
+// Hash map benchmark.
+// Compares std::unordered_map, etl::unordered_map and etl::flat_hash_map for
+// inserting, finding (hits and misses) and erasing uint64_t keys, with a
+// cache resident map and with a map that is much larger than the cache.
+//
+// Build:
+//   cmake -S . -B build && cmake --build build && ./build/unordered_map_benchmark
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "etl/unordered_map.h"
+#include "etl/flat_hash_map.h"
+
+namespace
+{
+  //***************************************************************************
+  struct Timer
+  {
+    Timer()
+      : start(std::chrono::steady_clock::now())
+    {
+    }
+
+    double ms() const
+    {
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::chrono::steady_clock::time_point start;
+  };
+
+  struct Result
+  {
+    double insert;
+    double find_hit;
+    double find_miss;
+    double erase;
+  };
+
+  //***************************************************************************
+  // Runs each phase over the same keys. Returns the total time per phase.
+  //***************************************************************************
+  template <typename TMap>
+  Result run(TMap& map, const std::vector<uint64_t>& keys, const std::vector<uint64_t>& misses, size_t iterations)
+  {
+    Result result = { 0.0, 0.0, 0.0, 0.0 };
+    size_t found  = 0U;
+
+    for (size_t i = 0UL; i < iterations; ++i)
+    {
+      Timer insert_timer;
+      for (size_t j = 0UL; j < keys.size(); ++j)
+      {
+        map.insert(std::make_pair(keys[j], uint16_t(j)));
+      }
+      result.insert += insert_timer.ms();
+
+      Timer hit_timer;
+      for (size_t j = 0UL; j < keys.size(); ++j)
+      {
+        found += map.count(keys[j]);
+      }
+      result.find_hit += hit_timer.ms();
+
+      Timer miss_timer;
+      for (size_t j = 0UL; j < misses.size(); ++j)
+      {
+        found += map.count(misses[j]);
+      }
+      result.find_miss += miss_timer.ms();
+
+      Timer erase_timer;
+      for (size_t j = 0UL; j < keys.size(); ++j)
+      {
+        map.erase(keys[j]);
+      }
+      result.erase += erase_timer.ms();
+    }
+
+    if (found != (keys.size() * iterations))
+    {
+      printf("ERROR: found %zu\n", found);
+    }
+
+    return result;
+  }
+
+  //***************************************************************************
+  void print(const char* name, const Result& result)
+  {
+    printf("%-20s %10.1f %10.1f %10.1f %10.1f\n", name, result.insert, result.find_hit, result.find_miss, result.erase);
+    fflush(stdout);
+  }
+
+  //***************************************************************************
+  template <size_t Size>
+  void run_all(const char* pattern, const std::vector<uint64_t>& keys, const std::vector<uint64_t>& misses, size_t iterations)
+  {
+    // The ETL maps are too large for the stack.
+    static std::unordered_map<uint64_t, uint16_t>      stdmap;
+    static etl::unordered_map<uint64_t, uint16_t, Size> etlmap;
+    static etl::flat_hash_map<uint64_t, uint16_t, Size> flatmap;
+
+    printf("\n%s keys, %zu x %zu\n", pattern, iterations, keys.size());
+    printf("%-20s %10s %10s %10s %10s\n", "ms", "insert", "find hit", "find miss", "erase");
+
+    print("std::unordered_map", run(stdmap, keys, misses, iterations));
+    print("etl::unordered_map", run(etlmap, keys, misses, iterations));
+    print("etl::flat_hash_map", run(flatmap, keys, misses, iterations));
+  }
+
+  //***************************************************************************
+  template <size_t Size>
+  void benchmark(size_t iterations)
+  {
+    std::vector<uint64_t> keys(Size);
+    std::vector<uint64_t> misses(Size);
+
+    // Sequential keys, as in the original benchmark.
+    for (size_t i = 0UL; i < Size; ++i)
+    {
+      keys[i]   = i;
+      misses[i] = i + Size;
+    }
+
+    run_all<Size>("Sequential", keys, misses, iterations);
+
+    // Random keys.
+    std::mt19937_64 rng(12345U);
+
+    for (size_t i = 0UL; i < Size; ++i)
+    {
+      keys[i]   = rng() | 1U;
+      misses[i] = rng() & ~uint64_t(1U);
+    }
+
+    run_all<Size>("Random", keys, misses, iterations);
+  }
+}
+
+//*****************************************************************************
+int main()
+{
+  benchmark<10000UL>(400UL);
+  benchmark<1000000UL>(4UL);
+
+  return 0;
+}
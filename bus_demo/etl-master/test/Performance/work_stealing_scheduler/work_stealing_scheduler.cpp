@@ -0,0 +1,244 @@
+//*****************************************************************************
+// Work stealing scheduler benchmark.
+// Runs the same set of tasks on an etl::scheduler and on an
+// etl::work_stealing_scheduler with 1 to 8 workers. Every task starts on
+// worker 0, so the other workers only get work by stealing it.
+// Reports the run time and the utilisation of each worker.
+// Run on a machine with several cores for meaningful results.
+//
+// Build:
+//   cmake -S . -B build && cmake --build build && ./build/work_stealing_scheduler_benchmark
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "etl/scheduler.h"
+#include "etl/work_stealing_scheduler.h"
+
+namespace
+{
+  static const size_t   Tasks       = 32U;
+  static const uint32_t WorkPerTask = 2000U;
+  static const uint32_t SpinPerWork = 2000U;
+
+  std::atomic<uint32_t> total_done(0U);
+
+  //***************************************************************************
+  struct Timer
+  {
+    Timer()
+      : start(std::chrono::steady_clock::now())
+    {
+    }
+
+    double seconds() const
+    {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::chrono::steady_clock::time_point start;
+  };
+
+  //***************************************************************************
+  uint32_t Clock()
+  {
+    return uint32_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  //***************************************************************************
+  class Task : public etl::task
+  {
+  public:
+
+    Task()
+      : task(0)
+      , remaining(0U)
+    {
+    }
+
+    void reset()
+    {
+      remaining = WorkPerTask;
+    }
+
+    uint32_t task_request_work() const
+    {
+      return remaining;
+    }
+
+    void task_process_work()
+    {
+      volatile uint32_t x = 0U;
+
+      for (uint32_t i = 0U; i < SpinPerWork; ++i)
+      {
+        x = x + i;
+      }
+
+      --remaining;
+      total_done.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+  private:
+
+    uint32_t remaining;
+  };
+
+  Task tasks[Tasks];
+
+  //***************************************************************************
+  template <typename TScheduler>
+  struct Control
+  {
+    Control(TScheduler& scheduler_)
+      : idle_callback(*this, &Control::IdleCallback)
+      , scheduler(scheduler_)
+    {
+    }
+
+    void IdleCallback(size_t)
+    {
+      if (total_done.load(std::memory_order_relaxed) == (Tasks * WorkPerTask))
+      {
+        scheduler.exit_scheduler();
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    etl::function<Control, size_t> idle_callback;
+    TScheduler& scheduler;
+  };
+
+  //***************************************************************************
+  void reset()
+  {
+    total_done.store(0U);
+
+    for (size_t i = 0UL; i < Tasks; ++i)
+    {
+      tasks[i].reset();
+    }
+  }
+
+  //***************************************************************************
+  struct SingleControl
+  {
+    SingleControl(etl::ischeduler& scheduler_)
+      : idle_callback(*this, &SingleControl::IdleCallback)
+      , scheduler(scheduler_)
+    {
+    }
+
+    void IdleCallback()
+    {
+      scheduler.exit_scheduler();
+    }
+
+    etl::function<SingleControl, void> idle_callback;
+    etl::ischeduler& scheduler;
+  };
+
+  //***************************************************************************
+  double run_single()
+  {
+    static etl::scheduler<etl::scheduler_policy_sequential_single, Tasks> s;
+
+    reset();
+
+    SingleControl control(s);
+    s.set_idle_callback(control.idle_callback);
+
+    for (size_t i = 0UL; i < Tasks; ++i)
+    {
+      s.add_task(tasks[i]);
+    }
+
+    Timer timer;
+    s.start();
+
+    return timer.seconds();
+  }
+
+  //***************************************************************************
+  template <size_t Workers>
+  double run_stealing()
+  {
+    typedef etl::work_stealing_scheduler<etl::scheduler_policy_sequential_single, Workers, Tasks> Scheduler;
+
+    static Scheduler s;
+
+    reset();
+
+    Control<Scheduler> control(s);
+    s.set_idle_callback(control.idle_callback);
+    s.set_clock(Clock);
+
+    for (size_t i = 0UL; i < Tasks; ++i)
+    {
+      s.add_task(tasks[i], 0U);
+    }
+
+    std::vector<std::thread> threads;
+
+    Timer timer;
+
+    for (size_t w = 0UL; w < Workers; ++w)
+    {
+      threads.push_back(std::thread([w]()
+      {
+        s.start(w);
+      }));
+    }
+
+    for (size_t i = 0UL; i < threads.size(); ++i)
+    {
+      threads[i].join();
+    }
+
+    double seconds = timer.seconds();
+
+    printf("%zu workers %8.3f s  utilisation %%:", Workers, seconds);
+
+    for (size_t w = 0UL; w < Workers; ++w)
+    {
+      etl::scheduler_worker_statistics statistics = s.get_statistics(w);
+      printf(" %3u", unsigned(statistics.get_utilisation()));
+    }
+
+    printf("  stolen:");
+
+    for (size_t w = 0UL; w < Workers; ++w)
+    {
+      printf(" %u", unsigned(s.get_statistics(w).tasks_stolen));
+    }
+
+    printf("\n");
+    fflush(stdout);
+
+    return seconds;
+  }
+}
+
+//*****************************************************************************
+int main()
+{
+  printf("%zu tasks of %u units, all starting on worker 0\n", Tasks, unsigned(WorkPerTask));
+  printf("etl::scheduler %8.3f s\n", run_single());
+  fflush(stdout);
+
+  run_stealing<1>();
+  run_stealing<2>();
+  run_stealing<4>();
+  run_stealing<8>();
+
+  return 0;
+}
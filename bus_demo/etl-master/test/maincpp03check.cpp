@@ -40,6 +40,8 @@ SOFTWARE.
 #include "etl/bitset.h"
 #include "etl/bit_stream.h"
 #include "etl/bloom_filter.h"
+#include "etl/btree_map.h"
+#include "etl/btree_set.h"
 #include "etl/callback.h"
 #include "etl/callback_service.h"
 #include "etl/callback_timer.h"
@@ -70,6 +72,7 @@ SOFTWARE.
 #include "etl/factorial.h"
 #include "etl/fibonacci.h"
 #include "etl/fixed_iterator.h"
+#include "etl/flat_hash_map.h"
 #include "etl/flat_map.h"
 #include "etl/flat_multimap.h"
 #include "etl/flat_multiset.h"
@@ -80,6 +83,7 @@ SOFTWARE.
 #include "etl/fsm.h"
 #include "etl/function.h"
 #include "etl/functional.h"
+#include "etl/futex.h"
 #include "etl/hash.h"
 #include "etl/ihash.h"
 #include "etl/instance_count.h"
@@ -123,6 +127,7 @@ SOFTWARE.
 #include "etl/power.h"
 #include "etl/priority_queue.h"
 #include "etl/queue.h"
+#include "etl/queue_mpmc_atomic.h"
 #include "etl/queue_mpmc_mutex.h"
 #include "etl/queue_spsc_atomic.h"
 #include "etl/queue_spsc_isr.h"
@@ -161,6 +166,8 @@ SOFTWARE.
 #include "etl/vector.h"
 #include "etl/version.h"
 #include "etl/visitor.h"
+#include "etl/work_stealing_deque.h"
+#include "etl/work_stealing_scheduler.h"
 #include "etl/wstring.h"
 
 int main()
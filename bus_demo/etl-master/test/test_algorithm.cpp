@@ -2170,6 +2170,312 @@ namespace
       CHECK(is_same);
     }
 
+    //*************************************************************************
+    TEST(pdq_sort_default)
+    {
+      // Sizes either side of the insertion sort and ninther thresholds.
+      const size_t sizes[] = { 0, 1, 2, 3, 23, 24, 25, 127, 128, 129, 1000, 5000 };
+
+      for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+      {
+        std::vector<int> data(sizes[s], 0);
+        std::iota(data.begin(), data.end(), 1);
+
+        for (int i = 0; i < 10; ++i)
+        {
+          std::shuffle(data.begin(), data.end(), urng);
+
+          std::vector<int> data1 = data;
+          std::vector<int> data2 = data;
+
+          std::sort(data1.begin(), data1.end());
+          etl::pdq_sort(data2.begin(), data2.end());
+
+          bool is_same = std::equal(data1.begin(), data1.end(), data2.begin());
+          CHECK(is_same);
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST(pdq_sort_greater)
+    {
+      std::vector<int> data(1000, 0);
+      std::iota(data.begin(), data.end(), 1);
+
+      for (int i = 0; i < 10; ++i)
+      {
+        std::shuffle(data.begin(), data.end(), urng);
+
+        std::vector<int> data1 = data;
+        std::vector<int> data2 = data;
+
+        std::sort(data1.begin(), data1.end(), std::greater<int>());
+        etl::pdq_sort(data2.begin(), data2.end(), std::greater<int>());
+
+        bool is_same = std::equal(data1.begin(), data1.end(), data2.begin());
+        CHECK(is_same);
+      }
+    }
+
+    //*************************************************************************
+    TEST(pdq_sort_patterns)
+    {
+      const int size = 10000;
+
+      std::vector<int> sorted(size);
+      std::vector<int> reversed(size);
+      std::vector<int> sawtooth(size);
+      std::vector<int> organ_pipe(size);
+      std::vector<int> few_unique(size);
+      std::vector<int> all_equal(size, 42);
+
+      for (int i = 0; i < size; ++i)
+      {
+        sorted[i]     = i;
+        reversed[i]   = size - i;
+        sawtooth[i]   = i % 64;
+        organ_pipe[i] = (i < size / 2) ? i : size - i;
+        few_unique[i] = static_cast<int>(urng() % 4U);
+      }
+
+      const std::vector<int>* inputs[] = { &sorted, &reversed, &sawtooth, &organ_pipe, &few_unique, &all_equal };
+
+      for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i)
+      {
+        std::vector<int> data1 = *inputs[i];
+        std::vector<int> data2 = *inputs[i];
+
+        std::sort(data1.begin(), data1.end());
+        etl::pdq_sort(data2.begin(), data2.end());
+
+        bool is_same = std::equal(data1.begin(), data1.end(), data2.begin());
+        CHECK(is_same);
+      }
+    }
+
+    //*************************************************************************
+    TEST(pdq_sort_non_default_constructible)
+    {
+      std::vector<NDC> initial_data;
+
+      for (int i = 0; i < 200; ++i)
+      {
+        initial_data.push_back(NDC(static_cast<int>(urng() % 50U), i));
+      }
+
+      std::vector<NDC> data1(initial_data);
+      std::vector<NDC> data2(initial_data);
+
+      std::stable_sort(data1.begin(), data1.end());
+      etl::pdq_sort(data2.begin(), data2.end());
+
+      // Not stable, so only compare the keys.
+      bool is_same = true;
+
+      for (size_t i = 0; i < data1.size(); ++i)
+      {
+        is_same = is_same && !(data1[i] < data2[i]) && !(data2[i] < data1[i]);
+      }
+
+      CHECK(is_same);
+    }
+
+    //*************************************************************************
+    TEST(radix_sort_unsigned)
+    {
+      std::vector<uint32_t> initial_data;
+
+      for (int i = 0; i < 1000; ++i)
+      {
+        initial_data.push_back(static_cast<uint32_t>(urng()));
+      }
+
+      initial_data.push_back(0U);
+      initial_data.push_back(0xFFFFFFFFUL);
+
+      std::vector<uint32_t> buffer(initial_data.size());
+
+      std::vector<uint32_t> data1(initial_data);
+      std::vector<uint32_t> data2(initial_data);
+      std::vector<uint32_t> data3(initial_data);
+
+      std::sort(data1.begin(), data1.end());
+      etl::radix_sort(data2.begin(), data2.end(), buffer.begin());
+      etl::radix_sort<11>(data3.begin(), data3.end(), buffer.begin());
+
+      CHECK(data1 == data2);
+      CHECK(data1 == data3);
+    }
+
+    //*************************************************************************
+    TEST(radix_sort_narrow_and_wide)
+    {
+      std::vector<uint8_t>  data8;
+      std::vector<uint64_t> data64;
+
+      for (int i = 0; i < 500; ++i)
+      {
+        data8.push_back(static_cast<uint8_t>(urng()));
+        data64.push_back((uint64_t(urng()) << 32) | urng());
+      }
+
+      std::vector<uint8_t>  compare8(data8);
+      std::vector<uint64_t> compare64(data64);
+      std::vector<uint8_t>  buffer8(data8.size());
+      std::vector<uint64_t> buffer64(data64.size());
+
+      std::sort(compare8.begin(), compare8.end());
+      std::sort(compare64.begin(), compare64.end());
+      etl::radix_sort(data8.begin(), data8.end(), buffer8.begin());
+      etl::radix_sort<11>(data64.begin(), data64.end(), buffer64.begin());
+
+      CHECK(compare8 == data8);
+      CHECK(compare64 == data64);
+    }
+
+    //*************************************************************************
+    TEST(radix_sort_signed)
+    {
+      std::vector<int16_t> data16;
+      std::vector<int32_t> data32;
+      std::vector<int64_t> data64;
+
+      for (int i = 0; i < 500; ++i)
+      {
+        data16.push_back(static_cast<int16_t>(urng()));
+        data32.push_back(static_cast<int32_t>(urng()));
+        data64.push_back(static_cast<int64_t>((uint64_t(urng()) << 32) | urng()));
+      }
+
+      data32.push_back(std::numeric_limits<int32_t>::min());
+      data32.push_back(std::numeric_limits<int32_t>::max());
+      data32.push_back(-1);
+      data32.push_back(0);
+
+      std::vector<int16_t> compare16(data16);
+      std::vector<int32_t> compare32(data32);
+      std::vector<int64_t> compare64(data64);
+      std::vector<int16_t> buffer16(data16.size());
+      std::vector<int32_t> buffer32(data32.size());
+      std::vector<int64_t> buffer64(data64.size());
+
+      std::sort(compare16.begin(), compare16.end());
+      std::sort(compare32.begin(), compare32.end());
+      std::sort(compare64.begin(), compare64.end());
+      etl::radix_sort(data16.begin(), data16.end(), buffer16.begin());
+      etl::radix_sort<11>(data32.begin(), data32.end(), buffer32.begin());
+      etl::radix_sort(data64.begin(), data64.end(), buffer64.begin());
+
+      CHECK(compare16 == data16);
+      CHECK(compare32 == data32);
+      CHECK(compare64 == data64);
+    }
+
+    //*************************************************************************
+    TEST(radix_sort_floating_point)
+    {
+      std::uniform_real_distribution<float>  distf(-1000.0f, 1000.0f);
+      std::uniform_real_distribution<double> distd(-1.0e9, 1.0e9);
+
+      std::vector<float>  dataf;
+      std::vector<double> datad;
+
+      for (int i = 0; i < 500; ++i)
+      {
+        dataf.push_back(distf(urng));
+        datad.push_back(distd(urng));
+      }
+
+      dataf.push_back(0.0f);
+      dataf.push_back(std::numeric_limits<float>::lowest());
+      dataf.push_back(std::numeric_limits<float>::max());
+      dataf.push_back(-std::numeric_limits<float>::infinity());
+      dataf.push_back(std::numeric_limits<float>::infinity());
+      datad.push_back(-std::numeric_limits<double>::denorm_min());
+      datad.push_back(std::numeric_limits<double>::denorm_min());
+
+      std::vector<float>  comparef(dataf);
+      std::vector<double> compared(datad);
+      std::vector<float>  bufferf(dataf.size());
+      std::vector<double> bufferd(datad.size());
+
+      std::sort(comparef.begin(), comparef.end());
+      std::sort(compared.begin(), compared.end());
+      etl::radix_sort(dataf.begin(), dataf.end(), bufferf.begin());
+      etl::radix_sort<11>(datad.begin(), datad.end(), bufferd.begin());
+
+      CHECK(comparef == dataf);
+      CHECK(compared == datad);
+    }
+
+    //*************************************************************************
+    TEST(radix_sort_key_extractor_is_stable)
+    {
+      struct Frame
+      {
+        uint32_t id;
+        int      sequence;
+      };
+
+      std::vector<Frame> data;
+
+      for (int i = 0; i < 1000; ++i)
+      {
+        Frame frame = { static_cast<uint32_t>(urng() % 64U) << 18U, i };
+        data.push_back(frame);
+      }
+
+      std::vector<Frame> compare(data);
+      std::vector<Frame> buffer(data.size());
+
+      std::stable_sort(compare.begin(), compare.end(), [](const Frame& lhs, const Frame& rhs) { return lhs.id < rhs.id; });
+      etl::radix_sort(data.begin(), data.end(), buffer.begin(), [](const Frame& frame) { return frame.id; });
+
+      bool is_same = true;
+
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        is_same = is_same && (data[i].id == compare[i].id) && (data[i].sequence == compare[i].sequence);
+      }
+
+      CHECK(is_same);
+    }
+
+    //*************************************************************************
+    TEST(radix_sort_uniform_digits)
+    {
+      // Only one digit varies, so only one pass is made and the result is copied back from the buffer.
+      std::vector<uint32_t> data;
+
+      for (uint32_t i = 0U; i < 256U; ++i)
+      {
+        data.push_back(0x12340000UL | ((255U - i) << 8U));
+      }
+
+      std::vector<uint32_t> compare(data);
+      std::vector<uint32_t> buffer(data.size());
+
+      std::sort(compare.begin(), compare.end());
+      etl::radix_sort(data.begin(), data.end(), buffer.begin());
+
+      CHECK(compare == data);
+
+      // All equal, no passes.
+      std::vector<uint32_t> equal(100U, 0xDEADBEEFUL);
+      std::vector<uint32_t> expected(equal);
+
+      etl::radix_sort(equal.begin(), equal.end(), buffer.begin());
+
+      CHECK(expected == equal);
+
+      // Empty and single element ranges.
+      etl::radix_sort(data.begin(), data.begin(), buffer.begin());
+      etl::radix_sort(data.begin(), data.begin() + 1, buffer.begin());
+
+      CHECK_EQUAL(compare[0], data[0]);
+    }
+
     //*************************************************************************
     TEST(multimax)
     {
@@ -332,6 +332,89 @@ namespace
       CHECK(stream.empty());
     }
 
+#if ETL_HAS_FUTEX
+    //*************************************************************************
+    TEST(test_blocking_read_reserve_wait_for_timeout)
+    {
+      etl::bip_buffer_spsc_atomic_blocking<int, 8> stream;
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      CHECK_EQUAL(0U, stream.read_reserve_wait_for(20U).size());
+      CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(15));
+
+      etl::span<int> writer = stream.write_reserve(2U);
+      writer[0] = 1;
+      writer[1] = 2;
+      stream.write_commit(writer);
+
+      etl::span<int> reader = stream.read_reserve_wait_for(20U);
+      CHECK_EQUAL(2U, reader.size());
+      CHECK_EQUAL(1, reader[0]);
+      CHECK_EQUAL(2, reader[1]);
+      stream.read_commit(reader);
+    }
+
+    //*************************************************************************
+    TEST(test_blocking_read_reserve_wait_threads)
+    {
+      static etl::bip_buffer_spsc_atomic_blocking<int, 32> stream;
+
+      const int Length = 100000;
+
+      // Pauses now and then so that the reader empties the buffer and blocks.
+      std::thread writer_thread([Length]()
+      {
+        int next = 0;
+
+        while (next < Length)
+        {
+          if ((next % 1000) == 0)
+          {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+          }
+
+          size_t wanted = size_t(Length - next) < 7U ? size_t(Length - next) : 7U;
+
+          etl::span<int> writer = stream.write_reserve_optimal(1U);
+
+          if (writer.size() > wanted)
+          {
+            writer = writer.first(wanted);
+          }
+
+          for (size_t i = 0UL; i < writer.size(); ++i)
+          {
+            writer[i] = next++;
+          }
+
+          stream.write_commit(writer);
+        }
+      });
+
+      std::vector<int> received;
+      received.reserve(Length);
+
+      while (received.size() < size_t(Length))
+      {
+        etl::span<int> reader = stream.read_reserve_wait(5U);
+        CHECK(reader.size() != 0U);
+        received.insert(received.end(), reader.begin(), reader.end());
+        stream.read_commit(reader);
+      }
+
+      writer_thread.join();
+
+      bool in_order = true;
+
+      for (int i = 0; i < Length; ++i)
+      {
+        in_order = in_order && (received[i] == i);
+      }
+
+      CHECK(in_order);
+    }
+#endif
+
     //*************************************************************************
 #if REALTIME_TEST && defined(ETL_COMPILER_MICROSOFT)
     #if defined(ETL_TARGET_OS_WINDOWS) // Only Windows priority is currently supported
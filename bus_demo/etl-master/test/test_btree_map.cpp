@@ -0,0 +1,654 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "unit_test_framework.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "data.h"
+
+#include "etl/btree_map.h"
+
+namespace
+{
+  //*************************************************************************
+  // Counts the live instances, to check that erase, clear and the moves
+  // between nodes destroy what they construct.
+  struct Counted
+  {
+    Counted()
+      : value(0)
+    {
+      ++instances;
+    }
+
+    explicit Counted(int value_)
+      : value(value_)
+    {
+      ++instances;
+    }
+
+    Counted(const Counted& other)
+      : value(other.value)
+    {
+      ++instances;
+    }
+
+    Counted& operator =(const Counted& other)
+    {
+      value = other.value;
+      return *this;
+    }
+
+    ~Counted()
+    {
+      --instances;
+    }
+
+    int value;
+
+    static int instances;
+  };
+
+  int Counted::instances = 0;
+
+  //*************************************************************************
+  // A large key gives the smallest nodes, so that small maps are several levels deep.
+  struct LargeKey
+  {
+    LargeKey()
+      : value(0)
+    {
+    }
+
+    LargeKey(int value_)
+      : value(value_)
+    {
+    }
+
+    friend bool operator <(const LargeKey& lhs, const LargeKey& rhs)
+    {
+      return lhs.value < rhs.value;
+    }
+
+    int  value;
+    char padding[60];
+  };
+
+  using NDC = TestDataNDC<std::string>;
+
+  SUITE(test_btree_map)
+  {
+    static const size_t SIZE = 10;
+
+    using Data            = etl::btree_map<std::string, NDC, SIZE>;
+    using IData           = etl::ibtree_map<std::string, NDC>;
+    using DataTransparent = etl::btree_map<std::string, int, SIZE, etl::less<>>;
+    using DataLarge       = etl::btree_map<uint32_t, uint32_t, 5000>;
+    using DataDeep        = etl::btree_map<LargeKey, int, 2000>;
+
+    std::vector<Data::value_type> initial_data =
+    {
+      { "A", NDC("a") }, { "B", NDC("b") }, { "C", NDC("c") }, { "D", NDC("d") }, { "E", NDC("e") },
+      { "F", NDC("f") }, { "G", NDC("g") }, { "H", NDC("h") }, { "I", NDC("i") }, { "J", NDC("j") }
+    };
+
+    //*************************************************************************
+    template <typename TMap, typename TCompare>
+    bool is_equal(const TMap& data, const TCompare& compare)
+    {
+      if (data.size() != compare.size())
+      {
+        return false;
+      }
+
+      typename TCompare::const_iterator itr = compare.begin();
+
+      for (typename TMap::const_iterator i = data.begin(); i != data.end(); ++i, ++itr)
+      {
+        if ((i->first != itr->first) || (i->second != itr->second))
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    //*************************************************************************
+    TEST(test_default_constructor)
+    {
+      Data data;
+
+      CHECK(data.empty());
+      CHECK(!data.full());
+      CHECK_EQUAL(0U, data.size());
+      CHECK_EQUAL(SIZE, data.max_size());
+      CHECK_EQUAL(SIZE, data.capacity());
+      CHECK_EQUAL(SIZE, data.available());
+      CHECK_EQUAL(0U, data.height());
+      CHECK(data.begin() == data.end());
+      CHECK(data.rbegin() == data.rend());
+    }
+
+    //*************************************************************************
+    TEST(test_node_sizes)
+    {
+      // pair<const uint32_t, uint32_t> is 8 bytes, so 32 fit in a 256 byte leaf.
+      CHECK_EQUAL(32U, DataLarge::Leaf_Capacity);
+      CHECK_EQUAL(16U, DataLarge::Leaf_Min);
+
+      // A large key is clamped to the minimum node size.
+      CHECK_EQUAL(4U, DataDeep::Leaf_Capacity);
+      CHECK_EQUAL(4U, DataDeep::Branch_Capacity);
+    }
+
+    //*************************************************************************
+    TEST(test_constructor_range)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      CHECK(data.full());
+      CHECK_EQUAL(SIZE, data.size());
+      CHECK(std::equal(initial_data.begin(), initial_data.end(), data.begin()));
+    }
+
+    //*************************************************************************
+    TEST(test_constructor_initializer_list)
+    {
+      Data data = { { "C", NDC("c") }, { "A", NDC("a") }, { "B", NDC("b") } };
+
+      CHECK_EQUAL(3U, data.size());
+      CHECK(std::equal(initial_data.begin(), initial_data.begin() + 3, data.begin()));
+    }
+
+    //*************************************************************************
+    TEST(test_copy_constructor_and_assignment)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+      Data copy(data);
+
+      CHECK(copy == data);
+
+      Data other;
+      other.insert(std::make_pair(std::string("Z"), NDC("z")));
+      other = data;
+
+      CHECK(other == data);
+
+      IData& idata = other;
+      idata = Data(initial_data.begin(), initial_data.begin() + 2);
+      CHECK_EQUAL(2U, other.size());
+    }
+
+    //*************************************************************************
+    TEST(test_move_constructor)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+      Data moved(std::move(data));
+
+      CHECK_EQUAL(SIZE, moved.size());
+      CHECK(data.empty());
+      CHECK(std::equal(initial_data.begin(), initial_data.end(), moved.begin()));
+
+      Data assigned;
+      assigned = std::move(moved);
+      CHECK_EQUAL(SIZE, assigned.size());
+      CHECK(moved.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_insert_and_find)
+    {
+      Data data;
+
+      for (size_t i = initial_data.size(); i != 0U; --i)
+      {
+        ETL_OR_STD::pair<Data::iterator, bool> result = data.insert(initial_data[i - 1U]);
+        CHECK(result.second);
+        CHECK(result.first->second == initial_data[i - 1U].second);
+      }
+
+      // Duplicates are not inserted.
+      ETL_OR_STD::pair<Data::iterator, bool> result = data.insert(std::make_pair(std::string("C"), NDC("x")));
+      CHECK(!result.second);
+      CHECK(result.first->second == NDC("c"));
+
+      CHECK(data.find("E")->second == NDC("e"));
+      CHECK(data.find("Z") == data.end());
+      CHECK(data.contains("A"));
+      CHECK(!data.contains("Z"));
+      CHECK_EQUAL(1U, data.count("J"));
+      CHECK_EQUAL(0U, data.count("Z"));
+
+      const Data& cdata = data;
+      CHECK(cdata.find("J")->second == NDC("j"));
+    }
+
+    //*************************************************************************
+    TEST(test_insert_full)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      CHECK_THROW(data.insert(std::make_pair(std::string("Z"), NDC("z"))), etl::btree_full);
+
+      // An existing key is still found when full.
+      CHECK(!data.insert(initial_data[0]).second);
+    }
+
+    //*************************************************************************
+    TEST(test_index_operator)
+    {
+      etl::btree_map<int, int, 100> data;
+
+      for (int i = 0; i < 100; ++i)
+      {
+        data[(i * 37) % 100] = i;
+      }
+
+      for (int i = 0; i < 100; ++i)
+      {
+        CHECK_EQUAL(i, data[(i * 37) % 100]);
+      }
+
+      CHECK_EQUAL(100U, data.size());
+      CHECK_THROW(data[1000] = 1, etl::btree_full);
+    }
+
+    //*************************************************************************
+    TEST(test_at)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+      const Data& cdata = data;
+
+      CHECK(data.at("D") == NDC("d"));
+      CHECK(cdata.at("H") == NDC("h"));
+      CHECK_THROW(data.at("Z"), etl::btree_out_of_bounds);
+      CHECK_THROW(cdata.at("Z"), etl::btree_out_of_bounds);
+    }
+
+    //*************************************************************************
+    TEST(test_iteration)
+    {
+      DataLarge data;
+      std::map<uint32_t, uint32_t> compare;
+
+      for (uint32_t i = 0U; i < 5000U; ++i)
+      {
+        const uint32_t key = (i * 7919U) % 5000U;
+        data.insert(std::make_pair(key, i));
+        compare.insert(std::make_pair(key, i));
+      }
+
+      CHECK(data.full());
+      CHECK(data.height() >= 2U);
+      CHECK(is_equal(data, compare));
+
+      // Backwards.
+      CHECK(std::equal(data.rbegin(), data.rend(), compare.rbegin()));
+      CHECK(std::equal(data.crbegin(), data.crend(), compare.rbegin()));
+
+      DataLarge::iterator itr = data.end();
+      --itr;
+      CHECK_EQUAL(4999U, itr->first);
+      itr--;
+      CHECK_EQUAL(4998U, itr->first);
+      itr++;
+      ++itr;
+      CHECK(itr == data.end());
+    }
+
+    //*************************************************************************
+    TEST(test_lower_upper_bound)
+    {
+      DataLarge data;
+
+      for (uint32_t i = 0U; i < 2000U; ++i)
+      {
+        data.insert(std::make_pair(i * 2U, i));
+      }
+
+      for (uint32_t key = 0U; key < 4002U; ++key)
+      {
+        DataLarge::iterator lower = data.lower_bound(key);
+        DataLarge::iterator upper = data.upper_bound(key);
+
+        const uint32_t expected_lower = (key + 1U) & ~1U;
+        const uint32_t expected_upper = (key + 2U) & ~1U;
+
+        if (expected_lower < 4000U)
+        {
+          CHECK_EQUAL(expected_lower, lower->first);
+        }
+        else
+        {
+          CHECK(lower == data.end());
+        }
+
+        if (expected_upper < 4000U)
+        {
+          CHECK_EQUAL(expected_upper, upper->first);
+        }
+        else
+        {
+          CHECK(upper == data.end());
+        }
+      }
+
+      // A range query.
+      const DataLarge& cdata = data;
+      uint32_t sum = 0U;
+
+      for (DataLarge::const_iterator itr = cdata.lower_bound(1001U); itr != cdata.upper_bound(1100U); ++itr)
+      {
+        sum += itr->second;
+      }
+
+      // Keys 1002 to 1100, values 501 to 550.
+      CHECK_EQUAL(((501U + 550U) * 50U) / 2U, sum);
+    }
+
+    //*************************************************************************
+    TEST(test_equal_range)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      ETL_OR_STD::pair<Data::iterator, Data::iterator> range = data.equal_range("B");
+      CHECK(range.first->first == "B");
+      CHECK(range.second->first == "C");
+
+      range = data.equal_range("BB");
+      CHECK(range.first == range.second);
+      CHECK(range.first->first == "C");
+
+      const Data& cdata = data;
+      ETL_OR_STD::pair<Data::const_iterator, Data::const_iterator> crange = cdata.equal_range("J");
+      CHECK(crange.first->first == "J");
+      CHECK(crange.second == cdata.end());
+    }
+
+    //*************************************************************************
+    TEST(test_erase_key)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      CHECK_EQUAL(1U, data.erase("C"));
+      CHECK_EQUAL(0U, data.erase("C"));
+      CHECK_EQUAL(SIZE - 1U, data.size());
+      CHECK(data.find("C") == data.end());
+      CHECK(data.find("D")->second == NDC("d"));
+    }
+
+    //*************************************************************************
+    TEST(test_erase_iterator)
+    {
+      DataLarge data;
+
+      for (uint32_t i = 0U; i < 1000U; ++i)
+      {
+        data.insert(std::make_pair(i, i));
+      }
+
+      // Erase every other element, following the returned iterator.
+      DataLarge::iterator itr = data.begin();
+
+      while (itr != data.end())
+      {
+        itr = data.erase(itr);
+
+        if (itr != data.end())
+        {
+          ++itr;
+        }
+      }
+
+      CHECK_EQUAL(500U, data.size());
+
+      uint32_t expected = 1U;
+      bool     all_odd  = true;
+
+      for (itr = data.begin(); itr != data.end(); ++itr)
+      {
+        all_odd = all_odd && (itr->first == expected);
+        expected += 2U;
+      }
+
+      CHECK(all_odd);
+    }
+
+    //*************************************************************************
+    TEST(test_erase_range)
+    {
+      DataLarge data;
+
+      for (uint32_t i = 0U; i < 1000U; ++i)
+      {
+        data.insert(std::make_pair(i, i));
+      }
+
+      DataLarge::iterator itr = data.erase(data.lower_bound(100U), data.lower_bound(900U));
+
+      CHECK_EQUAL(200U, data.size());
+      CHECK_EQUAL(900U, itr->first);
+
+      itr = data.erase(data.find(950U), data.end());
+
+      CHECK(itr == data.end());
+      CHECK_EQUAL(150U, data.size());
+      CHECK_EQUAL(949U, (--data.end())->first);
+
+      data.erase(data.begin(), data.end());
+      CHECK(data.empty());
+      CHECK_EQUAL(0U, data.height());
+    }
+
+    //*************************************************************************
+    TEST(test_clear)
+    {
+      DataLarge data;
+
+      for (uint32_t i = 0U; i < 5000U; ++i)
+      {
+        data.insert(std::make_pair(i, i));
+      }
+
+      data.clear();
+      CHECK(data.empty());
+      CHECK(data.begin() == data.end());
+
+      // Every node has been returned to the pools.
+      for (uint32_t i = 0U; i < 5000U; ++i)
+      {
+        data.insert(std::make_pair(4999U - i, i));
+      }
+
+      CHECK(data.full());
+    }
+
+    //*************************************************************************
+    TEST(test_values_are_destroyed)
+    {
+      Counted::instances = 0;
+
+      {
+        etl::btree_map<int, Counted, 500> data;
+
+        for (int i = 0; i < 500; ++i)
+        {
+          data.insert(std::make_pair(i, Counted(i)));
+        }
+
+        CHECK_EQUAL(500, Counted::instances);
+
+        for (int i = 0; i < 500; i += 3)
+        {
+          data.erase(i);
+        }
+
+        CHECK_EQUAL(int(data.size()), Counted::instances);
+
+        data.clear();
+        CHECK_EQUAL(0, Counted::instances);
+
+        data[1] = Counted(1);
+        data[2] = Counted(2);
+        CHECK_EQUAL(2, Counted::instances);
+      }
+
+      CHECK_EQUAL(0, Counted::instances);
+    }
+
+    //*************************************************************************
+    TEST(test_random_operations_match_std_map)
+    {
+      std::mt19937 rng(12345U);
+      std::map<uint32_t, uint32_t> compare;
+      DataLarge data;
+
+      for (int i = 0; i < 200000; ++i)
+      {
+        const uint32_t key = rng() % 8000U;
+
+        if ((rng() % 2U) != 0U)
+        {
+          if (!data.full() || data.contains(key))
+          {
+            const bool inserted = data.insert(std::make_pair(key, uint32_t(i))).second;
+            CHECK_EQUAL(compare.insert(std::make_pair(key, uint32_t(i))).second, inserted);
+          }
+        }
+        else
+        {
+          CHECK_EQUAL(compare.erase(key), data.erase(key));
+        }
+      }
+
+      CHECK(is_equal(data, compare));
+    }
+
+    //*************************************************************************
+    TEST(test_random_operations_deep_tree)
+    {
+      std::mt19937 rng(54321U);
+      std::map<int, int> compare;
+      DataDeep data;
+
+      for (int i = 0; i < 100000; ++i)
+      {
+        const int key = int(rng() % 3000U);
+
+        if ((rng() % 2U) != 0U)
+        {
+          if (!data.full() || data.contains(key))
+          {
+            data.insert(std::make_pair(LargeKey(key), i));
+            compare.insert(std::make_pair(key, i));
+          }
+        }
+        else
+        {
+          DataDeep::iterator itr = data.lower_bound(key);
+
+          if (itr != data.end())
+          {
+            compare.erase(compare.lower_bound(key));
+            data.erase(itr);
+          }
+        }
+      }
+
+      CHECK(data.height() >= 4U);
+
+      bool equal = (data.size() == compare.size());
+
+      std::map<int, int>::const_iterator itr = compare.begin();
+
+      for (DataDeep::const_iterator i = data.begin(); equal && (i != data.end()); ++i, ++itr)
+      {
+        equal = (i->first.value == itr->first) && (i->second == itr->second);
+      }
+
+      CHECK(equal);
+
+      // Empty it from the front, which merges leaves and branches on the left.
+      while (!data.empty())
+      {
+        data.erase(data.begin());
+      }
+
+      CHECK_EQUAL(0U, data.height());
+    }
+
+    //*************************************************************************
+    TEST(test_transparent_lookup)
+    {
+      DataTransparent data;
+
+      data["A"] = 1;
+      data["B"] = 2;
+
+      CHECK_EQUAL(1, data.find("A")->second);
+      CHECK_EQUAL(2, data.at("B"));
+      CHECK(data.contains("B"));
+      CHECK_EQUAL(1U, data.count("A"));
+      CHECK_EQUAL(1U, data.erase("A"));
+      CHECK(data.lower_bound("A")->first == "B");
+    }
+
+    //*************************************************************************
+    TEST(test_comparisons)
+    {
+      Data data1(initial_data.begin(), initial_data.end());
+      Data data2(initial_data.begin(), initial_data.end());
+      Data data3(initial_data.begin(), initial_data.begin() + 5);
+
+      CHECK(data1 == data2);
+      CHECK(data1 != data3);
+      CHECK(data3 < data1);
+      CHECK(data1 > data3);
+      CHECK(data3 <= data1);
+      CHECK(data1 >= data3);
+      CHECK(data1 <= data2);
+    }
+
+    //*************************************************************************
+    TEST(test_make_btree_map)
+    {
+      auto data = etl::make_btree_map<int, int>(std::make_pair(3, 30), std::make_pair(1, 10), std::make_pair(2, 20));
+
+      CHECK_EQUAL(3U, data.size());
+      CHECK_EQUAL(10, data.begin()->second);
+      CHECK_EQUAL(30, data.at(3));
+    }
+  };
+}
@@ -0,0 +1,238 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "unit_test_framework.h"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "etl/btree_set.h"
+
+namespace
+{
+  SUITE(test_btree_set)
+  {
+    static const size_t SIZE = 10;
+
+    using Data            = etl::btree_set<std::string, SIZE>;
+    using IData           = etl::ibtree_set<std::string>;
+    using DataTransparent = etl::btree_set<std::string, SIZE, etl::less<>>;
+    using DataLarge       = etl::btree_set<int, 5000>;
+    using DataReversed    = etl::btree_set<int, 1000, etl::greater<int>>;
+
+    std::vector<std::string> initial_data = { "A", "B", "C", "D", "E", "F", "G", "H", "I", "J" };
+
+    //*************************************************************************
+    TEST(test_default_constructor)
+    {
+      Data data;
+
+      CHECK(data.empty());
+      CHECK_EQUAL(0U, data.size());
+      CHECK_EQUAL(SIZE, data.max_size());
+      CHECK(data.begin() == data.end());
+    }
+
+    //*************************************************************************
+    TEST(test_constructor_range_and_initializer_list)
+    {
+      Data data1(initial_data.rbegin(), initial_data.rend());
+      Data data2 = { "C", "A", "B" };
+
+      CHECK(data1.full());
+      CHECK(std::equal(initial_data.begin(), initial_data.end(), data1.begin()));
+      CHECK_EQUAL(3U, data2.size());
+      CHECK(std::equal(initial_data.begin(), initial_data.begin() + 3, data2.begin()));
+    }
+
+    //*************************************************************************
+    TEST(test_copy_and_move)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+      Data copy(data);
+
+      CHECK(copy == data);
+
+      Data moved(std::move(copy));
+      CHECK(moved == data);
+      CHECK(copy.empty());
+
+      Data assigned;
+      assigned = data;
+      CHECK(assigned == data);
+
+      IData& idata = assigned;
+      idata = Data(initial_data.begin(), initial_data.begin() + 2);
+      CHECK_EQUAL(2U, assigned.size());
+    }
+
+    //*************************************************************************
+    TEST(test_insert_find_erase)
+    {
+      Data data;
+
+      CHECK(data.insert("B").second);
+      CHECK(data.insert("A").second);
+      CHECK(!data.insert("B").second);
+      CHECK(*data.find("A") == "A");
+      CHECK(data.find("Z") == data.end());
+      CHECK_EQUAL(1U, data.count("B"));
+      CHECK_EQUAL(1U, data.erase("B"));
+      CHECK_EQUAL(0U, data.erase("B"));
+      CHECK_EQUAL(1U, data.size());
+
+      data.assign(initial_data.begin(), initial_data.end());
+      CHECK_THROW(data.insert("Z"), etl::btree_full);
+    }
+
+    //*************************************************************************
+    TEST(test_bounds_and_ranges)
+    {
+      DataLarge data;
+
+      for (int i = 0; i < 5000; ++i)
+      {
+        data.insert((i * 7919) % 5000);
+      }
+
+      CHECK(data.height() >= 2U);
+      CHECK_EQUAL(100, *data.lower_bound(100));
+      CHECK_EQUAL(101, *data.upper_bound(100));
+      CHECK(data.lower_bound(5000) == data.end());
+
+      ETL_OR_STD::pair<DataLarge::iterator, DataLarge::iterator> range = data.equal_range(42);
+      CHECK_EQUAL(42, *range.first);
+      CHECK_EQUAL(43, *range.second);
+
+      CHECK_EQUAL(1000, std::distance(data.lower_bound(1000), data.lower_bound(2000)));
+
+      data.erase(data.lower_bound(1000), data.lower_bound(2000));
+      CHECK_EQUAL(4000U, data.size());
+      CHECK_EQUAL(2000, *data.lower_bound(1000));
+    }
+
+    //*************************************************************************
+    TEST(test_reverse_ordering)
+    {
+      DataReversed data;
+
+      for (int i = 0; i < 1000; ++i)
+      {
+        data.insert(i);
+      }
+
+      CHECK_EQUAL(999, *data.begin());
+      CHECK_EQUAL(0, *data.rbegin());
+      CHECK_EQUAL(500, *data.lower_bound(500));
+      CHECK_EQUAL(499, *data.upper_bound(500));
+    }
+
+    //*************************************************************************
+    TEST(test_random_operations_match_std_set)
+    {
+      std::mt19937 rng(2468U);
+      std::set<int> compare;
+      DataLarge data;
+
+      for (int i = 0; i < 200000; ++i)
+      {
+        const int key = int(rng() % 9000U);
+
+        switch (rng() % 3U)
+        {
+          case 0:
+          case 1:
+          {
+            if (!data.full() || data.contains(key))
+            {
+              CHECK_EQUAL(compare.insert(key).second, data.insert(key).second);
+            }
+            break;
+          }
+
+          default:
+          {
+            // Erase a short range, which exercises the iterator returned by erase.
+            DataLarge::iterator     first  = data.lower_bound(key);
+            std::set<int>::iterator cfirst = compare.lower_bound(key);
+            DataLarge::iterator     last   = data.lower_bound(key + 5);
+
+            compare.erase(cfirst, compare.lower_bound(key + 5));
+            DataLarge::iterator next = data.erase(first, last);
+
+            CHECK((next == data.end()) || (*next >= key + 5));
+            break;
+          }
+        }
+      }
+
+      CHECK_EQUAL(compare.size(), data.size());
+      CHECK(std::equal(data.begin(), data.end(), compare.begin()));
+      CHECK(std::equal(data.rbegin(), data.rend(), compare.rbegin()));
+    }
+
+    //*************************************************************************
+    TEST(test_transparent_lookup)
+    {
+      DataTransparent data = { "A", "B", "C" };
+
+      CHECK(data.find("B") != data.end());
+      CHECK(data.contains("C"));
+      CHECK_EQUAL(1U, data.erase("A"));
+      CHECK(*data.lower_bound("A") == "B");
+    }
+
+    //*************************************************************************
+    TEST(test_comparisons)
+    {
+      Data data1(initial_data.begin(), initial_data.end());
+      Data data2(initial_data.begin(), initial_data.end());
+      Data data3(initial_data.begin(), initial_data.begin() + 5);
+
+      CHECK(data1 == data2);
+      CHECK(data1 != data3);
+      CHECK(data3 < data1);
+      CHECK(data1 > data3);
+      CHECK(data3 <= data1);
+      CHECK(data1 >= data3);
+    }
+
+    //*************************************************************************
+    TEST(test_make_btree_set)
+    {
+      auto data = etl::make_btree_set<int>(3, 1, 2);
+
+      CHECK_EQUAL(3U, data.size());
+      CHECK_EQUAL(1, *data.begin());
+    }
+  };
+}
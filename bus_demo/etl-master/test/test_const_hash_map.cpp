@@ -0,0 +1,408 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the 'Software'), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "unit_test_framework.h"
+
+#include <map>
+#include <string.h>
+
+#include "etl/const_hash_map.h"
+
+namespace
+{
+  static const size_t Max_Size = 10UL;
+
+  enum class Colour : uint8_t
+  {
+    Red,
+    Green,
+    Blue
+  };
+
+  //*************************************************************************
+  // A key with a user supplied hash.
+  //*************************************************************************
+  struct Key
+  {
+    constexpr Key()
+      : k(0)
+    {
+    }
+
+    constexpr explicit Key(char k_)
+      : k(k_)
+    {
+    }
+
+    char k;
+  };
+
+  constexpr bool operator ==(const Key& lhs, const Key& rhs) noexcept
+  {
+    return (lhs.k == rhs.k);
+  }
+
+  struct KeyHash
+  {
+    constexpr uint32_t operator ()(const Key& key) const noexcept
+    {
+      return static_cast<uint32_t>(key.k);
+    }
+  };
+
+  struct CStringEqual
+  {
+    ETL_CONSTEXPR14 bool operator ()(const char* lhs, const char* rhs) const noexcept
+    {
+      while ((*lhs != '\0') && (*lhs == *rhs))
+      {
+        ++lhs;
+        ++rhs;
+      }
+
+      return (*lhs == *rhs);
+    }
+  };
+
+  using Data       = etl::const_hash_map<int, int, Max_Size>;
+  using IData      = etl::iconst_hash_map<int, int, etl::const_hash<int>, etl::equal_to<int>>;
+  using DataKey    = etl::const_hash_map<Key, int, Max_Size, KeyHash>;
+  using DataColour = etl::const_hash_map<Colour, const char*, 3>;
+  using DataString = etl::const_hash_map<const char*, int, 4, etl::const_hash<const char*>, CStringEqual>;
+
+  using value_type     = Data::value_type;
+  using const_iterator = Data::const_iterator;
+
+  //*************************************************************************
+  // Spreads the test keys over the whole 32 bit range.
+  //*************************************************************************
+  constexpr uint32_t large_key(size_t i)
+  {
+    return static_cast<uint32_t>((i + 1U) * 2654435761UL);
+  }
+
+  static const size_t Large_Size = 256UL;
+
+  using DataLarge = etl::const_hash_map<uint32_t, uint32_t, Large_Size>;
+
+#if ETL_USING_CPP14
+  template <typename TIndices>
+  struct Large;
+
+  template <size_t... Indices>
+  struct Large<etl::index_sequence<Indices...>>
+  {
+    static constexpr DataLarge data{ DataLarge::value_type{ large_key(Indices), static_cast<uint32_t>(Indices) }... };
+  };
+
+  template <size_t... Indices>
+  constexpr DataLarge Large<etl::index_sequence<Indices...>>::data;
+
+  using LargeTable = Large<etl::make_index_sequence<Large_Size>>;
+#endif
+
+  SUITE(test_const_hash_map)
+  {
+    //*************************************************************************
+    TEST(test_default_constructor)
+    {
+      const Data data;
+
+      CHECK_TRUE(data.is_valid());
+      CHECK_EQUAL(0U, data.size());
+      CHECK_TRUE(data.empty());
+      CHECK_FALSE(data.full());
+      CHECK_EQUAL(Max_Size, data.capacity());
+      CHECK_EQUAL(Max_Size, data.max_size());
+      CHECK_TRUE(data.begin() == data.end());
+      CHECK_TRUE(data.find(0) == data.end());
+      CHECK_FALSE(data.contains(0));
+    }
+
+    //*************************************************************************
+    TEST(test_constructor_min_size)
+    {
+      const Data data{ value_type{ 42, 0 } };
+
+      CHECK_TRUE(data.is_valid());
+      CHECK_EQUAL(1U, data.size());
+      CHECK_FALSE(data.empty());
+      CHECK_FALSE(data.full());
+      CHECK_EQUAL(1U, data.bucket_count());
+      CHECK_TRUE(data.contains(42));
+      CHECK_FALSE(data.contains(0));
+      CHECK_FALSE(data.contains(43));
+    }
+
+    //*************************************************************************
+    TEST(test_constructor_max_size)
+    {
+      const Data data{ value_type{ 9, 90 }, value_type{ 3, 30 }, value_type{ 7, 70 }, value_type{ 1, 10 }, value_type{ 5, 50 },
+                       value_type{ 0, 0  }, value_type{ 8, 80 }, value_type{ 2, 20 }, value_type{ 6, 60 }, value_type{ 4, 40 } };
+
+      CHECK_TRUE(data.is_valid());
+      CHECK_EQUAL(Max_Size, data.size());
+      CHECK_FALSE(data.empty());
+      CHECK_TRUE(data.full());
+      CHECK_EQUAL(Max_Size / 2U, data.bucket_count());
+    }
+
+    //*************************************************************************
+    TEST(test_iteration_order_is_construction_order)
+    {
+      const Data data{ value_type{ 9, 90 }, value_type{ 3, 30 }, value_type{ 7, 70 } };
+
+      const_iterator itr = data.begin();
+
+      CHECK_EQUAL(9, itr->first);
+      ++itr;
+      CHECK_EQUAL(3, itr->first);
+      ++itr;
+      CHECK_EQUAL(7, itr->first);
+      ++itr;
+      CHECK_TRUE(itr == data.end());
+    }
+
+    //*************************************************************************
+    TEST(test_find)
+    {
+      const Data data{ value_type{ 9, 90 }, value_type{ 3, 30 }, value_type{ 7, 70 }, value_type{ 1, 10 }, value_type{ 5, 50 },
+                       value_type{ 0, 0  }, value_type{ 8, 80 }, value_type{ 2, 20 }, value_type{ 6, 60 }, value_type{ 4, 40 } };
+
+      for (int i = 0; i < 10; ++i)
+      {
+        const_iterator itr = data.find(i);
+
+        CHECK_TRUE(itr != data.end());
+        CHECK_EQUAL(i,      itr->first);
+        CHECK_EQUAL(i * 10, itr->second);
+      }
+
+      for (int i = 10; i < 1000; ++i)
+      {
+        CHECK_TRUE(data.find(i) == data.end());
+        CHECK_TRUE(data.find(-i) == data.end());
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_index_and_at)
+    {
+      const Data data{ value_type{ 100, 1 }, value_type{ 200, 2 }, value_type{ 300, 3 } };
+
+      CHECK_EQUAL(1, data[100]);
+      CHECK_EQUAL(2, data[200]);
+      CHECK_EQUAL(3, data[300]);
+      CHECK_EQUAL(1, data.at(100));
+      CHECK_EQUAL(2, data.at(200));
+      CHECK_EQUAL(3, data.at(300));
+    }
+
+    //*************************************************************************
+    TEST(test_count_and_contains)
+    {
+      const Data data{ value_type{ 100, 1 }, value_type{ 200, 2 }, value_type{ 300, 3 } };
+
+      CHECK_EQUAL(1U, data.count(100));
+      CHECK_EQUAL(0U, data.count(101));
+      CHECK_TRUE(data.contains(300));
+      CHECK_FALSE(data.contains(301));
+    }
+
+    //*************************************************************************
+    TEST(test_equal_range)
+    {
+      const Data data{ value_type{ 100, 1 }, value_type{ 200, 2 }, value_type{ 300, 3 } };
+
+      ETL_OR_STD::pair<const_iterator, const_iterator> result = data.equal_range(200);
+
+      CHECK_EQUAL(1, etl::distance(result.first, result.second));
+      CHECK_EQUAL(200, result.first->first);
+
+      result = data.equal_range(201);
+
+      CHECK_TRUE(result.first == data.end());
+      CHECK_TRUE(result.second == data.end());
+    }
+
+    //*************************************************************************
+    TEST(test_duplicate_keys_are_not_valid)
+    {
+      const Data data{ value_type{ 100, 1 }, value_type{ 200, 2 }, value_type{ 100, 3 } };
+
+      CHECK_FALSE(data.is_valid());
+      CHECK_TRUE(data.find(200) == data.end());
+    }
+
+    //*************************************************************************
+    TEST(test_user_hash)
+    {
+      const DataKey data{ DataKey::value_type{ Key('A'), 0 }, DataKey::value_type{ Key('B'), 1 }, DataKey::value_type{ Key('C'), 2 },
+                          DataKey::value_type{ Key('D'), 3 }, DataKey::value_type{ Key('E'), 4 } };
+
+      CHECK_TRUE(data.is_valid());
+      CHECK_EQUAL(0, data[Key('A')]);
+      CHECK_EQUAL(2, data[Key('C')]);
+      CHECK_EQUAL(4, data[Key('E')]);
+      CHECK_FALSE(data.contains(Key('F')));
+    }
+
+    //*************************************************************************
+    TEST(test_enum_keys)
+    {
+      const DataColour data{ DataColour::value_type{ Colour::Blue,  "blue" },
+                             DataColour::value_type{ Colour::Red,   "red" },
+                             DataColour::value_type{ Colour::Green, "green" } };
+
+      CHECK_TRUE(data.is_valid());
+      CHECK_EQUAL(std::string("red"),   std::string(data[Colour::Red]));
+      CHECK_EQUAL(std::string("green"), std::string(data[Colour::Green]));
+      CHECK_EQUAL(std::string("blue"),  std::string(data[Colour::Blue]));
+    }
+
+    //*************************************************************************
+    TEST(test_string_keys)
+    {
+      const DataString data{ DataString::value_type{ "one",   1 }, DataString::value_type{ "two",  2 },
+                             DataString::value_type{ "three", 3 }, DataString::value_type{ "four", 4 } };
+
+      char key[8] = "three";
+
+      CHECK_TRUE(data.is_valid());
+      CHECK_EQUAL(3, data[key]);
+
+      strcpy(key, "five");
+      CHECK_FALSE(data.contains(key));
+    }
+
+    //*************************************************************************
+    TEST(test_equal)
+    {
+      const Data data1{ value_type{ 1, 10 }, value_type{ 2, 20 }, value_type{ 3, 30 } };
+      const Data data2{ value_type{ 3, 30 }, value_type{ 1, 10 }, value_type{ 2, 20 } };
+      const Data data3{ value_type{ 3, 30 }, value_type{ 1, 10 }, value_type{ 2, 21 } };
+      const Data data4{ value_type{ 3, 30 }, value_type{ 1, 10 } };
+
+      CHECK_TRUE(data1 == data2);
+      CHECK_FALSE(data1 != data2);
+      CHECK_FALSE(data1 == data3);
+      CHECK_TRUE(data1 != data4);
+
+      const IData& idata1 = data1;
+      const IData& idata2 = data2;
+
+      CHECK_TRUE(idata1 == idata2);
+    }
+
+#if ETL_USING_CPP14
+    //*************************************************************************
+    TEST(test_large_map)
+    {
+      const DataLarge& data = LargeTable::data;
+
+      CHECK_TRUE(data.is_valid());
+      CHECK_EQUAL(Large_Size, data.size());
+
+      std::map<uint32_t, uint32_t> compare;
+
+      for (size_t i = 0U; i < Large_Size; ++i)
+      {
+        compare[large_key(i)] = static_cast<uint32_t>(i);
+      }
+
+      for (size_t i = 0U; i < Large_Size; ++i)
+      {
+        CHECK_EQUAL(compare[large_key(i)], data[large_key(i)]);
+      }
+
+      for (uint32_t key = 0U; key < 100000U; ++key)
+      {
+        CHECK_EQUAL(compare.count(key), data.count(key));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_constexpr)
+    {
+      static constexpr Data data{ value_type{ 9, 90 }, value_type{ 3, 30 }, value_type{ 7, 70 }, value_type{ 1, 10 }, value_type{ 5, 50 },
+                                  value_type{ 0, 0  }, value_type{ 8, 80 }, value_type{ 2, 20 }, value_type{ 6, 60 }, value_type{ 4, 40 } };
+
+      static_assert(data.is_valid(),     "Invalid map");
+      static_assert(data.size() == 10U,  "Wrong size");
+      static_assert(data[7] == 70,       "Wrong value");
+      static_assert(data.contains(4),    "Missing key");
+      static_assert(!data.contains(10),  "Unexpected key");
+
+      static constexpr int value = data.at(3);
+
+      CHECK_EQUAL(30, value);
+    }
+
+    //*************************************************************************
+    TEST(test_constexpr_large_map)
+    {
+      constexpr const DataLarge& data = LargeTable::data;
+
+      static_assert(data.is_valid(),                                     "Invalid map");
+      static_assert(data[large_key(0)] == 0U,                            "Wrong value");
+      static_assert(data[large_key(Large_Size - 1U)] == Large_Size - 1U, "Wrong value");
+
+      for (size_t i = 0U; i < Large_Size; ++i)
+      {
+        CHECK_EQUAL(i, data[large_key(i)]);
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_constexpr_string_keys)
+    {
+      static constexpr DataString data{ DataString::value_type{ "one",   1 }, DataString::value_type{ "two",  2 },
+                                        DataString::value_type{ "three", 3 }, DataString::value_type{ "four", 4 } };
+
+      static_assert(data.is_valid(),        "Invalid map");
+      static_assert(data["four"] == 4,      "Wrong value");
+      static_assert(!data.contains("five"), "Unexpected key");
+
+      CHECK_EQUAL(2, data["two"]);
+    }
+#endif
+
+#if ETL_USING_CPP17
+    //*************************************************************************
+    TEST(test_cpp17_deduced_constructor)
+    {
+      const etl::const_hash_map data{ value_type{ 1, 10 }, value_type{ 2, 20 }, value_type{ 3, 30 } };
+
+      CHECK_TRUE(data.is_valid());
+      CHECK_EQUAL(3U, data.max_size());
+      CHECK_TRUE(data.full());
+      CHECK_EQUAL(20, data[2]);
+    }
+#endif
+  };
+}
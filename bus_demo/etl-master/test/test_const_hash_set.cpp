@@ -0,0 +1,216 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the 'Software'), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "unit_test_framework.h"
+
+#include <set>
+
+#include "etl/const_hash_set.h"
+
+namespace
+{
+  static const size_t Max_Size = 10UL;
+
+  using Data  = etl::const_hash_set<int, Max_Size>;
+  using IData = etl::iconst_hash_set<int, etl::const_hash<int>, etl::equal_to<int>>;
+
+  using value_type     = Data::value_type;
+  using const_iterator = Data::const_iterator;
+
+  //*************************************************************************
+  // CAN style identifiers.
+  //*************************************************************************
+  constexpr uint32_t can_id(size_t i)
+  {
+    return static_cast<uint32_t>(0x18FF0000UL + (i * 0x131UL));
+  }
+
+  static const size_t Large_Size = 128UL;
+
+  using DataLarge = etl::const_hash_set<uint32_t, Large_Size>;
+
+#if ETL_USING_CPP14
+  template <typename TIndices>
+  struct Large;
+
+  template <size_t... Indices>
+  struct Large<etl::index_sequence<Indices...>>
+  {
+    static constexpr DataLarge data{ can_id(Indices)... };
+  };
+
+  template <size_t... Indices>
+  constexpr DataLarge Large<etl::index_sequence<Indices...>>::data;
+
+  using LargeTable = Large<etl::make_index_sequence<Large_Size>>;
+#endif
+
+  SUITE(test_const_hash_set)
+  {
+    //*************************************************************************
+    TEST(test_default_constructor)
+    {
+      const Data data;
+
+      CHECK_TRUE(data.is_valid());
+      CHECK_EQUAL(0U, data.size());
+      CHECK_TRUE(data.empty());
+      CHECK_FALSE(data.full());
+      CHECK_EQUAL(Max_Size, data.max_size());
+      CHECK_TRUE(data.begin() == data.end());
+      CHECK_FALSE(data.contains(0));
+    }
+
+    //*************************************************************************
+    TEST(test_constructor_max_size)
+    {
+      const Data data{ 9, 3, 7, 1, 5, 0, 8, 2, 6, 4 };
+
+      CHECK_TRUE(data.is_valid());
+      CHECK_EQUAL(Max_Size, data.size());
+      CHECK_TRUE(data.full());
+
+      const_iterator itr = data.begin();
+
+      CHECK_EQUAL(9, *itr);
+      CHECK_EQUAL(4, *(data.end() - 1));
+    }
+
+    //*************************************************************************
+    TEST(test_find)
+    {
+      const Data data{ 9, 3, 7, 1, 5, 0, 8, 2, 6, 4 };
+
+      for (int i = 0; i < 10; ++i)
+      {
+        const_iterator itr = data.find(i);
+
+        CHECK_TRUE(itr != data.end());
+        CHECK_EQUAL(i, *itr);
+        CHECK_EQUAL(1U, data.count(i));
+      }
+
+      for (int i = 10; i < 1000; ++i)
+      {
+        CHECK_TRUE(data.find(i) == data.end());
+        CHECK_EQUAL(0U, data.count(-i));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_equal_range)
+    {
+      const Data data{ 100, 200, 300 };
+
+      ETL_OR_STD::pair<const_iterator, const_iterator> result = data.equal_range(300);
+
+      CHECK_EQUAL(1, etl::distance(result.first, result.second));
+      CHECK_EQUAL(300, *result.first);
+
+      result = data.equal_range(301);
+
+      CHECK_TRUE(result.first == result.second);
+    }
+
+    //*************************************************************************
+    TEST(test_duplicate_keys_are_not_valid)
+    {
+      const Data data{ 100, 200, 300, 200 };
+
+      CHECK_FALSE(data.is_valid());
+      CHECK_FALSE(data.contains(100));
+    }
+
+    //*************************************************************************
+    TEST(test_equal)
+    {
+      const Data data1{ 1, 2, 3 };
+      const Data data2{ 3, 1, 2 };
+      const Data data3{ 3, 1, 4 };
+
+      CHECK_TRUE(data1 == data2);
+      CHECK_FALSE(data1 != data2);
+      CHECK_FALSE(data1 == data3);
+
+      const IData& idata1 = data1;
+      const IData& idata3 = data3;
+
+      CHECK_TRUE(idata1 != idata3);
+    }
+
+#if ETL_USING_CPP14
+    //*************************************************************************
+    TEST(test_constexpr)
+    {
+      static constexpr Data data{ 9, 3, 7, 1, 5, 0, 8, 2, 6, 4 };
+
+      static_assert(data.is_valid(),    "Invalid set");
+      static_assert(data.contains(7),   "Missing key");
+      static_assert(!data.contains(10), "Unexpected key");
+
+      static constexpr size_t count = data.count(5);
+
+      CHECK_EQUAL(1U, count);
+    }
+
+    //*************************************************************************
+    TEST(test_constexpr_large_set)
+    {
+      constexpr const DataLarge& data = LargeTable::data;
+
+      static_assert(data.is_valid(),                        "Invalid set");
+      static_assert(data.contains(can_id(0)),               "Missing key");
+      static_assert(data.contains(can_id(Large_Size - 1U)), "Missing key");
+
+      std::set<uint32_t> compare;
+
+      for (size_t i = 0U; i < Large_Size; ++i)
+      {
+        compare.insert(can_id(i));
+      }
+
+      for (uint32_t id = 0x18FF0000UL; id < 0x19000000UL; ++id)
+      {
+        CHECK_EQUAL(compare.count(id), data.count(id));
+      }
+    }
+#endif
+
+#if ETL_USING_CPP17
+    //*************************************************************************
+    TEST(test_cpp17_deduced_constructor)
+    {
+      const etl::const_hash_set data{ 1, 2, 3 };
+
+      CHECK_TRUE(data.is_valid());
+      CHECK_EQUAL(3U, data.max_size());
+      CHECK_TRUE(data.contains(2));
+    }
+#endif
+  };
+}
@@ -0,0 +1,588 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "unit_test_framework.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "data.h"
+
+#include "etl/flat_hash_map.h"
+
+namespace
+{
+  //*************************************************************************
+  // Every key has the same hash, so every key probes the same groups.
+  struct colliding_hash
+  {
+    size_t operator ()(uint32_t) const
+    {
+      return 0U;
+    }
+  };
+
+  //*************************************************************************
+  // Colliding hash that counts how often it is called.
+  struct counting_colliding_hash
+  {
+    size_t operator ()(uint32_t) const
+    {
+      ++calls;
+      return 0U;
+    }
+
+    static size_t calls;
+  };
+
+  size_t counting_colliding_hash::calls = 0U;
+
+  //*************************************************************************
+  struct transparent_hash
+  {
+    typedef int is_transparent;
+
+    size_t operator ()(const char* s) const
+    {
+      return std::hash<std::string>()(std::string(s));
+    }
+
+    size_t operator ()(const std::string& text) const
+    {
+      return std::hash<std::string>()(text);
+    }
+  };
+
+  //*************************************************************************
+  // Counts the live instances, to check that erase and clear destroy values.
+  struct Counted
+  {
+    Counted()
+      : value(0)
+    {
+      ++instances;
+    }
+
+    explicit Counted(int value_)
+      : value(value_)
+    {
+      ++instances;
+    }
+
+    Counted(const Counted& other)
+      : value(other.value)
+    {
+      ++instances;
+    }
+
+    Counted& operator =(const Counted& other)
+    {
+      value = other.value;
+      return *this;
+    }
+
+    ~Counted()
+    {
+      --instances;
+    }
+
+    friend bool operator ==(const Counted& lhs, const Counted& rhs)
+    {
+      return lhs.value == rhs.value;
+    }
+
+    int value;
+
+    static int instances;
+  };
+
+  int Counted::instances = 0;
+
+  using NDC = TestDataNDC<std::string>;
+
+  SUITE(test_flat_hash_map)
+  {
+    static const size_t SIZE = 10;
+
+    using Data            = etl::flat_hash_map<std::string, NDC, SIZE, std::hash<std::string>>;
+    using IData           = etl::iflat_hash_map<std::string, NDC, std::hash<std::string>>;
+    using DataTransparent = etl::flat_hash_map<std::string, int, SIZE, transparent_hash, etl::equal_to<>>;
+    using DataColliding   = etl::flat_hash_map<uint32_t, uint32_t, 100, colliding_hash>;
+    using DataLarge       = etl::flat_hash_map<uint32_t, uint32_t, 1000>;
+
+    std::vector<std::pair<std::string, NDC>> initial_data =
+    {
+      { "A", NDC("a") }, { "B", NDC("b") }, { "C", NDC("c") }, { "D", NDC("d") }, { "E", NDC("e") },
+      { "F", NDC("f") }, { "G", NDC("g") }, { "H", NDC("h") }, { "I", NDC("i") }, { "J", NDC("j") }
+    };
+
+    //*************************************************************************
+    TEST(test_default_constructor)
+    {
+      Data data;
+
+      CHECK(data.empty());
+      CHECK(!data.full());
+      CHECK_EQUAL(0U, data.size());
+      CHECK_EQUAL(SIZE, data.max_size());
+      CHECK_EQUAL(SIZE, data.capacity());
+      CHECK_EQUAL(SIZE, data.available());
+      CHECK_EQUAL(16U, data.slot_count());
+      CHECK(data.begin() == data.end());
+    }
+
+    //*************************************************************************
+    TEST(test_slot_count)
+    {
+      // At least 8/7 of the capacity, rounded up to a power of 2.
+      CHECK_EQUAL(16U,   (etl::flat_hash_map<int, int, 1>::SLOT_COUNT));
+      CHECK_EQUAL(16U,   (etl::flat_hash_map<int, int, 14>::SLOT_COUNT));
+      CHECK_EQUAL(32U,   (etl::flat_hash_map<int, int, 15>::SLOT_COUNT));
+      CHECK_EQUAL(2048U, (etl::flat_hash_map<int, int, 1000>::SLOT_COUNT));
+    }
+
+    //*************************************************************************
+    TEST(test_constructor_range)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      CHECK(data.full());
+      CHECK_EQUAL(initial_data.size(), data.size());
+
+      for (size_t i = 0U; i < initial_data.size(); ++i)
+      {
+        CHECK(data.at(initial_data[i].first) == initial_data[i].second);
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_constructor_initializer_list)
+    {
+      etl::flat_hash_map<int, int, 4> data = { { 1, 10 }, { 2, 20 }, { 3, 30 } };
+
+      CHECK_EQUAL(3U, data.size());
+      CHECK_EQUAL(10, data.at(1));
+      CHECK_EQUAL(20, data.at(2));
+      CHECK_EQUAL(30, data.at(3));
+    }
+
+    //*************************************************************************
+    TEST(test_copy_constructor_and_assignment)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+      Data copy(data);
+
+      CHECK(data == copy);
+
+      Data other;
+      other.insert(std::make_pair(std::string("Z"), NDC("z")));
+      CHECK(data != other);
+
+      IData& idata  = data;
+      IData& iother = other;
+      iother = idata;
+
+      CHECK(data == other);
+      CHECK(!other.contains("Z"));
+    }
+
+    //*************************************************************************
+    TEST(test_move_constructor)
+    {
+      etl::flat_hash_map<std::string, std::string, 4, std::hash<std::string>> data;
+      data["A"] = "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
+      data["B"] = "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb";
+
+      etl::flat_hash_map<std::string, std::string, 4, std::hash<std::string>> moved(std::move(data));
+
+      CHECK_EQUAL(2U, moved.size());
+      CHECK_EQUAL(std::string("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"), moved.at("A"));
+      CHECK_EQUAL(std::string("bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb"), moved.at("B"));
+    }
+
+    //*************************************************************************
+    TEST(test_insert_and_find)
+    {
+      Data data;
+
+      for (size_t i = 0U; i < initial_data.size(); ++i)
+      {
+        ETL_OR_STD::pair<Data::iterator, bool> result = data.insert(initial_data[i]);
+
+        CHECK(result.second);
+        CHECK(result.first->first == initial_data[i].first);
+        CHECK(result.first->second == initial_data[i].second);
+      }
+
+      // Duplicate keys are not inserted.
+      ETL_OR_STD::pair<Data::iterator, bool> result = data.insert(std::make_pair(std::string("C"), NDC("x")));
+      CHECK(!result.second);
+      CHECK(result.first->second == NDC("c"));
+
+      CHECK(data.find("C") != data.end());
+      CHECK(data.find("Z") == data.end());
+      CHECK_EQUAL(1U, data.count("C"));
+      CHECK_EQUAL(0U, data.count("Z"));
+
+      const Data& cdata = data;
+      CHECK(cdata.find("J")->second == NDC("j"));
+    }
+
+    //*************************************************************************
+    TEST(test_insert_full)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      CHECK_THROW(data.insert(std::make_pair(std::string("Z"), NDC("z"))), etl::flat_hash_map_full);
+
+      // An existing key is still found when full.
+      CHECK(!data.insert(initial_data[0]).second);
+    }
+
+    //*************************************************************************
+    TEST(test_index_operator)
+    {
+      etl::flat_hash_map<std::string, int, SIZE, std::hash<std::string>> data;
+
+      data["A"] = 1;
+      data["B"] = 2;
+      data["A"] += 10;
+
+      CHECK_EQUAL(2U, data.size());
+      CHECK_EQUAL(11, data["A"]);
+      CHECK_EQUAL(2,  data["B"]);
+      CHECK_EQUAL(0,  data["C"]);
+      CHECK_EQUAL(3U, data.size());
+    }
+
+    //*************************************************************************
+    TEST(test_at)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+      const Data& cdata = data;
+
+      CHECK(data.at("E") == NDC("e"));
+      CHECK(cdata.at("F") == NDC("f"));
+      CHECK_THROW(data.at("Z"), etl::flat_hash_map_out_of_range);
+      CHECK_THROW(cdata.at("Z"), etl::flat_hash_map_out_of_range);
+    }
+
+    //*************************************************************************
+    TEST(test_iteration)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      std::vector<std::string> keys;
+
+      for (Data::const_iterator itr = data.cbegin(); itr != data.cend(); ++itr)
+      {
+        keys.push_back(itr->first);
+      }
+
+      std::sort(keys.begin(), keys.end());
+
+      CHECK_EQUAL(initial_data.size(), keys.size());
+
+      for (size_t i = 0U; i < keys.size(); ++i)
+      {
+        CHECK_EQUAL(initial_data[i].first, keys[i]);
+      }
+
+      CHECK_EQUAL(data.size(), size_t(std::distance(data.begin(), data.end())));
+    }
+
+    //*************************************************************************
+    TEST(test_erase_key)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      CHECK_EQUAL(1U, data.erase("C"));
+      CHECK_EQUAL(0U, data.erase("C"));
+      CHECK_EQUAL(initial_data.size() - 1U, data.size());
+      CHECK(!data.contains("C"));
+      CHECK(data.contains("D"));
+
+      // The freed slot can be used again.
+      CHECK(data.insert(std::make_pair(std::string("Z"), NDC("z"))).second);
+      CHECK(data.full());
+    }
+
+    //*************************************************************************
+    TEST(test_erase_iterator)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      Data::iterator itr = data.begin();
+      size_t erased = 0U;
+
+      // Erase every other element while iterating.
+      while (itr != data.end())
+      {
+        itr = data.erase(itr);
+        ++erased;
+
+        if (itr != data.end())
+        {
+          ++itr;
+        }
+      }
+
+      CHECK_EQUAL(initial_data.size() - erased, data.size());
+      CHECK_EQUAL(data.size(), size_t(std::distance(data.begin(), data.end())));
+    }
+
+    //*************************************************************************
+    TEST(test_erase_range)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      Data::iterator last = data.begin();
+      std::advance(last, 4);
+
+      Data::iterator next = data.erase(data.begin(), last);
+
+      CHECK(next == data.begin());
+      CHECK_EQUAL(initial_data.size() - 4U, data.size());
+
+      data.erase(data.begin(), data.end());
+      CHECK(data.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_clear)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      data.clear();
+
+      CHECK(data.empty());
+      CHECK(data.begin() == data.end());
+
+      data.assign(initial_data.begin(), initial_data.end());
+      CHECK(data.full());
+    }
+
+    //*************************************************************************
+    TEST(test_values_are_destroyed)
+    {
+      Counted::instances = 0;
+
+      {
+        etl::flat_hash_map<int, Counted, 20> data;
+
+        for (int i = 0; i < 20; ++i)
+        {
+          data.insert(std::make_pair(i, Counted(i)));
+        }
+
+        CHECK_EQUAL(20, Counted::instances);
+
+        data.erase(3);
+        data.erase(data.find(4));
+        CHECK_EQUAL(18, Counted::instances);
+
+        data.clear();
+        CHECK_EQUAL(0, Counted::instances);
+
+        data[1] = Counted(1);
+        data[2] = Counted(2);
+        CHECK_EQUAL(2, Counted::instances);
+      }
+
+      CHECK_EQUAL(0, Counted::instances);
+    }
+
+    //*************************************************************************
+    TEST(test_colliding_hashes)
+    {
+      // Every key lands in the same home group, so most keys overflow into later groups.
+      DataColliding data;
+
+      for (uint32_t i = 0U; i < 100U; ++i)
+      {
+        CHECK(data.insert(std::make_pair(i, i * 3U)).second);
+      }
+
+      CHECK(data.full());
+
+      for (uint32_t i = 0U; i < 100U; i += 2U)
+      {
+        CHECK_EQUAL(1U, data.erase(i));
+      }
+
+      // Keys that overflowed past erased slots are still found.
+      for (uint32_t i = 0U; i < 100U; ++i)
+      {
+        CHECK_EQUAL((i % 2U) == 0U ? 0U : 1U, data.count(i));
+      }
+
+      for (uint32_t i = 100U; i < 150U; ++i)
+      {
+        CHECK(data.insert(std::make_pair(i, i * 3U)).second);
+      }
+
+      CHECK(data.full());
+
+      for (uint32_t i = 1U; i < 150U; ++i)
+      {
+        if ((i >= 100U) || ((i % 2U) == 1U))
+        {
+          CHECK_EQUAL(i * 3U, data.at(i));
+        }
+      }
+
+      // Erasing everything returns every overflow count to zero, so a miss stops at the home group.
+      data.erase(data.begin(), data.end());
+      CHECK(data.empty());
+      CHECK(data.find(1U) == data.end());
+    }
+
+    //*************************************************************************
+    TEST(test_saturated_overflow_counts_are_recalculated)
+    {
+      // 400 colliding keys push 384 elements past the home group, so its count saturates.
+      etl::flat_hash_map<uint32_t, uint32_t, 400, counting_colliding_hash> data;
+
+      for (uint32_t i = 0U; i < 400U; ++i)
+      {
+        CHECK(data.insert(std::make_pair(i, i)).second);
+      }
+
+      // Erase 300 keys that were pushed past the home group.
+      // After 255 of them the counts are rebuilt from the 145 elements left, hashing each once.
+      counting_colliding_hash::calls = 0U;
+
+      for (uint32_t i = 399U; i >= 100U; --i)
+      {
+        CHECK_EQUAL(1U, data.erase(i));
+      }
+
+      CHECK_EQUAL(300U + 145U, counting_colliding_hash::calls);
+
+      // The rebuilt counts are exact, so they can be lowered and raised again.
+      for (uint32_t i = 0U; i < 100U; i += 2U)
+      {
+        CHECK_EQUAL(1U, data.erase(i));
+      }
+
+      for (uint32_t i = 1000U; i < 1300U; ++i)
+      {
+        CHECK(data.insert(std::make_pair(i, i)).second);
+      }
+
+      for (uint32_t i = 0U; i < 1300U; ++i)
+      {
+        const bool expected = ((i < 100U) && ((i % 2U) == 1U)) || (i >= 1000U);
+        CHECK_EQUAL(expected ? 1U : 0U, data.count(i));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_random_operations_match_std_unordered_map)
+    {
+      std::mt19937 rng(12345U);
+      std::unordered_map<uint32_t, uint32_t> compare;
+      DataLarge data;
+
+      for (int i = 0; i < 100000; ++i)
+      {
+        const uint32_t key = rng() % 3000U;
+
+        if ((rng() % 3U) != 0U)
+        {
+          if (!data.full() || data.contains(key))
+          {
+            const bool inserted = data.insert(std::make_pair(key, uint32_t(i))).second;
+            CHECK_EQUAL(compare.insert(std::make_pair(key, uint32_t(i))).second, inserted);
+          }
+        }
+        else
+        {
+          CHECK_EQUAL(compare.erase(key), data.erase(key));
+        }
+      }
+
+      CHECK_EQUAL(compare.size(), data.size());
+
+      bool all_found = true;
+
+      for (std::unordered_map<uint32_t, uint32_t>::const_iterator itr = compare.begin(); itr != compare.end(); ++itr)
+      {
+        DataLarge::const_iterator found = data.find(itr->first);
+        all_found = all_found && (found != data.end()) && (found->second == itr->second);
+      }
+
+      CHECK(all_found);
+    }
+
+    //*************************************************************************
+    TEST(test_equal_range)
+    {
+      Data data(initial_data.begin(), initial_data.end());
+
+      ETL_OR_STD::pair<Data::iterator, Data::iterator> range = data.equal_range("B");
+
+      CHECK(range.first->first == "B");
+      CHECK_EQUAL(1, std::distance(range.first, range.second));
+
+      range = data.equal_range("Z");
+      CHECK(range.first == data.end());
+      CHECK(range.second == data.end());
+    }
+
+    //*************************************************************************
+    TEST(test_transparent_lookup)
+    {
+      DataTransparent data;
+
+      data["Apple"]  = 1;
+      data["Banana"] = 2;
+
+      CHECK(data.contains("Apple"));
+      CHECK(!data.contains("Cherry"));
+      CHECK_EQUAL(2, data.find("Banana")->second);
+      CHECK_EQUAL(1U, data.count("Apple"));
+    }
+
+    //*************************************************************************
+    TEST(test_make_flat_hash_map)
+    {
+      auto data = etl::make_flat_hash_map<int, int>(ETL_OR_STD::pair<int, int>(1, 2), ETL_OR_STD::pair<int, int>(3, 4));
+
+      CHECK_EQUAL(2U, data.max_size());
+      CHECK_EQUAL(2, data.at(1));
+      CHECK_EQUAL(4, data.at(3));
+    }
+  };
+}
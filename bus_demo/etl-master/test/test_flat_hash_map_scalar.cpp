@@ -0,0 +1,170 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+// Build the map with the portable group probing, whatever the target supports.
+#define ETL_FLAT_HASH_MAP_FORCE_SCALAR
+
+#include "unit_test_framework.h"
+
+#include <random>
+#include <unordered_map>
+
+#include "etl/flat_hash_map.h"
+
+#if ETL_FLAT_HASH_MAP_USING_SSE2 || ETL_FLAT_HASH_MAP_USING_NEON
+  #error ETL_FLAT_HASH_MAP_FORCE_SCALAR did not select the scalar group
+#endif
+
+namespace
+{
+  //*************************************************************************
+  // The key type is local to this file, so no map instantiation is shared
+  // with test_flat_hash_map.cpp, which may be built with SSE2 or NEON.
+  struct Key
+  {
+    uint32_t value;
+
+    friend bool operator ==(const Key& lhs, const Key& rhs)
+    {
+      return lhs.value == rhs.value;
+    }
+  };
+
+  struct KeyHash
+  {
+    size_t operator ()(const Key& key) const
+    {
+      return key.value;
+    }
+  };
+
+  //*************************************************************************
+  // Only a few distinct hashes, so many keys share groups and overflow.
+  struct KeyHashCrowded
+  {
+    size_t operator ()(const Key& key) const
+    {
+      return key.value % 7U;
+    }
+  };
+
+  Key make_key(uint32_t value)
+  {
+    Key key = { value };
+    return key;
+  }
+
+  //*************************************************************************
+  template <typename TMap>
+  void check_random_operations(TMap& data, uint32_t key_range, int iterations)
+  {
+    std::mt19937 rng(54321U);
+    std::unordered_map<uint32_t, uint32_t> compare;
+
+    for (int i = 0; i < iterations; ++i)
+    {
+      const Key key = make_key(rng() % key_range);
+
+      if ((rng() % 3U) != 0U)
+      {
+        if (!data.full() || data.contains(key))
+        {
+          const bool inserted = data.insert(std::make_pair(key, uint32_t(i))).second;
+          CHECK_EQUAL(compare.insert(std::make_pair(key.value, uint32_t(i))).second, inserted);
+        }
+      }
+      else
+      {
+        CHECK_EQUAL(compare.erase(key.value), data.erase(key));
+      }
+    }
+
+    CHECK_EQUAL(compare.size(), data.size());
+
+    bool all_found = true;
+
+    for (std::unordered_map<uint32_t, uint32_t>::const_iterator itr = compare.begin(); itr != compare.end(); ++itr)
+    {
+      typename TMap::const_iterator found = data.find(make_key(itr->first));
+      all_found = all_found && (found != data.end()) && (found->second == itr->second);
+    }
+
+    CHECK(all_found);
+  }
+
+  SUITE(test_flat_hash_map_scalar)
+  {
+    //*************************************************************************
+    TEST(test_group_matches_each_lane)
+    {
+      typedef etl::private_flat_hash_map::group group_t;
+
+      std::mt19937 rng(12345U);
+      uint8_t ctrl[etl::private_flat_hash_map::Group_Width];
+
+      for (int pass = 0; pass < 1000; ++pass)
+      {
+        // Mostly full slots with a handful of hashes, some empty.
+        for (size_t i = 0U; i < etl::private_flat_hash_map::Group_Width; ++i)
+        {
+          ctrl[i] = ((rng() % 4U) == 0U) ? uint8_t(etl::private_flat_hash_map::Ctrl_Empty) : uint8_t(rng() % 4U);
+        }
+
+        const uint8_t h2 = uint8_t(rng() % 4U);
+        uint32_t expected_match = 0U;
+        uint32_t expected_empty = 0U;
+
+        for (size_t i = 0U; i < etl::private_flat_hash_map::Group_Width; ++i)
+        {
+          expected_match |= (ctrl[i] == h2) ? (1U << i) : 0U;
+          expected_empty |= (ctrl[i] == etl::private_flat_hash_map::Ctrl_Empty) ? (1U << i) : 0U;
+        }
+
+        const group_t group(ctrl);
+        CHECK_EQUAL(expected_match, uint32_t(group.match(h2)));
+        CHECK_EQUAL(expected_empty, uint32_t(group.match_empty()));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_random_operations_match_std_unordered_map)
+    {
+      etl::flat_hash_map<Key, uint32_t, 1000, KeyHash> data;
+
+      check_random_operations(data, 3000U, 100000);
+    }
+
+    //*************************************************************************
+    TEST(test_crowded_hashes_match_std_unordered_map)
+    {
+      etl::flat_hash_map<Key, uint32_t, 300, KeyHashCrowded> data;
+
+      check_random_operations(data, 600U, 50000);
+    }
+  }
+}
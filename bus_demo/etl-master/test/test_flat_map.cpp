@@ -1555,5 +1555,128 @@ namespace
       CHECK(data.contains(Key(1)));
       CHECK(!data.contains(Key(99)));
     }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_freeze_without_index)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      CHECK(!data.freeze());
+      CHECK(!data.is_frozen());
+      CHECK(data.find(5) != data.end());
+    }
+
+    //*************************************************************************
+    TEST(test_frozen_lookup_matches_sorted_lookup)
+    {
+      typedef etl::flat_map<int, int, 40, etl::less<int>, true> IndexedData;
+
+      IndexedData data;
+      std::vector<int> keys;
+
+      // Every size exercises a different shape of the index tree.
+      for (int size = 0; size <= 40; ++size)
+      {
+        data.clear();
+        keys.clear();
+
+        for (int i = 0; i < size; ++i)
+        {
+          data.insert(ETL_OR_STD::make_pair(i * 3, i));
+          keys.push_back(i * 3);
+        }
+
+        CHECK(data.freeze());
+        CHECK(data.is_frozen());
+
+        for (int key = -1; key <= (size * 3) + 1; ++key)
+        {
+          size_t lower = std::distance(keys.begin(), std::lower_bound(keys.begin(), keys.end(), key));
+          size_t upper = std::distance(keys.begin(), std::upper_bound(keys.begin(), keys.end(), key));
+
+          const IndexedData& cdata = data;
+
+          CHECK_EQUAL(lower, size_t(std::distance(data.begin(),   data.lower_bound(key))));
+          CHECK_EQUAL(upper, size_t(std::distance(data.begin(),   data.upper_bound(key))));
+          CHECK_EQUAL(lower, size_t(std::distance(cdata.begin(),  cdata.lower_bound(key))));
+          CHECK_EQUAL(upper, size_t(std::distance(cdata.begin(),  cdata.upper_bound(key))));
+          CHECK_EQUAL(lower, size_t(std::distance(data.begin(),   data.equal_range(key).first)));
+          CHECK_EQUAL(upper, size_t(std::distance(data.begin(),   data.equal_range(key).second)));
+          CHECK_EQUAL(upper, size_t(std::distance(cdata.begin(),  cdata.equal_range(key).second)));
+          CHECK_EQUAL((lower != upper), data.find(key) != data.end());
+          CHECK_EQUAL((lower != upper), cdata.find(key) != cdata.end());
+          CHECK_EQUAL((lower != upper) ? 1U : 0U, data.count(key));
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_frozen_lookup_with_transparent_comparator)
+    {
+      typedef etl::flat_map<int, int, SIZE, etl::less<>, true> IndexedData;
+
+      IndexedData data;
+
+      for (int i = 0; i < 8; ++i)
+      {
+        data.insert(ETL_OR_STD::make_pair(i * 2, i));
+      }
+
+      CHECK(data.freeze());
+
+      CHECK_EQUAL(3, data.find(Key(6))->second);
+      CHECK(data.find(Key(7)) == data.end());
+      CHECK(data.lower_bound(Key(7)) == data.find(8));
+      CHECK(data.upper_bound(Key(8)) == data.find(10));
+      CHECK(data.contains(Key(14)));
+      CHECK(!data.contains(Key(15)));
+    }
+
+    //*************************************************************************
+    TEST(test_modify_thaws_frozen_map)
+    {
+      typedef etl::flat_map<int, int, SIZE, etl::less<int>, true> IndexedData;
+
+      IndexedData data;
+
+      data.insert(ETL_OR_STD::make_pair(1, 1));
+      data.insert(ETL_OR_STD::make_pair(3, 3));
+      CHECK(data.freeze());
+
+      data.insert(ETL_OR_STD::make_pair(2, 2));
+      CHECK(!data.is_frozen());
+      CHECK_EQUAL(2, data.find(2)->second);
+
+      CHECK(data.freeze());
+      data[5] = 5;
+      CHECK(!data.is_frozen());
+      CHECK_EQUAL(5, data.find(5)->second);
+
+      CHECK(data.freeze());
+      data.erase(1);
+      CHECK(!data.is_frozen());
+      CHECK(data.find(1) == data.end());
+
+      CHECK(data.freeze());
+      data.erase(data.begin());
+      CHECK(!data.is_frozen());
+      CHECK(data.find(2) == data.end());
+
+      CHECK(data.freeze());
+      data.clear();
+      CHECK(!data.is_frozen());
+      CHECK(data.find(3) == data.end());
+
+      // A lookup that does not insert keeps the index.
+      data[4] = 4;
+      CHECK(data.freeze());
+      data[4] = 40;
+      CHECK(data.is_frozen());
+      CHECK_EQUAL(40, data.find(4)->second);
+
+      data.thaw();
+      CHECK(!data.is_frozen());
+      CHECK_EQUAL(40, data.find(4)->second);
+    }
   };
 }
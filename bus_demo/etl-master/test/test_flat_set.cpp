@@ -1316,5 +1316,93 @@ namespace
       CHECK(data.contains(Key(N5)));
       CHECK(!data.contains(Key(NX)));
     }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_freeze_without_index)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      CHECK(!data.freeze());
+      CHECK(!data.is_frozen());
+      CHECK(data.find(N5) != data.end());
+    }
+
+    //*************************************************************************
+    TEST(test_frozen_lookup_matches_sorted_lookup)
+    {
+      typedef etl::flat_set<int, 40, etl::less<int>, true> IndexedData;
+
+      IndexedData data;
+      std::vector<int> keys;
+
+      // Every size exercises a different shape of the index tree.
+      for (int size = 0; size <= 40; ++size)
+      {
+        data.clear();
+        keys.clear();
+
+        for (int i = size - 1; i >= 0; --i)
+        {
+          data.insert(i * 3);
+          keys.insert(keys.begin(), i * 3);
+        }
+
+        CHECK(data.freeze());
+        CHECK(data.is_frozen());
+
+        for (int key = -1; key <= (size * 3) + 1; ++key)
+        {
+          size_t lower = std::distance(keys.begin(), std::lower_bound(keys.begin(), keys.end(), key));
+          size_t upper = std::distance(keys.begin(), std::upper_bound(keys.begin(), keys.end(), key));
+
+          const IndexedData& cdata = data;
+
+          CHECK_EQUAL(lower, size_t(std::distance(data.begin(),  data.lower_bound(key))));
+          CHECK_EQUAL(upper, size_t(std::distance(data.begin(),  data.upper_bound(key))));
+          CHECK_EQUAL(lower, size_t(std::distance(cdata.begin(), cdata.lower_bound(key))));
+          CHECK_EQUAL(upper, size_t(std::distance(cdata.begin(), cdata.upper_bound(key))));
+          CHECK_EQUAL(lower, size_t(std::distance(data.begin(),  data.equal_range(key).first)));
+          CHECK_EQUAL(upper, size_t(std::distance(data.begin(),  data.equal_range(key).second)));
+          CHECK_EQUAL(lower, size_t(std::distance(cdata.begin(), cdata.equal_range(key).first)));
+          CHECK_EQUAL(upper, size_t(std::distance(cdata.begin(), cdata.equal_range(key).second)));
+          CHECK_EQUAL((lower != upper), data.find(key) != data.end());
+          CHECK_EQUAL((lower != upper), cdata.find(key) != cdata.end());
+          CHECK_EQUAL((lower != upper) ? 1U : 0U, data.count(key));
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_frozen_lookup_with_non_trivial_key)
+    {
+      typedef etl::flat_set<NDC, SIZE, etl::less<>, true> IndexedData;
+
+      IndexedData data(initial_data.begin(), initial_data.end());
+
+      CHECK(data.freeze());
+      CHECK(data.is_frozen());
+
+      for (size_t i = 0UL; i < initial_data.size(); ++i)
+      {
+        CHECK_EQUAL(initial_data[i], *data.find(initial_data[i]));
+        CHECK_EQUAL(initial_data[i], *data.find(Key(initial_data[i])));
+      }
+
+      CHECK(data.find(NX) == data.end());
+      CHECK(data.find(Key(NX)) == data.end());
+
+      // Freezing again rebuilds the index in place.
+      CHECK(data.freeze());
+      CHECK(data.contains(N5));
+
+      data.erase(N5);
+      CHECK(!data.is_frozen());
+      CHECK(!data.contains(N5));
+
+      CHECK(data.freeze());
+      data.insert(N5);
+      CHECK(!data.is_frozen());
+      CHECK(data.contains(N5));
+    }
   };
 }
@@ -31,6 +31,8 @@ SOFTWARE.
 #include <thread>
 #include <chrono>
 #include <vector>
+#include <string>
+#include <iterator>
 
 #include "etl/queue_spsc_atomic.h"
 
@@ -394,6 +396,235 @@ namespace
       CHECK(queue.full());
     }
 
+    //*************************************************************************
+    TEST(test_push_n_pop_n)
+    {
+      etl::queue_spsc_atomic<int, 6> queue;
+
+      int input[]  = { 1, 2, 3, 4, 5, 6, 7, 8 };
+      int output[] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+      CHECK_EQUAL(4U, queue.push_n(input, 4U));
+      CHECK_EQUAL(4U, queue.size());
+
+      CHECK_EQUAL(3U, queue.pop_n(output, 3U));
+      CHECK_EQUAL(1, output[0]);
+      CHECK_EQUAL(2, output[1]);
+      CHECK_EQUAL(3, output[2]);
+
+      // Wraps around the end of the buffer and stops when full.
+      CHECK_EQUAL(5U, queue.push_n(input + 3, 5U));
+      CHECK_EQUAL(0U, queue.push_n(input, 1U));
+      CHECK(queue.full());
+
+      CHECK_EQUAL(6U, queue.pop_n(output, 8U));
+      CHECK_EQUAL(4, output[0]);
+      CHECK_EQUAL(4, output[1]);
+      CHECK_EQUAL(5, output[2]);
+      CHECK_EQUAL(6, output[3]);
+      CHECK_EQUAL(7, output[4]);
+      CHECK_EQUAL(8, output[5]);
+
+      CHECK_EQUAL(0U, queue.pop_n(output, 1U));
+      CHECK(queue.empty());
+      CHECK_EQUAL(0U, queue.push_n(input, 0U));
+      CHECK_EQUAL(0U, queue.pop_n(output, 0U));
+    }
+
+    //*************************************************************************
+    TEST(test_push_n_pop_n_non_trivial)
+    {
+      etl::queue_spsc_atomic<std::string, 4> queue;
+
+      std::vector<std::string> input;
+      input.push_back("1");
+      input.push_back("2");
+      input.push_back("3");
+
+      std::vector<std::string> output;
+
+      CHECK_EQUAL(3U, queue.push_n(input.begin(), 3U));
+      CHECK(queue.push(std::string("4")));
+      CHECK_EQUAL(2U, queue.pop_n(std::back_inserter(output), 2U));
+      CHECK_EQUAL(2U, queue.push_n(input.begin(), 3U));
+      CHECK_EQUAL(4U, queue.pop_n(std::back_inserter(output), 4U));
+
+      CHECK_EQUAL(6U, output.size());
+      CHECK_EQUAL(std::string("1"), output[0]);
+      CHECK_EQUAL(std::string("2"), output[1]);
+      CHECK_EQUAL(std::string("3"), output[2]);
+      CHECK_EQUAL(std::string("4"), output[3]);
+      CHECK_EQUAL(std::string("1"), output[4]);
+      CHECK_EQUAL(std::string("2"), output[5]);
+
+      // Leave items behind for the destructor.
+      CHECK_EQUAL(3U, queue.push_n(input.begin(), 3U));
+    }
+
+    //*************************************************************************
+    TEST(test_push_n_pop_n_threads)
+    {
+      static etl::queue_spsc_atomic<int, 64> queue;
+
+      const int Length = 200000;
+
+      std::thread producer([&]()
+      {
+        int values[16];
+        int next = 0;
+
+        while (next < Length)
+        {
+          if ((next % 3) == 0)
+          {
+            // Single push.
+            if (queue.push(next))
+            {
+              ++next;
+            }
+          }
+          else
+          {
+            int count = (Length - next) < 16 ? (Length - next) : 16;
+
+            for (int i = 0; i < count; ++i)
+            {
+              values[i] = next + i;
+            }
+
+            next += int(queue.push_n(values, size_t(count)));
+          }
+        }
+      });
+
+      std::vector<int> received;
+      received.reserve(Length);
+
+      int values[11];
+
+      while (received.size() < size_t(Length))
+      {
+        if ((received.size() % 2) == 0)
+        {
+          int value;
+
+          if (queue.pop(value))
+          {
+            received.push_back(value);
+          }
+        }
+        else
+        {
+          size_t count = queue.pop_n(values, 11U);
+          received.insert(received.end(), values, values + count);
+        }
+      }
+
+      producer.join();
+
+      bool in_order = true;
+
+      for (int i = 0; i < Length; ++i)
+      {
+        in_order = in_order && (received[i] == i);
+      }
+
+      CHECK(in_order);
+      CHECK(queue.empty());
+    }
+
+#if ETL_HAS_FUTEX
+    //*************************************************************************
+    TEST(test_blocking_pop_wait_for_timeout)
+    {
+      etl::queue_spsc_atomic_blocking<int, 4> queue;
+
+      int value = 0;
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      CHECK(!queue.pop_wait_for(value, 20U));
+      CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(15));
+
+      CHECK(queue.push(1));
+      CHECK(queue.pop_wait_for(value, 20U));
+      CHECK_EQUAL(1, value);
+    }
+
+    //*************************************************************************
+    TEST(test_blocking_pop_wait_threads)
+    {
+      static etl::queue_spsc_atomic_blocking<int, 16> queue;
+
+      const int Length = 100000;
+
+      // Pauses now and then so that the consumer empties the queue and blocks.
+      std::thread producer([Length]()
+      {
+        int values[8];
+        int next = 0;
+
+        while (next < Length)
+        {
+          if ((next % 1000) == 0)
+          {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+          }
+
+          if ((next % 2) == 0)
+          {
+            if (queue.push(next))
+            {
+              ++next;
+            }
+          }
+          else
+          {
+            int count = (Length - next) < 8 ? (Length - next) : 8;
+
+            for (int i = 0; i < count; ++i)
+            {
+              values[i] = next + i;
+            }
+
+            next += int(queue.push_n(values, size_t(count)));
+          }
+        }
+      });
+
+      std::vector<int> received;
+      received.reserve(Length);
+
+      int values[5];
+
+      while (received.size() < size_t(Length))
+      {
+        if ((received.size() % 3) == 0)
+        {
+          int value;
+          queue.pop_wait(value);
+          received.push_back(value);
+        }
+        else
+        {
+          size_t count = queue.pop_n_wait(values, 5U);
+          CHECK(count != 0U);
+          received.insert(received.end(), values, values + count);
+        }
+      }
+
+      producer.join();
+
+      bool in_order = true;
+
+      for (int i = 0; i < Length; ++i)
+      {
+        in_order = in_order && (received[i] == i);
+      }
+
+      CHECK(in_order);
+    }
+#endif
+
     //*************************************************************************
 #if REALTIME_TEST && defined(ETL_COMPILER_MICROSOFT)
     #if defined(ETL_TARGET_OS_WINDOWS) // Only Windows priority is currently supported
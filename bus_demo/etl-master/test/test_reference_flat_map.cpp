@@ -976,5 +976,112 @@ namespace
 
       CHECK(initial1 != different);
     }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_freeze_without_index)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      CHECK(!data.freeze());
+      CHECK(!data.is_frozen());
+      CHECK(data.find(5) != data.end());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_frozen_lookup_matches_sorted_lookup)
+    {
+      typedef etl::reference_flat_map<int, NDC, 20, etl::less<int>, true> IndexedData;
+
+      // The map refers to these elements, so they must not move.
+      std::vector<ElementNDC> elements;
+      elements.reserve(20);
+
+      for (int i = 0; i < 20; ++i)
+      {
+        elements.push_back(ElementNDC(i * 3, N0));
+      }
+
+      IndexedData data;
+
+      // Every size exercises a different shape of the index tree.
+      for (int size = 0; size <= 20; ++size)
+      {
+        data.clear();
+        data.insert(elements.begin(), elements.begin() + size);
+
+        CHECK(data.freeze());
+        CHECK(data.is_frozen());
+
+        const IndexedData& cdata = data;
+
+        for (int key = -1; key <= (size * 3) + 1; ++key)
+        {
+          const size_t lower = size_t((key < 0) ? 0 : std::min((key + 2) / 3, size));
+          const size_t upper = size_t((key < 0) ? 0 : std::min((key / 3) + 1, size));
+
+          CHECK_EQUAL(lower, size_t(std::distance(data.begin(),  data.lower_bound(key))));
+          CHECK_EQUAL(upper, size_t(std::distance(data.begin(),  data.upper_bound(key))));
+          CHECK_EQUAL(lower, size_t(std::distance(cdata.begin(), cdata.lower_bound(key))));
+          CHECK_EQUAL(upper, size_t(std::distance(cdata.begin(), cdata.upper_bound(key))));
+          CHECK_EQUAL(lower, size_t(std::distance(data.begin(),  data.equal_range(key).first)));
+          CHECK_EQUAL(upper, size_t(std::distance(cdata.begin(), cdata.equal_range(key).second)));
+          CHECK_EQUAL((lower != upper), data.find(key) != data.end());
+          CHECK_EQUAL((lower != upper), cdata.find(key) != cdata.end());
+          CHECK_EQUAL((lower != upper) ? 1U : 0U, data.count(key));
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_modify_thaws_frozen_map)
+    {
+      typedef etl::reference_flat_map<int, NDC, SIZE, etl::less<int>, true> IndexedData;
+
+      IndexedData data(initial_data.begin(), initial_data.begin() + 5);
+      CHECK(data.freeze());
+      CHECK(data.find(3)->second == N3);
+
+      // Insert thaws the index; lookups then see the new element and the old ones.
+      data.insert(initial_data[7]);
+      CHECK(!data.is_frozen());
+      CHECK(data.find(7)->second == N7);
+      CHECK(data.find(4)->second == N4);
+      CHECK(data.lower_bound(5) == data.find(7));
+      CHECK(data.find(6) == data.end());
+
+      // Refreezing indexes the new element too.
+      CHECK(data.freeze());
+      CHECK(data.find(7)->second == N7);
+      CHECK(data.upper_bound(4) == data.find(7));
+
+      data.erase(2);
+      CHECK(!data.is_frozen());
+      CHECK(data.find(2) == data.end());
+      CHECK(data.find(3)->second == N3);
+
+      CHECK(data.freeze());
+      data.erase(data.begin());
+      CHECK(!data.is_frozen());
+      CHECK(data.find(0) == data.end());
+      CHECK(data.begin()->first == 1);
+
+      CHECK(data.freeze());
+      data.erase(data.find(3), data.end());
+      CHECK(!data.is_frozen());
+      CHECK_EQUAL(1U, data.size());
+      CHECK(data.find(7) == data.end());
+      CHECK(data.find(1)->second == N1);
+
+      CHECK(data.freeze());
+      data.clear();
+      CHECK(!data.is_frozen());
+      CHECK(data.find(1) == data.end());
+
+      data.insert(initial_data[9]);
+      CHECK(data.freeze());
+      data.thaw();
+      CHECK(!data.is_frozen());
+      CHECK(data.find(9)->second == N9);
+    }
   };
 }
@@ -762,6 +762,44 @@ namespace
       CHECK_EQUAL(std::distance(compare_data.begin(), i_compare.second), std::distance(data.begin(), i_data.second));
     }
 
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_equal_range_const)
+    {
+      Compare_DataNDC compare_data(initial_data.begin(), initial_data.end());
+      const DataNDC data(initial_data.begin(), initial_data.end());
+
+      ETL_OR_STD::pair<Compare_DataNDC::const_iterator, Compare_DataNDC::const_iterator> i_compare = compare_data.equal_range(N5);
+      ETL_OR_STD::pair<DataNDC::const_iterator, DataNDC::const_iterator> i_data = data.equal_range(N5);
+
+      CHECK_EQUAL(std::distance(compare_data.cbegin(), i_compare.first),  std::distance(data.cbegin(), i_data.first));
+      CHECK_EQUAL(std::distance(compare_data.cbegin(), i_compare.second), std::distance(data.cbegin(), i_data.second));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_frozen_lookup)
+    {
+      typedef etl::reference_flat_set<NDC, SIZE, etl::less<NDC>, true> IndexedData;
+
+      IndexedData data(initial_data.begin(), initial_data.end());
+      const IndexedData& cdata = data;
+
+      CHECK(data.freeze());
+
+      for (size_t i = 0UL; i < initial_data.size(); ++i)
+      {
+        CHECK(data.find(initial_data[i]) != data.end());
+        CHECK(data.equal_range(initial_data[i]).first  == data.find(initial_data[i]));
+        CHECK(cdata.equal_range(initial_data[i]).second == ++cdata.find(initial_data[i]));
+      }
+
+      CHECK(data.lower_bound(NX) == data.begin());
+      CHECK(data.upper_bound(NY) == data.end());
+
+      data.erase(N5);
+      CHECK(!data.is_frozen());
+      CHECK(data.find(N5) == data.end());
+    }
+
     //*************************************************************************
     TEST_FIXTURE(SetupFixture, test_equal_range_using_transparent_comparator)
     {
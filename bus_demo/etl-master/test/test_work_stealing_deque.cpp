@@ -0,0 +1,278 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "unit_test_framework.h"
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "etl/work_stealing_deque.h"
+
+#if ETL_HAS_ATOMIC
+
+namespace
+{
+  SUITE(test_work_stealing_deque)
+  {
+    //*************************************************************************
+    TEST(test_constructor)
+    {
+      etl::work_stealing_deque<int, 8> deque;
+
+      CHECK_EQUAL(8U, deque.max_size());
+      CHECK_EQUAL(8U, deque.capacity());
+      CHECK_EQUAL(0U, deque.size());
+      CHECK_EQUAL(8U, deque.available());
+      CHECK(deque.empty());
+      CHECK(!deque.full());
+    }
+
+    //*************************************************************************
+    TEST(test_push_pop_is_lifo)
+    {
+      etl::work_stealing_deque<int, 4> deque;
+
+      CHECK(deque.push(1));
+      CHECK(deque.push(2));
+      CHECK(deque.push(3));
+      CHECK_EQUAL(3U, deque.size());
+
+      int value = 0;
+
+      CHECK(deque.pop(value));
+      CHECK_EQUAL(3, value);
+      CHECK(deque.pop(value));
+      CHECK_EQUAL(2, value);
+      CHECK(deque.pop(value));
+      CHECK_EQUAL(1, value);
+      CHECK(!deque.pop(value));
+      CHECK(deque.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_push_steal_is_fifo)
+    {
+      etl::work_stealing_deque<int, 4> deque;
+
+      CHECK(deque.push(1));
+      CHECK(deque.push(2));
+      CHECK(deque.push(3));
+
+      int value = 0;
+
+      CHECK(deque.steal(value));
+      CHECK_EQUAL(1, value);
+      CHECK(deque.steal(value));
+      CHECK_EQUAL(2, value);
+      CHECK(deque.pop(value));
+      CHECK_EQUAL(3, value);
+      CHECK(!deque.steal(value));
+      CHECK(!deque.pop(value));
+      CHECK(deque.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_push_full)
+    {
+      etl::work_stealing_deque<int, 4> deque;
+
+      CHECK(deque.push(1));
+      CHECK(deque.push(2));
+      CHECK(deque.push(3));
+      CHECK(deque.push(4));
+      CHECK(deque.full());
+      CHECK(!deque.push(5));
+
+      int value = 0;
+
+      // Stealing makes room at the top.
+      CHECK(deque.steal(value));
+      CHECK_EQUAL(1, value);
+      CHECK(deque.push(5));
+      CHECK(deque.full());
+
+      CHECK(deque.pop(value));
+      CHECK_EQUAL(5, value);
+      CHECK(deque.steal(value));
+      CHECK_EQUAL(2, value);
+    }
+
+    //*************************************************************************
+    TEST(test_wrap_around)
+    {
+      etl::work_stealing_deque<int, 4> deque;
+
+      int next_pushed = 0;
+      int next_stolen = 0;
+
+      for (int i = 0; i < 100; ++i)
+      {
+        CHECK(deque.push(next_pushed++));
+        CHECK(deque.push(next_pushed++));
+
+        int value = -1;
+        CHECK(deque.steal(value));
+        CHECK_EQUAL(next_stolen++, value);
+        CHECK(deque.steal(value));
+        CHECK_EQUAL(next_stolen++, value);
+      }
+
+      CHECK(deque.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_clear)
+    {
+      etl::work_stealing_deque<int, 4> deque;
+
+      deque.push(1);
+      deque.push(2);
+      deque.clear();
+
+      CHECK(deque.empty());
+
+      int value = 0;
+      CHECK(!deque.steal(value));
+
+      CHECK(deque.push(3));
+      CHECK(deque.steal(value));
+      CHECK_EQUAL(3, value);
+    }
+
+    //*************************************************************************
+    TEST(test_interface)
+    {
+      etl::work_stealing_deque<int*, 2> deque;
+      etl::iwork_stealing_deque<int*>& ideque = deque;
+
+      int a = 1;
+      int* p = ETL_NULLPTR;
+
+      CHECK(ideque.push(&a));
+      CHECK(ideque.steal(p));
+      CHECK(p == &a);
+    }
+
+    //*************************************************************************
+    TEST(test_steal_threads)
+    {
+      static etl::work_stealing_deque<int, 64> deque;
+
+      const int Thieves = 3;
+      const int Length  = 200000;
+
+      std::vector<std::vector<int> > taken(Thieves + 1);
+      std::vector<std::thread> threads;
+      etl::atomic<bool> done(false);
+
+      // The owner pushes, and pops one item in every three.
+      threads.push_back(std::thread([&taken, &done, Length]()
+      {
+        int value = 0;
+
+        while (value < Length)
+        {
+          if (deque.push(value))
+          {
+            ++value;
+          }
+          else
+          {
+            std::this_thread::yield();
+          }
+
+          int popped;
+
+          if (((value % 3) == 0) && deque.pop(popped))
+          {
+            taken[0].push_back(popped);
+          }
+        }
+
+        int popped;
+
+        while (deque.pop(popped))
+        {
+          taken[0].push_back(popped);
+        }
+
+        done.store(true);
+      }));
+
+      for (int t = 1; t <= Thieves; ++t)
+      {
+        threads.push_back(std::thread([t, &taken, &done]()
+        {
+          int value;
+
+          while (!done.load())
+          {
+            if (deque.steal(value))
+            {
+              taken[t].push_back(value);
+            }
+            else
+            {
+              std::this_thread::yield();
+            }
+          }
+        }));
+      }
+
+      for (size_t i = 0UL; i < threads.size(); ++i)
+      {
+        threads[i].join();
+      }
+
+      // Every value is taken exactly once.
+      std::vector<int> all;
+
+      for (size_t t = 0UL; t < taken.size(); ++t)
+      {
+        all.insert(all.end(), taken[t].begin(), taken[t].end());
+      }
+
+      std::sort(all.begin(), all.end());
+
+      CHECK_EQUAL(size_t(Length), all.size());
+
+      bool all_present = true;
+
+      for (size_t i = 0UL; i < all.size(); ++i)
+      {
+        all_present = all_present && (all[i] == int(i));
+      }
+
+      CHECK(all_present);
+      CHECK(deque.empty());
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,432 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2026 John Wellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "unit_test_framework.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <thread>
+
+#include "etl/work_stealing_scheduler.h"
+
+#if ETL_HAS_ATOMIC
+
+namespace
+{
+  typedef std::vector<std::string> WorkList_t;
+
+  //***************************************************************************
+  /// A task that records the work it does, for checking the order of work.
+  //***************************************************************************
+  class Task : public etl::task
+  {
+  public:
+
+    Task(etl::task_priority_t priority_, const WorkList_t& work_, WorkList_t& done_)
+      : task(priority_)
+      , task_added(false)
+      , work(work_)
+      , done(done_)
+      , workIndex(0)
+    {
+    }
+
+    virtual uint32_t task_request_work() const ETL_OVERRIDE
+    {
+      return uint32_t(work.size() - workIndex);
+    }
+
+    virtual void task_process_work() ETL_OVERRIDE
+    {
+      done.push_back(work[workIndex]);
+      ++workIndex;
+    }
+
+    virtual void on_task_added() ETL_OVERRIDE
+    {
+      task_added = true;
+    }
+
+    bool task_added;
+
+  private:
+
+    WorkList_t  work;
+    WorkList_t& done;
+    size_t      workIndex;
+  };
+
+  //***************************************************************************
+  /// A task with a number of units of work.
+  /// Checks that it is never called by two workers at once.
+  //***************************************************************************
+  class CountingTask : public etl::task
+  {
+  public:
+
+    CountingTask(etl::task_priority_t priority_, uint32_t work_, etl::atomic<uint32_t>& total_done_)
+      : task(priority_)
+      , remaining(work_)
+      , processed(0)
+      , in_use(false)
+      , overlapped(false)
+      , total_done(total_done_)
+    {
+    }
+
+    virtual uint32_t task_request_work() const ETL_OVERRIDE
+    {
+      return remaining;
+    }
+
+    virtual void task_process_work() ETL_OVERRIDE
+    {
+      if (in_use.exchange(true))
+      {
+        overlapped = true;
+      }
+
+      // Some busy work.
+      volatile uint32_t x = 0;
+
+      for (int i = 0; i < 1000; ++i)
+      {
+        x = x + uint32_t(i);
+      }
+
+      --remaining;
+      ++processed;
+      total_done.fetch_add(1);
+
+      in_use.store(false);
+
+      // Let the other workers run, even on a single core.
+      std::this_thread::yield();
+    }
+
+    uint32_t remaining;
+    uint32_t processed;
+    etl::atomic<bool> in_use;
+    bool overlapped;
+
+  private:
+
+    etl::atomic<uint32_t>& total_done;
+  };
+
+  //***************************************************************************
+  /// Exits the scheduler once all of the work is done.
+  //***************************************************************************
+  template <typename TScheduler>
+  struct Control
+  {
+    Control(TScheduler& scheduler_, etl::atomic<uint32_t>& total_done_, uint32_t total_work_)
+      : idle_callback(*this, &Control::IdleCallback)
+      , scheduler(scheduler_)
+      , total_done(total_done_)
+      , total_work(total_work_)
+    {
+    }
+
+    void IdleCallback(size_t)
+    {
+      if (total_done.load() == total_work)
+      {
+        scheduler.exit_scheduler();
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    etl::function<Control, size_t> idle_callback;
+    TScheduler& scheduler;
+    etl::atomic<uint32_t>& total_done;
+    uint32_t total_work;
+  };
+
+  //***************************************************************************
+  /// Exits the scheduler when first idle.
+  //***************************************************************************
+  template <typename TScheduler>
+  struct ExitOnIdle
+  {
+    ExitOnIdle()
+      : idle_callback(*this, &ExitOnIdle::IdleCallback)
+      , watchdog_callback(*this, &ExitOnIdle::WatchdogCallback)
+      , pScheduler(nullptr)
+      , watchdog_calls(0)
+    {
+    }
+
+    void IdleCallback(size_t)
+    {
+      pScheduler->exit_scheduler();
+    }
+
+    void WatchdogCallback(size_t)
+    {
+      ++watchdog_calls;
+    }
+
+    etl::function<ExitOnIdle, size_t> idle_callback;
+    etl::function<ExitOnIdle, size_t> watchdog_callback;
+    TScheduler* pScheduler;
+    int watchdog_calls;
+  };
+
+  uint32_t ticks = 0;
+
+  uint32_t Clock()
+  {
+    return ++ticks;
+  }
+
+  SUITE(test_work_stealing_scheduler)
+  {
+    //*************************************************************************
+    TEST(test_add_task)
+    {
+      etl::work_stealing_scheduler<etl::scheduler_policy_sequential_single, 3, 6> s;
+
+      WorkList_t done;
+      WorkList_t work;
+
+      Task task1(1, work, done);
+      Task task2(2, work, done);
+      Task task3(3, work, done);
+      Task task4(4, work, done);
+      Task task5(5, work, done);
+
+      etl::task* taskList[] = { &task1, &task2, &task3, &task4 };
+
+      s.add_task_list(taskList, ETL_OR_STD17::size(taskList));
+      s.add_task(task5, 2);
+
+      CHECK(task1.task_added);
+      CHECK(task5.task_added);
+
+      // Tasks go to the worker with the fewest.
+      CHECK_EQUAL(2U, s.get_statistics(0).tasks_owned);
+      CHECK_EQUAL(1U, s.get_statistics(1).tasks_owned);
+      CHECK_EQUAL(2U, s.get_statistics(2).tasks_owned);
+
+      CHECK_THROW(s.add_task(task5, 3), etl::scheduler_invalid_worker_exception);
+      CHECK_THROW(s.get_statistics(3), etl::scheduler_invalid_worker_exception);
+
+      s.add_task(task5);
+      CHECK_THROW(s.add_task(task5), etl::scheduler_too_many_tasks_exception);
+    }
+
+    //*************************************************************************
+    TEST(test_single_worker_uses_policy)
+    {
+      typedef etl::work_stealing_scheduler<etl::scheduler_policy_sequential_single, 1, 3> Scheduler;
+
+      Scheduler s;
+      ExitOnIdle<Scheduler> control;
+      control.pScheduler = &s;
+
+      WorkList_t done;
+
+      Task task1(1, WorkList_t{ "T1W1", "T1W2", "T1W3" }, done);
+      Task task2(2, WorkList_t{ "T2W1", "T2W2", "T2W3", "T2W4" }, done);
+      Task task3(3, WorkList_t{ "T3W1", "T3W2" }, done);
+
+      s.set_idle_callback(control.idle_callback);
+      s.set_watchdog_callback(control.watchdog_callback);
+      s.add_task(task1);
+      s.add_task(task2);
+      s.add_task(task3);
+      s.start(0); // If 'start' returns then the idle callback was successfully called.
+
+      WorkList_t expected = { "T3W1", "T2W1", "T1W1", "T3W2", "T2W2", "T1W2", "T2W3", "T1W3", "T2W4" };
+
+      CHECK(expected == done);
+      CHECK_EQUAL(5, control.watchdog_calls);
+
+      etl::scheduler_worker_statistics statistics = s.get_statistics(0);
+
+      CHECK_EQUAL(4U, statistics.busy_passes);
+      CHECK_EQUAL(1U, statistics.idle_passes);
+      CHECK_EQUAL(0U, statistics.tasks_stolen);
+      CHECK_EQUAL(3U, statistics.tasks_owned);
+      CHECK_EQUAL(80U, statistics.get_utilisation());
+    }
+
+    //*************************************************************************
+    TEST(test_no_offers_without_idle_worker)
+    {
+      // Worker 1 never starts, so never signals idle. Worker 0 must not offer
+      // any of its tasks, and its policy must see all of them on every pass.
+      typedef etl::work_stealing_scheduler<etl::scheduler_policy_sequential_single, 2, 3> Scheduler;
+
+      Scheduler s;
+      ExitOnIdle<Scheduler> control;
+      control.pScheduler = &s;
+
+      WorkList_t done;
+
+      Task task1(1, WorkList_t{ "T1W1", "T1W2", "T1W3" }, done);
+      Task task2(2, WorkList_t{ "T2W1", "T2W2", "T2W3", "T2W4" }, done);
+      Task task3(3, WorkList_t{ "T3W1", "T3W2" }, done);
+
+      s.set_idle_callback(control.idle_callback);
+      s.add_task(task1, 0);
+      s.add_task(task2, 0);
+      s.add_task(task3, 0);
+      s.start(0);
+
+      WorkList_t expected = { "T3W1", "T2W1", "T1W1", "T3W2", "T2W2", "T1W2", "T2W3", "T1W3", "T2W4" };
+
+      CHECK(expected == done);
+
+      etl::scheduler_worker_statistics statistics = s.get_statistics(0);
+
+      CHECK_EQUAL(4U, statistics.busy_passes);
+      CHECK_EQUAL(1U, statistics.idle_passes);
+      CHECK_EQUAL(3U, statistics.tasks_owned);
+    }
+
+    //*************************************************************************
+    TEST(test_statistics_with_clock)
+    {
+      typedef etl::work_stealing_scheduler<etl::scheduler_policy_sequential_single, 1, 3> Scheduler;
+
+      Scheduler s;
+      ExitOnIdle<Scheduler> control;
+      control.pScheduler = &s;
+
+      WorkList_t done;
+
+      Task task1(1, WorkList_t{ "T1W1", "T1W2", "T1W3" }, done);
+
+      ticks = 0;
+
+      s.set_idle_callback(control.idle_callback);
+      s.set_clock(Clock);
+      s.add_task(task1);
+      s.start(0);
+
+      etl::scheduler_worker_statistics statistics = s.get_statistics(0);
+
+      // The clock advances by one tick per call, once at the start and once per pass.
+      CHECK_EQUAL(3U, statistics.busy_passes);
+      CHECK_EQUAL(1U, statistics.idle_passes);
+      CHECK_EQUAL(3U, statistics.busy_ticks);
+      CHECK_EQUAL(1U, statistics.idle_ticks);
+      CHECK_EQUAL(75U, statistics.get_utilisation());
+    }
+
+    //*************************************************************************
+    TEST(test_statistics_empty)
+    {
+      etl::scheduler_worker_statistics statistics;
+
+      CHECK_EQUAL(0U, statistics.get_utilisation());
+    }
+
+    //*************************************************************************
+    TEST(test_threads_steal_work)
+    {
+      const size_t   Workers     = 4;
+      const size_t   Tasks       = 16;
+      const uint32_t WorkPerTask = 1000;
+
+      typedef etl::work_stealing_scheduler<etl::scheduler_policy_sequential_single, Workers, Tasks> Scheduler;
+
+      static Scheduler s;
+      etl::atomic<uint32_t> total_done(0);
+
+      Control<Scheduler> control(s, total_done, Tasks * WorkPerTask);
+
+      std::vector<CountingTask*> tasks;
+
+      // Give every task to worker 0. The others must steal.
+      for (size_t i = 0; i < Tasks; ++i)
+      {
+        tasks.push_back(new CountingTask(etl::task_priority_t(i % 4), WorkPerTask, total_done));
+        s.add_task(*tasks.back(), 0);
+      }
+
+      s.set_idle_callback(control.idle_callback);
+
+      std::vector<std::thread> threads;
+
+      // Start worker 0 last, so that the others are waiting to steal.
+      for (size_t w = Workers; w-- > 0;)
+      {
+        threads.push_back(std::thread([w]()
+        {
+          s.start(w);
+        }));
+      }
+
+      for (size_t i = 0UL; i < threads.size(); ++i)
+      {
+        threads[i].join();
+      }
+
+      CHECK_EQUAL(Tasks * WorkPerTask, total_done.load());
+
+      bool all_done   = true;
+      bool no_overlap = true;
+
+      for (size_t i = 0; i < Tasks; ++i)
+      {
+        all_done   = all_done && (tasks[i]->processed == WorkPerTask);
+        no_overlap = no_overlap && !tasks[i]->overlapped;
+        delete tasks[i];
+      }
+
+      CHECK(all_done);
+      CHECK(no_overlap);
+
+      // Every task is owned by exactly one worker, and some moved from worker 0.
+      size_t owned  = 0;
+      size_t stolen = 0;
+
+      for (size_t w = 0; w < Workers; ++w)
+      {
+        etl::scheduler_worker_statistics statistics = s.get_statistics(w);
+
+        owned  += statistics.tasks_owned;
+        stolen += statistics.tasks_stolen;
+
+        CHECK(statistics.get_utilisation() <= 100U);
+      }
+
+      CHECK_EQUAL(Tasks, owned);
+      CHECK(stolen > 0U);
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,84 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: BusBuffer.h
+ * Author		: Fan Fei
+ * Description	: õĻ etl::spanֻӵڴ
+ * Comments		: ɢ/ۼ I/O Զбʾֱת iovec / i2c_msg
+ *				  ֮䴫
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <sys/uio.h>
+#include "etl/span.h"
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+#define BUS_IOV_MAX 16      // ηɢ/ۼ I/O Ķʱ BusErr_InvalidArgɵ÷
+
+/***************************************************************************
+ 						type definition
+***************************************************************************/
+typedef etl::span<uint8_t>       BusBuf;        // д壨Ŀ꣩
+typedef etl::span<const uint8_t> BusConstBuf;   // ֻ壨дԴ
+
+typedef etl::span<const BusBuf>      BusScatter;    // 
+typedef etl::span<const BusConstBuf> BusGather;     // дд
+
+/***************************************************************************
+ 						function definition
+***************************************************************************/
+// бת iovecݣնΣ iovec 
+// ÷ȼ segs.size() <= BUS_IOV_MAXﲻд BUS_IOV_MAX 
+template <typename TSpan>
+inline int busToIovec(etl::span<const TSpan> segs, struct iovec* iov)
+{
+    int n = 0;
+    for (size_t i = 0; i < segs.size() && n < BUS_IOV_MAX; ++i) {
+        if (segs[i].empty())
+            continue;
+        iov[n].iov_base = (void*)segs[i].data();
+        iov[n].iov_len  = segs[i].size();
+        ++n;
+    }
+    return n;
+}
+
+// бֽ
+template <typename TSpan>
+inline size_t busTotalBytes(etl::span<const TSpan> segs)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < segs.size(); ++i)
+        total += segs[i].size();
+    return total;
+}
+
+// д done ֽں󣬰 iovec ǰƵһδдĶΣʣ
+inline int busAdvanceIovec(struct iovec*& iov, int count, size_t done)
+{
+    while (count > 0 && done >= iov->iov_len) {
+        done -= iov->iov_len;
+        ++iov;
+        --count;
+    }
+    if (count > 0) {
+        iov->iov_base = (uint8_t*)iov->iov_base + done;
+        iov->iov_len -= done;
+    }
+    return count;
+}
+/******************************** FILE END ********************************/
@@ -0,0 +1,65 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: BusError.h
+ * Author		: Fan Fei
+ * Description	: ͳһ뷵
+ * Comments		: ʧʱͨ etl::expected Я롢errno ͳλ
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include "etl/expected.h"
+
+/***************************************************************************
+ 						type definition
+***************************************************************************/
+enum BusErrc {
+    BusErr_None = 0,
+    BusErr_NotOpen,         // 豸δ
+    BusErr_InvalidArg,      // Ƿָ롢Ϊ 0 ȣ
+    BusErr_Timeout,         // ȴʱδյ
+    BusErr_ShortRead,       // ĳȲ
+    BusErr_ShortWrite,      // дĳȲ
+    BusErr_Open,            // 豸/ socket ʧ
+    BusErr_Config,          // òʧܣtermiossetsockoptioctl ȣ
+    BusErr_Io,              // деϵͳʧ
+    BusErr_State,           // ǰ״̬²òдֵ
+    BusErr_Full             // 󱻾ܾ
+};
+
+struct BusError {
+    BusErrc     code;
+    int         sysErrno;   // 0 ʾϵͳô
+    const char* where;      // λãַ
+};
+
+typedef etl::expected<void, BusError> BusStatus;   // ֻĳɹ
+typedef etl::expected<int, BusError>  BusCount;    // ɹʱֽ
+
+/***************************************************************************
+ 						function declaration
+***************************************************************************/
+// ƣ־
+const char* busErrcName(BusErrc code);
+
+// 󷵻ֵ¼־ʱȵ÷Ԥڵ
+inline etl::unexpected<BusError> busError(BusErrc code, const char* where = "")
+{
+    BusError err = { code, 0, where };
+    return etl::unexpected<BusError>(err);
+}
+
+// 󷵻ֵϢͶݵ첽־ BusLog.h
+etl::unexpected<BusError> busFail(BusErrc code, int sysErrno, const char* where);
+/******************************** FILE END ********************************/
@@ -0,0 +1,223 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: BusLog.cpp
+ * Author		: Fan Fei
+ * Description	:
+ * Comments		:
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include "BusLog.h"
+
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/***************************************************************************
+ 						function definition
+***************************************************************************/
+static uint64_t monotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+const char* busErrcName(BusErrc code)
+{
+    switch (code) {
+    case BusErr_None:       return "ok";
+    case BusErr_NotOpen:    return "not open";
+    case BusErr_InvalidArg: return "invalid argument";
+    case BusErr_Timeout:    return "timeout";
+    case BusErr_ShortRead:  return "short read";
+    case BusErr_ShortWrite: return "short write";
+    case BusErr_Open:       return "open failed";
+    case BusErr_Config:     return "config failed";
+    case BusErr_Io:         return "io failed";
+    case BusErr_State:      return "bad state";
+    case BusErr_Full:       return "queue full";
+    default:                return "unknown";
+    }
+}
+
+etl::unexpected<BusError> busFail(BusErrc code, int sysErrno, const char* where)
+{
+    BusLog::instance().post(code, sysErrno, where);
+
+    BusError err = { code, sysErrno, where };
+    return etl::unexpected<BusError>(err);
+}
+
+/***************************************************************************
+ 						class definition
+***************************************************************************/
+BusLog& BusLog::instance()
+{
+    static BusLog log;
+    return log;
+}
+
+BusLog::BusLog()
+    : m_head(0)
+    , m_tail(0)
+    , m_windowSec(0)
+    , m_windowCount(0)
+    , m_suppressed(0)
+    , m_suppressedTotal(0)
+    , m_dropped(0)
+    , m_running(false)
+    , m_out(stderr)
+    , m_periodMs(20)
+{
+    for (uint32_t i = 0; i < BUS_LOG_CAPACITY; ++i)
+        m_slots[i].seq.store(i, etl::memory_order_relaxed);
+}
+
+BusLog::~BusLog()
+{
+    stop();
+}
+
+bool BusLog::allowByRate(uint64_t nowNs)
+{
+    // Ϊڼлʱľֻø¼лඪɽ
+    uint64_t sec    = nowNs / 1000000000ull;
+    uint64_t window = m_windowSec.load(etl::memory_order_relaxed);
+    if (window != sec) {
+        if (m_windowSec.compare_exchange_strong(window, sec, etl::memory_order_relaxed))
+            m_windowCount.store(0, etl::memory_order_relaxed);
+    }
+
+    if (m_windowCount.fetch_add(1, etl::memory_order_relaxed) >= BUS_LOG_RATE_PER_SEC) {
+        m_suppressed.fetch_add(1, etl::memory_order_relaxed);
+        m_suppressedTotal.fetch_add(1, etl::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool BusLog::post(BusErrc code, int sysErrno, const char* where)
+{
+    uint64_t now = monotonicNs();
+    if (!allowByRate(now))
+        return false;
+
+    // нÿλţŵλʱòλд
+    uint32_t pos = m_head.load(etl::memory_order_relaxed);
+    Slot*    slot;
+    for (;;) {
+        slot = &m_slots[pos & (BUS_LOG_CAPACITY - 1)];
+        uint32_t seq  = slot->seq.load(etl::memory_order_acquire);
+        int32_t  diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            if (m_head.compare_exchange_weak(pos, pos + 1, etl::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            // 
+            m_dropped.fetch_add(1, etl::memory_order_relaxed);
+            return false;
+        } else {
+            pos = m_head.load(etl::memory_order_relaxed);
+        }
+    }
+
+    slot->rec.tsNs     = now;
+    slot->rec.code     = code;
+    slot->rec.sysErrno = sysErrno;
+    slot->rec.where    = where;
+    slot->seq.store(pos + 1, etl::memory_order_release);
+    return true;
+}
+
+bool BusLog::pop(Record& rec)
+{
+    uint32_t pos = m_tail.load(etl::memory_order_relaxed);
+    Slot*    slot;
+    for (;;) {
+        slot = &m_slots[pos & (BUS_LOG_CAPACITY - 1)];
+        uint32_t seq  = slot->seq.load(etl::memory_order_acquire);
+        int32_t  diff = (int32_t)(seq - (pos + 1));
+        if (diff == 0) {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, etl::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false; // 
+        } else {
+            pos = m_tail.load(etl::memory_order_relaxed);
+        }
+    }
+
+    rec = slot->rec;
+    slot->seq.store(pos + BUS_LOG_CAPACITY, etl::memory_order_release);
+    return true;
+}
+
+int BusLog::drain(FILE* out)
+{
+    int    count = 0;
+    Record rec;
+    while (pop(rec)) {
+        if (rec.sysErrno != 0) {
+            fprintf(out, "[bus %llu.%06llu] %s: %s (%s)\n",
+                    (unsigned long long)(rec.tsNs / 1000000000ull),
+                    (unsigned long long)((rec.tsNs / 1000ull) % 1000000ull),
+                    rec.where, busErrcName(rec.code), strerror(rec.sysErrno));
+        } else {
+            fprintf(out, "[bus %llu.%06llu] %s: %s\n",
+                    (unsigned long long)(rec.tsNs / 1000000000ull),
+                    (unsigned long long)((rec.tsNs / 1000ull) % 1000000ull),
+                    rec.where, busErrcName(rec.code));
+        }
+        ++count;
+    }
+
+    uint32_t suppressed = m_suppressed.exchange(0, etl::memory_order_relaxed);
+    if (suppressed != 0)
+        fprintf(out, "[bus] %u messages suppressed by rate limit\n", suppressed);
+
+    if (count != 0 || suppressed != 0)
+        fflush(out);
+    return count;
+}
+
+void BusLog::run()
+{
+    while (m_running.load(etl::memory_order_acquire)) {
+        drain(m_out);
+        usleep((useconds_t)m_periodMs * 1000);
+    }
+    drain(m_out);
+}
+
+bool BusLog::start(FILE* out, int periodMs)
+{
+    if (m_running.load(etl::memory_order_acquire))
+        return true;
+
+    m_out      = (out != nullptr) ? out : stderr;
+    m_periodMs = (periodMs > 0) ? periodMs : 20;
+    m_running.store(true, etl::memory_order_release);
+    m_thread = std::thread(&BusLog::run, this);
+    return true;
+}
+
+void BusLog::stop()
+{
+    if (!m_running.exchange(false, etl::memory_order_acq_rel))
+        return;
+
+    if (m_thread.joinable())
+        m_thread.join();
+}
+/******************************** FILE END ********************************/
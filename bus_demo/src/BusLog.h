@@ -0,0 +1,92 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: BusLog.h
+ * Author		: Fan Fei
+ * Description	: Ϣ첽־
+ * Comments		: ֻ߳һӣʽд stderr ɺ̨߳
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <thread>
+#include "etl/atomic.h"
+#include "etl/array.h"
+#include "BusError.h"
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+#define BUS_LOG_CAPACITY      256   // ־ 2 
+#define BUS_LOG_RATE_PER_SEC  100   // ÿֻ
+
+/***************************************************************************
+ 						class declaration
+***************************************************************************/
+class BusLog {
+public:
+    struct Record {
+        uint64_t    tsNs;       // CLOCK_MONOTONIC ʱ
+        BusErrc     code;
+        int         sysErrno;
+        const char* where;
+    };
+
+    static BusLog& instance();
+
+    // Ͷһϣ߳̿ɵãϵͳ
+    // ־򳬹ʱ false
+    bool post(BusErrc code, int sysErrno, const char* where);
+
+    // /ֹ̨̣ͣ߳periodMs Ϊѯ
+    bool start(FILE* out = stderr, int periodMs = 20);
+    void stop();
+
+    // ڵǰ߳ȡм¼
+    int drain(FILE* out);
+
+    uint32_t dropped() const    { return m_dropped.load(etl::memory_order_relaxed); }
+    uint32_t suppressed() const { return m_suppressedTotal.load(etl::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        etl::atomic<uint32_t> seq;
+        Record                rec;
+    };
+
+    BusLog();
+    ~BusLog();
+    BusLog(const BusLog&);
+    BusLog& operator=(const BusLog&);
+
+    bool pop(Record& rec);
+    bool allowByRate(uint64_t nowNs);
+    void run();
+
+    etl::array<Slot, BUS_LOG_CAPACITY> m_slots;
+    etl::atomic<uint32_t> m_head;       // λ
+    etl::atomic<uint32_t> m_tail;       // ߳λ
+
+    etl::atomic<uint64_t> m_windowSec;  // ǰٴڣ룩
+    etl::atomic<uint32_t> m_windowCount;
+    etl::atomic<uint32_t> m_suppressed; // δٶ
+    etl::atomic<uint32_t> m_suppressedTotal;
+    etl::atomic<uint32_t> m_dropped;    // ־
+
+    std::thread           m_thread;
+    etl::atomic<bool>     m_running;
+    FILE*                 m_out;
+    int                   m_periodMs;
+};
+/******************************** FILE END ********************************/
@@ -0,0 +1,704 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: BusRing.cpp
+ * Author		: Fan Fei
+ * Description	:
+ * Comments		:
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include "BusRing.h"
+#include "BusLog.h"
+
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include <linux/can.h>
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+#define RING_BGID           1       // provided buffer 
+#define RING_NIL            0xFFFFFFFFu
+
+// user_data  8 λͣλΪԴŻͲ
+#define RING_TAG_READ       1ull
+#define RING_TAG_WRITE      2ull
+#define RING_TAG_BUFFER     3ull
+#define RING_TAG(tag, idx)  (((tag) << 56) | (uint64_t)(idx))
+
+// д EAGAIN / ENOBUFS / EINTR ˻غ Uart ԴCAN Դ Can ķ˱
+#define RING_TX_RETRY_US    1000
+
+// ɰںͷļû IORING_OP_READ_MULTISHOT6.7 룩ʱ probe ȷ
+#define RING_OP_READ_MULTISHOT 49
+
+/***************************************************************************
+ 						function definition
+***************************************************************************/
+static int ringSetup(unsigned entries, struct io_uring_params* p)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int ringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags,
+                     const void* arg, size_t argSize)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize);
+}
+
+static int ringRegister(int fd, unsigned opcode, void* arg, unsigned nrArgs)
+{
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs);
+}
+
+/***************************************************************************
+ 						class definition
+***************************************************************************/
+BusRing::BusRing()
+    : m_cfg()
+    , m_ringFd(-1)
+    , m_features(0)
+    , m_sq()
+    , m_cq()
+    , m_sqes(nullptr)
+    , m_sqesSize(0)
+    , m_pending(0)
+    , m_multishotRead(false)
+    , m_rxBase(nullptr)
+    , m_txBase(nullptr)
+    , m_bufSize(0)
+    , m_txSlots(nullptr)
+    , m_txFree(RING_NIL)
+    , m_bufDeferred(RING_NIL)
+    , m_sources()
+{
+    memset(&m_counters, 0, sizeof(m_counters));
+}
+
+BusRing::BusRing(const Config& cfg)
+    : m_cfg(cfg)
+    , m_ringFd(-1)
+    , m_features(0)
+    , m_sq()
+    , m_cq()
+    , m_sqes(nullptr)
+    , m_sqesSize(0)
+    , m_pending(0)
+    , m_multishotRead(false)
+    , m_rxBase(nullptr)
+    , m_txBase(nullptr)
+    , m_bufSize(0)
+    , m_txSlots(nullptr)
+    , m_txFree(RING_NIL)
+    , m_bufDeferred(RING_NIL)
+    , m_sources()
+{
+    memset(&m_counters, 0, sizeof(m_counters));
+}
+
+BusRing::~BusRing()
+{
+    close();
+}
+
+BusStatus BusRing::open()
+{
+    if (isOpen())
+        return BusStatus();
+
+    if (m_cfg.entries == 0 || m_cfg.bufferCount == 0 || m_cfg.bufferCount > 65535 ||
+        m_cfg.bufferSize < CAN_RAW_FRAME_SIZE || m_cfg.txSlots == 0 ||
+        m_cfg.txSlotSize == 0 || m_cfg.txSlotSize > 65535)
+        return busError(BusErr_InvalidArg, "ring config");
+
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    int fd = ringSetup(m_cfg.entries, &p);
+    if (fd < 0)
+        return busError(BusErr_Open, "io_uring_setup");   // ־߻˻ select
+
+    // Ҫ SINGLE_MMAP5.4 EXT_ARG5.11ʱȴϵںֱ select
+    if (!(p.features & IORING_FEAT_SINGLE_MMAP) || !(p.features & IORING_FEAT_EXT_ARG)) {
+        ::close(fd);
+        return busError(BusErr_Open, "io_uring features");
+    }
+
+    m_ringFd   = fd;
+    m_features = p.features;
+
+    size_t sqSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    size_t cqSize = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    size_t mapSize = (sqSize > cqSize) ? sqSize : cqSize;
+
+    void* ring = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      fd, IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED) {
+        BusStatus st = busFail(BusErr_Open, errno, "mmap sq ring");
+        close();
+        return st;
+    }
+
+    m_sq.map       = ring;
+    m_sq.mapSize   = mapSize;
+    m_sq.head      = (unsigned*)((uint8_t*)ring + p.sq_off.head);
+    m_sq.tail      = (unsigned*)((uint8_t*)ring + p.sq_off.tail);
+    m_sq.mask      = (unsigned*)((uint8_t*)ring + p.sq_off.ring_mask);
+    m_sq.array     = (unsigned*)((uint8_t*)ring + p.sq_off.array);
+    m_sq.localTail = *m_sq.tail;
+
+    m_cq.map     = ring;        // SINGLE_MMAPCQ  SQ һӳ
+    m_cq.mapSize = 0;
+    m_cq.head    = (unsigned*)((uint8_t*)ring + p.cq_off.head);
+    m_cq.tail    = (unsigned*)((uint8_t*)ring + p.cq_off.tail);
+    m_cq.mask    = (unsigned*)((uint8_t*)ring + p.cq_off.ring_mask);
+    m_cq.cqes    = (uint8_t*)ring + p.cq_off.cqes;
+
+    m_sqesSize = p.sq_entries * sizeof(struct io_uring_sqe);
+    m_sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  fd, IORING_OFF_SQES);
+    if (m_sqes == MAP_FAILED) {
+        m_sqes = nullptr;
+        BusStatus st = busFail(BusErr_Open, errno, "mmap sqes");
+        close();
+        return st;
+    }
+
+    BusStatus st = probe();
+    if (!st) {
+        close();
+        return st;
+    }
+
+    // շһӳ䲢Ԥȴвȱҳ
+    size_t rxSize   = (size_t)m_cfg.bufferCount * m_cfg.bufferSize;
+    size_t txSize   = (size_t)m_cfg.txSlots * m_cfg.txSlotSize;
+    size_t slotSize = (size_t)m_cfg.txSlots * sizeof(TxSlot);
+    m_bufSize = rxSize + txSize + slotSize;
+
+    void* buf = mmap(nullptr, m_bufSize, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (buf == MAP_FAILED) {
+        st = busFail(BusErr_Open, errno, "mmap ring buffers");
+        close();
+        return st;
+    }
+
+    m_rxBase  = (uint8_t*)buf;
+    m_txBase  = m_rxBase + rxSize;
+    m_txSlots = (TxSlot*)(m_txBase + txSize);
+
+    m_txFree = RING_NIL;
+    for (uint32_t i = m_cfg.txSlots; i-- > 0;) {
+        m_txSlots[i].next     = m_txFree;
+        m_txSlots[i].inflight = 0;
+        m_txFree = i;
+    }
+
+    // һ԰ȫջ彻ں
+    struct io_uring_sqe* sqe = (struct io_uring_sqe*)getSqe();
+    sqe->opcode    = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd        = (int)m_cfg.bufferCount;
+    sqe->addr      = (uint64_t)(uintptr_t)m_rxBase;
+    sqe->len       = m_cfg.bufferSize;
+    sqe->off       = 0;
+    sqe->buf_group = RING_BGID;
+    sqe->user_data = RING_TAG(RING_TAG_BUFFER, 0);
+
+    return BusStatus();
+}
+
+BusStatus BusRing::probe()
+{
+    // io_uring_probe ĩβ飬 256 
+    uint8_t mem[sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op)];
+    memset(mem, 0, sizeof(mem));
+    struct io_uring_probe* pr = (struct io_uring_probe*)mem;
+
+    if (ringRegister(m_ringFd, IORING_REGISTER_PROBE, pr, 256) < 0)
+        return busError(BusErr_Open, "io_uring probe");
+
+    const unsigned need[] = { IORING_OP_PROVIDE_BUFFERS, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_RECV };
+    for (size_t i = 0; i < sizeof(need) / sizeof(need[0]); ++i) {
+        if (need[i] > pr->last_op || !(pr->ops[need[i]].flags & IO_URING_OP_SUPPORTED))
+            return busError(BusErr_Open, "io_uring op missing");
+    }
+
+    m_multishotRead = (RING_OP_READ_MULTISHOT <= pr->last_op) &&
+                      (pr->ops[RING_OP_READ_MULTISHOT].flags & IO_URING_OP_SUPPORTED);
+    return BusStatus();
+}
+
+void BusRing::close()
+{
+    if (m_bufSize != 0) {
+        munmap(m_rxBase, m_bufSize);
+        m_rxBase  = nullptr;
+        m_txBase  = nullptr;
+        m_txSlots = nullptr;
+        m_bufSize = 0;
+    }
+    if (m_sqes != nullptr) {
+        munmap(m_sqes, m_sqesSize);
+        m_sqes = nullptr;
+    }
+    if (m_sq.map != nullptr) {
+        munmap(m_sq.map, m_sq.mapSize);
+        m_sq.map = nullptr;
+        m_cq.map = nullptr;
+    }
+    if (m_ringFd >= 0) {
+        // ر ring ȡδɵ
+        ::close(m_ringFd);
+        m_ringFd = -1;
+    }
+    m_sources.clear();
+    m_pending     = 0;
+    m_bufDeferred = RING_NIL;
+}
+
+unsigned BusRing::sqSpace() const
+{
+    unsigned head = __atomic_load_n(m_sq.head, __ATOMIC_ACQUIRE);
+    return *m_sq.mask + 1u - (m_sq.localTail - head);
+}
+
+void* BusRing::getSqe()
+{
+    if (sqSpace() == 0) {
+        // SQ ˣύһύʧʱܸں˻ûȡߵ SQE
+        if (m_pending == 0 || submitAndWait(0, 0) < 0 || sqSpace() == 0)
+            return nullptr;
+    }
+
+    unsigned idx = m_sq.localTail & *m_sq.mask;
+    struct io_uring_sqe* sqe = (struct io_uring_sqe*)m_sqes + idx;
+    memset(sqe, 0, sizeof(*sqe));
+    m_sq.array[idx] = idx;
+    ++m_sq.localTail;
+    ++m_pending;
+    return sqe;
+}
+
+int BusRing::submitAndWait(unsigned waitNr, int timeoutMs)
+{
+    __atomic_store_n(m_sq.tail, m_sq.localTail, __ATOMIC_RELEASE);
+
+    struct __kernel_timespec ts;
+    struct io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.sigmask_sz = _NSIG / 8;
+
+    unsigned flags = 0;
+    if (waitNr > 0) {
+        flags |= IORING_ENTER_GETEVENTS;
+        if (timeoutMs >= 0) {
+            ts.tv_sec  = timeoutMs / 1000;
+            ts.tv_nsec = (long long)(timeoutMs % 1000) * 1000000;
+            arg.ts     = (uint64_t)(uintptr_t)&ts;
+        }
+    }
+
+    unsigned toSubmit = m_pending;
+    ++m_counters.enters;
+    int ret = ringEnter(m_ringFd, toSubmit, waitNr, flags | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    if (ret < 0)
+        return -errno;
+
+    // ύ SQE ںѣδѵ´ύ
+    m_pending = (ret >= (int)toSubmit) ? 0 : toSubmit - (unsigned)ret;
+    return ret;
+}
+
+BusStatus BusRing::addSource(int fd, uint8_t kind, void* owner, void* handler, void* ctx)
+{
+    if (!isOpen())
+        return busError(BusErr_NotOpen, "ring add source");
+    if (fd < 0)
+        return busError(BusErr_NotOpen, "ring source fd");
+    if (m_sources.full())
+        return busError(BusErr_Full, "ring sources");
+
+    Source s;
+    s.fd         = fd;
+    s.kind       = kind;
+    s.armed      = 0;
+    s.multishot  = 1;
+    s.gotData    = 0;
+    s.owner      = owner;
+    s.handler    = handler;
+    s.ctx        = ctx;
+    s.txHead     = RING_NIL;
+    s.txTail     = RING_NIL;
+    s.txInflight = 0;
+    s.txRetryNs  = 0;
+    m_sources.push_back(s);
+
+    armRead((uint32_t)(m_sources.size() - 1));
+    return BusStatus();
+}
+
+BusStatus BusRing::addUart(Uart& uart, UartHandler handler, void* ctx)
+{
+    return addSource(uart.m_fd, Source_Uart, &uart, (void*)handler, ctx);
+}
+
+BusStatus BusRing::addCan(Can& can, CanHandler handler, void* ctx)
+{
+    return addSource(can.m_fd, Source_Can, &can, (void*)handler, ctx);
+}
+
+void BusRing::armRead(uint32_t index)
+{
+    Source& s = m_sources[index];
+    if (s.multishot && s.kind == Source_Uart && !m_multishotRead)
+        s.multishot = 0;
+
+    struct io_uring_sqe* sqe = (struct io_uring_sqe*)getSqe();
+    if (sqe == nullptr)
+        return;                 // armed Ϊ 0´ poll() ύ
+    sqe->fd        = s.fd;
+    sqe->flags     = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = RING_BGID;
+    sqe->len       = 0;         // 0ѡ
+    sqe->user_data = RING_TAG(RING_TAG_READ, index);
+
+    if (s.kind == Source_Can) {
+        // һһ֡෢ recv ڻ幻ʱһֱЧ
+        sqe->opcode = IORING_OP_RECV;
+        sqe->ioprio = s.multishot ? IORING_RECV_MULTISHOT : 0;
+    } else if (s.multishot) {
+        sqe->opcode = RING_OP_READ_MULTISHOT;
+    } else {
+        sqe->opcode = IORING_OP_READ;
+        sqe->off    = (uint64_t)-1;
+    }
+
+    s.armed = 1;
+}
+
+void BusRing::provideBuffer(uint32_t bid)
+{
+    struct io_uring_sqe* sqe = (struct io_uring_sqe*)getSqe();
+    if (sqe == nullptr) {
+        // ҵ黹´ poll() ٽں
+        memcpy(rxBuffer(bid), &m_bufDeferred, sizeof(m_bufDeferred));
+        m_bufDeferred = bid;
+        return;
+    }
+    sqe->opcode    = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd        = 1;
+    sqe->addr      = (uint64_t)(uintptr_t)rxBuffer(bid);
+    sqe->len       = m_cfg.bufferSize;
+    sqe->off       = bid;
+    sqe->buf_group = RING_BGID;
+    sqe->user_data = RING_TAG(RING_TAG_BUFFER, bid);
+}
+
+void BusRing::onRead(uint32_t index, int res, uint32_t flags)
+{
+    Source& s = m_sources[index];
+
+    if (!(flags & IORING_CQE_F_MORE)) {
+        // ѽľpoll() ĩβύ
+        s.armed = 0;
+    }
+
+    if (res > 0 && (flags & IORING_CQE_F_BUFFER)) {
+        uint32_t bid  = flags >> IORING_CQE_BUFFER_SHIFT;
+        uint8_t* data = rxBuffer(bid);
+        s.gotData = 1;
+
+        if (s.kind == Source_Can) {
+            Can& can = *(Can*)s.owner;
+            if (res == CAN_RAW_FRAME_SIZE && (((const struct can_frame*)data)->can_id & CAN_ERR_FLAG)) {
+                // ֻ֡ Can Ĵ״̬ص
+                can.onErrorFrame(data);
+            } else if (res == CAN_RAW_FRAME_SIZE) {
+                Can::Frame frame;
+                Can::fromRaw(data, frame);
+                ++m_counters.framesIn;
+                m_counters.bytesIn += frame.dlc;
+                ((CanHandler)s.handler)(s.ctx, can, frame);
+            }
+        } else {
+            m_counters.bytesIn += (uint64_t)res;
+            ((UartHandler)s.handler)(s.ctx, *(Uart*)s.owner, data, res);
+        }
+
+        // صغ󻺳黹һһύ
+        provideBuffer(bid);
+        return;
+    }
+
+    if (res == -ENOBUFS || res == -EINTR || res == -EAGAIN || res == -ECANCELED)
+        return;
+
+    if (res < 0 && s.multishot && !s.gotData &&
+        (res == -EINVAL || res == -EOPNOTSUPP || res == -EBADFD)) {
+        // 豸ֶ֧෢õÿɺύ
+        s.multishot = 0;
+        return;
+    }
+
+    if (res <= 0) {
+        // 0Զ˹ҶϣΪ豸󣬲ύת
+        s.armed = 2;
+        busFail(BusErr_Io, -res, (res == 0) ? "ring read hangup" : "ring read");
+    }
+}
+
+void BusRing::queueTx(uint32_t source, uint32_t slot)
+{
+    Source& s = m_sources[source];
+    m_txSlots[slot].next = RING_NIL;
+    if (s.txTail == RING_NIL)
+        s.txHead = slot;
+    else
+        m_txSlots[s.txTail].next = slot;
+    s.txTail = slot;
+}
+
+//  true ʾԴݴд˱
+bool BusRing::flushTx(uint32_t source)
+{
+    Source& s = m_sources[source];
+    if (s.txInflight != 0 || s.txHead == RING_NIL)
+        return false;
+
+    // д˻غ˱ܽύCAN Դ Can::send() ͬһ˱ܴ
+    if (s.txRetryNs != 0) {
+        if (BusStats::nowNs() < s.txRetryNs)
+            return true;
+        s.txRetryNs = 0;
+    }
+    if (s.kind == Source_Can && !((Can*)s.owner)->txGate("ring write"))
+        return true;
+
+    // ͬһԴд IO_LINK ֤˳ɣһʧܺĻᱻȡ´ᡣ
+    // һ io_uring_enter ύ;ύضϣ
+    // ŲʱȰŶӵ SQE ύԷŲ¾Ͱʣռض̣ʣµĵɺύ
+    unsigned need = 0;
+    for (uint32_t i = s.txHead; i != RING_NIL; i = m_txSlots[i].next)
+        ++need;
+    if (need > sqSpace() && m_pending != 0)
+        submitAndWait(0, 0);
+    unsigned room = sqSpace();
+    if (need > room)
+        need = room;
+
+    uint32_t i = s.txHead;
+    for (unsigned n = 0; n < need; ++n, i = m_txSlots[i].next) {
+        TxSlot& t = m_txSlots[i];
+        struct io_uring_sqe* sqe = (struct io_uring_sqe*)getSqe();
+        sqe->opcode    = IORING_OP_WRITE;
+        sqe->fd        = s.fd;
+        sqe->addr      = (uint64_t)(uintptr_t)(txBuffer(i) + t.off);
+        sqe->len       = (uint32_t)(t.len - t.off);
+        sqe->off       = (uint64_t)-1;
+        sqe->flags     = (n + 1 < need) ? IOSQE_IO_LINK : 0;
+        sqe->user_data = RING_TAG(RING_TAG_WRITE, i);
+        t.inflight = 1;
+        ++s.txInflight;
+    }
+    return false;
+}
+
+void BusRing::onWrite(uint32_t slot, int res)
+{
+    TxSlot& t = m_txSlots[slot];
+    Source& s = m_sources[t.source];
+    t.inflight = 0;
+    --s.txInflight;
+
+    bool done = false;
+    if (res >= 0) {
+        t.off = (uint16_t)(t.off + res);
+        m_counters.bytesOut += (uint64_t)res;
+        done = (t.off >= t.len);
+        if (done && s.kind == Source_Can) {
+            ++m_counters.framesOut;
+            ((Can*)s.owner)->txSucceeded();
+        }
+    } else if (res == -EAGAIN || res == -ENOBUFS || res == -EINTR) {
+        // Ͷһ poll() ᣬCAN  Can ָ˱ܣUart ̶һ
+        if (s.kind == Source_Can && res != -EINTR)
+            ((Can*)s.owner)->txFailed(-res, "ring write");
+        else
+            s.txRetryNs = BusStats::nowNs() + (uint64_t)RING_TX_RETRY_US * 1000u;
+    } else if (res != -ECANCELED) {
+        ++m_counters.writeErrors;
+        busFail(BusErr_Io, -res, "ring write");
+        done = true;
+    }
+
+    if (!done)
+        return;
+
+    // ԴĴдժ黹
+    uint32_t prev = RING_NIL;
+    for (uint32_t i = s.txHead; i != RING_NIL; prev = i, i = m_txSlots[i].next) {
+        if (i != slot)
+            continue;
+        if (prev == RING_NIL)
+            s.txHead = t.next;
+        else
+            m_txSlots[prev].next = t.next;
+        if (s.txTail == slot)
+            s.txTail = prev;
+        break;
+    }
+    t.next   = m_txFree;
+    m_txFree = slot;
+}
+
+BusStatus BusRing::write(Uart& uart, const uint8_t* data, int len)
+{
+    if (!isOpen())
+        return busError(BusErr_NotOpen, "ring write");
+    if (data == nullptr || len <= 0)
+        return busError(BusErr_InvalidArg, "ring write");
+
+    uint32_t source = RING_NIL;
+    for (uint32_t i = 0; i < m_sources.size(); ++i) {
+        if (m_sources[i].owner == &uart)
+            source = i;
+    }
+    if (source == RING_NIL)
+        return busError(BusErr_InvalidArg, "ring write unknown uart");
+
+    // ҪôŶӣҪôξܾ
+    uint32_t need = ((uint32_t)len + m_cfg.txSlotSize - 1) / m_cfg.txSlotSize;
+    uint32_t have = 0;
+    for (uint32_t i = m_txFree; i != RING_NIL && have < need; i = m_txSlots[i].next)
+        ++have;
+    if (have < need) {
+        ++m_counters.txFull;
+        return busError(BusErr_Full, "ring tx slots");
+    }
+
+    for (int off = 0; off < len; off += (int)m_cfg.txSlotSize) {
+        uint32_t slot = m_txFree;
+        m_txFree = m_txSlots[slot].next;
+
+        int n = len - off;
+        if (n > (int)m_cfg.txSlotSize)
+            n = (int)m_cfg.txSlotSize;
+        memcpy(txBuffer(slot), data + off, (size_t)n);
+
+        TxSlot& t = m_txSlots[slot];
+        t.len    = (uint16_t)n;
+        t.off    = 0;
+        t.source = (uint8_t)source;
+        queueTx(source, slot);
+    }
+    return BusStatus();
+}
+
+BusStatus BusRing::send(Can& can, const Can::Frame& frame)
+{
+    if (!isOpen())
+        return busError(BusErr_NotOpen, "ring send");
+
+    uint32_t source = RING_NIL;
+    for (uint32_t i = 0; i < m_sources.size(); ++i) {
+        if (m_sources[i].owner == &can)
+            source = i;
+    }
+    if (source == RING_NIL)
+        return busError(BusErr_InvalidArg, "ring send unknown can");
+
+    if (m_txFree == RING_NIL || m_cfg.txSlotSize < CAN_RAW_FRAME_SIZE) {
+        ++m_counters.txFull;
+        return busError(BusErr_Full, "ring tx slots");
+    }
+
+    uint32_t slot = m_txFree;
+    m_txFree = m_txSlots[slot].next;
+    Can::toRaw(frame, txBuffer(slot));
+
+    TxSlot& t = m_txSlots[slot];
+    t.len    = CAN_RAW_FRAME_SIZE;
+    t.off    = 0;
+    t.source = (uint8_t)source;
+    queueTx(source, slot);
+    return BusStatus();
+}
+
+BusCount BusRing::poll(int timeoutMs)
+{
+    if (!isOpen())
+        return busError(BusErr_NotOpen, "ring poll");
+
+    while (m_bufDeferred != RING_NIL && sqSpace() != 0) {
+        uint32_t bid = m_bufDeferred;
+        memcpy(&m_bufDeferred, rxBuffer(bid), sizeof(m_bufDeferred));
+        provideBuffer(bid);
+    }
+
+    bool txDeferred = false;
+    for (uint32_t i = 0; i < m_sources.size(); ++i) {
+        if (m_sources[i].armed == 0) {
+            ++m_counters.rearms;
+            armRead(i);
+        }
+        if (flushTx(i))
+            txDeferred = true;
+
+        // bus-off ·ȴʱصʱ
+        if (m_sources[i].kind == Source_Can) {
+            int restartMs = ((Can*)m_sources[i].owner)->serviceRestart();
+            if (restartMs >= 0 && (timeoutMs < 0 || restartMs < timeoutMs))
+                timeoutMs = restartMs;
+        }
+    }
+
+    // з˱ʱȴ 1ms˱ܼܽʱ
+    if (txDeferred && (timeoutMs < 0 || timeoutMs > 1))
+        timeoutMs = 1;
+
+    int ret = submitAndWait(1, timeoutMs);
+    if (ret < 0 && ret != -ETIME && ret != -EINTR && ret != -EBUSY)
+        return busFail(BusErr_Io, -ret, "io_uring_enter");
+
+    // ոһζ tailһд head
+    int handled = 0;
+    unsigned head = *m_cq.head;
+    unsigned tail = __atomic_load_n(m_cq.tail, __ATOMIC_ACQUIRE);
+    const unsigned mask = *m_cq.mask;
+
+    for (; head != tail; ++head) {
+        const struct io_uring_cqe* cqe = (const struct io_uring_cqe*)m_cq.cqes + (head & mask);
+        uint64_t tag   = cqe->user_data >> 56;
+        uint32_t index = (uint32_t)(cqe->user_data & 0xFFFFFFFFu);
+        ++m_counters.completions;
+
+        if (tag == RING_TAG_READ) {
+            onRead(index, cqe->res, cqe->flags);
+            ++handled;
+        } else if (tag == RING_TAG_WRITE) {
+            onWrite(index, cqe->res);
+            ++handled;
+        } else if (tag == RING_TAG_BUFFER && cqe->res < 0) {
+            busFail(BusErr_Io, -cqe->res, "ring provide buffers");
+        }
+    }
+    __atomic_store_n(m_cq.head, head, __ATOMIC_RELEASE);
+
+    return handled;
+}
+/******************************** FILE END ********************************/
@@ -0,0 +1,182 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: BusRing.h
+ * Author		: Fan Fei
+ * Description	: io_uring շˣһ̷߳· Uart / Can
+ * Comments		: ֱ io_uring_setup/io_uring_enter ϵͳú linux/io_uring.h
+ *				   liburingں˲֧ʱ open() ʧܣ߼ select ·
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include "etl/vector.h"
+#include "Uart.h"
+#include "Can.h"
+#include "BusError.h"
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+#define BUS_RING_MAX_SOURCES 16
+
+/***************************************************************************
+ 						class declaration
+***************************************************************************/
+class BusRing {
+public:
+    // ص poll() ִ߳Уdata ֻڻصڼЧ
+    typedef void (*UartHandler)(void* ctx, Uart& uart, const uint8_t* data, int len);
+    typedef void (*CanHandler)(void* ctx, Can& can, const Can::Frame& frame);
+
+    struct Config {
+        Config()
+            : entries(256)
+            , bufferCount(128)
+            , bufferSize(1024)
+            , txSlots(256)
+            , txSlotSize(256)
+        {
+        }
+
+        uint32_t entries;       // SQ ȣ2 
+        uint32_t bufferCount;   // õ provided buffer Դã
+        uint32_t bufferSize;    // ÿջĴСCAN ÿ֡ռһ
+        uint32_t txSlots;       // Ͳ۸ȿύ
+        uint32_t txSlotSize;    // ÿͲ۵ĴСUart дɶ
+    };
+
+    struct Counters {
+        uint64_t enters;        // io_uring_enter ô
+        uint64_t completions;   // ո CQE 
+        uint64_t rearms;        // ύ෢򵥷ģʽ
+        uint64_t bytesIn;
+        uint64_t framesIn;
+        uint64_t bytesOut;
+        uint64_t framesOut;
+        uint64_t writeErrors;
+        uint64_t txFull;        // ͲþܾĴ
+    };
+
+    BusRing();
+    BusRing(const Config& cfg);
+    ~BusRing();
+
+    // ں˲֧ io_uring ȱʱ BusErr_Open
+    BusStatus open();
+    void close();
+    bool isOpen() const { return m_ringFd >= 0; }
+
+    // Դ open BusRing رǰִ
+    BusStatus addUart(Uart& uart, UartHandler handler, void* ctx);
+    BusStatus addCan(Can& can, CanHandler handler, void* ctx);
+
+    // 뷢Ͳ۲Ŷӣ´ poll() ʱһύ
+    // ͬһԴд˳
+    BusStatus write(Uart& uart, const uint8_t* data, int len);
+    BusStatus send(Can& can, const Can::Frame& frame);
+
+    // һ io_uring_enter ύŶ󲢵ȴһɣȻոַص
+    // شʱ 0timeoutMs < 0 ʾһֱ
+    BusCount poll(int timeoutMs);
+
+    bool multishot() const { return m_multishotRead; }
+    void counters(Counters& out) const { out = m_counters; }
+
+private:
+    enum SourceKind {
+        Source_Uart,
+        Source_Can
+    };
+
+    struct Source {
+        int      fd;
+        uint8_t  kind;
+        uint8_t  armed;         // Ƿں
+        uint8_t  multishot;     // ǰǷΪ෢
+        uint8_t  gotData;       // Ƿɹݣж϶෢Ƿ
+        void*    owner;         // Uart*  Can*
+        void*    handler;
+        void*    ctx;
+        uint32_t txHead;        // дύ˳
+        uint32_t txTail;
+        uint32_t txInflight;
+        uint64_t txRetryNs;     // д˻أEAGAIN ȣʱᣬ0 ʾ
+    };
+
+    struct TxSlot {
+        uint32_t next;
+        uint16_t len;
+        uint16_t off;
+        uint8_t  source;
+        uint8_t  inflight;
+    };
+
+    struct SubmissionRing {
+        unsigned* head;
+        unsigned* tail;
+        unsigned* mask;
+        unsigned* array;
+        unsigned  localTail;
+        void*     map;
+        size_t    mapSize;
+    };
+
+    struct CompletionRing {
+        unsigned* head;
+        unsigned* tail;
+        unsigned* mask;
+        void*     cqes;
+        void*     map;
+        size_t    mapSize;
+    };
+
+    BusRing(const BusRing&);
+    BusRing& operator=(const BusRing&);
+
+    BusStatus addSource(int fd, uint8_t kind, void* owner, void* handler, void* ctx);
+    BusStatus probe();
+    void*     getSqe();         // SQ ύȥʱ nullptr
+    unsigned  sqSpace() const;
+    int       submitAndWait(unsigned waitNr, int timeoutMs);
+    void      armRead(uint32_t index);
+    void      provideBuffer(uint32_t bid);
+    void      queueTx(uint32_t source, uint32_t slot);
+    bool      flushTx(uint32_t source);
+    void      onRead(uint32_t index, int res, uint32_t flags);
+    void      onWrite(uint32_t slot, int res);
+    uint8_t*  rxBuffer(uint32_t bid) const { return m_rxBase + (size_t)bid * m_cfg.bufferSize; }
+    uint8_t*  txBuffer(uint32_t slot) const { return m_txBase + (size_t)slot * m_cfg.txSlotSize; }
+
+    Config          m_cfg;
+    int             m_ringFd;
+    unsigned        m_features;
+    SubmissionRing  m_sq;
+    CompletionRing  m_cq;
+    void*           m_sqes;
+    size_t          m_sqesSize;
+    unsigned        m_pending;      // дδύ SQE 
+    bool            m_multishotRead;
+
+    uint8_t*        m_rxBase;
+    uint8_t*        m_txBase;
+    size_t          m_bufSize;
+    TxSlot*         m_txSlots;
+    uint32_t        m_txFree;       // в
+    uint32_t        m_bufDeferred;  // SQ ʱûܹ黹Ľջ壬ָڻͷ 4 ֽ
+
+    etl::vector<Source, BUS_RING_MAX_SOURCES> m_sources;
+    Counters        m_counters;
+};
+/******************************** FILE END ********************************/
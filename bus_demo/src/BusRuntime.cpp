@@ -0,0 +1,275 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: BusRuntime.cpp
+ * Author		: Fan Fei
+ * Description	:
+ * Comments		:
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include "BusRuntime.h"
+#include "BusLog.h"
+#include "BusStats.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <alloca.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+/***************************************************************************
+ 						function definition
+***************************************************************************/
+// ̵ǰǷڴ棨/proc/self/status  VmLck  0ʱ
+//  close() ʱҲڴ
+static bool processHasLockedMemory()
+{
+    FILE* fp = fopen("/proc/self/status", "r");
+    if (fp == nullptr)
+        return true;
+
+    bool locked = true;
+    char line[128];
+    while (fgets(line, sizeof(line), fp) != nullptr) {
+        unsigned long kb = 0;
+        if (sscanf(line, "VmLck: %lu", &kb) == 1) {
+            locked = (kb != 0);
+            break;
+        }
+    }
+    fclose(fp);
+    return locked;
+}
+
+/***************************************************************************
+ 						class definition
+***************************************************************************/
+BusRuntime::BusRuntime(const Config& cfg)
+    : m_cfg(cfg)
+    , m_locked(false)
+{
+}
+
+BusRuntime::~BusRuntime()
+{
+    joinThreads();
+    close();
+}
+
+BusStatus BusRuntime::open()
+{
+    // ڴ棺֮豸仺ҳ᳣פ
+    // ֮ǰڴʱճ MCL_FUTUREΪģclose() 
+    if (m_cfg.lockMemory && !m_locked) {
+        bool ownLock = !processHasLockedMemory();
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0)
+            return busFail(BusErr_Config, errno, "mlockall");
+        m_locked = ownLock;
+    }
+
+    for (size_t i = 0; i < m_cfg.uarts.size(); ++i) {
+        m_uarts[i].reconfigure(m_cfg.uarts[i]);
+        BusStatus st = m_uarts[i].open();
+        if (!st) {
+            close();
+            return st;
+        }
+    }
+
+    for (size_t i = 0; i < m_cfg.cans.size(); ++i) {
+        m_cans[i].reconfigure(m_cfg.cans[i]);
+        BusStatus st = m_cans[i].open();
+        if (!st) {
+            close();
+            return st;
+        }
+    }
+
+    for (size_t i = 0; i < m_cfg.gpios.size(); ++i) {
+        m_gpios[i].reconfigure(m_cfg.gpios[i]);
+        BusStatus st = m_gpios[i].open();
+        if (!st) {
+            close();
+            return st;
+        }
+    }
+
+    return BusStatus();
+}
+
+void BusRuntime::close()
+{
+    for (int i = 0; i < BUS_RT_MAX_UARTS; ++i)
+        m_uarts[i].close();
+    for (int i = 0; i < BUS_RT_MAX_CANS; ++i)
+        m_cans[i].close();
+    for (int i = 0; i < BUS_RT_MAX_GPIOS; ++i)
+        m_gpios[i].close();
+
+    // munlockall ǽ̼ģֻ open() ʱûбڴŵ
+    if (m_locked) {
+        munlockall();
+        m_locked = false;
+    }
+}
+
+BusStatus BusRuntime::applyThread(const ThreadConfig& cfg)
+{
+    if (cfg.cpuMask != 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64; ++cpu) {
+            if (cfg.cpuMask & (1ull << cpu))
+                CPU_SET(cpu, &set);
+        }
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (err != 0)
+            return busFail(BusErr_Config, err, "pthread_setaffinity_np");
+    }
+
+    if (cfg.rtPriority > 0) {
+        struct sched_param sp;
+        memset(&sp, 0, sizeof(sp));
+        sp.sched_priority = cfg.rtPriority;
+        int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+        if (err != 0)
+            return busFail(BusErr_Config, err, "pthread_setschedparam SCHED_FIFO");
+    }
+
+    if (cfg.stackPrefaultKb > 0)
+        prefaultStack((size_t)cfg.stackPrefaultKb * 1024);
+
+    return BusStatus();
+}
+
+void BusRuntime::prefault(void* buf, size_t len)
+{
+    if (buf == nullptr || len == 0)
+        return;
+
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0)
+        page = 4096;
+
+    // volatile дͬһֵȴȱҳֲ
+    volatile uint8_t* p = (volatile uint8_t*)buf;
+    for (size_t off = 0; off < len; off += (size_t)page)
+        p[off] = p[off];
+    p[len - 1] = p[len - 1];
+}
+
+void BusRuntime::prefaultStack(size_t bytes)
+{
+    // ڵǰջ֡·һ鲢ҳдչջҳ mlockall 󱣳ֳפ
+    volatile uint8_t* stack = (volatile uint8_t*)alloca(bytes);
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0)
+        page = 4096;
+    for (size_t off = 0; off < bytes; off += (size_t)page)
+        stack[off] = 0;
+}
+
+void BusRuntime::threadEntry(ThreadStart start)
+{
+    // Ӧʧֻ¼־߳ճУû CAP_SYS_NICE
+    applyThread(start.cfg);
+    start.fn(start.ctx);
+}
+
+BusStatus BusRuntime::startThread(ThreadFn fn, void* ctx)
+{
+    if (fn == nullptr)
+        return busError(BusErr_InvalidArg, "runtime thread fn");
+    if (m_threads.full())
+        return busError(BusErr_Full, "runtime threads");
+
+    ThreadStart start;
+    start.cfg = m_cfg.io;
+    start.fn  = fn;
+    start.ctx = ctx;
+    m_threads.push_back(std::thread(threadEntry, start));
+    return BusStatus();
+}
+
+void BusRuntime::joinThreads()
+{
+    for (size_t i = 0; i < m_threads.size(); ++i) {
+        if (m_threads[i].joinable())
+            m_threads[i].join();
+    }
+    m_threads.clear();
+}
+
+BusStatus BusRuntime::measureWakeup(int intervalUs, int loops, WakeupStats& out)
+{
+    memset(&out, 0, sizeof(out));
+    if (intervalUs <= 0 || loops <= 0)
+        return busError(BusErr_InvalidArg, "runtime wakeup args");
+
+    out.minNs = 0xFFFFFFFFu;
+    uint64_t sum  = 0;
+    uint64_t next = BusStats::nowNs();
+
+    for (int i = 0; i < loops; ++i) {
+        next += (uint64_t)intervalUs * 1000ull;
+
+        struct timespec ts;
+        ts.tv_sec  = (time_t)(next / 1000000000ull);
+        ts.tv_nsec = (long)(next % 1000000000ull);
+        int err;
+        while ((err = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr)) == EINTR) {
+        }
+        if (err != 0)
+            return busFail(BusErr_Io, err, "clock_nanosleep");
+
+        uint64_t now  = BusStats::nowNs();
+        uint64_t late = (now > next) ? now - next : 0;
+        uint32_t ns   = (late > 0xFFFFFFFFull) ? 0xFFFFFFFFu : (uint32_t)late;
+
+        if (ns < out.minNs)
+            out.minNs = ns;
+        if (ns > out.maxNs)
+            out.maxNs = ns;
+        sum += ns;
+
+        uint32_t us = ns / 1000u;
+        if (us < BUS_RT_HIST_US)
+            ++out.histUs[us];
+        else
+            ++out.overflow;
+        ++out.loops;
+
+        // 󳬹һʱӵǰʱţ˯
+        if (now > next + (uint64_t)intervalUs * 1000ull)
+            next = now;
+    }
+
+    out.avgNs = (double)sum / (double)out.loops;
+
+    uint32_t target = out.loops - out.loops / 100;
+    uint32_t seen   = 0;
+    out.p99Us = BUS_RT_HIST_US;
+    for (uint32_t us = 0; us < BUS_RT_HIST_US; ++us) {
+        seen += out.histUs[us];
+        if (seen >= target) {
+            out.p99Us = us;
+            break;
+        }
+    }
+    return BusStatus();
+}
+/******************************** FILE END ********************************/
@@ -0,0 +1,139 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: BusRuntime.h
+ * Author		: Fan Fei
+ * Description	: ʵʱ I/O ߳лCPU 󶨡SCHED_FIFOmlockall
+ *				  ջͻԤȱҳԼ cyclictest Ļʱͳ
+ * Comments		: һ Config  I/O ࣨ߳ + ȫ Uart/Can/Gpio
+ *				  open() ˳ڴ豸
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <thread>
+#include "etl/vector.h"
+#include "Uart.h"
+#include "Can.h"
+#include "Gpio.h"
+#include "BusError.h"
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+#define BUS_RT_MAX_UARTS  4
+#define BUS_RT_MAX_CANS   2
+#define BUS_RT_MAX_GPIOS  8
+#define BUS_RT_MAX_THREADS 4
+#define BUS_RT_HIST_US    1000  // ʱֱͼ 1 us Ͱļ overflow
+
+/***************************************************************************
+ 						class declaration
+***************************************************************************/
+class BusRuntime {
+public:
+    // ߳ԣI/O ߳ʱӦãٽҵѭ
+    struct ThreadConfig {
+        ThreadConfig()
+            : cpuMask(0)
+            , rtPriority(0)
+            , stackPrefaultKb(64)
+        {
+        }
+
+        uint64_t cpuMask;         //  i λΪ 1 ʾ CPU i ϣ0 ʾ
+        int      rtPriority;      // 1-99 ʹ SCHED_FIFO0 Ĭϵ
+        int      stackPrefaultKb; // ߳ʱԤȴջС
+    };
+
+    struct Config {
+        Config()
+            : io()
+            , lockMemory(1)
+        {
+        }
+
+        ThreadConfig io;
+        int          lockMemory;  //  0 ʱ mlockall(MCL_CURRENT | MCL_FUTURE) open()
+
+        etl::vector<Uart::Config, BUS_RT_MAX_UARTS> uarts;
+        etl::vector<Can::Config, BUS_RT_MAX_CANS>   cans;
+        etl::vector<Gpio::Config, BUS_RT_MAX_GPIOS> gpios;
+    };
+
+    // cyclictest Ļʱӣʵʻʱ - Ԥʱ䣩
+    struct WakeupStats {
+        uint32_t loops;
+        uint32_t minNs;
+        uint32_t maxNs;
+        double   avgNs;
+        uint32_t p99Us;
+        uint32_t overflow;                  // >= BUS_RT_HIST_US Ĵ
+        uint32_t histUs[BUS_RT_HIST_US];
+    };
+
+    typedef void (*ThreadFn)(void* ctx);
+
+    BusRuntime(const Config& cfg);
+    ~BusRuntime();
+
+    // ڴ桢ȫ豸κһʧܶرѴ򿪵豸
+    // mlockall ̣޷ֻģĲ֣open() ǰڴ
+    // ӦԼ mlock / mlockall ʱ close()  munlockall close() ̡
+    // һֻӦһ BusRuntime  lockMemory
+    BusStatus open();
+    void close();
+
+    int   uartCount() const { return (int)m_cfg.uarts.size(); }
+    int   canCount() const  { return (int)m_cfg.cans.size(); }
+    int   gpioCount() const { return (int)m_cfg.gpios.size(); }
+    Uart& uart(int i) { return m_uarts[i]; }
+    Can&  can(int i)  { return m_cans[i]; }
+    Gpio& gpio(int i) { return m_gpios[i]; }
+
+    //  io ߳һ̣߳joinThreads() ͳһȴ˳
+    BusStatus startThread(ThreadFn fn, void* ctx);
+    void      joinThreads();
+
+    // Ե߳Ӧ߳ԣԼֱ߳ӵã
+    static BusStatus applyThread(const ThreadConfig& cfg);
+
+    // ҳдһ飬ȱҳڳʼ׶ζշ·
+    static void prefault(void* buf, size_t len);
+    static void prefaultStack(size_t bytes);
+
+    // ڵ߳ intervalUs ˯ loops Σͳƻʱ
+    static BusStatus measureWakeup(int intervalUs, int loops, WakeupStats& out);
+
+private:
+    struct ThreadStart {
+        ThreadConfig cfg;
+        ThreadFn     fn;
+        void*        ctx;
+    };
+
+    BusRuntime(const BusRuntime&);
+    BusRuntime& operator=(const BusRuntime&);
+
+    static void threadEntry(ThreadStart start);
+
+    Config   m_cfg;
+    bool     m_locked;
+    Uart     m_uarts[BUS_RT_MAX_UARTS];
+    Can      m_cans[BUS_RT_MAX_CANS];
+    Gpio     m_gpios[BUS_RT_MAX_GPIOS];
+
+    etl::vector<std::thread, BUS_RT_MAX_THREADS> m_threads;
+};
+/******************************** FILE END ********************************/
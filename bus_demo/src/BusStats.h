@@ -0,0 +1,175 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: BusStats.h
+ * Author		: Fan Fei
+ * Description	: ͳƣ + ʱֱͼ
+ * Comments		: BUS_STATS_ENABLE=0 ʱȫӿΪʵ֣޿
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "etl/atomic.h"
+#include "etl/array.h"
+#include "etl/histogram.h"
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+#ifndef BUS_STATS_ENABLE
+#define BUS_STATS_ENABLE 1
+#endif
+
+#define BUS_STATS_ERRNO_MAX   134 // Linux errno ȡֵΧ [0, 133]һ
+#define BUS_STATS_LAT_BUCKETS 32  //  i ͳ [2^i, 2^(i+1)) 
+
+/***************************************************************************
+ 						class declaration
+***************************************************************************/
+class BusStats {
+public:
+    // ʱֱͼ i Ͱͳ [2^i, 2^(i+1)) 룻setCount()  snapshot() ԭӼװ
+    class LatencyHistogram : public etl::histogram<uint8_t, uint32_t, BUS_STATS_LAT_BUCKETS, 0> {
+    public:
+        void setCount(uint8_t bucket, uint32_t n) { this->accumulator[bucket] = n; }
+    };
+
+    // ĳһʱ̵ͳƿգ̶߳ȡ
+    struct Snapshot {
+        uint64_t bytesIn;
+        uint64_t bytesOut;
+        uint64_t framesIn;
+        uint64_t framesOut;
+        uint64_t syscalls;      // ·Ϸϵͳô
+        uint64_t timeouts;
+        uint64_t shortReads;
+        uint64_t shortWrites;
+        uint64_t errors;        //  errno ֮
+        uint32_t errnoCount[BUS_STATS_ERRNO_MAX];
+        LatencyHistogram latency;
+    };
+
+    static uint64_t nowNs()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    }
+
+#if BUS_STATS_ENABLE
+    BusStats() { reset(); }
+
+    void addBytesIn(uint32_t n)   { m_bytesIn.fetch_add(n, etl::memory_order_relaxed); }
+    void addBytesOut(uint32_t n)  { m_bytesOut.fetch_add(n, etl::memory_order_relaxed); }
+    void addFrameIn()             { m_framesIn.fetch_add(1, etl::memory_order_relaxed); }
+    void addFrameOut()            { m_framesOut.fetch_add(1, etl::memory_order_relaxed); }
+    void addSyscall()             { m_syscalls.fetch_add(1, etl::memory_order_relaxed); }
+    void addTimeout()             { m_timeouts.fetch_add(1, etl::memory_order_relaxed); }
+    void addShortRead()           { m_shortReads.fetch_add(1, etl::memory_order_relaxed); }
+    void addShortWrite()          { m_shortWrites.fetch_add(1, etl::memory_order_relaxed); }
+
+    void addError(int err)
+    {
+        if (err < 0 || err >= BUS_STATS_ERRNO_MAX)
+            err = BUS_STATS_ERRNO_MAX - 1;
+        m_errno[err].fetch_add(1, etl::memory_order_relaxed);
+        m_errors.fetch_add(1, etl::memory_order_relaxed);
+    }
+
+    // ÿʼ/ʱһ
+    // ÿͰ relaxed ԭӼ߳̿ʱ snapshot()/reset()
+    uint64_t beginCall() const { return nowNs(); }
+
+    void endCall(uint64_t startNs)
+    {
+        uint64_t ns = nowNs() - startNs;
+        uint8_t  bucket = 0;
+        while ((ns >>= 1) != 0 && bucket < BUS_STATS_LAT_BUCKETS - 1)
+            ++bucket;
+        m_latency[bucket].fetch_add(1, etl::memory_order_relaxed);
+    }
+
+    void snapshot(Snapshot& out) const
+    {
+        out.bytesIn     = m_bytesIn.load(etl::memory_order_relaxed);
+        out.bytesOut    = m_bytesOut.load(etl::memory_order_relaxed);
+        out.framesIn    = m_framesIn.load(etl::memory_order_relaxed);
+        out.framesOut   = m_framesOut.load(etl::memory_order_relaxed);
+        out.syscalls    = m_syscalls.load(etl::memory_order_relaxed);
+        out.timeouts    = m_timeouts.load(etl::memory_order_relaxed);
+        out.shortReads  = m_shortReads.load(etl::memory_order_relaxed);
+        out.shortWrites = m_shortWrites.load(etl::memory_order_relaxed);
+        out.errors      = m_errors.load(etl::memory_order_relaxed);
+        for (int i = 0; i < BUS_STATS_ERRNO_MAX; ++i)
+            out.errnoCount[i] = m_errno[i].load(etl::memory_order_relaxed);
+        for (uint8_t i = 0; i < BUS_STATS_LAT_BUCKETS; ++i)
+            out.latency.setCount(i, m_latency[i].load(etl::memory_order_relaxed));
+    }
+
+    void reset()
+    {
+        m_bytesIn.store(0, etl::memory_order_relaxed);
+        m_bytesOut.store(0, etl::memory_order_relaxed);
+        m_framesIn.store(0, etl::memory_order_relaxed);
+        m_framesOut.store(0, etl::memory_order_relaxed);
+        m_syscalls.store(0, etl::memory_order_relaxed);
+        m_timeouts.store(0, etl::memory_order_relaxed);
+        m_shortReads.store(0, etl::memory_order_relaxed);
+        m_shortWrites.store(0, etl::memory_order_relaxed);
+        m_errors.store(0, etl::memory_order_relaxed);
+        for (int i = 0; i < BUS_STATS_ERRNO_MAX; ++i)
+            m_errno[i].store(0, etl::memory_order_relaxed);
+        for (int i = 0; i < BUS_STATS_LAT_BUCKETS; ++i)
+            m_latency[i].store(0, etl::memory_order_relaxed);
+    }
+
+private:
+    etl::atomic<uint64_t> m_bytesIn;
+    etl::atomic<uint64_t> m_bytesOut;
+    etl::atomic<uint64_t> m_framesIn;
+    etl::atomic<uint64_t> m_framesOut;
+    etl::atomic<uint64_t> m_syscalls;
+    etl::atomic<uint64_t> m_timeouts;
+    etl::atomic<uint64_t> m_shortReads;
+    etl::atomic<uint64_t> m_shortWrites;
+    etl::atomic<uint64_t> m_errors;
+    etl::array<etl::atomic<uint32_t>, BUS_STATS_ERRNO_MAX> m_errno;
+    etl::array<etl::atomic<uint32_t>, BUS_STATS_LAT_BUCKETS> m_latency;
+#else
+    // رͳƣȫΪղõᱻȫ
+    void addBytesIn(uint32_t)  {}
+    void addBytesOut(uint32_t) {}
+    void addFrameIn()          {}
+    void addFrameOut()         {}
+    void addSyscall()          {}
+    void addTimeout()          {}
+    void addShortRead()        {}
+    void addShortWrite()       {}
+    void addError(int)         {}
+    uint64_t beginCall() const { return 0; }
+    void endCall(uint64_t)     {}
+
+    void snapshot(Snapshot& out) const
+    {
+        out.bytesIn = out.bytesOut = out.framesIn = out.framesOut = 0;
+        out.syscalls = out.timeouts = out.shortReads = out.shortWrites = out.errors = 0;
+        memset(out.errnoCount, 0, sizeof(out.errnoCount));
+        out.latency.clear();
+    }
+
+    void reset() {}
+#endif
+};
+/******************************** FILE END ********************************/
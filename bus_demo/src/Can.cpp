@@ -18,17 +18,68 @@
  							include files
 ***************************************************************************/
 #include "Can.h"
+#include "BusLog.h"
 
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#include <linux/sockios.h>
 #include <net/if.h>
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <linux/can/error.h>
+#include <linux/can/netlink.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_link.h>
 #include <sys/select.h>
+#include <time.h>
+
+/***************************************************************************
+ 						function definition
+***************************************************************************/
+static void fromCanFrame(const struct can_frame& cf, Can::Frame& frame)
+{
+    frame.isExtended = (cf.can_id & CAN_EFF_FLAG) ? 1 : 0;
+    frame.isRTR      = (cf.can_id & CAN_RTR_FLAG) ? 1 : 0;
+
+    if (frame.isExtended) {
+        frame.id = cf.can_id & CAN_EFF_MASK;
+    } else {
+        frame.id = cf.can_id & CAN_SFF_MASK;
+    }
+
+    frame.dlc = cf.can_dlc;
+    if (frame.dlc > 8)
+        frame.dlc = 8;
+
+    memcpy(frame.data, cf.data, frame.dlc);
+}
+
+static void toCanFrame(const Can::Frame& frame, struct can_frame& cf)
+{
+    memset(&cf, 0, sizeof(cf));
+
+    if (frame.isExtended) {
+        cf.can_id = frame.id | CAN_EFF_FLAG;
+    } else {
+        cf.can_id = frame.id & CAN_SFF_MASK;
+    }
+
+    if (frame.isRTR) {
+        cf.can_id |= CAN_RTR_FLAG;
+    }
+
+    cf.can_dlc = frame.dlc;
+    if (cf.can_dlc > 8)
+        cf.can_dlc = 8;
+
+    memcpy(cf.data, frame.data, cf.can_dlc);
+}
 
 /***************************************************************************
  						class definition
@@ -36,12 +87,44 @@
 Can::Can()
     : m_fd(-1)
     , m_cfg{}
+    , m_ctrlState(State_Active)
+    , m_errCounters(0)
+    , m_errFrames(0)
+    , m_busOffs(0)
+    , m_restarts(0)
+    , m_arbLost(0)
+    , m_protErrors(0)
+    , m_ackErrors(0)
+    , m_rxOverflows(0)
+    , m_txTimeouts(0)
+    , m_txThrottled(0)
+    , m_lastErrNs(0)
+    , m_busOffNs(0)
+    , m_backoffUntilNs(0)
+    , m_backoffUs(0)
+    , m_restartReqFor(0)
 {
 }
 
 Can::Can(const Config& cfg)
     : m_fd(-1)
     , m_cfg(cfg)
+    , m_ctrlState(State_Active)
+    , m_errCounters(0)
+    , m_errFrames(0)
+    , m_busOffs(0)
+    , m_restarts(0)
+    , m_arbLost(0)
+    , m_protErrors(0)
+    , m_ackErrors(0)
+    , m_rxOverflows(0)
+    , m_txTimeouts(0)
+    , m_txThrottled(0)
+    , m_lastErrNs(0)
+    , m_busOffNs(0)
+    , m_backoffUntilNs(0)
+    , m_backoffUs(0)
+    , m_restartReqFor(0)
 {
 }
 
@@ -50,64 +133,90 @@ Can::~Can()
     close();
 }
 
-bool Can::applyOptions()
+void Can::toRaw(const Frame& frame, void* raw)
 {
-    if (m_fd < 0)
-        return false;
+    static_assert(sizeof(struct can_frame) == CAN_RAW_FRAME_SIZE, "unexpected can_frame size");
+    toCanFrame(frame, *(struct can_frame*)raw);
+}
 
-    int loopback = m_cfg.loopback ? 1 : 0;
-    if (setsockopt(m_fd, SOL_CAN_RAW, CAN_RAW_LOOPBACK,
-                   &loopback, sizeof(loopback)) < 0) {
-        perror("setsockopt CAN_RAW_LOOPBACK");
-        return false;
-    }
+void Can::fromRaw(const void* raw, Frame& frame)
+{
+    fromCanFrame(*(const struct can_frame*)raw, frame);
+}
 
-    int recvOwn = m_cfg.recvOwn ? 1 : 0;
-    if (setsockopt(m_fd, SOL_CAN_RAW, CAN_RAW_RECV_OWN_MSGS,
-                   &recvOwn, sizeof(recvOwn)) < 0) {
-        perror("setsockopt CAN_RAW_RECV_OWN_MSGS");
-        return false;
+// prev Ϊ nullptr ʱȫãֻ prev ͬѡ
+BusStatus Can::applyOptions(int fd, const Config* prev)
+{
+    if (fd < 0)
+        return busError(BusErr_NotOpen, "can options");
+
+    if (prev == nullptr || (prev->loopback != 0) != (m_cfg.loopback != 0)) {
+        int loopback = m_cfg.loopback ? 1 : 0;
+        if (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_LOOPBACK,
+                       &loopback, sizeof(loopback)) < 0) {
+            m_stats.addError(errno);
+            return busFail(BusErr_Config, errno, "setsockopt CAN_RAW_LOOPBACK");
+        }
     }
 
-    // Ĭϲˣȫգ
-    struct can_filter filter;
-    filter.can_id   = 0;
-    filter.can_mask = 0;
-    if (setsockopt(m_fd, SOL_CAN_RAW, CAN_RAW_FILTER,
-                   &filter, sizeof(filter)) < 0) {
-        perror("setsockopt CAN_RAW_FILTER");
-        return false;
+    if (prev == nullptr || (prev->recvOwn != 0) != (m_cfg.recvOwn != 0)) {
+        int recvOwn = m_cfg.recvOwn ? 1 : 0;
+        if (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_RECV_OWN_MSGS,
+                       &recvOwn, sizeof(recvOwn)) < 0) {
+            m_stats.addError(errno);
+            return busFail(BusErr_Config, errno, "setsockopt CAN_RAW_RECV_OWN_MSGS");
+        }
     }
 
-    return true;
-}
-
-bool Can::open()
-{
-    if (isOpen())
-        return true;
+    // Ĭ mask Ϊ 0ˣȫգ
+    if (prev == nullptr || prev->filterId != m_cfg.filterId || prev->filterMask != m_cfg.filterMask) {
+        struct can_filter filter;
+        filter.can_id   = m_cfg.filterId;
+        filter.can_mask = m_cfg.filterMask;
+        if (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER,
+                       &filter, sizeof(filter)) < 0) {
+            m_stats.addError(errno);
+            return busFail(BusErr_Config, errno, "setsockopt CAN_RAW_FILTER");
+        }
+    }
 
-    m_fd = ::socket(PF_CAN, SOCK_RAW, CAN_RAW);
-    if (m_fd < 0) {
-        perror("socket CAN_RAW");
-        return false;
+    // ֡״̬bus-off/¼
+    if (prev == nullptr || (prev->errorFrames != 0) != (m_cfg.errorFrames != 0)) {
+        can_err_mask_t mask = m_cfg.errorFrames ? CAN_ERR_MASK : 0;
+        if (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_ERR_FILTER,
+                       &mask, sizeof(mask)) < 0) {
+            m_stats.addError(errno);
+            return busFail(BusErr_Config, errno, "setsockopt CAN_RAW_ERR_FILTER");
+        }
+        // ص֡Ҳղ CAN_ERR_RESTARTEDɵ bus-off ״̬˱ܲ
+        if (prev != nullptr && m_cfg.errorFrames == 0)
+            resetErrorState();
     }
 
-    if (!applyOptions()) {
-        close();
-        return false;
+    // ں˽ʱץ/طʹ
+    if (prev == nullptr || (prev->timestamp != 0) != (m_cfg.timestamp != 0)) {
+        int stamp = m_cfg.timestamp ? 1 : 0;
+        if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS,
+                       &stamp, sizeof(stamp)) < 0) {
+            m_stats.addError(errno);
+            return busFail(BusErr_Config, errno, "setsockopt SO_TIMESTAMPNS");
+        }
     }
 
+    return BusStatus();
+}
+
+BusStatus Can::bindInterface(int fd, const char* where)
+{
     struct ifreq ifr;
     memset(&ifr, 0, sizeof(ifr));
     // ӿ
     strncpy(ifr.ifr_name, m_cfg.ifName.c_str(), sizeof(ifr.ifr_name) - 1);
     ifr.ifr_name[sizeof(ifr.ifr_name) - 1] = '\0';
 
-    if (ioctl(m_fd, SIOCGIFINDEX, &ifr) < 0) { // ioctl(SIOCGIFINDEX)  "can0" תں˵Ľӿ ifr.ifr_ifindex
-        perror("ioctl SIOCGIFINDEX");
-        close();
-        return false;
+    if (ioctl(fd, SIOCGIFINDEX, &ifr) < 0) { // ioctl(SIOCGIFINDEX)  "can0" תں˵Ľӿ ifr.ifr_ifindex
+        m_stats.addError(errno);
+        return busFail(BusErr_Config, errno, "ioctl SIOCGIFINDEX");
     }
 
     struct sockaddr_can addr;
@@ -115,13 +224,34 @@ bool Can::open()
     addr.can_family  = AF_CAN;
     addr.can_ifindex = ifr.ifr_ifindex;
 
-    if (::bind(m_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-        perror("bind can");
+    if (::bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        m_stats.addError(errno);
+        return busFail(BusErr_Open, errno, where);
+    }
+    return BusStatus();
+}
+
+BusStatus Can::open()
+{
+    if (isOpen())
+        return BusStatus();
+
+    m_fd = ::socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (m_fd < 0) {
+        m_stats.addError(errno);
+        return busFail(BusErr_Open, errno, "socket CAN_RAW");
+    }
+
+    BusStatus st = applyOptions(m_fd, nullptr);
+    if (st)
+        st = bindInterface(m_fd, "bind can");
+    if (!st) {
         close();
-        return false;
+        return st;
     }
 
-    return true;
+    resetErrorState();
+    return BusStatus();
 }
 
 void Can::close()
@@ -132,22 +262,88 @@ void Can::close()
     }
 }
 
-bool Can::reconfigure(const Config& cfg)
+//  socket socket еĻѹٰ֡󶨣 dup2 ԭ滻 m_fd ϣ
+// fd Ų䣨BusRing ȳעᣩ socket յ֡ᱻʧ
+// 굽 dup2 ֮ŵɽӿڵ֡ͬδֻһ bind ʱ
+BusStatus Can::replaceSocket(uint32_t* lostFrames)
 {
+    int fd = ::socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (fd < 0) {
+        m_stats.addError(errno);
+        return busFail(BusErr_Open, errno, "socket CAN_RAW");
+    }
+
+    BusStatus st = applyOptions(fd, nullptr);
+    if (!st) {
+        ::close(fd);
+        return st;
+    }
+
+    //  socket ﻹûߵ֡ dup2 һ
+    uint32_t lost = 0;
+    struct can_frame cfs[CAN_RX_BATCH_MAX];
+    struct iovec     iovs[CAN_RX_BATCH_MAX];
+    struct mmsghdr   msgs[CAN_RX_BATCH_MAX];
+    for (;;) {
+        memset(msgs, 0, sizeof(msgs));
+        for (int i = 0; i < CAN_RX_BATCH_MAX; ++i) {
+            iovs[i].iov_base = &cfs[i];
+            iovs[i].iov_len  = sizeof(cfs[i]);
+            msgs[i].msg_hdr.msg_iov    = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        m_stats.addSyscall();
+        int n = ::recvmmsg(m_fd, msgs, CAN_RX_BATCH_MAX, MSG_DONTWAIT, nullptr);
+        if (n <= 0)
+            break;
+        lost += (uint32_t)n;
+    }
+
+    // ʧʱþ socketѶߵ֡ͬʧ
+    st = bindInterface(fd, "rebind can");
+    if (st && ::dup2(fd, m_fd) < 0) {
+        m_stats.addError(errno);
+        st = busFail(BusErr_Open, errno, "dup2 can");
+    }
+    ::close(fd);
+
+    if (lostFrames != nullptr)
+        *lostFrames = lost;
+    return st;
+}
+
+BusStatus Can::reconfigure(const Config& cfg, uint32_t* lostFrames)
+{
+    if (lostFrames != nullptr)
+        *lostFrames = 0;
+
+    if (!isOpen()) {
+        m_cfg = cfg;
+        return BusStatus();
+    }
+
+    Config prev = m_cfg;
     m_cfg = cfg;
 
-    if (!isOpen())
-        return true;
+    // ֻı仯ѡsocket նбֲ
+    BusStatus st = applyOptions(m_fd, &prev);
+    if (st && prev.ifName != cfg.ifName) {
+        // CAN_RAW ֧Ѱ󶨵 socket ٴ bindںȹ½ӿժɽӿڣ֡
+        // ӿڲڵôֱӷأʧܣں˲֧ذ󣩲Ż socket
+        st = bindInterface(m_fd, "rebind can");
+        if (!st && st.error().code == BusErr_Open)
+            st = replaceSocket(lostFrames);
+    }
 
-    // Ϊؿ socket
-    close();
-    return open();
+    if (!st)
+        m_cfg = prev;
+    return st;
 }
 
-bool Can::setFilter(uint32_t id, uint32_t mask)
+BusStatus Can::setFilter(uint32_t id, uint32_t mask)
 {
     if (m_fd < 0)
-        return false;
+        return busError(BusErr_NotOpen, "can filter");
 
     struct can_filter filter;
     filter.can_id   = id;
@@ -155,96 +351,596 @@ bool Can::setFilter(uint32_t id, uint32_t mask)
 
     if (setsockopt(m_fd, SOL_CAN_RAW, CAN_RAW_FILTER,
                    &filter, sizeof(filter)) < 0) {
-        perror("setsockopt CAN_RAW_FILTER");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Config, errno, "setsockopt CAN_RAW_FILTER");
     }
-    return true;
+    m_cfg.filterId   = id;
+    m_cfg.filterMask = mask;
+    return BusStatus();
 }
 
-bool Can::send(const Frame& frame)
+BusCount Can::txQueuedBytes() const
 {
     if (m_fd < 0)
-        return false;
+        return busError(BusErr_NotOpen, "can outq");
+
+    int bytes = 0;
+    if (ioctl(m_fd, SIOCOUTQ, &bytes) < 0) {
+        // ٲ߳ÿ֡ѯʧʱ־
+        BusError err = { BusErr_Io, errno, "ioctl SIOCOUTQ" };
+        return etl::unexpected<BusError>(err);
+    }
+    return bytes;
+}
+
+BusStatus Can::send(const Frame& frame)
+{
+    if (m_fd < 0)
+        return busError(BusErr_NotOpen, "can write");
+
+    BusStatus gate = txGate("can write");
+    if (!gate)
+        return gate;
 
     struct can_frame cf;
-    memset(&cf, 0, sizeof(cf));
+    toCanFrame(frame, cf);
 
-    if (frame.isExtended) {
-        cf.can_id = frame.id | CAN_EFF_FLAG;
-    } else {
-        cf.can_id = frame.id & CAN_SFF_MASK;
+    m_stats.addSyscall();
+    int n = (int)::write(m_fd, &cf, sizeof(cf));
+    if (n < 0) {
+        m_stats.addError(errno);
+        return txFailed(errno, "can write");
+    }
+    if (n != (int)sizeof(cf)) {
+        m_stats.addShortWrite();
+        return busFail(BusErr_ShortWrite, 0, "can write");
     }
 
-    if (frame.isRTR) {
-        cf.can_id |= CAN_RTR_FLAG;
+    txSucceeded();
+    m_stats.addFrameOut();
+    m_stats.addBytesOut(cf.can_dlc);
+    return BusStatus();
+}
+
+BusStatus Can::waitReadable(uint64_t callStart, int timeoutMs, const char* where)
+{
+    uint64_t deadline = 0;
+    for (;;) {
+        // bus-off ڼû֡ȴʱصʱ̣
+        int  waitMs    = timeoutMs;
+        int  restartMs = serviceRestart();
+        bool capped    = restartMs >= 0 && (waitMs < 0 || restartMs < waitMs);
+        if (capped) {
+            if (timeoutMs >= 0 && deadline == 0)
+                deadline = BusStats::nowNs() + (uint64_t)timeoutMs * 1000000u;
+            waitMs = restartMs;
+        }
+
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(m_fd, &readfds);
+
+        struct timeval tv;
+        struct timeval* ptv = nullptr;
+
+        if (waitMs >= 0) {
+            tv.tv_sec  = waitMs / 1000;
+            tv.tv_usec = (waitMs % 1000) * 1000;
+            ptv = &tv;
+        }
+
+        m_stats.addSyscall();
+        int ret = ::select(m_fd + 1, &readfds, nullptr, nullptr, ptv);
+        if (ret < 0) {
+            m_stats.addError(errno);
+            return busFail(BusErr_Io, errno, "select can");
+        } else if (ret > 0) {
+            return BusStatus();
+        }
+
+        if (capped) {
+            // ֻǵʱ̣÷ĳʱû
+            if (timeoutMs < 0)
+                continue;
+            uint64_t now = BusStats::nowNs();
+            if (now < deadline) {
+                timeoutMs = (int)((deadline - now + 999999u) / 1000000u);
+                continue;
+            }
+        }
+
+        // ʱ
+        m_stats.addTimeout();
+        m_stats.endCall(callStart);
+        return busError(BusErr_Timeout, where);
     }
+}
 
-    cf.can_dlc = frame.dlc;
-    if (cf.can_dlc > 8)
-        cf.can_dlc = 8;
+BusStatus Can::receive(Frame& frame)
+{
+    if (m_fd < 0)
+        return busError(BusErr_NotOpen, "can read");
 
-    memcpy(cf.data, frame.data, cf.can_dlc);
+    // ʱӽ receive() 㣬;յĴ֡¼ʱ
+    uint64_t deadline = (m_cfg.recvTimeoutMs > 0) ?
+                        BusStats::nowNs() + (uint64_t)m_cfg.recvTimeoutMs * 1000000u : 0;
 
-    int n = (int)::write(m_fd, &cf, sizeof(cf));
+    struct can_frame cf;
+    for (;;) {
+        uint64_t t0 = m_stats.beginCall();
+        int timeoutMs = -1;
+        if (deadline != 0) {
+            uint64_t now = BusStats::nowNs();
+            timeoutMs = (now >= deadline) ? 0 : (int)((deadline - now + 999999u) / 1000000u);
+        }
+        BusStatus st = waitReadable(t0, timeoutMs, "can read");
+        if (!st)
+            return st;
+
+        m_stats.addSyscall();
+        int n = (int)::read(m_fd, &cf, sizeof(cf));
+        m_stats.endCall(t0);
+        if (n < 0) {
+            m_stats.addError(errno);
+            return busFail(BusErr_Io, errno, "can read");
+        }
+        if (n != (int)sizeof(cf)) {
+            m_stats.addShortRead();
+            return busFail(BusErr_ShortRead, 0, "can read");
+        }
+
+        // ֻ֡״̬֡
+        if ((cf.can_id & CAN_ERR_FLAG) == 0)
+            break;
+        onErrorFrame(&cf);
+    }
+
+    fromCanFrame(cf, frame);
+
+    m_stats.addFrameIn();
+    m_stats.addBytesIn(frame.dlc);
+    return BusStatus();
+}
+
+BusCount Can::receiveBatch(Frame* frames, uint64_t* stampsNs, int maxFrames)
+{
+    if (m_fd < 0)
+        return busError(BusErr_NotOpen, "can read batch");
+    if (frames == nullptr || maxFrames <= 0)
+        return busError(BusErr_InvalidArg, "can read batch");
+    if (maxFrames > CAN_RX_BATCH_MAX)
+        maxFrames = CAN_RX_BATCH_MAX;
+
+    uint64_t t0 = m_stats.beginCall();
+    BusStatus st = waitReadable(t0, (m_cfg.recvTimeoutMs > 0) ? m_cfg.recvTimeoutMs : -1, "can read batch");
+    if (!st)
+        return etl::unexpected<BusError>(st.error());
+
+    struct can_frame cfs[CAN_RX_BATCH_MAX];
+    struct iovec     iovs[CAN_RX_BATCH_MAX];
+    struct mmsghdr   msgs[CAN_RX_BATCH_MAX];
+    char             ctrl[CAN_RX_BATCH_MAX][CMSG_SPACE(sizeof(struct timespec))];
+
+    memset(msgs, 0, sizeof(msgs[0]) * maxFrames);
+    for (int i = 0; i < maxFrames; ++i) {
+        iovs[i].iov_base = &cfs[i];
+        iovs[i].iov_len  = sizeof(cfs[i]);
+        msgs[i].msg_hdr.msg_iov    = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        if (m_cfg.timestamp) {
+            msgs[i].msg_hdr.msg_control    = ctrl[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(ctrl[i]);
+        }
+    }
+
+    // ȷϿɶﲻȡȡ
+    m_stats.addSyscall();
+    int n = ::recvmmsg(m_fd, msgs, (unsigned int)maxFrames, MSG_DONTWAIT, nullptr);
+    m_stats.endCall(t0);
     if (n < 0) {
-        perror("can write");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Io, errno, "can recvmmsg");
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t batchNs = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+
+    int count = 0;
+    for (int i = 0; i < n; ++i) {
+        if (msgs[i].msg_len != sizeof(struct can_frame)) {
+            m_stats.addShortRead();
+            continue;
+        }
+        if (cfs[i].can_id & CAN_ERR_FLAG) {
+            onErrorFrame(&cfs[i]);
+            continue;
+        }
+
+        fromCanFrame(cfs[i], frames[count]);
+
+        if (stampsNs != nullptr) {
+            stampsNs[count] = batchNs;
+            if (m_cfg.timestamp) {
+                for (struct cmsghdr* cm = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cm != nullptr;
+                     cm = CMSG_NXTHDR(&msgs[i].msg_hdr, cm)) {
+                    if (cm->cmsg_level == SOL_SOCKET && cm->cmsg_type == SCM_TIMESTAMPNS) {
+                        struct timespec ts;
+                        memcpy(&ts, CMSG_DATA(cm), sizeof(ts));
+                        stampsNs[count] = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+                    }
+                }
+            }
+        }
+
+        m_stats.addFrameIn();
+        m_stats.addBytesIn(frames[count].dlc);
+        ++count;
     }
-    return (n == (int)sizeof(cf));
+
+    return count;
 }
 
-bool Can::receive(Frame& frame)
+BusCount Can::sendBatch(const Frame* frames, int count)
 {
     if (m_fd < 0)
-        return false;
+        return busError(BusErr_NotOpen, "can write batch");
+    if (frames == nullptr || count <= 0)
+        return busError(BusErr_InvalidArg, "can write batch");
+    if (count > CAN_TX_BATCH_MAX)
+        count = CAN_TX_BATCH_MAX;
+
+    BusStatus gate = txGate("can write batch");
+    if (!gate)
+        return etl::unexpected<BusError>(gate.error());
+
+    struct can_frame cfs[CAN_TX_BATCH_MAX];
+    struct iovec     iovs[CAN_TX_BATCH_MAX];
+    struct mmsghdr   msgs[CAN_TX_BATCH_MAX];
+
+    memset(msgs, 0, sizeof(msgs[0]) * count);
+    for (int i = 0; i < count; ++i) {
+        toCanFrame(frames[i], cfs[i]);
+        iovs[i].iov_base = &cfs[i];
+        iovs[i].iov_len  = sizeof(cfs[i]);
+        msgs[i].msg_hdr.msg_iov    = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
 
-    fd_set readfds;
-    FD_ZERO(&readfds);
-    FD_SET(m_fd, &readfds);
+    uint64_t t0 = m_stats.beginCall();
+    m_stats.addSyscall();
+    int n = ::sendmmsg(m_fd, msgs, (unsigned int)count, 0);
+    m_stats.endCall(t0);
+    if (n < 0) {
+        m_stats.addError(errno);
+        BusStatus st = txFailed(errno, "can sendmmsg");
+        return etl::unexpected<BusError>(st.error());
+    }
+    txSucceeded();
 
-    struct timeval tv;
-    struct timeval* ptv = nullptr;
+    for (int i = 0; i < n; ++i) {
+        m_stats.addFrameOut();
+        m_stats.addBytesOut(cfs[i].can_dlc);
+    }
+    if (n < count)
+        m_stats.addShortWrite();
+    return n;
+}
 
-    if (m_cfg.recvTimeoutMs > 0) {
-        tv.tv_sec  = m_cfg.recvTimeoutMs / 1000;
-        tv.tv_usec = (m_cfg.recvTimeoutMs % 1000) * 1000;
-        ptv = &tv;
+BusCount Can::sendRaw(BusConstBuf raw)
+{
+    if (m_fd < 0)
+        return busError(BusErr_NotOpen, "can write raw");
+    int count = (int)(raw.size() / sizeof(struct can_frame));
+    if (count <= 0 || raw.size() % sizeof(struct can_frame) != 0)
+        return busError(BusErr_InvalidArg, "can write raw");
+    if (count > CAN_TX_BATCH_MAX)
+        count = CAN_TX_BATCH_MAX;
+
+    BusStatus gate = txGate("can write raw");
+    if (!gate)
+        return etl::unexpected<BusError>(gate.error());
+
+    struct iovec   iovs[CAN_TX_BATCH_MAX];
+    struct mmsghdr msgs[CAN_TX_BATCH_MAX];
+    memset(msgs, 0, sizeof(msgs[0]) * count);
+    for (int i = 0; i < count; ++i) {
+        iovs[i].iov_base = (void*)(raw.data() + i * sizeof(struct can_frame));
+        iovs[i].iov_len  = sizeof(struct can_frame);
+        msgs[i].msg_hdr.msg_iov    = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
     }
 
-    int ret = ::select(m_fd + 1, &readfds, nullptr, nullptr, ptv);
-    if (ret < 0) {
-        perror("select can");
-        return false;
-    } else if (ret == 0) {
-        // ʱ
-        return false;
+    uint64_t t0 = m_stats.beginCall();
+    m_stats.addSyscall();
+    int n = ::sendmmsg(m_fd, msgs, (unsigned int)count, 0);
+    m_stats.endCall(t0);
+    if (n < 0) {
+        m_stats.addError(errno);
+        BusStatus st = txFailed(errno, "can sendmmsg raw");
+        return etl::unexpected<BusError>(st.error());
     }
+    txSucceeded();
 
-    struct can_frame cf;
-    int n = (int)::read(m_fd, &cf, sizeof(cf));
+    for (int i = 0; i < n; ++i) {
+        m_stats.addFrameOut();
+        m_stats.addBytesOut(((const struct can_frame*)iovs[i].iov_base)->can_dlc);
+    }
+    if (n < count)
+        m_stats.addShortWrite();
+    return n;
+}
+
+BusCount Can::receiveRaw(BusBuf raw)
+{
+    if (m_fd < 0)
+        return busError(BusErr_NotOpen, "can read raw");
+    int maxFrames = (int)(raw.size() / sizeof(struct can_frame));
+    if (maxFrames <= 0)
+        return busError(BusErr_InvalidArg, "can read raw");
+    if (maxFrames > CAN_RX_BATCH_MAX)
+        maxFrames = CAN_RX_BATCH_MAX;
+
+    uint64_t t0 = m_stats.beginCall();
+    BusStatus st = waitReadable(t0, (m_cfg.recvTimeoutMs > 0) ? m_cfg.recvTimeoutMs : -1, "can read raw");
+    if (!st)
+        return etl::unexpected<BusError>(st.error());
+
+    struct iovec   iovs[CAN_RX_BATCH_MAX];
+    struct mmsghdr msgs[CAN_RX_BATCH_MAX];
+    memset(msgs, 0, sizeof(msgs[0]) * maxFrames);
+    for (int i = 0; i < maxFrames; ++i) {
+        iovs[i].iov_base = raw.data() + i * sizeof(struct can_frame);
+        iovs[i].iov_len  = sizeof(struct can_frame);
+        msgs[i].msg_hdr.msg_iov    = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    m_stats.addSyscall();
+    int n = ::recvmmsg(m_fd, msgs, (unsigned int)maxFrames, MSG_DONTWAIT, nullptr);
+    m_stats.endCall(t0);
     if (n < 0) {
-        perror("can read");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Io, errno, "can recvmmsg raw");
     }
-    if (n != (int)sizeof(cf)) {
-        return false;
+
+    // ֡ͳȲԵ֡ԭ޳֡ǰŲ
+    int count = 0;
+    for (int i = 0; i < n; ++i) {
+        struct can_frame* cf = (struct can_frame*)iovs[i].iov_base;
+        if (msgs[i].msg_len != sizeof(struct can_frame)) {
+            m_stats.addShortRead();
+            continue;
+        }
+        if (cf->can_id & CAN_ERR_FLAG) {
+            onErrorFrame(cf);
+            continue;
+        }
+        if (count != i)
+            memcpy(raw.data() + count * sizeof(struct can_frame), cf, sizeof(struct can_frame));
+        m_stats.addFrameIn();
+        m_stats.addBytesIn(cf->can_dlc);
+        ++count;
     }
+    return count;
+}
 
-    frame.isExtended = (cf.can_id & CAN_EFF_FLAG) ? 1 : 0;
-    frame.isRTR      = (cf.can_id & CAN_RTR_FLAG) ? 1 : 0;
+void Can::resetErrorState()
+{
+    m_ctrlState.store(State_Active, etl::memory_order_relaxed);
+    m_errCounters.store(0, etl::memory_order_relaxed);
+    m_backoffUntilNs.store(0, etl::memory_order_relaxed);
+    m_backoffUs.store(0, etl::memory_order_relaxed);
+}
 
-    if (frame.isExtended) {
-        frame.id = cf.can_id & CAN_EFF_MASK;
-    } else {
-        frame.id = cf.can_id & CAN_SFF_MASK;
+void Can::onErrorFrame(const void* raw)
+{
+    const struct can_frame& cf = *(const struct can_frame*)raw;
+    uint32_t cls = cf.can_id & CAN_ERR_MASK;
+    uint64_t now = BusStats::nowNs();
+
+    m_errFrames.fetch_add(1, etl::memory_order_relaxed);
+    m_lastErrNs.store(now, etl::memory_order_relaxed);
+
+    if (cls & CAN_ERR_CNT)
+        m_errCounters.store((uint32_t)cf.data[6] | ((uint32_t)cf.data[7] << 8), etl::memory_order_relaxed);
+    if (cls & CAN_ERR_LOSTARB)
+        m_arbLost.fetch_add(1, etl::memory_order_relaxed);
+    if (cls & CAN_ERR_PROT)
+        m_protErrors.fetch_add(1, etl::memory_order_relaxed);
+    if (cls & CAN_ERR_ACK)
+        m_ackErrors.fetch_add(1, etl::memory_order_relaxed);
+    if (cls & CAN_ERR_TX_TIMEOUT)
+        m_txTimeouts.fetch_add(1, etl::memory_order_relaxed);
+
+    if (cls & CAN_ERR_CRTL) {
+        uint8_t c = cf.data[1];
+        if (c & CAN_ERR_CRTL_RX_OVERFLOW)
+            m_rxOverflows.fetch_add(1, etl::memory_order_relaxed);
+        // һ֡ͬʱ־س̶ȡ
+        if (c & (CAN_ERR_CRTL_RX_PASSIVE | CAN_ERR_CRTL_TX_PASSIVE))
+            m_ctrlState.store(State_Passive, etl::memory_order_relaxed);
+        else if (c & (CAN_ERR_CRTL_RX_WARNING | CAN_ERR_CRTL_TX_WARNING))
+            m_ctrlState.store(State_Warning, etl::memory_order_relaxed);
+        else if (c & CAN_ERR_CRTL_ACTIVE)
+            m_ctrlState.store(State_Active, etl::memory_order_relaxed);
     }
 
-    frame.dlc = cf.can_dlc;
-    if (frame.dlc > 8)
-        frame.dlc = 8;
+    // bus-off ȼ״̬
+    if (cls & CAN_ERR_BUSOFF) {
+        m_busOffNs.store(now, etl::memory_order_relaxed);
+        m_busOffs.fetch_add(1, etl::memory_order_relaxed);
+        m_ctrlState.store(State_BusOff, etl::memory_order_relaxed);
+    }
+    if (cls & CAN_ERR_RESTARTED) {
+        m_restarts.fetch_add(1, etl::memory_order_relaxed);
+        m_ctrlState.store(State_Active, etl::memory_order_relaxed);
+    }
+}
 
-    memcpy(frame.data, cf.data, frame.dlc);
+void Can::errorStatus(ErrorStatus& out) const
+{
+    uint32_t cnt = m_errCounters.load(etl::memory_order_relaxed);
+    out.state           = (CtrlState)m_ctrlState.load(etl::memory_order_relaxed);
+    out.txErrors        = (uint8_t)(cnt & 0xFF);
+    out.rxErrors        = (uint8_t)(cnt >> 8);
+    out.errorFrames     = m_errFrames.load(etl::memory_order_relaxed);
+    out.busOffs         = m_busOffs.load(etl::memory_order_relaxed);
+    out.restarts        = m_restarts.load(etl::memory_order_relaxed);
+    out.arbitrationLost = m_arbLost.load(etl::memory_order_relaxed);
+    out.protocolErrors  = m_protErrors.load(etl::memory_order_relaxed);
+    out.ackErrors       = m_ackErrors.load(etl::memory_order_relaxed);
+    out.rxOverflows     = m_rxOverflows.load(etl::memory_order_relaxed);
+    out.txTimeouts      = m_txTimeouts.load(etl::memory_order_relaxed);
+    out.txThrottled     = m_txThrottled.load(etl::memory_order_relaxed);
+    out.lastErrorNs     = m_lastErrNs.load(etl::memory_order_relaxed);
+}
+
+// ǰ飺bus-off ˱ֱܴӾܾϵͳ
+BusStatus Can::txGate(const char* where)
+{
+    uint64_t now = 0;
+
+    if (m_ctrlState.load(etl::memory_order_relaxed) == State_BusOff) {
+        now = BusStats::nowNs();
+        uint64_t offNs = m_busOffNs.load(etl::memory_order_relaxed);
+
+        // ɽ· serviceRestart() ֻ CAN_ERR_RESTARTED
+        // ˱δյʱһ֡ȥ̽
+        uint32_t maxUs = m_cfg.txBackoffMaxUs > 0 ? (uint32_t)m_cfg.txBackoffMaxUs : CAN_TX_BACKOFF_MAX_US;
+        if (now - offNs < (uint64_t)maxUs * 1000u || now < m_backoffUntilNs.load(etl::memory_order_relaxed)) {
+            m_txThrottled.fetch_add(1, etl::memory_order_relaxed);
+            BusError err = { BusErr_Full, ENOBUFS, where };
+            return etl::unexpected<BusError>(err);
+        }
+    }
+
+    uint64_t until = m_backoffUntilNs.load(etl::memory_order_relaxed);
+    if (until != 0) {
+        if (now == 0)
+            now = BusStats::nowNs();
+        if (now < until) {
+            m_txThrottled.fetch_add(1, etl::memory_order_relaxed);
+            BusError err = { BusErr_Full, ENOBUFS, where };
+            return etl::unexpected<BusError>(err);
+        }
+    }
+    return BusStatus();
+}
 
-    return true;
+// û restart-ms ʱɽ·ÿ bus-off ֻһΣ
+// ߳ͬʱʱֻл¾ֵǸȥ
+int Can::serviceRestart()
+{
+    if (m_cfg.busOffRestartMs <= 0 || m_ctrlState.load(etl::memory_order_relaxed) != State_BusOff)
+        return -1;
+
+    uint32_t offs = m_busOffs.load(etl::memory_order_relaxed);
+    if (m_restartReqFor.load(etl::memory_order_relaxed) == offs)
+        return -1;
+
+    uint64_t now = BusStats::nowNs();
+    uint64_t due = m_busOffNs.load(etl::memory_order_relaxed) + (uint64_t)m_cfg.busOffRestartMs * 1000000u;
+    if (now < due)
+        return (int)((due - now + 999999u) / 1000000u);
+
+    if (m_restartReqFor.exchange(offs, etl::memory_order_relaxed) != offs)
+        restartController();
+    return -1;
+}
+
+// ʧܣӿ down ȡ߷ȥĴָ˱ܣ
+// ֻʧܵĵһд־
+BusStatus Can::txFailed(int err, const char* where)
+{
+    if (err != ENOBUFS && err != ENETDOWN && err != EAGAIN)
+        return busFail(BusErr_Io, err, where);
+
+    uint32_t minUs = m_cfg.txBackoffMinUs > 0 ? (uint32_t)m_cfg.txBackoffMinUs : CAN_TX_BACKOFF_MIN_US;
+    uint32_t maxUs = m_cfg.txBackoffMaxUs > 0 ? (uint32_t)m_cfg.txBackoffMaxUs : CAN_TX_BACKOFF_MAX_US;
+
+    // ʧʱÿ̸߳һΣֻд 0 𲽵Ǹ߳д־
+    uint32_t prev = m_backoffUs.load(etl::memory_order_relaxed);
+    uint32_t next;
+    do {
+        next = (prev == 0) ? minUs : prev * 2;
+        if (next > maxUs)
+            next = maxUs;
+    } while (!m_backoffUs.compare_exchange_weak(prev, next, etl::memory_order_relaxed));
+    bool first = (prev == 0);
+    m_backoffUntilNs.store(BusStats::nowNs() + (uint64_t)next * 1000u, etl::memory_order_relaxed);
+
+    if (first)
+        return busFail(BusErr_Io, err, where);
+    BusError e = { BusErr_Io, err, where };
+    return etl::unexpected<BusError>(e);
+}
+
+BusStatus Can::restartController()
+{
+    unsigned int ifindex = if_nametoindex(m_cfg.ifName.c_str());
+    if (ifindex == 0)
+        return busFail(BusErr_Config, errno, "can restart ifindex");
+
+    int fd = ::socket(AF_NETLINK, SOCK_RAW, NETLINK_ROUTE);
+    if (fd < 0)
+        return busFail(BusErr_Open, errno, "can restart socket");
+
+    // RTM_NEWLINK { ifinfomsg, IFLA_LINKINFO { IFLA_INFO_KIND "can", IFLA_INFO_DATA { IFLA_CAN_RESTART = 1 } } }
+    struct {
+        struct nlmsghdr  nh;
+        struct ifinfomsg ifi;
+        char             attrs[64];
+    } req;
+    memset(&req, 0, sizeof(req));
+    req.nh.nlmsg_len   = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    req.nh.nlmsg_type  = RTM_NEWLINK;
+    req.nh.nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK;
+    req.nh.nlmsg_seq   = 1;
+    req.ifi.ifi_family = AF_UNSPEC;
+    req.ifi.ifi_index  = (int)ifindex;
+
+    struct rtattr* linkinfo = (struct rtattr*)((char*)&req + NLMSG_ALIGN(req.nh.nlmsg_len));
+    linkinfo->rta_type = IFLA_LINKINFO;
+    linkinfo->rta_len  = RTA_LENGTH(0);
+
+    struct rtattr* kind = (struct rtattr*)((char*)linkinfo + RTA_ALIGN(linkinfo->rta_len));
+    kind->rta_type = IFLA_INFO_KIND;
+    kind->rta_len  = RTA_LENGTH(sizeof("can"));
+    memcpy(RTA_DATA(kind), "can", sizeof("can"));
+    linkinfo->rta_len = (unsigned short)(RTA_ALIGN(linkinfo->rta_len) + RTA_ALIGN(kind->rta_len));
+
+    struct rtattr* data = (struct rtattr*)((char*)linkinfo + linkinfo->rta_len);
+    data->rta_type = IFLA_INFO_DATA;
+    data->rta_len  = RTA_LENGTH(0);
+
+    struct rtattr* restart = (struct rtattr*)((char*)data + RTA_ALIGN(data->rta_len));
+    uint32_t one = 1;
+    restart->rta_type = IFLA_CAN_RESTART;
+    restart->rta_len  = RTA_LENGTH(sizeof(one));
+    memcpy(RTA_DATA(restart), &one, sizeof(one));
+    data->rta_len     = (unsigned short)(RTA_ALIGN(data->rta_len) + RTA_ALIGN(restart->rta_len));
+    linkinfo->rta_len = (unsigned short)(linkinfo->rta_len + data->rta_len);
+    req.nh.nlmsg_len  = NLMSG_ALIGN(req.nh.nlmsg_len) + RTA_ALIGN(linkinfo->rta_len);
+
+    BusStatus st;
+    if (::send(fd, &req, req.nh.nlmsg_len, 0) < 0) {
+        st = busFail(BusErr_Io, errno, "can restart send");
+    } else {
+        char buf[512];
+        int  n = (int)::recv(fd, buf, sizeof(buf), 0);
+        if (n < 0) {
+            st = busFail(BusErr_Io, errno, "can restart recv");
+        } else if (n >= (int)NLMSG_LENGTH(sizeof(struct nlmsgerr))) {
+            struct nlmsghdr* nh = (struct nlmsghdr*)buf;
+            if (nh->nlmsg_type == NLMSG_ERROR) {
+                int err = -((struct nlmsgerr*)NLMSG_DATA(nh))->error;
+                if (err != 0)
+                    st = busFail(BusErr_Config, err, "can restart");
+            }
+        }
+    }
+    ::close(fd);
+    return st;
 }
 /******************************** FILE END ********************************/
@@ -20,6 +20,10 @@
 ***************************************************************************/
 #include <stdint.h>
 #include "etl/string.h"
+#include "etl/atomic.h"
+#include "BusStats.h"
+#include "BusError.h"
+#include "BusBuffer.h"
 
 /***************************************************************************
  						macro definition
@@ -27,6 +31,13 @@
 #define CAN0_DEVICE "can0"
 #define CAN1_DEVICE "can1"
 
+#define CAN_RX_BATCH_MAX 32     // receiveBatch() ȡ֡
+#define CAN_RAW_FRAME_SIZE 16   // ں struct can_frame ĴС
+#define CAN_TX_BATCH_MAX 32     // sendBatch() ෢֡
+
+#define CAN_TX_BACKOFF_MIN_US 100       // ʧܺ״˱ʱ䣨΢룩
+#define CAN_TX_BACKOFF_MAX_US 100000    // ˱ʱޣÿʧܷ
+
 /***************************************************************************
  						class declaration
 ***************************************************************************/
@@ -38,6 +49,38 @@ public:
         int  loopback;          // Ƿ򿪻ػ0 أ 0 
         int  recvOwn;           // ǷԼ֡
         int  recvTimeoutMs;     // receive() ȴ֡ʱ䣬룩<=0 ʾһֱ
+        int  timestamp;         //  0 ʱ SO_TIMESTAMPNSreceiveBatch() ں˽ʱ
+        uint32_t filterId;      // չ id/maskmask Ϊ 0 ʾȫ
+        uint32_t filterMask;
+        int  errorFrames;       //  0 ʱ CAN_RAW_ERR_FILTER֡÷ֻ errorStatus()
+        int  txBackoffMinUs;    // ˱/ޣ΢룩<=0 ʹ CAN_TX_BACKOFF_*_US
+        int  txBackoffMaxUs;
+        int  busOffRestartMs;   // >0bus-off 󳬹ʱδָ netlink  CAP_NET_ADMIN
+                                // ɽ·receive / receiveBatch / receiveRaw / BusRing::poll𣬷̲߳ϵͳ
+    };
+
+    // ״̬ɴ֡ƶϣδ errorFrames ʱΪ State_Active
+    enum CtrlState {
+        State_Active  = 0,
+        State_Warning = 1,
+        State_Passive = 2,
+        State_BusOff  = 3
+    };
+
+    struct ErrorStatus {
+        CtrlState state;
+        uint8_t   txErrors;         // ϱ CAN_ERR_CNT ʱЧ
+        uint8_t   rxErrors;
+        uint32_t  errorFrames;
+        uint32_t  busOffs;
+        uint32_t  restarts;         // յ CAN_ERR_RESTARTED Ĵ
+        uint32_t  arbitrationLost;
+        uint32_t  protocolErrors;
+        uint32_t  ackErrors;
+        uint32_t  rxOverflows;
+        uint32_t  txTimeouts;
+        uint32_t  txThrottled;      // ˱ܻ bus-off ڼֱӾܾķʹ
+        uint64_t  lastErrorNs;      // һδ֡ʱ䣨CLOCK_MONOTONIC0 ʾû
     };
 
     struct Frame {
@@ -52,23 +95,99 @@ public:
     Can(const Config& cfg);
     ~Can();
 
-    bool open();
+    BusStatus open();
     void close();
     bool isOpen() const { return m_fd >= 0; }
 
-    bool reconfigure(const Config& cfg);
+    // ѴʱЧֻԱ仯ѡ setsockoptifName 仯ʱ bind
+    //  bind ԭ socket ϽУŶӵ֡Կɶں˲֧ԭذʱ
+    // ½ socket 滻ԭ fd ϣ socket ߵ֡ lostFramesΪ nullptr
+    // ѹ֡ socket ǰ㣬滻ǰһ̵ɽӿڵĸ֡ᶪ롣
+    // ʧʱ config() ־ãʧ֮ܵǰѡѾЧ
+    BusStatus reconfigure(const Config& cfg, uint32_t* lostFrames = nullptr);
     const Config& config() const { return m_cfg; }
 
-    bool send(const Frame& frame);
-    bool receive(Frame& frame); // ʱ/󷵻 false
+    // bus-off ˱ڼ䲻ϵͳá־ֱӷ BusErr_FullsysErrno Ϊ ENOBUFS
+    // ÷ԭеġENOBUFS Եԡ߼޸ġ
+    // send / sendBatch / sendRaw ڶ߳ͬʱã˱״̬з̹߳
+    BusStatus send(const Frame& frame);
+    BusStatus receive(Frame& frame); // ʱ BusErr_Timeout
+
+    // һεȴ + һ recvmmsg ȡ֡֡ʱ BusErr_Timeout
+    // stampsNs Ϊ nullptrtimestamp ʱΪں˽ʱ䣨CLOCK_REALTIME
+    // Ϊȡһ CLOCK_MONOTONIC ʱ
+    BusCount receiveBatch(Frame* frames, uint64_t* stampsNs, int maxFrames);
+
+    // һ sendmmsg ֡ʵʷ֡ count
+    // 緢Ͷһ֡ûʱش
+    BusCount sendBatch(const Frame* frames, int count);
+
+    // ֱշں struct can_frame 飨ÿ֡ CAN_RAW_FRAME_SIZE ֽڣ toRaw/fromRaw ת
+    // ÿ֡һ iovec ָ÷壬һ sendmmsg / recvmmsg Frame תм俽
+    // ֡ CAN_TX_BATCH_MAX / CAN_RX_BATCH_MAX ֡֡ͬ
+    BusCount sendRaw(BusConstBuf raw);
+    BusCount receiveRaw(BusBuf raw);
+
+    // SIOCOUTQѽں˵δɵֽ skb ռüƣ֡
+    //  CanTxArbiter ѹ qdisc / ֡
+    BusCount txQueuedBytes() const;
 
-    // ü򵥹id/mask
-    bool setFilter(uint32_t id, uint32_t mask);
+    // ü򵥹id/maskͬʱ config()
+    BusStatus setFilter(uint32_t id, uint32_t mask);
+
+    // ں struct can_frame ת BusRing ƹ send/receive  I/O ʹ
+    static void toRaw(const Frame& frame, void* raw);
+    static void fromRaw(const void* raw, Frame& frame);
+
+    // ֡ͳ״̵̬߳
+    void errorStatus(ErrorStatus& out) const;
+
+    //  netlink ͬ ip link set canX type can restart
+    BusStatus restartController();
+
+    // ͳƿգBUS_STATS_ENABLE=0 ʱΪ 0̵߳
+    void statsSnapshot(BusStats::Snapshot& out) const { m_stats.snapshot(out); }
+    void resetStats() { m_stats.reset(); }
 
 private:
+    friend class BusRing;   // io_uring ֱ m_fd ύд
+
     int    m_fd;
     Config m_cfg;
+    BusStats m_stats;
+
+    BusStatus applyOptions(int fd, const Config* prev);
+    BusStatus bindInterface(int fd, const char* where);
+    BusStatus replaceSocket(uint32_t* lostFrames);
+
+    void      onErrorFrame(const void* raw);    // Ϊں struct can_frame
+    void      resetErrorState();
+    BusStatus txGate(const char* where);
+    int       serviceRestart();     // ·ãؾжٺ룬-1 ʾȴ
+    BusStatus txFailed(int err, const char* where);
+    void      txSucceeded() { m_backoffUs.store(0, etl::memory_order_relaxed); }
+
+    // ״̬ɽ߳д̶̺߳߳
+    etl::atomic<int>      m_ctrlState;
+    etl::atomic<uint32_t> m_errCounters;        // txErrors | rxErrors << 8
+    etl::atomic<uint32_t> m_errFrames;
+    etl::atomic<uint32_t> m_busOffs;
+    etl::atomic<uint32_t> m_restarts;
+    etl::atomic<uint32_t> m_arbLost;
+    etl::atomic<uint32_t> m_protErrors;
+    etl::atomic<uint32_t> m_ackErrors;
+    etl::atomic<uint32_t> m_rxOverflows;
+    etl::atomic<uint32_t> m_txTimeouts;
+    etl::atomic<uint32_t> m_txThrottled;
+    etl::atomic<uint64_t> m_lastErrNs;
+    etl::atomic<uint64_t> m_busOffNs;
+
+    // ˱ܣз̣߳ BusRingͬд
+    etl::atomic<uint64_t> m_backoffUntilNs;
+    etl::atomic<uint32_t> m_backoffUs;
+    etl::atomic<uint32_t> m_restartReqFor;      // Ϊڼ bus-off 
 
-    bool applyOptions();
+    // timeoutMs < 0 ʾһֱ
+    BusStatus waitReadable(uint64_t callStart, int timeoutMs, const char* where);
 };
 /******************************** FILE END ********************************/
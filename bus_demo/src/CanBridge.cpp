@@ -0,0 +1,174 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: CanBridge.cpp
+ * Author		: Fan Fei
+ * Description	:
+ * Comments		:
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include "CanBridge.h"
+
+/***************************************************************************
+ 						class definition
+***************************************************************************/
+void* CanBridge::BlockAllocator::allocate_block(size_t size, size_t alignment)
+{
+    void* p;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        p = m_blocks.allocate(size, alignment);
+    }
+
+    if (p != nullptr) {
+        uint32_t n = m_inUse.fetch_add(1, etl::memory_order_relaxed) + 1;
+        uint32_t peak = m_peak.load(etl::memory_order_relaxed);
+        while (n > peak && !m_peak.compare_exchange_weak(peak, n, etl::memory_order_relaxed)) {
+        }
+    }
+    return p;
+}
+
+bool CanBridge::BlockAllocator::release_block(const void* const block)
+{
+    bool released;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        released = m_blocks.release(block);
+    }
+
+    if (released)
+        m_inUse.fetch_sub(1, etl::memory_order_relaxed);
+    return released;
+}
+
+bool CanBridge::BlockAllocator::is_owner_of_block(const void* const block) const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_blocks.is_owner_of(block);
+}
+
+void CanBridge::Probe::receive(const etl::imessage& msg)
+{
+    uint64_t t0 = m_stats.beginCall();
+    m_target.receive(msg);
+    m_stats.endCall(t0);
+    m_stats.addFrameIn();
+}
+
+void CanBridge::Probe::receive(etl::shared_message msg)
+{
+    // ֻãҪ첽б msg
+    uint64_t t0 = m_stats.beginCall();
+    m_target.receive(msg);
+    m_stats.endCall(t0);
+    m_stats.addFrameIn();
+}
+
+CanBridge::CanBridge(etl::imessage_bus& bus, uint8_t channel)
+    : m_bus(bus)
+    , m_channel(channel)
+    , m_allocator()
+    , m_pool(m_allocator)
+    , m_routes()
+    , m_probes()
+    , m_published(0)
+    , m_unrouted(0)
+    , m_exhausted(0)
+{
+}
+
+CanBridge::~CanBridge()
+{
+    unsubscribeAll();
+}
+
+BusStatus CanBridge::subscribe(etl::imessage_router& router)
+{
+    if (m_probes.full())
+        return busError(BusErr_Full, "can bridge subscribe");
+
+    m_probes.emplace_back(router);
+    if (!m_bus.subscribe(m_probes.back())) {
+        m_probes.pop_back();
+        return busError(BusErr_Full, "can bridge subscribe");
+    }
+    return BusStatus();
+}
+
+void CanBridge::unsubscribeAll()
+{
+    for (size_t i = 0; i < m_probes.size(); ++i)
+        m_bus.unsubscribe(m_probes[i]);
+    m_probes.clear();
+}
+
+BusStatus CanBridge::publish(const Can::Frame& frame, uint64_t tsNs)
+{
+    const Route* route = nullptr;
+    for (size_t i = 0; i < m_routes.size(); ++i) {
+        if ((frame.id & m_routes[i].mask) == m_routes[i].canId) {
+            route = &m_routes[i];
+            break;
+        }
+    }
+
+    if (route == nullptr) {
+        m_unrouted.fetch_add(1, etl::memory_order_relaxed);
+        return busError(BusErr_InvalidArg, "can bridge unrouted");
+    }
+
+    // ֻб̷߳䣬ֻ߳ͷţ￴пλһܷɹ
+    // ܵȵ allocate ʧٴetl ڷʧʱ
+    if (m_allocator.inUse() >= CAN_BRIDGE_POOL_SIZE) {
+        m_exhausted.fetch_add(1, etl::memory_order_relaxed);
+        return busError(BusErr_Full, "can bridge pool");
+    }
+
+    etl::shared_message msg = route->make(m_pool, frame, tsNs, m_channel);
+    m_bus.receive(msg);
+    m_published.fetch_add(1, etl::memory_order_relaxed);
+    return BusStatus();
+}
+
+BusCount CanBridge::pump(Can& can)
+{
+    Can::Frame frames[CAN_RX_BATCH_MAX];
+    uint64_t   stamps[CAN_RX_BATCH_MAX];
+
+    BusCount n = can.receiveBatch(frames, stamps, CAN_RX_BATCH_MAX);
+    if (!n)
+        return n;
+
+    int published = 0;
+    for (int i = 0; i < n.value(); ++i) {
+        if (publish(frames[i], stamps[i]))
+            ++published;
+    }
+    return published;
+}
+
+void CanBridge::stats(Stats& out) const
+{
+    out.published     = m_published.load(etl::memory_order_relaxed);
+    out.unrouted      = m_unrouted.load(etl::memory_order_relaxed);
+    out.poolExhausted = m_exhausted.load(etl::memory_order_relaxed);
+    out.poolInUse     = m_allocator.inUse();
+    out.poolPeak      = m_allocator.peak();
+}
+
+void CanBridge::routerStats(int index, BusStats::Snapshot& out) const
+{
+    m_probes[index].m_stats.snapshot(out);
+}
+/******************************** FILE END ********************************/
@@ -0,0 +1,189 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: CanBridge.h
+ * Author		: Fan Fei
+ * Description	: յ CAN ֡ת etl::shared_message Ͷݵ etl::message_bus
+ * Comments		: ϢüϢط䣬ж߹ͬһغɣ
+ *				  غľδƥ·ɡߴʱӶм
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include <mutex>
+#include "etl/atomic.h"
+#include "etl/vector.h"
+#include "etl/message.h"
+#include "etl/message_bus.h"
+#include "etl/shared_message.h"
+#include "etl/reference_counted_message.h"
+#include "etl/reference_counted_message_pool.h"
+#include "etl/fixed_sized_memory_block_allocator.h"
+#include "Can.h"
+#include "BusError.h"
+#include "BusStats.h"
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+#define CAN_BRIDGE_POOL_SIZE   64   // ͬʱ;߳УϢ
+#define CAN_BRIDGE_MAX_ROUTES  32
+#define CAN_BRIDGE_MAX_ROUTERS 8
+
+/***************************************************************************
+ 						class declaration
+***************************************************************************/
+// CAN ֡ϢID Ϊ etl Ϣ ID·ɱЩ CAN ID ӳ䵽Ϣ
+template <etl::message_id_t ID>
+struct CanFrameMessage : public etl::message<ID> {
+    CanFrameMessage(const Can::Frame& f, uint64_t ts, uint8_t ch)
+        : frame(f)
+        , tsNs(ts)
+        , channel(ch)
+    {
+    }
+
+    Can::Frame frame;
+    uint64_t   tsNs;
+    uint8_t    channel;
+};
+
+class CanBridge {
+public:
+    struct Stats {
+        uint64_t published;     // ɹͶݵߵ֡
+        uint64_t unrouted;      // ûƥ·ɶ֡
+        uint64_t poolExhausted; // Ϣþ֡
+        uint32_t poolInUse;
+        uint32_t poolPeak;
+    };
+
+    CanBridge(etl::imessage_bus& bus, uint8_t channel);
+    ~CanBridge();
+
+    //  (id & mask) == (canId & mask) ֡ת CanFrameMessage<MSG_ID>
+    // ˳ƥ䣬ƥ
+    template <etl::message_id_t MSG_ID>
+    BusStatus addRoute(uint32_t canId, uint32_t mask)
+    {
+        if (m_routes.full())
+            return busError(BusErr_Full, "can bridge route");
+
+        Route r;
+        r.canId = canId & mask;
+        r.mask  = mask;
+        r.make  = &CanBridge::makeMessage<MSG_ID>;
+        m_routes.push_back(r);
+        return BusStatus();
+    }
+
+    // ͨŶߣмһʱ¼ÿߵĴʱ
+    BusStatus subscribe(etl::imessage_router& router);
+    void unsubscribeAll();
+
+    // Ͷһ֡·ʱش󲢼
+    BusStatus publish(const Can::Frame& frame, uint64_t tsNs);
+
+    //  can һβͶݣͶݳɹ֡
+    BusCount pump(Can& can);
+
+    void stats(Stats& out) const;
+    int  routerCount() const { return (int)m_probes.size(); }
+    //  index ߵʱֱͼϢframesIn
+    void routerStats(int index, BusStats::Snapshot& out) const;
+
+private:
+    CanBridge(const CanBridge&);
+    CanBridge& operator=(const CanBridge&);
+
+    typedef etl::reference_counted_message_pool<etl::atomic_int32_t> MessagePool;
+
+    //  CanFrameMessage<ID> СͬһֿС
+    typedef etl::atomic_counted_message<CanFrameMessage<0> > PooledMessage;
+
+    typedef etl::shared_message (*MakeFn)(MessagePool& pool, const Can::Frame& frame,
+                                          uint64_t tsNs, uint8_t channel);
+
+    struct Route {
+        uint32_t canId;
+        uint32_t mask;
+        MakeFn   make;
+    };
+
+    // Ŀ߿ڱ߳ͷϢԼ
+    class BlockAllocator : public etl::imemory_block_allocator {
+    public:
+        BlockAllocator() : m_inUse(0), m_peak(0) {}
+
+        uint32_t inUse() const { return m_inUse.load(etl::memory_order_relaxed); }
+        uint32_t peak() const  { return m_peak.load(etl::memory_order_relaxed); }
+
+    protected:
+        virtual void* allocate_block(size_t size, size_t alignment) override;
+        virtual bool  release_block(const void* const block) override;
+        virtual bool  is_owner_of_block(const void* const block) const override;
+
+    private:
+        etl::fixed_sized_memory_block_allocator<sizeof(PooledMessage),
+                                                etl::alignment_of<PooledMessage>::value,
+                                                CAN_BRIDGE_POOL_SIZE> m_blocks;
+        mutable std::mutex    m_lock;
+        etl::atomic<uint32_t> m_inUse;
+        etl::atomic<uint32_t> m_peak;
+    };
+
+    // ʱ뱻Ķͬ IDתʱʱ
+    class Probe : public etl::imessage_router {
+    public:
+        Probe(etl::imessage_router& target)
+            : etl::imessage_router(target.get_message_router_id())
+            , m_target(target)
+        {
+        }
+
+        using etl::imessage_router::receive;
+        using etl::imessage_router::accepts;
+
+        virtual void receive(const etl::imessage& msg) override;
+        virtual void receive(etl::shared_message msg) override;
+        virtual bool accepts(etl::message_id_t id) const override { return m_target.accepts(id); }
+        virtual bool is_null_router() const override { return m_target.is_null_router(); }
+        virtual bool is_producer() const override    { return m_target.is_producer(); }
+        virtual bool is_consumer() const override    { return m_target.is_consumer(); }
+
+        BusStats m_stats;
+
+    private:
+        etl::imessage_router& m_target;
+    };
+
+    template <etl::message_id_t MSG_ID>
+    static etl::shared_message makeMessage(MessagePool& pool, const Can::Frame& frame,
+                                           uint64_t tsNs, uint8_t channel)
+    {
+        static_assert(sizeof(etl::atomic_counted_message<CanFrameMessage<MSG_ID> >) == sizeof(PooledMessage),
+                      "CanFrameMessage size differs between IDs");
+        return etl::shared_message::create<CanFrameMessage<MSG_ID> >(pool, frame, tsNs, channel);
+    }
+
+    etl::imessage_bus&                          m_bus;
+    uint8_t                                     m_channel;
+    BlockAllocator                              m_allocator;
+    MessagePool                                 m_pool;
+    etl::vector<Route, CAN_BRIDGE_MAX_ROUTES>   m_routes;
+    etl::vector<Probe, CAN_BRIDGE_MAX_ROUTERS>  m_probes;
+    etl::atomic<uint64_t>                       m_published;
+    etl::atomic<uint64_t>                       m_unrouted;
+    etl::atomic<uint64_t>                       m_exhausted;
+};
+/******************************** FILE END ********************************/
@@ -0,0 +1,533 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: CanGateway.cpp
+ * Author		: Fan Fei
+ * Description	:
+ * Comments		:
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include "CanGateway.h"
+#include "BusStats.h"
+#include "etl/crc16_ccitt.h"
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+/***************************************************************************
+ 						function definition
+***************************************************************************/
+static int putVarint(uint8_t* out, uint64_t v)
+{
+    int n = 0;
+    while (v >= 0x80) {
+        out[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+// Խ򳬹 10 ֽڷ false
+static bool getVarint(const uint8_t* in, int len, int& pos, uint64_t& v)
+{
+    v = 0;
+    for (int shift = 0; shift < 70; shift += 7) {
+        if (pos >= len)
+            return false;
+        uint8_t b = in[pos++];
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+static uint32_t zigzag(int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v)
+{
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static uint16_t packetCrc(const uint8_t* data, int len)
+{
+    return (uint16_t)etl::crc16_ccitt(data, data + len).value();
+}
+
+/***************************************************************************
+ 						class definition
+***************************************************************************/
+CanGwEncoder::CanGwEncoder(int packetBytes, int maxFrames)
+    : m_len(0)
+    , m_limit(packetBytes)
+    , m_maxFrames(maxFrames)
+    , m_count(0)
+    , m_seq(0)
+    , m_prevId(0)
+    , m_prevUs(0)
+{
+    // Ҫܷ°ͷ + һ֡ + CRC
+    if (m_limit > CAN_GW_PACKET_MAX)
+        m_limit = CAN_GW_PACKET_MAX;
+    if (m_limit < CAN_GW_HEAD_WORST + CAN_GW_FRAME_WORST + 2)
+        m_limit = CAN_GW_HEAD_WORST + CAN_GW_FRAME_WORST + 2;
+    if (m_maxFrames > CAN_GW_FRAMES_MAX)
+        m_maxFrames = CAN_GW_FRAMES_MAX;
+    if (m_maxFrames < 1)
+        m_maxFrames = 1;
+}
+
+void CanGwEncoder::reset()
+{
+    m_len    = 0;
+    m_count  = 0;
+    m_prevId = 0;
+    m_prevUs = 0;
+}
+
+bool CanGwEncoder::full() const
+{
+    return m_count >= m_maxFrames || m_len + CAN_GW_FRAME_WORST + 2 > m_limit;
+}
+
+bool CanGwEncoder::add(const Can::Frame& frame, uint64_t tsNs)
+{
+    if (m_count >= m_maxFrames)
+        return false;
+
+    uint64_t tsUs = tsNs / 1000;
+    uint8_t  tmp[CAN_GW_HEAD_WORST + CAN_GW_FRAME_WORST];
+    int      n = 0;
+
+    if (m_count == 0) {
+        tmp[n++] = m_seq;
+        tmp[n++] = 0;           // ֡finish() ʱ
+        n += putVarint(tmp + n, tsUs);
+        m_prevUs = tsUs;
+    }
+
+    // ʱ䵹ˣ˲ͬʱӣʱ 0 ִ
+    if (tsUs < m_prevUs)
+        tsUs = m_prevUs;
+
+    uint8_t dlc = frame.dlc > 8 ? 8 : frame.dlc;
+    uint8_t head = dlc;
+    if (frame.isExtended)
+        head |= CAN_GW_HEAD_EXT;
+    if (frame.isRTR)
+        head |= CAN_GW_HEAD_RTR;
+
+    tmp[n++] = head;
+    n += putVarint(tmp + n, zigzag((int32_t)(frame.id - m_prevId)));
+    n += putVarint(tmp + n, tsUs - m_prevUs);
+    if (!frame.isRTR) {
+        memcpy(tmp + n, frame.data, dlc);
+        n += dlc;
+    }
+
+    // ʵʱ볤жϣCRC Ԥ 2 ֽ
+    if (m_len + n + 2 > m_limit)
+        return false;
+
+    memcpy(m_buf + m_len, tmp, (size_t)n);
+    m_len   += n;
+    m_prevId = frame.id;
+    m_prevUs = tsUs;
+    ++m_count;
+    return true;
+}
+
+int CanGwEncoder::finish(uint8_t* wire)
+{
+    if (m_count == 0)
+        return 0;
+
+    m_buf[1] = (uint8_t)m_count;
+    uint16_t crc = packetCrc(m_buf, m_len);
+    m_buf[m_len++] = (uint8_t)(crc & 0xFF);
+    m_buf[m_len++] = (uint8_t)(crc >> 8);
+
+    int n = cobsEncode(m_buf, m_len, wire);
+    wire[n++] = 0;
+
+    ++m_seq;
+    reset();
+    return n;
+}
+
+int CanGwEncoder::cobsEncode(const uint8_t* in, int len, uint8_t* out)
+{
+    int     codeIdx = 0;
+    int     o = 1;
+    uint8_t code = 1;
+
+    for (int i = 0; i < len; ++i) {
+        if (in[i] == 0) {
+            out[codeIdx] = code;
+            codeIdx = o++;
+            code = 1;
+            continue;
+        }
+        out[o++] = in[i];
+        if (++code == 0xFF) {
+            out[codeIdx] = code;
+            codeIdx = o++;
+            code = 1;
+        }
+    }
+    out[codeIdx] = code;
+    return o;
+}
+
+int CanGwEncoder::cobsDecode(const uint8_t* in, int len, uint8_t* out)
+{
+    int i = 0;
+    int o = 0;
+
+    while (i < len) {
+        uint8_t code = in[i++];
+        if (code == 0)
+            return -1;
+        for (int k = 1; k < code; ++k) {
+            if (i >= len || in[i] == 0)
+                return -1;
+            out[o++] = in[i++];
+        }
+        // 0xFF û 0һҲû
+        if (code != 0xFF && i < len)
+            out[o++] = 0;
+    }
+    return o;
+}
+
+CanGwDecoder::CanGwDecoder()
+    : m_rawLen(0)
+    , m_overflow(false)
+    , m_ready(false)
+    , m_haveSeq(false)
+    , m_lastSeq(0)
+    , m_count(0)
+{
+    memset(&m_counters, 0, sizeof(m_counters));
+}
+
+int CanGwDecoder::feed(const uint8_t* data, int len)
+{
+    m_ready = false;
+
+    for (int i = 0; i < len; ++i) {
+        uint8_t b = data[i];
+        if (b != 0) {
+            if (m_rawLen < (int)sizeof(m_raw))
+                m_raw[m_rawLen++] = b;
+            else
+                m_overflow = true;
+            continue;
+        }
+
+        // ָ 0 Ϊհ
+        if (m_rawLen == 0 && !m_overflow)
+            continue;
+
+        bool ok = false;
+        if (!m_overflow) {
+            uint8_t pkt[CAN_GW_WIRE_MAX];
+            int n = CanGwEncoder::cobsDecode(m_raw, m_rawLen, pkt);
+            if (n < 0)
+                ++m_counters.formatErrors;
+            else
+                ok = parse(pkt, n);
+        } else {
+            ++m_counters.formatErrors;
+        }
+
+        m_rawLen   = 0;
+        m_overflow = false;
+        if (ok) {
+            m_ready = true;
+            return i + 1;
+        }
+    }
+    return len;
+}
+
+bool CanGwDecoder::parse(const uint8_t* pkt, int len)
+{
+    // ̣seq + count + 1 ֽڻ׼ʱ + crc
+    if (len < 5) {
+        ++m_counters.formatErrors;
+        return false;
+    }
+
+    int      body = len - 2;
+    uint16_t crc  = (uint16_t)(pkt[body] | (pkt[body + 1] << 8));
+    if (packetCrc(pkt, body) != crc) {
+        ++m_counters.crcErrors;
+        return false;
+    }
+
+    uint8_t seq   = pkt[0];
+    int     count = pkt[1];
+    int     pos   = 2;
+    uint64_t tsUs;
+    if (count == 0 || count > CAN_GW_FRAMES_MAX || !getVarint(pkt, body, pos, tsUs)) {
+        ++m_counters.formatErrors;
+        return false;
+    }
+
+    uint32_t id = 0;
+    for (int i = 0; i < count; ++i) {
+        if (pos >= body) {
+            ++m_counters.formatErrors;
+            return false;
+        }
+        uint8_t  head = pkt[pos++];
+        uint64_t idDelta;
+        uint64_t tsDelta;
+        if (!getVarint(pkt, body, pos, idDelta) || !getVarint(pkt, body, pos, tsDelta)) {
+            ++m_counters.formatErrors;
+            return false;
+        }
+
+        Can::Frame& f = m_frames[i];
+        f.dlc        = head & 0x0F;
+        f.isExtended = (head & CAN_GW_HEAD_EXT) ? 1 : 0;
+        f.isRTR      = (head & CAN_GW_HEAD_RTR) ? 1 : 0;
+        if (f.dlc > 8) {
+            ++m_counters.formatErrors;
+            return false;
+        }
+
+        id  += (uint32_t)unzigzag((uint32_t)idDelta);
+        tsUs += tsDelta;
+        f.id = id;
+        m_stampsNs[i] = tsUs * 1000;
+
+        memset(f.data, 0, sizeof(f.data));
+        if (!f.isRTR) {
+            if (pos + f.dlc > body) {
+                ++m_counters.formatErrors;
+                return false;
+            }
+            memcpy(f.data, pkt + pos, f.dlc);
+            pos += f.dlc;
+        }
+    }
+
+    if (pos != body) {
+        ++m_counters.formatErrors;
+        return false;
+    }
+
+    if (m_haveSeq)
+        m_counters.seqGaps += (uint8_t)(seq - m_lastSeq - 1);
+    m_haveSeq = true;
+    m_lastSeq = seq;
+
+    m_count = count;
+    ++m_counters.packets;
+    m_counters.frames += (uint64_t)count;
+    return true;
+}
+
+CanGateway::CanGateway()
+    : m_cfg()
+    , m_enc(m_cfg.packetBytes, m_cfg.maxFrames)
+    , m_dec()
+    , m_pendingNs(0)
+    , m_framesToUart(0)
+    , m_packetsToUart(0)
+    , m_bytesToUart(0)
+    , m_flushBySize(0)
+    , m_flushByDeadline(0)
+    , m_framesToCan(0)
+    , m_canSendRetries(0)
+    , m_canFramesDropped(0)
+    , m_rxPackets(0)
+    , m_rxFrames(0)
+    , m_rxCrcErrors(0)
+    , m_rxFormatErrors(0)
+    , m_rxSeqGaps(0)
+{
+}
+
+CanGateway::CanGateway(const Config& cfg)
+    : m_cfg(cfg)
+    , m_enc(cfg.packetBytes, cfg.maxFrames)
+    , m_dec()
+    , m_pendingNs(0)
+    , m_framesToUart(0)
+    , m_packetsToUart(0)
+    , m_bytesToUart(0)
+    , m_flushBySize(0)
+    , m_flushByDeadline(0)
+    , m_framesToCan(0)
+    , m_canSendRetries(0)
+    , m_canFramesDropped(0)
+    , m_rxPackets(0)
+    , m_rxFrames(0)
+    , m_rxCrcErrors(0)
+    , m_rxFormatErrors(0)
+    , m_rxSeqGaps(0)
+{
+}
+
+BusStatus CanGateway::writePacket(Uart& uart)
+{
+    int frames = m_enc.count();
+    int n = m_enc.finish(m_wire);
+    if (n <= 0)
+        return BusStatus();
+
+    BusCount w = uart.write(m_wire, n);
+    if (!w)
+        return etl::unexpected<BusError>(w.error());
+
+    m_framesToUart.fetch_add((uint64_t)frames, etl::memory_order_relaxed);
+    m_packetsToUart.fetch_add(1, etl::memory_order_relaxed);
+    m_bytesToUart.fetch_add((uint64_t)n, etl::memory_order_relaxed);
+    return BusStatus();
+}
+
+BusStatus CanGateway::flush(Uart& uart)
+{
+    if (m_enc.empty())
+        return BusStatus();
+    m_flushByDeadline.fetch_add(1, etl::memory_order_relaxed);
+    return writePacket(uart);
+}
+
+BusCount CanGateway::pumpCanToUart(Can& can, Uart& uart)
+{
+    Can::Frame frames[CAN_RX_BATCH_MAX];
+    uint64_t   stamps[CAN_RX_BATCH_MAX];
+
+    int n = 0;
+    BusCount got = can.receiveBatch(frames, stamps, CAN_RX_BATCH_MAX);
+    if (got)
+        n = *got;
+    else if (got.error().code != BusErr_Timeout)
+        return got;
+
+    for (int i = 0; i < n; ++i) {
+        if (m_enc.empty())
+            m_pendingNs = BusStats::nowNs();
+
+        if (!m_enc.add(frames[i], stamps[i])) {
+            // ʵʳȷŲ£ȷǰٷ
+            m_flushBySize.fetch_add(1, etl::memory_order_relaxed);
+            BusStatus st = writePacket(uart);
+            if (!st)
+                return etl::unexpected<BusError>(st.error());
+            m_pendingNs = BusStats::nowNs();
+            m_enc.add(frames[i], stamps[i]);
+        }
+
+        if (m_enc.full()) {
+            m_flushBySize.fetch_add(1, etl::memory_order_relaxed);
+            BusStatus st = writePacket(uart);
+            if (!st)
+                return etl::unexpected<BusError>(st.error());
+        }
+    }
+
+    if (!m_enc.empty() && BusStats::nowNs() - m_pendingNs >= (uint64_t)m_cfg.flushUs * 1000u) {
+        BusStatus st = flush(uart);
+        if (!st)
+            return etl::unexpected<BusError>(st.error());
+    }
+    return n;
+}
+
+BusCount CanGateway::sendAll(Can& can, const Can::Frame* frames, int count)
+{
+    int      sent     = 0;
+    uint64_t deadline = 0;
+    while (sent < count) {
+        BusCount n = can.sendBatch(frames + sent, count - sent);
+        if (n) {
+            sent += *n;
+            m_framesToCan.fetch_add((uint64_t)*n, etl::memory_order_relaxed);
+            continue;
+        }
+
+        int err = n.error().sysErrno;
+        if (err != ENOBUFS && err != EAGAIN)
+            return n;
+
+        // Ͷʱԣbus-off ڼ txGate һֱֱܾӶ
+        Can::ErrorStatus es;
+        can.errorStatus(es);
+        uint64_t now = BusStats::nowNs();
+        if (deadline == 0)
+            deadline = now + (uint64_t)(m_cfg.canSendTimeoutMs > 0 ? m_cfg.canSendTimeoutMs : 0) * 1000000u;
+        if (es.state == Can::State_BusOff || now >= deadline) {
+            m_canFramesDropped.fetch_add((uint64_t)(count - sent), etl::memory_order_relaxed);
+            break;
+        }
+        m_canSendRetries.fetch_add(1, etl::memory_order_relaxed);
+        usleep(100);
+    }
+    return sent;
+}
+
+BusCount CanGateway::pumpUartToCan(Uart& uart, Can& can, int readTimeoutMs)
+{
+    BusCount r = uart.read(m_rxBuf, (int)sizeof(m_rxBuf), readTimeoutMs);
+    if (!r)
+        return r;
+
+    int total = 0;
+    int off   = 0;
+    while (off < *r) {
+        off += m_dec.feed(m_rxBuf + off, *r - off);
+        if (!m_dec.ready())
+            continue;
+
+        BusCount n = sendAll(can, m_dec.frames(), m_dec.count());
+        if (!n)
+            return n;
+        total += *n;
+    }
+
+    const CanGwDecoder::Counters& c = m_dec.counters();
+    m_rxPackets.store(c.packets, etl::memory_order_relaxed);
+    m_rxFrames.store(c.frames, etl::memory_order_relaxed);
+    m_rxCrcErrors.store(c.crcErrors, etl::memory_order_relaxed);
+    m_rxFormatErrors.store(c.formatErrors, etl::memory_order_relaxed);
+    m_rxSeqGaps.store(c.seqGaps, etl::memory_order_relaxed);
+    return total;
+}
+
+void CanGateway::counters(Counters& out) const
+{
+    out.framesToUart    = m_framesToUart.load(etl::memory_order_relaxed);
+    out.packetsToUart   = m_packetsToUart.load(etl::memory_order_relaxed);
+    out.bytesToUart     = m_bytesToUart.load(etl::memory_order_relaxed);
+    out.flushBySize     = m_flushBySize.load(etl::memory_order_relaxed);
+    out.flushByDeadline = m_flushByDeadline.load(etl::memory_order_relaxed);
+    out.framesToCan     = m_framesToCan.load(etl::memory_order_relaxed);
+    out.canSendRetries  = m_canSendRetries.load(etl::memory_order_relaxed);
+    out.canFramesDropped = m_canFramesDropped.load(etl::memory_order_relaxed);
+    out.rx.packets      = m_rxPackets.load(etl::memory_order_relaxed);
+    out.rx.frames       = m_rxFrames.load(etl::memory_order_relaxed);
+    out.rx.crcErrors    = m_rxCrcErrors.load(etl::memory_order_relaxed);
+    out.rx.formatErrors = m_rxFormatErrors.load(etl::memory_order_relaxed);
+    out.rx.seqGaps      = m_rxSeqGaps.load(etl::memory_order_relaxed);
+}
+/******************************** FILE END ********************************/
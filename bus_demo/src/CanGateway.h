@@ -0,0 +1,194 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: CanGateway.h
+ * Author		: Fan Fei
+ * Description	: CAN <-> أ CAN ֡ߴڣ̨
+ *				  Զ˽ CAN
+ * Comments		: ʽCOBS ǰ
+ *				    seq(1) | count(1) | baseTsUs(varint) | ֡ * count | crc16(2)
+ *				  ÿ֡head(1) | idDelta(zigzag varint) | tsDeltaUs(varint) | data
+ *				  head  4 λΪ dlcbit4 չ֡bit5 RTRRTR ֡ݣ
+ *				  ID ʱ䶼԰һ֣֡ÿ 0 ¿ʼһӰ
+ *				  CRC Ϊ CRC16-CCITTetl/crc16_ccitt.hCOBS  0x00 ָ
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include "etl/atomic.h"
+#include "Can.h"
+#include "Uart.h"
+#include "BusError.h"
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+#define CAN_GW_PACKET_MAX   512     //  COBS ǰֽ
+#define CAN_GW_FRAMES_MAX   64      // ɵ֡
+#define CAN_GW_FRAME_WORST  24      // ֡볤ȣ1 + 5 + 10 + 8
+#define CAN_GW_HEAD_WORST   12      // ͷȣ1 + 1 + 10
+#define CAN_GW_WIRE_MAX     (CAN_GW_PACKET_MAX + CAN_GW_PACKET_MAX / 254 + 2)   // COBS  + ָ
+
+#define CAN_GW_HEAD_EXT     0x10
+#define CAN_GW_HEAD_RTR     0x20
+
+/***************************************************************************
+ 						class declaration
+***************************************************************************/
+// ˣ֡ʱ finish() һοֱдڵֽ
+class CanGwEncoder {
+public:
+    // packetBytes / maxFrames ʱ޴
+    CanGwEncoder(int packetBytes = CAN_GW_PACKET_MAX, int maxFrames = CAN_GW_FRAMES_MAX);
+
+    // Ųʱ false÷Ӧ finish() 
+    bool add(const Can::Frame& frame, uint64_t tsNs);
+
+    bool empty() const { return m_count == 0; }
+    int  count() const { return m_count; }
+    bool full() const;      // һ֡»Ų
+
+    // ׷ CRCCOBS 벢ӷָд wire CAN_GW_WIRE_MAX ֽڣ
+    // ·ֽ֮ʼµһ
+    int finish(uint8_t* wire);
+
+    // COBS /룬ȣǷ뷵 -1
+    static int cobsEncode(const uint8_t* in, int len, uint8_t* out);
+    static int cobsDecode(const uint8_t* in, int len, uint8_t* out);
+
+private:
+    void reset();
+
+    uint8_t  m_buf[CAN_GW_PACKET_MAX];
+    int      m_len;
+    int      m_limit;
+    int      m_maxFrames;
+    int      m_count;
+    uint8_t  m_seq;
+    uint32_t m_prevId;
+    uint64_t m_prevUs;
+};
+
+// ˣֽι룬һ CRC ȷȫ֡
+class CanGwDecoder {
+public:
+    struct Counters {
+        uint64_t packets;       // Уͨİ
+        uint64_t frames;
+        uint64_t crcErrors;
+        uint64_t formatErrors;  // COBS ǷȲ
+        uint64_t seqGaps;       //  seq ƶ϶ʧİ
+    };
+
+    CanGwDecoder();
+
+    //  data ֽڣֱһֽ꣬
+    // ҽɹʱ ready() Ϊ棬ֱһ feed()
+    int feed(const uint8_t* data, int len);
+
+    bool              ready() const { return m_ready; }
+    int               count() const { return m_count; }
+    const Can::Frame* frames() const { return m_frames; }
+    const uint64_t*   stampsNs() const { return m_stampsNs; }  // Ͷʱӣ루΢뾫ȣ
+
+    const Counters& counters() const { return m_counters; }
+
+private:
+    bool parse(const uint8_t* pkt, int len);
+
+    uint8_t    m_raw[CAN_GW_WIRE_MAX];
+    int        m_rawLen;
+    bool       m_overflow;
+    bool       m_ready;
+    bool       m_haveSeq;
+    uint8_t    m_lastSeq;
+    int        m_count;
+    Can::Frame m_frames[CAN_GW_FRAMES_MAX];
+    uint64_t   m_stampsNs[CAN_GW_FRAMES_MAX];
+    Counters   m_counters;
+};
+
+// ˮߣ򻥲״̬ɷֱ߳ѭ
+class CanGateway {
+public:
+    struct Config {
+        Config()
+            : packetBytes(CAN_GW_PACKET_MAX)
+            , maxFrames(CAN_GW_FRAMES_MAX)
+            , flushUs(2000)
+            , canSendTimeoutMs(20)
+        {
+        }
+
+        int      packetBytes;   // ֽڣCOBS ǰͷ
+        int      maxFrames;     // ֡ͷ
+        uint32_t flushUs;       // һ֡ȶþͷ΢
+        int      canSendTimeoutMs;  // CAN ͶʱһԶãʱʣ֡<=0 
+    };
+
+    struct Counters {
+        uint64_t framesToUart;
+        uint64_t packetsToUart;
+        uint64_t bytesToUart;
+        uint64_t flushBySize;
+        uint64_t flushByDeadline;
+        uint64_t framesToCan;
+        uint64_t canSendRetries;    // CAN ͶʱԴ
+        uint64_t canFramesDropped;  // Գʱ bus-off ʱ֡
+        CanGwDecoder::Counters rx;
+    };
+
+    CanGateway();
+    CanGateway(const Config& cfg);
+
+    // CAN -> ڣȡһ֡룬ʱдڣرȡ֡
+    // ֹж receiveBatch() غУcan  recvTimeoutMs Ӧ flushUs
+    BusCount pumpCanToUart(Can& can, Uart& uart);
+
+    // δİд
+    BusStatus flush(Uart& uart);
+
+    //  -> CANһδڣѽİ sendBatch()  CANط֡
+    // Ͷʱ canSendTimeoutMsbus-off ʱԣ֡ canFramesDropped
+    //  CAN ߹ʱһŻѹ
+    BusCount pumpUartToCan(Uart& uart, Can& can, int readTimeoutMs);
+
+    // ̵߳ãֶεԭӶȡ
+    void counters(Counters& out) const;
+
+private:
+    BusStatus writePacket(Uart& uart);
+    BusCount  sendAll(Can& can, const Can::Frame* frames, int count);
+
+    Config       m_cfg;
+    CanGwEncoder m_enc;
+    CanGwDecoder m_dec;
+    uint8_t      m_wire[CAN_GW_WIRE_MAX];
+    uint8_t      m_rxBuf[1024];
+    uint64_t     m_pendingNs;   // ǰһ֡ʱ䣨CLOCK_MONOTONIC
+
+    etl::atomic<uint64_t> m_framesToUart;
+    etl::atomic<uint64_t> m_packetsToUart;
+    etl::atomic<uint64_t> m_bytesToUart;
+    etl::atomic<uint64_t> m_flushBySize;
+    etl::atomic<uint64_t> m_flushByDeadline;
+    etl::atomic<uint64_t> m_framesToCan;
+    etl::atomic<uint64_t> m_canSendRetries;
+    etl::atomic<uint64_t> m_canFramesDropped;
+    etl::atomic<uint64_t> m_rxPackets;
+    etl::atomic<uint64_t> m_rxFrames;
+    etl::atomic<uint64_t> m_rxCrcErrors;
+    etl::atomic<uint64_t> m_rxFormatErrors;
+    etl::atomic<uint64_t> m_rxSeqGaps;
+};
+/******************************** FILE END ********************************/
@@ -0,0 +1,470 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: CanRecorder.cpp
+ * Author		: Fan Fei
+ * Description	:
+ * Comments		:
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include "CanRecorder.h"
+#include "BusLog.h"
+#include "BusStats.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/***************************************************************************
+ 						class definition
+***************************************************************************/
+CanRecorder::CanRecorder()
+    : m_cfg()
+    , m_curPath()
+    , m_sparePath()
+    , m_fileIndex(0)
+    , m_generation(0)
+    , m_header(nullptr)
+    , m_records(nullptr)
+    , m_recorded(0)
+    , m_rotateFailures(0)
+    , m_renameTo(-1)
+    , m_spareFailed(false)
+    , m_prepBroken(false)
+    , m_prepStop(false)
+{
+    m_cur.header = nullptr;
+    m_cur.size   = 0;
+    m_spare      = m_cur;
+    m_retired    = m_cur;
+}
+
+CanRecorder::CanRecorder(const Config& cfg)
+    : m_cfg(cfg)
+    , m_curPath()
+    , m_sparePath()
+    , m_fileIndex(0)
+    , m_generation(0)
+    , m_header(nullptr)
+    , m_records(nullptr)
+    , m_recorded(0)
+    , m_rotateFailures(0)
+    , m_renameTo(-1)
+    , m_spareFailed(false)
+    , m_prepBroken(false)
+    , m_prepStop(false)
+{
+    m_cur.header = nullptr;
+    m_cur.size   = 0;
+    m_spare      = m_cur;
+    m_retired    = m_cur;
+}
+
+CanRecorder::~CanRecorder()
+{
+    close();
+}
+
+void CanRecorder::makePath(int index, etl::string<72>& out) const
+{
+    out = m_cfg.path.c_str();
+    if (m_cfg.fileCount > 1) {
+        char suffix[16];
+        snprintf(suffix, sizeof(suffix), ".%d", index);
+        out += suffix;
+    }
+}
+
+BusStatus CanRecorder::mapFile(const char* path, Mapping& out) const
+{
+    int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return busFail(BusErr_Open, errno, "open can log");
+
+    // һ԰ļŵմСֻ֮дӳڴ
+    size_t size = sizeof(FileHeader) + (size_t)m_cfg.recordsPerFile * sizeof(Record);
+    if (ftruncate(fd, (off_t)size) < 0) {
+        BusStatus st = busFail(BusErr_Io, errno, "ftruncate can log");
+        ::close(fd);
+        return st;
+    }
+
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        return busFail(BusErr_Io, errno, "mmap can log");
+
+    // Ԥȴҳץȱҳ
+    madvise(addr, size, MADV_WILLNEED);
+    memset(addr, 0, size);
+
+    FileHeader* header = (FileHeader*)addr;
+    memcpy(header->magic, CAN_LOG_MAGIC, sizeof(CAN_LOG_MAGIC));
+    header->recordSize = sizeof(Record);
+    header->capacity   = m_cfg.recordsPerFile;
+
+    out.header = header;
+    out.size   = size;
+    return BusStatus();
+}
+
+void CanRecorder::unmapFile(Mapping& map)
+{
+    if (map.header != nullptr) {
+        // 첽ˢ
+        msync(map.header, map.size, MS_ASYNC);
+        munmap(map.header, map.size);
+        map.header = nullptr;
+        map.size   = 0;
+    }
+}
+
+void CanRecorder::activate(const Mapping& map)
+{
+    // ֻдӳڴ棬ץ߳еҲ
+    m_cur     = map;
+    m_header  = map.header;
+    m_records = (Record*)((uint8_t*)map.header + sizeof(FileHeader));
+
+    m_header->count      = 0;
+    m_header->next       = 0;
+    m_header->generation = m_generation;
+    m_header->createNs   = BusStats::nowNs();
+    makePath(m_fileIndex, m_curPath);
+}
+
+BusStatus CanRecorder::open()
+{
+    if (isOpen())
+        return BusStatus();
+
+    if (m_cfg.recordsPerFile == 0 || m_cfg.fileCount <= 0)
+        return busError(BusErr_InvalidArg, "can log config");
+
+    m_fileIndex      = 0;
+    m_generation     = 0;
+    m_recorded       = 0;
+    m_rotateFailures = 0;
+
+    etl::string<72> path;
+    makePath(0, path);
+
+    Mapping map;
+    BusStatus st = mapFile(path.c_str(), map);
+    if (!st)
+        return st;
+    activate(map);
+
+    if (m_cfg.fileCount > 1) {
+        // Ԥ߳ʼ׼һļ
+        m_sparePath  = m_cfg.path.c_str();
+        m_sparePath += ".next";
+        m_renameTo    = -1;
+        m_spareFailed = false;
+        m_prepBroken  = false;
+        m_prepStop    = false;
+        m_prepThread  = std::thread(&CanRecorder::prepareLoop, this);
+    }
+    return BusStatus();
+}
+
+void CanRecorder::close()
+{
+    if (m_prepThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_prepStop = true;
+        }
+        m_cond.notify_one();
+        m_prepThread.join();
+    }
+
+    unmapFile(m_retired);
+    if (m_renameTo >= 0) {
+        // ǰļ path.next
+        if (::rename(m_sparePath.c_str(), m_curPath.c_str()) < 0)
+            busFail(BusErr_Io, errno, "rename can log");
+        m_renameTo = -1;
+    } else if (m_spare.header != nullptr) {
+        unmapFile(m_spare);
+        ::unlink(m_sparePath.c_str());
+    }
+
+    unmapFile(m_cur);
+    m_header  = nullptr;
+    m_records = nullptr;
+}
+
+void CanRecorder::prepareLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_cond.wait(lock, [this]() {
+            return m_prepStop || m_retired.header != nullptr || m_renameTo >= 0 ||
+                   (m_spare.header == nullptr && !m_spareFailed && !m_prepBroken);
+        });
+        if (m_prepStop)
+            return;
+
+        Mapping retired = m_retired;
+        int     renameTo = m_renameTo;
+        bool    needSpare = (m_spare.header == nullptr && !m_spareFailed && !m_prepBroken);
+        m_retired.header = nullptr;
+        m_retired.size   = 0;
+        m_renameTo       = -1;
+        lock.unlock();
+
+        // ӳ䡢ļڱ߳ɣץ̲߳Щϵͳ
+        unmapFile(retired);
+
+        bool renamed = true;
+        if (renameTo >= 0) {
+            etl::string<72> path;
+            makePath(renameTo, path);
+            if (::rename(m_sparePath.c_str(), path.c_str()) < 0) {
+                busFail(BusErr_Io, errno, "rename can log");
+                renamed = false;
+            }
+        }
+
+        // ȸٽµ path.nextضдļ
+        Mapping   spare = { nullptr, 0 };
+        BusStatus st;
+        if (needSpare && renamed)
+            st = mapFile(m_sparePath.c_str(), spare);
+
+        lock.lock();
+        if (!renamed) {
+            m_prepBroken = true;
+            if (renameTo >= 0)
+                m_renameTo = renameTo;     //  close() һ
+        } else if (needSpare) {
+            if (st)
+                m_spare = spare;
+            else
+                m_spareFailed = true;
+        }
+    }
+}
+
+BusStatus CanRecorder::rotate()
+{
+    Mapping next;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_spare.header == nullptr) {
+            // Ԥ̻߳ûûʧܣԣβת
+            m_spareFailed = false;
+            m_cond.notify_one();
+            return busFail(BusErr_Io, 0, "can log rotate");
+        }
+
+        // õļ˵Ԥ߳Ѵһε m_retired / m_renameTo
+        next      = m_spare;
+        m_retired = m_cur;
+        m_spare.header = nullptr;
+        m_spare.size   = 0;
+        m_fileIndex = (m_fileIndex + 1) % m_cfg.fileCount;
+        m_renameTo  = m_fileIndex;
+    }
+    m_cond.notify_one();
+
+    ++m_generation;
+    activate(next);
+    return BusStatus();
+}
+
+BusStatus CanRecorder::append(const Can::Frame& frame, uint64_t tsNs, uint8_t channel)
+{
+    if (m_header == nullptr)
+        return busError(BusErr_NotOpen, "can log append");
+
+    BusStatus st;
+    if (m_header->next >= m_header->capacity) {
+        if (m_cfg.fileCount > 1)
+            st = rotate();
+        if (m_cfg.fileCount <= 1 || !st) {
+            // ļƣתʧʱڵǰļڻƣ֡
+            if (!st)
+                ++m_rotateFailures;
+            m_header->next = 0;
+        }
+    }
+
+    uint8_t dlc = (frame.dlc > 8) ? 8 : frame.dlc;
+
+    Record& rec = m_records[m_header->next];
+    rec.tsNs     = tsNs;
+    rec.id       = frame.id;
+    rec.flags    = (uint8_t)((frame.isExtended ? CAN_LOG_FLAG_EXT : 0) |
+                             (frame.isRTR ? CAN_LOG_FLAG_RTR : 0));
+    rec.dlc      = frame.dlc;
+    rec.channel  = channel;
+    rec.reserved = 0;
+    // dlc ֽ֮㣬ѵ÷Ĳдļ
+    memcpy(rec.data, frame.data, dlc);
+    memset(rec.data + dlc, 0, sizeof(rec.data) - dlc);
+
+    ++m_header->next;
+    if (m_header->count < m_header->capacity)
+        ++m_header->count;
+    ++m_recorded;
+    return st;
+}
+
+BusCount CanRecorder::capture(Can& can, uint8_t channel)
+{
+    Can::Frame frames[CAN_RX_BATCH_MAX];
+    uint64_t   stamps[CAN_RX_BATCH_MAX];
+
+    BusCount n = can.receiveBatch(frames, stamps, CAN_RX_BATCH_MAX);
+    if (!n)
+        return n;
+
+    // append() ʧʱ֡Ҳд루תʧܸΪƣҪ
+    for (int i = 0; i < n.value(); ++i)
+        append(frames[i], stamps[i], channel);
+    return n;
+}
+
+CanReplayer::CanReplayer()
+    : m_header(nullptr)
+    , m_records(nullptr)
+    , m_mapSize(0)
+{
+}
+
+CanReplayer::~CanReplayer()
+{
+    close();
+}
+
+BusStatus CanReplayer::open(const char* path)
+{
+    if (isOpen())
+        close();
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return busFail(BusErr_Open, errno, "open can log");
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        BusStatus ret = busFail(BusErr_Io, errno, "fstat can log");
+        ::close(fd);
+        return ret;
+    }
+
+    size_t size = (size_t)st.st_size;
+    if (size < sizeof(CanRecorder::FileHeader)) {
+        ::close(fd);
+        return busFail(BusErr_ShortRead, 0, "can log too small");
+    }
+
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        return busFail(BusErr_Io, errno, "mmap can log");
+
+    const CanRecorder::FileHeader* header = (const CanRecorder::FileHeader*)addr;
+    if (memcmp(header->magic, CAN_LOG_MAGIC, sizeof(CAN_LOG_MAGIC)) != 0 ||
+        header->recordSize != sizeof(CanRecorder::Record) ||
+        sizeof(CanRecorder::FileHeader) + (size_t)header->capacity * sizeof(CanRecorder::Record) > size ||
+        header->count > header->capacity || header->next > header->capacity) {
+        munmap(addr, size);
+        return busFail(BusErr_InvalidArg, 0, "bad can log header");
+    }
+
+    m_header  = header;
+    m_records = (const CanRecorder::Record*)((const uint8_t*)addr + sizeof(CanRecorder::FileHeader));
+    m_mapSize = size;
+    madvise(addr, size, MADV_SEQUENTIAL);
+    return BusStatus();
+}
+
+void CanReplayer::close()
+{
+    if (m_header != nullptr) {
+        munmap((void*)m_header, m_mapSize);
+        m_header  = nullptr;
+        m_records = nullptr;
+        m_mapSize = 0;
+    }
+}
+
+const CanRecorder::Record& CanReplayer::at(uint32_t i) const
+{
+    // δʱ 0 ʼƺɵһ next 
+    uint32_t first = (m_header->count < m_header->capacity) ? 0 : m_header->next;
+    uint32_t pos   = first + i;
+    if (pos >= m_header->capacity)
+        pos -= m_header->capacity;
+    return m_records[pos];
+}
+
+void CanReplayer::toFrame(const CanRecorder::Record& rec, Can::Frame& frame)
+{
+    frame.id         = rec.id;
+    frame.isExtended = (rec.flags & CAN_LOG_FLAG_EXT) ? 1 : 0;
+    frame.isRTR      = (rec.flags & CAN_LOG_FLAG_RTR) ? 1 : 0;
+    frame.dlc        = (rec.dlc > 8) ? 8 : rec.dlc;
+    memcpy(frame.data, rec.data, sizeof(frame.data));
+}
+
+BusCount CanReplayer::replay(Can& can, double speed)
+{
+    if (m_header == nullptr)
+        return busError(BusErr_NotOpen, "can replay");
+
+    const uint32_t total = count();
+    if (total == 0)
+        return 0;
+
+    const uint64_t baseTs = at(0).tsNs;
+    const uint64_t start  = BusStats::nowNs();
+
+    int sent = 0;
+    for (uint32_t i = 0; i < total; ++i) {
+        const CanRecorder::Record& rec = at(i);
+
+        if (speed > 0.0 && rec.tsNs > baseTs) {
+            // þʱ˯ߣ֡ۻ
+            uint64_t due = start + (uint64_t)((double)(rec.tsNs - baseTs) / speed);
+            struct timespec ts;
+            ts.tv_sec  = (time_t)(due / 1000000000ull);
+            ts.tv_nsec = (long)(due % 1000000000ull);
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+            }
+        }
+
+        Can::Frame frame;
+        toFrame(rec, frame);
+
+        BusStatus st = can.send(frame);
+        while (!st && (st.error().sysErrno == ENOBUFS || st.error().sysErrno == EAGAIN)) {
+            // ͶԵٷ֡
+            usleep(100);
+            st = can.send(frame);
+        }
+        if (!st)
+            return etl::unexpected<BusError>(st.error());
+        ++sent;
+    }
+    return sent;
+}
+/******************************** FILE END ********************************/
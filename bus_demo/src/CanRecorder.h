@@ -0,0 +1,167 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: CanRecorder.h
+ * Author		: Fan Fei
+ * Description	: CAN ץڴӳļԼԭʼʱط
+ * Comments		: ¼Ϊƽṹ׷ʱֻдӳڴ棬ϵͳã
+ *				  ֻļдתʱŻ munmap/open/mmap
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "etl/string.h"
+#include "Can.h"
+#include "BusError.h"
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+#define CAN_LOG_MAGIC        "CANLOG1"
+#define CAN_LOG_FLAG_EXT     0x01
+#define CAN_LOG_FLAG_RTR     0x02
+
+/***************************************************************************
+ 						class declaration
+***************************************************************************/
+class CanRecorder {
+public:
+    // ¼24 ֽ
+    struct Record {
+        uint64_t tsNs;          // ʱ䣬
+        uint32_t id;
+        uint8_t  flags;         // CAN_LOG_FLAG_*
+        uint8_t  dlc;
+        uint8_t  channel;       // ץͨţ 0 ʾ can0
+        uint8_t  reserved;
+        uint8_t  data[8];
+    };
+
+    // ļͷ64 ֽڣ capacity ¼
+    struct FileHeader {
+        char     magic[8];
+        uint32_t recordSize;
+        uint32_t capacity;      // ļɵļ¼
+        uint32_t count;         // Ч¼ƺ capacity
+        uint32_t next;          // һдλ
+        uint32_t generation;    // תţ 0 
+        uint32_t reserved0;
+        uint64_t createNs;
+        uint8_t  reserved1[24];
+    };
+
+    struct Config {
+        Config()
+            : path("/tmp/can0.canlog")
+            , recordsPerFile(1u << 20)
+            , fileCount(1)
+        {
+        }
+
+        etl::string<64> path;   // fileCount > 1 ʱʵļΪ path.0path.1 ...
+        uint32_t recordsPerFile;
+        int      fileCount;     // 1ļڻƸǣ>1дתһļ
+                                // һļɺ̨߳ǰ path.next òӳ䣬תָֻ
+    };
+
+    CanRecorder();
+    CanRecorder(const Config& cfg);
+    ~CanRecorder();
+
+    BusStatus open();
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+
+    // ׷һֻ֡дӳڴ棬ϵͳá
+    // һļûûʧʱڵǰļڻƼ¼֡Ǳļɵļ¼
+    //  rotateFailures() ش
+    BusStatus append(const Can::Frame& frame, uint64_t tsNs, uint8_t channel);
+
+    //  can ȡһ֡ȫ׷ӣ֡ץ߳ѭ
+    BusCount capture(Can& can, uint8_t channel);
+
+    // ǰļתʱ仯
+    const etl::string<72>& currentPath() const { return m_curPath; }
+    uint64_t recorded() const { return m_recorded; }
+    uint32_t rotateFailures() const { return m_rotateFailures; }
+
+private:
+    struct Mapping {
+        FileHeader* header;
+        size_t      size;
+    };
+
+    CanRecorder(const CanRecorder&);
+    CanRecorder& operator=(const CanRecorder&);
+
+    void      makePath(int index, etl::string<72>& out) const;
+    BusStatus mapFile(const char* path, Mapping& out) const;
+    static void unmapFile(Mapping& map);
+    void      activate(const Mapping& map);
+    BusStatus rotate();
+    void      prepareLoop();
+
+    Config          m_cfg;
+    etl::string<72> m_curPath;
+    etl::string<72> m_sparePath;    // Ԥļ path.nextתԤ̸߳Ϊ path.N
+    int             m_fileIndex;
+    uint32_t        m_generation;
+    Mapping         m_cur;
+    FileHeader*     m_header;
+    Record*         m_records;
+    uint64_t        m_recorded;
+    uint32_t        m_rotateFailures;
+
+    //  m_mutex ץֻ߳תʱݳָ
+    std::mutex              m_mutex;
+    std::condition_variable m_cond;
+    Mapping                 m_spare;        // ѽáԤȱҳһļ
+    Mapping                 m_retired;      // дļԤ߳̽ӳ
+    int                     m_renameTo;     // >=0Ԥ߳ path.next Ϊŵļ
+    bool                    m_spareFailed;  // һļʧܣ´תʱ
+    bool                    m_prepBroken;   // ʧܣpath.next ʹãԤ
+    bool                    m_prepStop;
+    std::thread             m_prepThread;
+};
+
+class CanReplayer {
+public:
+    CanReplayer();
+    ~CanReplayer();
+
+    BusStatus open(const char* path);
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+
+    uint32_t count() const { return m_header ? m_header->count : 0; }
+
+    // ʱȺȡ i ¼Ѵƣ
+    const CanRecorder::Record& at(uint32_t i) const;
+    static void toFrame(const CanRecorder::Record& rec, Can::Frame& frame);
+
+    // ͨ can ·ȫ¼ط֡
+    // speed > 0ԭʼ֡ / speed ͣ1.0 Ϊԭ٣speed <= 0췢
+    BusCount replay(Can& can, double speed);
+
+private:
+    CanReplayer(const CanReplayer&);
+    CanReplayer& operator=(const CanReplayer&);
+
+    const CanRecorder::FileHeader* m_header;
+    const CanRecorder::Record*     m_records;
+    size_t                         m_mapSize;
+};
+/******************************** FILE END ********************************/
@@ -0,0 +1,149 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: CanSignal.h
+ * Author		: Fan Fei
+ * Description	:  CAN ź루Ӧ DBC е SG_ 壩
+ * Comments		: ʼλȡֽ򡢷Ŷģÿźű
+ *				  һ 8 ֽװ + λ/룬λѭ
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include "etl/binary.h"
+#include "etl/endianness.h"
+#include "etl/static_assert.h"
+#include "Can.h"
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+// DBC ֽ@1 Ϊ IntelСˣ@0 Ϊ Motorolaˣ
+#define CAN_SIG_INTEL    1
+#define CAN_SIG_MOTOROLA 0
+// DBC ţ+ ޷ţ- з
+#define CAN_SIG_UNSIGNED 0
+#define CAN_SIG_SIGNED   1
+
+//  DBC һ SG_ һ/ƫƵźţ
+//   SG_ EngineSpeed : 24|16@1+ (0.125,0) ...
+//   CAN_SIGNAL(EngineSpeed, 24, 16, CAN_SIG_INTEL, CAN_SIG_UNSIGNED, 0.125, 0);
+#define CAN_SIGNAL(name, start, len, order, sign, factor, offset)                 \
+    struct name : public CanSignal<start, len, order, sign> {                    \
+        static double phys(const uint8_t* d) { return (double)raw(d) * (factor) + (offset); } \
+    }
+
+// źţmux Ϊÿźţֻ mux ԭʼֵ value ʱźŲЧ
+#define CAN_MUX_SIGNAL(name, mux, value, start, len, order, sign, factor, offset) \
+    struct name : public CanMuxSignal<mux, value, CanSignal<start, len, order, sign> > { \
+        static double phys(const uint8_t* d) { return (double)raw(d) * (factor) + (offset); } \
+    }
+
+/***************************************************************************
+ 						class declaration
+***************************************************************************/
+//  8 ֽغװһ 64 λϲһװأҪʱһֽڷת
+inline uint64_t canLoadLittle(const uint8_t* d)
+{
+    uint64_t v;
+    memcpy(&v, d, sizeof(v));
+    return (etl::endianness::value() == etl::endian::little) ? v : etl::reverse_bytes(v);
+}
+
+inline uint64_t canLoadBig(const uint8_t* d)
+{
+    uint64_t v;
+    memcpy(&v, d, sizeof(v));
+    return etl::ntoh(v);
+}
+
+template <uint8_t START, uint8_t LEN, int ORDER, int SIGN>
+struct CanSignal {
+    ETL_STATIC_ASSERT(LEN >= 1 && LEN <= 64, "signal length must be 1..64");
+    ETL_STATIC_ASSERT(START < 64, "start bit out of range");
+
+    // Motorola ʼλλ DBC ݱеλãɴԱ
+    //  0 ֽڵ bit7 Ϊ 0λԱ = λ + LEN - 1
+    static const unsigned MSB_LINEAR = (START / 8u) * 8u + (7u - START % 8u);
+    static const unsigned LSB_LINEAR = MSB_LINEAR + LEN - 1u;
+
+    ETL_STATIC_ASSERT(ORDER == CAN_SIG_MOTOROLA || START + LEN <= 64, "intel signal exceeds 8 bytes");
+    ETL_STATIC_ASSERT(ORDER == CAN_SIG_INTEL || LSB_LINEAR <= 63, "motorola signal exceeds 8 bytes");
+
+    static const unsigned SHIFT = (ORDER == CAN_SIG_INTEL) ? START : (63u - LSB_LINEAR);
+    // źõֽ dlc Сʱźδյֽ
+    static const unsigned BYTES = (ORDER == CAN_SIG_INTEL) ? (START + LEN + 7u) / 8u : (LSB_LINEAR / 8u + 1u);
+    static const uint64_t MASK  = etl::lsb_mask<uint64_t, LEN>::value;
+
+    static const int  start  = START;
+    static const int  length = LEN;
+    static const bool isSigned = (SIGN == CAN_SIG_SIGNED);
+
+    // ԭʼֵзźչ
+    static int64_t raw(const uint8_t* d)
+    {
+        uint64_t word = (ORDER == CAN_SIG_INTEL) ? canLoadLittle(d) : canLoadBig(d);
+        uint64_t v    = (word >> SHIFT) & MASK;
+        if (SIGN == CAN_SIG_SIGNED && LEN < 64)
+            return (int64_t)(v << (64 - LEN)) >> (64 - LEN);
+        return (int64_t)v;
+    }
+
+    static int64_t raw(const Can::Frame& f) { return raw(f.data); }
+
+    // Ǹź 8 ֽغЧ dlc ʱҪźȫյֽ
+    static bool present(const uint8_t*) { return true; }
+    static bool present(const uint8_t*, uint8_t dlc) { return dlc >= BYTES; }
+};
+
+template <typename MUX, int64_t VALUE, typename SIGNAL>
+struct CanMuxSignal : public SIGNAL {
+    static bool present(const uint8_t* d) { return MUX::raw(d) == VALUE; }
+    static bool present(const uint8_t* d, uint8_t dlc)
+    {
+        return SIGNAL::present(d, dlc) && MUX::present(d, dlc) && MUX::raw(d) == VALUE;
+    }
+};
+
+// һĵȫźţdecode() չźŵֱߴ
+// out[i] д i źŵֵֵ i λʾźǷЧ
+// δѡСźų dlc ֽʱΪ 0 Can::Frame ʱʹ frame.dlc
+template <typename... SIGNALS>
+struct CanMessageLayout;
+
+template <>
+struct CanMessageLayout<> {
+    static const int count = 0;
+
+    static uint64_t decode(const uint8_t*, double*, int, uint8_t = 8) { return 0; }
+};
+
+template <typename FIRST, typename... REST>
+struct CanMessageLayout<FIRST, REST...> {
+    static const int count = 1 + CanMessageLayout<REST...>::count;
+    ETL_STATIC_ASSERT(count <= 64, "too many signals in one message");
+
+    static uint64_t decode(const uint8_t* d, double* out, int index = 0, uint8_t dlc = 8)
+    {
+        uint64_t valid = 0;
+        if (FIRST::present(d, dlc)) {
+            out[index] = FIRST::phys(d);
+            valid = 1ull << index;
+        }
+        return valid | CanMessageLayout<REST...>::decode(d, out, index + 1, dlc);
+    }
+
+    static uint64_t decode(const Can::Frame& f, double* out) { return decode(f.data, out, 0, f.dlc); }
+};
+/******************************** FILE END ********************************/
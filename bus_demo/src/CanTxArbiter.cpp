@@ -0,0 +1,273 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: CanTxArbiter.cpp
+ * Author		: Fan Fei
+ * Description	:
+ * Comments		:
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include "CanTxArbiter.h"
+#include "BusLog.h"
+
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+/***************************************************************************
+ 						class definition
+***************************************************************************/
+CanTxArbiter::CanTxArbiter(Can& can)
+    : m_can(can)
+    , m_cfg()
+    , m_head(0)
+    , m_tail(0)
+    , m_order(0)
+    , m_frameBytes(UINT32_MAX)
+    , m_submitted(0)
+    , m_rejected(0)
+    , m_sent(0)
+    , m_sendErrors(0)
+    , m_dropped(0)
+    , m_eventFd(-1)
+    , m_sleeping(false)
+    , m_running(false)
+{
+    for (uint32_t i = 0; i < CAN_TX_ARBITER_DEPTH; ++i)
+        m_slots[i].seq.store(i, etl::memory_order_relaxed);
+}
+
+CanTxArbiter::CanTxArbiter(Can& can, const Config& cfg)
+    : m_can(can)
+    , m_cfg(cfg)
+    , m_head(0)
+    , m_tail(0)
+    , m_order(0)
+    , m_frameBytes(UINT32_MAX)
+    , m_submitted(0)
+    , m_rejected(0)
+    , m_sent(0)
+    , m_sendErrors(0)
+    , m_dropped(0)
+    , m_eventFd(-1)
+    , m_sleeping(false)
+    , m_running(false)
+{
+    for (uint32_t i = 0; i < CAN_TX_ARBITER_DEPTH; ++i)
+        m_slots[i].seq.store(i, etl::memory_order_relaxed);
+}
+
+CanTxArbiter::~CanTxArbiter()
+{
+    stop();
+}
+
+uint32_t CanTxArbiter::arbitrationKey(const Can::Frame& frame)
+{
+    // ϵλ˳ƴٲֶΣ
+    //  ID(11) | RTR/SRR(1) | IDE(1) | չ ID(18) | RTR(1)
+    // ׼֡ͬ ID չ֡ȣ׼֡ӮRTR=0 < SRR=1
+    if (frame.isExtended) {
+        uint32_t base = (frame.id >> 18) & 0x7FF;
+        uint32_t ext  = frame.id & 0x3FFFF;
+        return (base << 21) | (1u << 20) | (1u << 19) | (ext << 1) | (frame.isRTR ? 1u : 0u);
+    }
+
+    return ((frame.id & 0x7FF) << 21) | ((frame.isRTR ? 1u : 0u) << 20);
+}
+
+BusStatus CanTxArbiter::start()
+{
+    if (isRunning())
+        return BusStatus();
+
+    if (!txReady())
+        return busError(BusErr_NotOpen, "can arbiter start");
+
+    m_eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_eventFd < 0)
+        return busFail(BusErr_Open, errno, "eventfd can arbiter");
+
+    m_running.store(true, etl::memory_order_release);
+    m_thread = std::thread(&CanTxArbiter::run, this);
+    return BusStatus();
+}
+
+void CanTxArbiter::stop()
+{
+    if (!m_running.exchange(false, etl::memory_order_acq_rel))
+        return;
+
+    wake();
+    if (m_thread.joinable())
+        m_thread.join();
+
+    ::close(m_eventFd);
+    m_eventFd = -1;
+
+    discardPending();
+}
+
+BusStatus CanTxArbiter::submit(const Can::Frame& frame)
+{
+    // н MPSC λŵλʱд
+    uint32_t pos = m_head.load(etl::memory_order_relaxed);
+    Slot*    slot;
+    for (;;) {
+        slot = &m_slots[pos & (CAN_TX_ARBITER_DEPTH - 1)];
+        uint32_t seq  = slot->seq.load(etl::memory_order_acquire);
+        int32_t  diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            if (m_head.compare_exchange_weak(pos, pos + 1, etl::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            m_rejected.fetch_add(1, etl::memory_order_relaxed);
+            return busError(BusErr_Full, "can arbiter submit");
+        } else {
+            pos = m_head.load(etl::memory_order_relaxed);
+        }
+    }
+
+    slot->frame = frame;
+    // ٲ̵߳ m_sleeping 鹹 Dekker ʽԣҪ seq_cst
+    slot->seq.store(pos + 1, etl::memory_order_seq_cst);
+    m_submitted.fetch_add(1, etl::memory_order_relaxed);
+
+    // ֻٲ߳˯ʱŸһ write(eventfd)
+    if (m_sleeping.load(etl::memory_order_seq_cst) &&
+        m_sleeping.exchange(false, etl::memory_order_seq_cst))
+        wake();
+
+    return BusStatus();
+}
+
+bool CanTxArbiter::pop(Can::Frame& frame)
+{
+    // ֻٲ̳߳ӣ CAS
+    uint32_t pos  = m_tail.load(etl::memory_order_relaxed);
+    Slot&    slot = m_slots[pos & (CAN_TX_ARBITER_DEPTH - 1)];
+    if (slot.seq.load(etl::memory_order_acquire) != pos + 1)
+        return false;
+
+    frame = slot.frame;
+    slot.seq.store(pos + CAN_TX_ARBITER_DEPTH, etl::memory_order_release);
+    m_tail.store(pos + 1, etl::memory_order_relaxed);
+    return true;
+}
+
+bool CanTxArbiter::ringEmpty() const
+{
+    uint32_t pos = m_tail.load(etl::memory_order_relaxed);
+    const Slot& slot = m_slots[pos & (CAN_TX_ARBITER_DEPTH - 1)];
+    return slot.seq.load(etl::memory_order_seq_cst) != pos + 1;
+}
+
+void CanTxArbiter::collect()
+{
+    // ѻ֡ѣʱʣ֡ڻγɱѹ
+    Entry entry;
+    while (!m_ready.full() && pop(entry.frame)) {
+        entry.key   = arbitrationKey(entry.frame);
+        entry.order = m_order++;
+        m_ready.push(entry);
+    }
+}
+
+void CanTxArbiter::discardPending()
+{
+    // ٲ߳˳ռӶ
+    uint32_t   count = 0;
+    Can::Frame frame;
+    while (!m_ready.empty()) {
+        m_ready.pop();
+        ++count;
+    }
+    while (pop(frame))
+        ++count;
+
+    if (count > 0)
+        m_dropped.fetch_add(count, etl::memory_order_relaxed);
+}
+
+void CanTxArbiter::wake()
+{
+    uint64_t one = 1;
+    ssize_t ret = ::write(m_eventFd, &one, sizeof(one));
+    (void)ret;
+}
+
+void CanTxArbiter::waitForWork(int timeoutMs)
+{
+    m_sleeping.store(true, etl::memory_order_seq_cst);
+    if (!ringEmpty() || !m_running.load(etl::memory_order_acquire)) {
+        m_sleeping.store(false, etl::memory_order_relaxed);
+        return;
+    }
+
+    struct pollfd pfd;
+    pfd.fd      = m_eventFd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+    if (::poll(&pfd, 1, timeoutMs) > 0) {
+        uint64_t value;
+        ssize_t ret = ::read(m_eventFd, &value, sizeof(value));
+        (void)ret;
+    }
+    m_sleeping.store(false, etl::memory_order_relaxed);
+}
+
+int CanTxArbiter::txInFlight()
+{
+    BusCount bytes = m_can.txQueuedBytes();
+    if (!bytes || *bytes <= 0)
+        return 0;
+
+    // skb ռںͬ;ֻһ֡ʱľǵ֡ռã
+    // У׼֮ǰκηֵһ֡
+    if ((uint32_t)*bytes < m_frameBytes)
+        m_frameBytes = (uint32_t)*bytes;
+    return (int)(((uint32_t)*bytes + m_frameBytes - 1) / m_frameBytes);
+}
+
+void CanTxArbiter::run()
+{
+    while (m_running.load(etl::memory_order_acquire)) {
+        collect();
+
+        if (m_ready.empty()) {
+            waitForWork(m_cfg.idleWaitMs);
+            continue;
+        }
+
+        // ;֡ʱѹ֡ڶȴڼµĸȼ֡Կɲ嵽ǰ
+        if (m_cfg.maxInFlight > 0 && txInFlight() >= m_cfg.maxInFlight) {
+            usleep((useconds_t)m_cfg.retryUs);
+            continue;
+        }
+
+        // ÿһ֡ǰռµĸȼ֡Բ嵽ǰ
+        BusStatus st = transmit(m_ready.top().frame);
+        if (st) {
+            m_ready.pop();
+            m_sent.fetch_add(1, etl::memory_order_relaxed);
+        } else if (st.error().sysErrno == ENOBUFS || st.error().sysErrno == EAGAIN) {
+            // ں˷Ͷ֡ڶѶԺ
+            usleep((useconds_t)m_cfg.retryUs);
+        } else {
+            m_ready.pop();
+            m_sendErrors.fetch_add(1, etl::memory_order_relaxed);
+        }
+    }
+}
+/******************************** FILE END ********************************/
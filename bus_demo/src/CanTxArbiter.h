@@ -0,0 +1,143 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: CanTxArbiter.h
+ * Author		: Fan Fei
+ * Description	: ̹߳һ Can ʱȼٲ
+ * Comments		: ߳ submit() ӣٲ̰߳ CAN ٲ˳
+ *				  ID ԽСȼԽߣ֡ Can::send()
+ *				  ں;֡ maxInFlight ڣ֡ھ
+ *				  ȼ֡ qdisc /  FIFO󵽵ĸȼ֡Ǻ
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include <thread>
+#include "etl/atomic.h"
+#include "etl/array.h"
+#include "etl/priority_queue.h"
+#include "Can.h"
+#include "BusError.h"
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+#define CAN_TX_ARBITER_DEPTH  256   // ӻ;ѸԵ 2 
+
+/***************************************************************************
+ 						class declaration
+***************************************************************************/
+class CanTxArbiter {
+public:
+    struct Config {
+        Config()
+            : retryUs(200)
+            , idleWaitMs(100)
+            , maxInFlight(2)
+        {
+        }
+
+        int retryUs;      // ں˷ͶENOBUFS;֡ʱԼ΢
+        int idleWaitMs;   // ֡ɷʱٲ̵߳ȴʱ䣬
+        int maxInFlight;  // ѽںδ֡ޣSIOCOUTQ 㣩<=0 
+    };
+
+    // ٲڼ䣬can  send() ֻٲ̵߳
+    explicit CanTxArbiter(Can& can);
+    CanTxArbiter(Can& can, const Config& cfg);
+    virtual ~CanTxArbiter();
+
+    BusStatus start();
+    // ֹͣʱӻ;е֡ȫ dropped()´ start() 󲹷
+    void stop();
+    bool isRunning() const { return m_running.load(etl::memory_order_acquire); }
+
+    // ̵߳ãӣʱ BusErr_Full
+    BusStatus submit(const Can::Frame& frame);
+
+    uint32_t submitted() const  { return m_submitted.load(etl::memory_order_relaxed); }
+    uint32_t rejected() const   { return m_rejected.load(etl::memory_order_relaxed); }
+    uint32_t sent() const       { return m_sent.load(etl::memory_order_relaxed); }
+    uint32_t sendErrors() const { return m_sendErrors.load(etl::memory_order_relaxed); }
+    uint32_t dropped() const    { return m_dropped.load(etl::memory_order_relaxed); }
+
+    // ٲüֵԽСԽӮٲ
+    static uint32_t arbitrationKey(const Can::Frame& frame);
+
+protected:
+    // һ֡ CAN ֻٲ߳еã滻Ϊ¼֡
+    // Լȵ stop()
+    virtual bool      txReady() const                   { return m_can.isOpen(); }
+    virtual BusStatus transmit(const Can::Frame& frame) { return m_can.send(frame); }
+    // ѽںδɵ֡ѯʧʱ 0
+    virtual int       txInFlight();
+
+private:
+    struct Slot {
+        etl::atomic<uint32_t> seq;
+        Can::Frame            frame;
+    };
+
+    struct Entry {
+        uint32_t   key;
+        uint32_t   order;   // ˳ͬ ID ֡Ƚȳ
+        Can::Frame frame;
+    };
+
+    // priority_queue ΪԪأȼߵ֡
+    struct EntryLess {
+        bool operator()(const Entry& a, const Entry& b) const
+        {
+            if (a.key != b.key)
+                return a.key > b.key;
+            return (int32_t)(a.order - b.order) > 0;
+        }
+    };
+
+    typedef etl::priority_queue<Entry, CAN_TX_ARBITER_DEPTH,
+                                etl::vector<Entry, CAN_TX_ARBITER_DEPTH>, EntryLess> ReadyQueue;
+
+    CanTxArbiter(const CanTxArbiter&);
+    CanTxArbiter& operator=(const CanTxArbiter&);
+
+    bool pop(Can::Frame& frame);
+    bool ringEmpty() const;
+    void collect();
+    void discardPending();
+    void waitForWork(int timeoutMs);
+    void wake();
+    void run();
+
+    Can&    m_can;
+    Config  m_cfg;
+
+    etl::array<Slot, CAN_TX_ARBITER_DEPTH> m_slots;
+    etl::atomic<uint32_t> m_head;
+    etl::atomic<uint32_t> m_tail;
+
+    ReadyQueue  m_ready;      // ֻٲ̷߳
+    uint32_t    m_order;
+    uint32_t    m_frameBytes; // ֡ SIOCOUTQ еռãȡ۲쵽Сֵֻٲ̷߳
+
+    etl::atomic<uint32_t> m_submitted;
+    etl::atomic<uint32_t> m_rejected;
+    etl::atomic<uint32_t> m_sent;
+    etl::atomic<uint32_t> m_sendErrors;
+    etl::atomic<uint32_t> m_dropped;
+
+    int                 m_eventFd;   // ߻ٲ߳
+    etl::atomic<bool>   m_sleeping;
+    etl::atomic<bool>   m_running;
+    std::thread         m_thread;
+};
+/******************************** FILE END ********************************/
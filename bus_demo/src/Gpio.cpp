@@ -18,6 +18,7 @@
  							include files
 ***************************************************************************/
 #include "Gpio.h"
+#include "BusLog.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -72,7 +73,7 @@ bool Gpio::checkPinFilesReady(int pin)
     return false;
 }
 
-bool Gpio::exportPin(int pin, bool* wasExported)
+BusStatus Gpio::exportPin(int pin, bool* wasExported)
 {
     if (wasExported) {
         *wasExported = false;
@@ -83,8 +84,8 @@ bool Gpio::exportPin(int pin, bool* wasExported)
 
     int fd = ::open(GPIO_EXPORT_PATH, O_WRONLY);
     if (fd < 0) {
-        perror("open gpio export");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Open, errno, "open gpio export");
     }
 
     ssize_t len = ::write(fd, pinStr, strlen(pinStr));
@@ -98,14 +99,17 @@ bool Gpio::exportPin(int pin, bool* wasExported)
             }
             // ļǷѾ
             if (checkPinFilesReady(pin)) {
-                return true;
+                return BusStatus();
             }
             // ļڵܻڳʼȴһ
             usleep(100000); // 100ms
-            return checkPinFilesReady(pin);
+            if (checkPinFilesReady(pin)) {
+                return BusStatus();
+            }
+            return busFail(BusErr_State, 0, "gpio export: files not ready");
         } else {
-            perror("write gpio export");
-            return false;
+            m_stats.addError(errno);
+            return busFail(BusErr_Config, errno, "write gpio export");
         }
     }
 
@@ -117,7 +121,7 @@ bool Gpio::exportPin(int pin, bool* wasExported)
         usleep(delay);
         
         if (checkPinFilesReady(pin)) {
-            return true;
+            return BusStatus();
         }
         
         retries--;
@@ -126,30 +130,29 @@ bool Gpio::exportPin(int pin, bool* wasExported)
         }
     }
 
-    fprintf(stderr, "gpio export: direction/value files not ready after export\n");
-    return false;
+    return busFail(BusErr_State, 0, "gpio export: direction/value files not ready after export");
 }
 
-bool Gpio::unexportPin(int pin)
+BusStatus Gpio::unexportPin(int pin)
 {
     char pinStr[16];
     snprintf(pinStr, sizeof(pinStr), "%d", pin);
 
     int fd = ::open(GPIO_UNEXPORT_PATH, O_WRONLY);
     if (fd < 0) {
-        perror("open gpio unexport");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Open, errno, "open gpio unexport");
     }
 
     ssize_t len = ::write(fd, pinStr, strlen(pinStr));
     ::close(fd);
 
     if (len < 0 && errno != ENOENT) { // ENOENTʾGPIOδԺ
-        perror("write gpio unexport");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Config, errno, "write gpio unexport");
     }
 
-    return true;
+    return BusStatus();
 }
 
 etl::string<64> Gpio::getPinPath(int pin, const char* file)
@@ -164,17 +167,17 @@ etl::string<64> Gpio::getPinPath(int pin, const char* file)
     return path;
 }
 
-bool Gpio::setDirectionInternal(Direction dir)
+BusStatus Gpio::setDirectionInternal(Direction dir)
 {
     if (m_pin < 0)
-        return false;
+        return busError(BusErr_NotOpen, "gpio direction");
 
     etl::string<64> directionPath = getPinPath(m_pin, "direction");
 
     int fd = ::open(directionPath.c_str(), O_WRONLY);
     if (fd < 0) {
-        perror("open gpio direction");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Open, errno, "open gpio direction");
     }
 
     const char* dirStr = (dir == Direction_In) ? "in" : "out";
@@ -182,17 +185,17 @@ bool Gpio::setDirectionInternal(Direction dir)
     ::close(fd);
 
     if (len < 0) {
-        perror("write gpio direction");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Config, errno, "write gpio direction");
     }
 
-    return true;
+    return BusStatus();
 }
 
-bool Gpio::openValueFile()
+BusStatus Gpio::openValueFile()
 {
     if (m_pin < 0)
-        return false;
+        return busError(BusErr_NotOpen, "gpio value");
 
     closeValueFile(); // ȷ֮ǰѹر
 
@@ -200,11 +203,11 @@ bool Gpio::openValueFile()
 
     m_valueFd = ::open(valuePath.c_str(), O_RDWR);
     if (m_valueFd < 0) {
-        perror("open gpio value");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Open, errno, "open gpio value");
     }
 
-    return true;
+    return BusStatus();
 }
 
 void Gpio::closeValueFile()
@@ -215,38 +218,40 @@ void Gpio::closeValueFile()
     }
 }
 
-bool Gpio::open()
+BusStatus Gpio::open()
 {
     if (isOpen())
-        return true;
+        return BusStatus();
 
     if (m_cfg.pin < 0) {
-        fprintf(stderr, "gpio pin number is invalid\n");
-        return false;
+        return busFail(BusErr_InvalidArg, 0, "gpio pin number is invalid");
     }
 
     // GPIO¼Ƿǵ
     bool wasExported = false;
-    if (!exportPin(m_cfg.pin, &wasExported)) {
-        return false;
+    BusStatus st = exportPin(m_cfg.pin, &wasExported);
+    if (!st) {
+        return st;
     }
 
     m_pin = m_cfg.pin;
     m_exportedByUs = !wasExported; // ѵģ˵ǵ
 
     // ÷
-    if (!setDirectionInternal(m_cfg.direction)) {
+    st = setDirectionInternal(m_cfg.direction);
+    if (!st) {
         close();
-        return false;
+        return st;
     }
 
     // valueļ
-    if (!openValueFile()) {
+    st = openValueFile();
+    if (!st) {
         close();
-        return false;
+        return st;
     }
 
-    return true;
+    return BusStatus();
 }
 
 void Gpio::close()
@@ -263,7 +268,7 @@ void Gpio::close()
     }
 }
 
-bool Gpio::reconfigure(const Config& cfg)
+BusStatus Gpio::reconfigure(const Config& cfg)
 {
     bool wasOpen = isOpen();
     int oldPin = m_pin;
@@ -283,8 +288,9 @@ bool Gpio::reconfigure(const Config& cfg)
         
         // źֻͬҪ´򿪲÷
         bool wasExported = false;
-        if (!exportPin(m_cfg.pin, &wasExported)) {
-            return false;
+        BusStatus st = exportPin(m_cfg.pin, &wasExported);
+        if (!st) {
+            return st;
         }
         
         m_pin = m_cfg.pin;
@@ -292,106 +298,113 @@ bool Gpio::reconfigure(const Config& cfg)
         
         // ÷ı䣩
         if (oldDir != m_cfg.direction) {
-            if (!setDirectionInternal(m_cfg.direction)) {
+            st = setDirectionInternal(m_cfg.direction);
+            if (!st) {
                 close();
-                return false;
+                return st;
             }
             // ıʱҪ´valueļȷȨȷ
-            if (!openValueFile()) {
+            st = openValueFile();
+            if (!st) {
                 close();
-                return false;
+                return st;
             }
         } else {
             // δı䣬ֻ´valueļ
-            if (!openValueFile()) {
+            st = openValueFile();
+            if (!st) {
                 close();
-                return false;
+                return st;
             }
         }
     }
 
-    return true;
+    return BusStatus();
 }
 
-bool Gpio::setDirection(Direction dir)
+BusStatus Gpio::setDirection(Direction dir)
 {
     if (m_pin < 0)
-        return false;
+        return busError(BusErr_NotOpen, "gpio direction");
 
     // ûиı䣬Ҫκβ
     if (m_cfg.direction == dir) {
-        return true;
+        return BusStatus();
     }
 
-    if (!setDirectionInternal(dir)) {
-        return false;
+    BusStatus st = setDirectionInternal(dir);
+    if (!st) {
+        return st;
     }
 
     m_cfg.direction = dir;
 
     // ıʱҪ´valueļȷȨȷ
     // ΪҪͬļģʽ
-    if (!openValueFile()) {
-        return false;
-    }
-
-    return true;
+    return openValueFile();
 }
 
-bool Gpio::setValue(Value val)
+BusStatus Gpio::setValue(Value val)
 {
     if (m_valueFd < 0)
-        return false;
+        return busError(BusErr_NotOpen, "gpio write value");
 
     if (m_cfg.direction != Direction_Out) {
-        fprintf(stderr, "gpio is not configured as output\n");
-        return false;
+        return busFail(BusErr_State, 0, "gpio is not configured as output");
     }
 
     const char* valStr = (val == Value_Low) ? "0" : "1";
+    m_stats.addSyscall();
     ssize_t len = ::write(m_valueFd, valStr, 1);
     
     if (len < 0) {
-        perror("gpio write value");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Io, errno, "gpio write value");
     }
+    m_stats.addBytesOut((uint32_t)len);
 
     // ȷд
+    m_stats.addSyscall();
     if (fsync(m_valueFd) < 0) {
-        perror("gpio fsync");
-        // falseΪĳЩϵͳfsync
+        m_stats.addError(errno);
+        busFail(BusErr_Io, errno, "gpio fsync");
+        // ʧܣΪĳЩϵͳfsync
     }
 
-    return true;
+    return BusStatus();
 }
 
-int Gpio::getValue()
+Gpio::ValueResult Gpio::getValue()
 {
     if (m_valueFd < 0)
-        return -1;
+        return busError(BusErr_NotOpen, "gpio read value");
 
     if (m_cfg.direction != Direction_In) {
-        fprintf(stderr, "gpio is not configured as input\n");
-        return -1;
+        return busFail(BusErr_State, 0, "gpio is not configured as input");
     }
 
     // ļָõͷ
+    m_stats.addSyscall();
     if (lseek(m_valueFd, 0, SEEK_SET) < 0) {
-        perror("gpio lseek");
-        return -1;
+        m_stats.addError(errno);
+        return busFail(BusErr_Io, errno, "gpio lseek");
     }
 
     char buf[4];
+    uint64_t t0 = m_stats.beginCall();
+    m_stats.addSyscall();
     ssize_t len = ::read(m_valueFd, buf, sizeof(buf) - 1);
+    m_stats.endCall(t0);
     
     if (len < 0) {
-        perror("gpio read value");
-        return -1;
+        m_stats.addError(errno);
+        return busFail(BusErr_Io, errno, "gpio read value");
     }
+    m_stats.addBytesIn((uint32_t)len);
 
     if (len == 0) {
-        fprintf(stderr, "gpio read value: no data\n");
-        return -1;
+        m_stats.addShortRead();
+        return busFail(BusErr_ShortRead, 0, "gpio read value: no data");
     }
 
     if (buf[0] == '1') {
@@ -400,8 +413,7 @@ int Gpio::getValue()
         return Value_Low;
     }
     
-    fprintf(stderr, "gpio read value: invalid first character '%c'\n", buf[0]);
-    return -1;
+    return busFail(BusErr_Io, 0, "gpio read value: invalid first character");
 }
 
 /******************************** FILE END ********************************/
@@ -20,6 +20,8 @@
 ***************************************************************************/
 #include <stdint.h>
 #include "etl/string.h"
+#include "BusStats.h"
+#include "BusError.h"
 
 /***************************************************************************
  						macro definition
@@ -43,6 +45,8 @@ public:
         Value_High = 1      // ߵƽ
     };
 
+    typedef etl::expected<Value, BusError> ValueResult;
+
     struct Config {
         Config()
             : pin(0)
@@ -58,37 +62,41 @@ public:
     Gpio(const Config& cfg);
     ~Gpio();
 
-    bool open();
+    BusStatus open();
     void close();
     bool isOpen() const { return m_pin >= 0; }
 
-    bool reconfigure(const Config& cfg);
+    BusStatus reconfigure(const Config& cfg);
 
     // ÷/
-    bool setDirection(Direction dir);
+    BusStatus setDirection(Direction dir);
 
     // ֵģʽЧ
-    //  true ɹfalse ʧ
-    bool setValue(Value val);
+    BusStatus setValue(Value val);
 
     // ȡֵģʽЧ
-    //  Value_Low  Value_Highʧܷ -1
-    int getValue();
+    //  Value_Low  Value_Highʧʱش
+    ValueResult getValue();
 
     // ȡǰ
     const Config& config() const { return m_cfg; }
 
+    // ͳƿգBUS_STATS_ENABLE=0 ʱΪ 0̵߳
+    void statsSnapshot(BusStats::Snapshot& out) const { m_stats.snapshot(out); }
+    void resetStats() { m_stats.reset(); }
+
 private:
     int    m_pin;        // GPIOűţ-1ʾδ
     int    m_valueFd;    // valueļ
     Config m_cfg;
     bool   m_exportedByUs; // ǷǵGPIO
+    BusStats m_stats;
 
     // ڲ
-    bool exportPin(int pin, bool* wasExported);
-    bool unexportPin(int pin);
-    bool setDirectionInternal(Direction dir);
-    bool openValueFile();
+    BusStatus exportPin(int pin, bool* wasExported);
+    BusStatus unexportPin(int pin);
+    BusStatus setDirectionInternal(Direction dir);
+    BusStatus openValueFile();
     void closeValueFile();
     bool checkPinFilesReady(int pin); // GPIOļǷ
     etl::string<64> getPinPath(int pin, const char* file);
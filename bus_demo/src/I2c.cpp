@@ -16,9 +16,11 @@
  							include files
 ***************************************************************************/
 #include "I2c.h"
+#include "BusLog.h"
 
 #include <stdio.h>
 #include <string.h>
+#include <errno.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
@@ -31,12 +33,14 @@
 I2c::I2c()
     : m_fd(-1)
     , m_cfg{}
+    , m_funcs(0)
 {
 }
 
 I2c::I2c(const Config& cfg)
     : m_fd(-1)
     , m_cfg(cfg)
+    , m_funcs(0)
 {
 }
 
@@ -45,23 +49,29 @@ I2c::~I2c()
     close();
 }
 
-bool I2c::open()
+BusStatus I2c::open()
 {
     if (isOpen())
-        return true;
+        return BusStatus();
 
     m_fd = ::open(m_cfg.device.c_str(), O_RDWR);
     if (m_fd < 0) {
-        perror("open i2c");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Open, errno, "open i2c");
     }
 
-    if (!setSlaveAddress(m_cfg.addr)) {
+    BusStatus st = setSlaveAddress(m_cfg.addr);
+    if (!st) {
         close();
-        return false;
+        return st;
     }
 
-    return true;
+    // ѯʧʱֻ֧ͨ read/write 
+    m_funcs = 0;
+    if (ioctl(m_fd, I2C_FUNCS, &m_funcs) < 0)
+        m_funcs = 0;
+
+    return BusStatus();
 }
 
 void I2c::close()
@@ -72,7 +82,7 @@ void I2c::close()
     }
 }
 
-bool I2c::reconfigure(const Config& cfg)
+BusStatus I2c::reconfigure(const Config& cfg)
 {
     // ֱӿ
     m_cfg = cfg;
@@ -81,52 +91,70 @@ bool I2c::reconfigure(const Config& cfg)
         // ĿǰֻҪôӵַ
         return setSlaveAddress(m_cfg.addr);
     }
-    return true;
+    return BusStatus();
 }
 
-bool I2c::setSlaveAddress(uint8_t addr)
+BusStatus I2c::setSlaveAddress(uint8_t addr)
 {
     if (m_fd < 0)
-        return false;
+        return busError(BusErr_NotOpen, "ioctl I2C_SLAVE");
 
     if (ioctl(m_fd, I2C_SLAVE, addr) < 0) { // I2C_SLAVE ָ豸ַ
-        perror("ioctl I2C_SLAVE");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Config, errno, "ioctl I2C_SLAVE");
     }
-    return true;
+    return BusStatus();
 }
 
-bool I2c::writeBytes(const uint8_t* data, uint16_t len)
+BusStatus I2c::writeBytes(const uint8_t* data, uint16_t len)
 {
     if (m_fd < 0)
-        return false;
+        return busError(BusErr_NotOpen, "i2c write");
     if (data == 0 || len == 0)
-        return false;
+        return busError(BusErr_InvalidArg, "i2c write");
 
+    uint64_t t0 = m_stats.beginCall();
+    m_stats.addSyscall();
     int ret = ::write(m_fd, data, len);
+    m_stats.endCall(t0);
     if (ret < 0) {
-        perror("i2c write");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Io, errno, "i2c write");
+    }
+    m_stats.addFrameOut();
+    m_stats.addBytesOut((uint32_t)ret);
+    if (ret != (int)len) {
+        m_stats.addShortWrite();
+        return busFail(BusErr_ShortWrite, 0, "i2c write");
     }
-    return (ret == (int)len);
+    return BusStatus();
 }
 
-bool I2c::readBytes(uint8_t* buf, uint16_t len)
+BusStatus I2c::readBytes(uint8_t* buf, uint16_t len)
 {
     if (m_fd < 0)
-        return false;
+        return busError(BusErr_NotOpen, "i2c read");
     if (buf == 0 || len == 0)
-        return false;
+        return busError(BusErr_InvalidArg, "i2c read");
 
+    uint64_t t0 = m_stats.beginCall();
+    m_stats.addSyscall();
     int ret = ::read(m_fd, buf, len);
+    m_stats.endCall(t0);
     if (ret < 0) {
-        perror("i2c read");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Io, errno, "i2c read");
+    }
+    m_stats.addFrameIn();
+    m_stats.addBytesIn((uint32_t)ret);
+    if (ret != (int)len) {
+        m_stats.addShortRead();
+        return busFail(BusErr_ShortRead, 0, "i2c read");
     }
-    return (ret == (int)len);
+    return BusStatus();
 }
 
-bool I2c::writeReg8(uint8_t reg, uint8_t val)
+BusStatus I2c::writeReg8(uint8_t reg, uint8_t val)
 {
     uint8_t buf[2];
     buf[0] = reg;
@@ -134,15 +162,81 @@ bool I2c::writeReg8(uint8_t reg, uint8_t val)
     return writeBytes(buf, 2);
 }
 
-bool I2c::writeRegBlock(uint8_t reg, const uint8_t* data, uint16_t len)
+BusStatus I2c::transfer(etl::span<const Msg> msgs)
+{
+    if (m_fd < 0)
+        return busError(BusErr_NotOpen, "i2c transfer");
+    if (msgs.empty() || msgs.size() > BUS_IOV_MAX)
+        return busError(BusErr_InvalidArg, "i2c transfer");
+    if ((m_funcs & I2C_FUNC_I2C) == 0)
+        return busError(BusErr_State, "i2c transfer");
+
+    struct i2c_msg kmsgs[BUS_IOV_MAX];
+    uint32_t inBytes  = 0;
+    uint32_t outBytes = 0;
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        const Msg& m = msgs[i];
+        if (m.buf.empty() || m.buf.size() > 0xFFFF)
+            return busError(BusErr_InvalidArg, "i2c transfer");
+        if (m.noStart && (m_funcs & I2C_FUNC_NOSTART) == 0)
+            return busError(BusErr_State, "i2c transfer nostart");
+
+        kmsgs[i].addr  = m_cfg.addr;
+        kmsgs[i].flags = (uint16_t)((m.isRead ? I2C_M_RD : 0) | (m.noStart ? I2C_M_NOSTART : 0));
+        kmsgs[i].len   = (uint16_t)m.buf.size();
+        kmsgs[i].buf   = m.buf.data();
+        if (m.isRead)
+            inBytes += (uint32_t)m.buf.size();
+        else
+            outBytes += (uint32_t)m.buf.size();
+    }
+
+    struct i2c_rdwr_ioctl_data data;
+    data.msgs  = kmsgs;
+    data.nmsgs = (uint32_t)msgs.size();
+
+    uint64_t t0 = m_stats.beginCall();
+    m_stats.addSyscall();
+    int ret = ioctl(m_fd, I2C_RDWR, &data);
+    m_stats.endCall(t0);
+    if (ret < 0) {
+        m_stats.addError(errno);
+        return busFail(BusErr_Io, errno, "ioctl I2C_RDWR");
+    }
+    if (ret != (int)msgs.size()) {
+        m_stats.addShortWrite();
+        return busFail(BusErr_ShortWrite, 0, "ioctl I2C_RDWR");
+    }
+
+    if (outBytes != 0) {
+        m_stats.addFrameOut();
+        m_stats.addBytesOut(outBytes);
+    }
+    if (inBytes != 0) {
+        m_stats.addFrameIn();
+        m_stats.addBytesIn(inBytes);
+    }
+    return BusStatus();
+}
+
+BusStatus I2c::writeRegBlock(uint8_t reg, const uint8_t* data, uint16_t len)
 {
     if (data == 0 || len == 0)
-        return false;
+        return busError(BusErr_InvalidArg, "i2c write reg block");
+
+    // reg ΪͬһдΣֱõ÷
+    if ((m_funcs & (I2C_FUNC_I2C | I2C_FUNC_NOSTART)) == (I2C_FUNC_I2C | I2C_FUNC_NOSTART)) {
+        Msg msgs[2] = {
+            Msg::write(BusConstBuf(&reg, 1)),
+            Msg::write(BusConstBuf(data, len), true)
+        };
+        return transfer(etl::span<const Msg>(msgs, 2));
+    }
 
     // ĴС buffer ߴ
     uint8_t buf[256];
     if ((uint16_t)(len + 1) > (uint16_t)sizeof(buf))
-        return false;
+        return busError(BusErr_InvalidArg, "i2c write reg block");
 
     buf[0] = reg;
     memcpy(&buf[1], data, len);
@@ -150,24 +244,32 @@ bool I2c::writeRegBlock(uint8_t reg, const uint8_t* data, uint16_t len)
     return writeBytes(buf, len + 1);
 }
 
-bool I2c::readReg8(uint8_t reg, uint8_t* val)
+BusStatus I2c::readReg8(uint8_t reg, uint8_t* val)
 {
     if (val == 0)
-        return false;
-
-    if (!writeBytes(&reg, 1))
-        return false;
+        return busError(BusErr_InvalidArg, "i2c read reg");
 
-    return readBytes(val, 1);
+    return readRegBlock(reg, val, 1);
 }
 
-bool I2c::readRegBlock(uint8_t reg, uint8_t* buf, uint16_t len)
+BusStatus I2c::readRegBlock(uint8_t reg, uint8_t* buf, uint16_t len)
 {
     if (buf == 0 || len == 0)
-        return false;
+        return busError(BusErr_InvalidArg, "i2c read reg block");
+
+    // д reg ظʼٶһϵͳãм䲻ͷߣ
+    // Щ豸Ҫζֻôʱ
+    if (m_cfg.repeatedStart && (m_funcs & I2C_FUNC_I2C)) {
+        Msg msgs[2] = {
+            Msg::write(BusConstBuf(&reg, 1)),
+            Msg::read(BusBuf(buf, len))
+        };
+        return transfer(etl::span<const Msg>(msgs, 2));
+    }
 
-    if (!writeBytes(&reg, 1))
-        return false;
+    BusStatus st = writeBytes(&reg, 1);
+    if (!st)
+        return st;
 
     return readBytes(buf, len);
 }
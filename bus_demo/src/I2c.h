@@ -20,6 +20,9 @@
 ***************************************************************************/
 #include <stdint.h>
 #include "etl/string.h"
+#include "BusStats.h"
+#include "BusError.h"
+#include "BusBuffer.h"
 
 /***************************************************************************
  						macro definition
@@ -37,33 +40,67 @@ public:
     struct Config {
         etl::string<32> device;     // 豸ڵ· "/dev/i2c-2"
         uint8_t addr;               // 豸ַ
+        bool    repeatedStart;      // truereadReg8 / readRegBlock д reg ظʼٶ
+                                    // falseĬϣд regSTOPٶڰ汾ʱһ
+    };
+
+    // I2C_RDWR һΣֱõ÷
+    struct Msg {
+        BusBuf buf;
+        bool   isRead;
+        bool   noStart;             // һηͣظʼ͵ַ֧ NOSTART
+
+        static Msg write(BusConstBuf b, bool noStart = false)
+        {
+            Msg m = { BusBuf(const_cast<uint8_t*>(b.data()), b.size()), false, noStart };
+            return m;
+        }
+        static Msg read(BusBuf b)
+        {
+            Msg m = { b, true, false };
+            return m;
+        }
     };
 
     I2c();
     I2c(const Config& cfg);
     ~I2c();
 
-    bool open();
+    BusStatus open();
     void close();
     bool isOpen() const { return m_fd >= 0; }
 
-    bool reconfigure(const Config& cfg);
+    BusStatus reconfigure(const Config& cfg);
     const Config& config() const { return m_cfg; }
 
     // д
-    bool writeBytes(const uint8_t* data, uint16_t len);
-    bool readBytes(uint8_t* buf, uint16_t len);
+    BusStatus writeBytes(const uint8_t* data, uint16_t len);
+    BusStatus readBytes(uint8_t* buf, uint16_t len);
+
+    // һ ioctl(I2C_RDWR) ɶδ䣬֮Ϊظʼŷ STOP
+    //  BUS_IOV_MAX Σִ֧ I2C ʱ BusErr_State
+    BusStatus transfer(etl::span<const Msg> msgs);
 
     // Ĵд
-    bool writeReg8(uint8_t reg, uint8_t val);
-    bool writeRegBlock(uint8_t reg, const uint8_t* data, uint16_t len);
-    bool readReg8(uint8_t reg, uint8_t* val);
-    bool readRegBlock(uint8_t reg, uint8_t* buf, uint16_t len);
+    // ֧ʱд reg + ΣNOSTARTconfig().repeatedStart ʱ
+    //  д reg + ظʼ + ֻһϵͳã˻ԭĿ / ε
+    BusStatus writeReg8(uint8_t reg, uint8_t val);
+    BusStatus writeRegBlock(uint8_t reg, const uint8_t* data, uint16_t len);
+    BusStatus writeRegBlock(uint8_t reg, BusConstBuf data) { return writeRegBlock(reg, data.data(), (uint16_t)data.size()); }
+    BusStatus readReg8(uint8_t reg, uint8_t* val);
+    BusStatus readRegBlock(uint8_t reg, uint8_t* buf, uint16_t len);
+    BusStatus readRegBlock(uint8_t reg, BusBuf buf) { return readRegBlock(reg, buf.data(), (uint16_t)buf.size()); }
+
+    // ͳƿգBUS_STATS_ENABLE=0 ʱΪ 0̵߳
+    void statsSnapshot(BusStats::Snapshot& out) const { m_stats.snapshot(out); }
+    void resetStats() { m_stats.reset(); }
 
 private:
     int    m_fd;
     Config m_cfg;
+    BusStats m_stats;
+    unsigned long m_funcs;      // ioctl(I2C_FUNCS) ʱѯһ
 
-    bool setSlaveAddress(uint8_t addr);
+    BusStatus setSlaveAddress(uint8_t addr);
 };
 /******************************** FILE END ********************************/
@@ -0,0 +1,686 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: J1939.cpp
+ * Author		: Fan Fei
+ * Description	:
+ * Comments		:
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include "J1939.h"
+#include "BusLog.h"
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <sys/select.h>
+#include <net/if.h>
+#include <linux/can.h>
+
+#if defined(__has_include)
+#if __has_include(<linux/can/j1939.h>)
+#include <linux/can/j1939.h>
+#define BUS_HAVE_J1939_SOCKET 1
+#endif
+#endif
+
+#ifndef BUS_HAVE_J1939_SOCKET
+#define BUS_HAVE_J1939_SOCKET 0
+#endif
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+// TP.CM ֽ
+#define TP_CM_RTS       16
+#define TP_CM_CTS       17
+#define TP_CM_EOMA      19
+#define TP_CM_BAM       32
+#define TP_CM_ABORT     255
+
+// TP ֹԭ
+#define TP_ABORT_BUSY      1    // лỰ޷ٿ
+#define TP_ABORT_RESOURCE  2    // ûпԴ
+#define TP_ABORT_TIMEOUT   3
+#define TP_ABORT_BAD_SEQ   7
+
+// J1939-21 ʱ
+#define TP_T1_MS        750     // ݰ֮
+#define TP_T2_MS        1250    //  CTS ȴ
+#define TP_BAM_GAP_MS   50      // BAM ͵İ
+#define CLAIM_WAIT_MS   250     // ַõĵȴʱ
+
+// õַΧ
+#define ADDR_DYNAMIC_MIN 128
+#define ADDR_DYNAMIC_MAX 247
+
+/***************************************************************************
+ 						function definition
+***************************************************************************/
+static uint32_t readPgn(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)(p[2] & 0x03) << 16);
+}
+
+static void writePgn(uint8_t* p, uint32_t pgn)
+{
+    p[0] = (uint8_t)(pgn & 0xFF);
+    p[1] = (uint8_t)((pgn >> 8) & 0xFF);
+    p[2] = (uint8_t)((pgn >> 16) & 0x03);
+}
+
+static uint64_t readName(const uint8_t* p)
+{
+    uint64_t name = 0;
+    for (int i = 7; i >= 0; --i)
+        name = (name << 8) | p[i];
+    return name;
+}
+
+static void writeName(uint8_t* p, uint64_t name)
+{
+    for (int i = 0; i < 8; ++i)
+        p[i] = (uint8_t)(name >> (8 * i));
+}
+
+/***************************************************************************
+ 						class definition
+***************************************************************************/
+uint32_t J1939::pgnOf(uint32_t id)
+{
+    uint32_t pgn = (id >> 8) & 0x3FFFF;
+    if (((pgn >> 8) & 0xFF) < 240)
+        pgn &= 0x3FF00;         // PDU1PS Ŀĵַ PGN
+    return pgn;
+}
+
+uint8_t J1939::daOf(uint32_t id)
+{
+    uint8_t pf = (uint8_t)((id >> 16) & 0xFF);
+    return (pf < 240) ? (uint8_t)((id >> 8) & 0xFF) : (uint8_t)ADDR_GLOBAL;
+}
+
+uint32_t J1939::makeId(uint8_t priority, uint32_t pgn, uint8_t sa, uint8_t da)
+{
+    uint32_t pdu = pgn & 0x3FFFF;
+    if (((pdu >> 8) & 0xFF) < 240)
+        pdu = (pdu & 0x3FF00) | da;
+    return ((uint32_t)(priority & 0x7) << 26) | (pdu << 8) | sa;
+}
+
+uint64_t J1939::nowMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000ull + (uint64_t)ts.tv_nsec / 1000000ull;
+}
+
+J1939::J1939(Can& can, const Config& cfg)
+    : m_can(can)
+    , m_cfg(cfg)
+    , m_sock(-1)
+    , m_address(ADDR_NULL)
+    , m_claimMs(0)
+    , m_taken()
+    , m_tpCompleted(0)
+    , m_tpAborted(0)
+    , m_tpTimeouts(0)
+    , m_tpNoSlot(0)
+{
+    for (int i = 0; i < J1939_TP_SLOTS; ++i)
+        m_sessions[i].state = Session_Idle;
+}
+
+J1939::~J1939()
+{
+    close();
+}
+
+BusStatus J1939::open()
+{
+    m_address = m_cfg.preferredAddress;
+    m_taken.reset();
+
+    bool kernel = false;
+    if (m_cfg.useKernel) {
+        BusStatus st = openKernel();
+        kernel = (bool)st;
+        if (!kernel && st.error().code != BusErr_Open)
+            return st;
+    }
+
+    if (!kernel) {
+        // ں˲֧ CAN_J1939˻û̬ԭʼ CAN ׽ϴ
+        BusStatus st = m_can.open();
+        if (!st)
+            return st;
+    }
+
+    return sendClaim(m_address);
+}
+
+BusStatus J1939::openKernel()
+{
+#if BUS_HAVE_J1939_SOCKET
+    int fd = ::socket(PF_CAN, SOCK_DGRAM, CAN_J1939);
+    if (fd < 0)
+        return busError(BusErr_Open, "socket CAN_J1939");
+
+    int on = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on)) < 0) {
+        ::close(fd);
+        return busFail(BusErr_Config, errno, "setsockopt SO_BROADCAST");
+    }
+
+    struct ifreq ifr;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, m_can.config().ifName.c_str(), sizeof(ifr.ifr_name) - 1);
+    if (ioctl(fd, SIOCGIFINDEX, &ifr) < 0) {
+        ::close(fd);
+        return busFail(BusErr_Config, errno, "ioctl SIOCGIFINDEX");
+    }
+
+    // ַ̬󶨣ַɱԼɣַʱ°
+    struct sockaddr_can addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family         = AF_CAN;
+    addr.can_ifindex        = ifr.ifr_ifindex;
+    addr.can_addr.j1939.name = J1939_NO_NAME;
+    addr.can_addr.j1939.pgn  = J1939_NO_PGN;
+    addr.can_addr.j1939.addr = m_address;
+
+    if (::bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        ::close(fd);
+        return busFail(BusErr_Open, errno, "bind j1939");
+    }
+
+    m_sock = fd;
+    return BusStatus();
+#else
+    return busError(BusErr_Open, "CAN_J1939 not available");
+#endif
+}
+
+void J1939::close()
+{
+    if (m_sock >= 0) {
+        ::close(m_sock);
+        m_sock = -1;
+    }
+    for (int i = 0; i < J1939_TP_SLOTS; ++i)
+        m_sessions[i].state = Session_Idle;
+}
+
+bool J1939::addressClaimed() const
+{
+    return m_address != ADDR_NULL && nowMs() - m_claimMs >= CLAIM_WAIT_MS;
+}
+
+BusStatus J1939::sendKernel(uint8_t priority, uint32_t pgn, uint8_t da, const uint8_t* data, uint16_t len)
+{
+#if BUS_HAVE_J1939_SOCKET
+    int prio = priority;
+    if (setsockopt(m_sock, SOL_CAN_J1939, SO_J1939_SEND_PRIO, &prio, sizeof(prio)) < 0)
+        return busFail(BusErr_Config, errno, "setsockopt SO_J1939_SEND_PRIO");
+
+    struct sockaddr_can addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family          = AF_CAN;
+    addr.can_addr.j1939.name = J1939_NO_NAME;
+    addr.can_addr.j1939.pgn  = pgn;
+    addr.can_addr.j1939.addr = da;
+
+    if (::sendto(m_sock, data, len, 0, (struct sockaddr*)&addr, sizeof(addr)) < 0)
+        return busFail(BusErr_Io, errno, "j1939 sendto");
+    return BusStatus();
+#else
+    (void)priority;
+    (void)pgn;
+    (void)da;
+    (void)data;
+    (void)len;
+    return busError(BusErr_NotOpen, "j1939 kernel socket");
+#endif
+}
+
+BusStatus J1939::sendFrame(uint8_t priority, uint32_t pgn, uint8_t da, const uint8_t* data, uint8_t len)
+{
+    if (m_sock >= 0)
+        return sendKernel(priority, pgn, da, data, len);
+
+    Can::Frame f;
+    memset(&f, 0, sizeof(f));
+    f.id         = makeId(priority, pgn, m_address, da);
+    f.isExtended = 1;
+    f.dlc        = len;
+    memcpy(f.data, data, len);
+    return m_can.send(f);
+}
+
+BusStatus J1939::sendClaim(uint8_t address)
+{
+    uint8_t d[8];
+    writeName(d, m_cfg.name);
+
+    bool changed = (address != m_address);
+    m_address = address;
+    m_claimMs = nowMs();
+
+    if (m_sock >= 0 && changed) {
+        // ں׽ֵԴַ bindַʱ°
+        ::close(m_sock);
+        m_sock = -1;
+        BusStatus st = openKernel();
+        if (!st)
+            return st;
+    }
+
+    return sendFrame(6, PGN_ADDRESS_CLAIMED, ADDR_GLOBAL, d, 8);
+}
+
+void J1939::sendTpCm(uint8_t da, uint8_t ctrl, uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint32_t pgn)
+{
+    uint8_t d[8];
+    d[0] = ctrl;
+    d[1] = b1;
+    d[2] = b2;
+    d[3] = b3;
+    d[4] = b4;
+    writePgn(d + 5, pgn);
+    sendFrame(7, PGN_TP_CM, da, d, 8);
+}
+
+BusStatus J1939::sendBam(uint32_t pgn, const uint8_t* data, uint16_t len, uint8_t priority)
+{
+    uint8_t packets = (uint8_t)((len + 6) / 7);
+
+    uint8_t d[8];
+    d[0] = TP_CM_BAM;
+    d[1] = (uint8_t)(len & 0xFF);
+    d[2] = (uint8_t)(len >> 8);
+    d[3] = packets;
+    d[4] = 0xFF;
+    writePgn(d + 5, pgn);
+
+    BusStatus st = sendFrame(priority, PGN_TP_CM, ADDR_GLOBAL, d, 8);
+    if (!st)
+        return st;
+
+    for (uint8_t seq = 1; seq <= packets; ++seq) {
+        usleep(TP_BAM_GAP_MS * 1000);
+
+        size_t off = (size_t)(seq - 1) * 7;
+        size_t n   = (len - off < 7) ? (len - off) : 7;
+        memset(d, 0xFF, sizeof(d));
+        d[0] = seq;
+        memcpy(d + 1, data + off, n);
+
+        st = sendFrame(priority, PGN_TP_DT, ADDR_GLOBAL, d, 8);
+        if (!st)
+            return st;
+    }
+    return BusStatus();
+}
+
+BusStatus J1939::send(uint32_t pgn, uint8_t da, const uint8_t* data, uint16_t len, uint8_t priority)
+{
+    if (m_address == ADDR_NULL)
+        return busError(BusErr_State, "j1939 no address");
+    if (len > J1939_MAX_DATA)
+        return busError(BusErr_InvalidArg, "j1939 length");
+
+    // ںģʽں˸ְȫ BAMԵ RTS/CTS
+    if (m_sock >= 0)
+        return sendKernel(priority, pgn, da, data, len);
+    if (len <= 8)
+        return sendFrame(priority, pgn, da, data, (uint8_t)len);
+
+    if (da != ADDR_GLOBAL)
+        return busError(BusErr_State, "j1939 cmdt send needs kernel socket");
+    return sendBam(pgn, data, len, priority);
+}
+
+J1939::Session* J1939::findSession(uint8_t sa, uint8_t da)
+{
+    for (int i = 0; i < J1939_TP_SLOTS; ++i) {
+        Session& s = m_sessions[i];
+        if ((s.state == Session_Bam || s.state == Session_Cmdt) && s.sa == sa && s.da == da)
+            return &s;
+    }
+    return nullptr;
+}
+
+J1939::Session* J1939::allocSession()
+{
+    for (int i = 0; i < J1939_TP_SLOTS; ++i) {
+        if (m_sessions[i].state == Session_Idle)
+            return &m_sessions[i];
+    }
+    return nullptr;
+}
+
+void J1939::releaseDelivered()
+{
+    for (int i = 0; i < J1939_TP_SLOTS; ++i) {
+        if (m_sessions[i].state == Session_Delivered)
+            m_sessions[i].state = Session_Idle;
+    }
+}
+
+void J1939::expireSessions(uint64_t now)
+{
+    for (int i = 0; i < J1939_TP_SLOTS; ++i) {
+        Session& s = m_sessions[i];
+        if ((s.state == Session_Bam || s.state == Session_Cmdt) && now > s.deadlineMs) {
+            if (s.state == Session_Cmdt)
+                sendTpCm(s.sa, TP_CM_ABORT, TP_ABORT_TIMEOUT, 0xFF, 0xFF, 0xFF, s.pgn);
+            s.state = Session_Idle;
+            ++m_tpTimeouts;
+        }
+    }
+}
+
+bool J1939::handleTpCm(uint8_t sa, uint8_t da, uint8_t priority, const uint8_t* d, uint64_t now)
+{
+    uint8_t  ctrl    = d[0];
+    uint16_t size    = (uint16_t)(d[1] | (d[2] << 8));
+    uint8_t  packets = d[3];
+    uint32_t pgn     = readPgn(d + 5);
+
+    if (ctrl == TP_CM_ABORT) {
+        Session* s = findSession(sa, da);
+        if (s != nullptr) {
+            s->state = Session_Idle;
+            ++m_tpAborted;
+        }
+        return false;
+    }
+
+    if (ctrl != TP_CM_BAM && ctrl != TP_CM_RTS)
+        return false;           // CTS / EOMA ڷͷû̬ CMDT 
+    if (ctrl == TP_CM_BAM && da != ADDR_GLOBAL)
+        return false;
+    if (ctrl == TP_CM_RTS && da != m_address)
+        return false;
+
+    if (size <= 8 || size > J1939_MAX_DATA || packets != (size + 6) / 7) {
+        if (ctrl == TP_CM_RTS)
+            sendTpCm(sa, TP_CM_ABORT, TP_ABORT_RESOURCE, 0xFF, 0xFF, 0xFF, pgn);
+        return false;
+    }
+
+    // ͬһԴĿģ»Ự滻ɻỰ
+    Session* s = findSession(sa, da);
+    if (s != nullptr)
+        ++m_tpAborted;
+    else
+        s = allocSession();
+
+    if (s == nullptr) {
+        ++m_tpNoSlot;
+        if (ctrl == TP_CM_RTS)
+            sendTpCm(sa, TP_CM_ABORT, TP_ABORT_BUSY, 0xFF, 0xFF, 0xFF, pgn);
+        return false;
+    }
+
+    s->state     = (ctrl == TP_CM_BAM) ? Session_Bam : Session_Cmdt;
+    s->sa        = sa;
+    s->da        = da;
+    s->priority  = priority;
+    s->pgn       = pgn;
+    s->size      = size;
+    s->packets   = packets;
+    s->nextSeq   = 1;
+    s->maxWindow = (ctrl == TP_CM_RTS) ? d[4] : 0xFF;
+    s->windowEnd = packets;
+    s->deadlineMs = now + TP_T1_MS;
+
+    if (ctrl == TP_CM_RTS) {
+        uint8_t window = (s->maxWindow < packets) ? s->maxWindow : packets;
+        if (window == 0)
+            window = packets;
+        s->windowEnd  = window;
+        s->deadlineMs = now + TP_T2_MS;
+        sendTpCm(sa, TP_CM_CTS, window, 1, 0xFF, 0xFF, pgn);
+    }
+    return true;
+}
+
+bool J1939::handleTpDt(uint8_t sa, uint8_t da, const uint8_t* d, Message& msg, uint64_t now)
+{
+    Session* s = findSession(sa, da);
+    if (s == nullptr)
+        return false;
+
+    uint8_t seq = d[0];
+    if (seq != s->nextSeq) {
+        if (s->state == Session_Cmdt)
+            sendTpCm(sa, TP_CM_ABORT, TP_ABORT_BAD_SEQ, 0xFF, 0xFF, 0xFF, s->pgn);
+        s->state = Session_Idle;
+        ++m_tpAborted;
+        return false;
+    }
+
+    size_t off = (size_t)(seq - 1) * 7;
+    size_t n   = (s->size - off < 7) ? (s->size - off) : 7;
+    memcpy(s->data + off, d + 1, n);
+    ++s->nextSeq;
+
+    if (seq == s->packets) {
+        if (s->state == Session_Cmdt)
+            sendTpCm(sa, TP_CM_EOMA, (uint8_t)(s->size & 0xFF), (uint8_t)(s->size >> 8), s->packets, 0xFF, s->pgn);
+
+        msg.pgn      = s->pgn;
+        msg.priority = s->priority;
+        msg.sa       = s->sa;
+        msg.da       = s->da;
+        msg.length   = s->size;
+        msg.data     = s->data;
+        s->state     = Session_Delivered;
+        ++m_tpCompleted;
+        return true;
+    }
+
+    if (s->state == Session_Cmdt && seq == s->windowEnd) {
+        // ꣬һ
+        uint8_t left   = (uint8_t)(s->packets - seq);
+        uint8_t window = (s->maxWindow < left) ? s->maxWindow : left;
+        if (window == 0)
+            window = left;
+        s->windowEnd  = (uint8_t)(seq + window);
+        s->deadlineMs = now + TP_T2_MS;
+        sendTpCm(sa, TP_CM_CTS, window, s->nextSeq, 0xFF, 0xFF, s->pgn);
+    } else {
+        s->deadlineMs = now + TP_T1_MS;
+    }
+    return false;
+}
+
+uint8_t J1939::pickAddress() const
+{
+    for (int a = ADDR_DYNAMIC_MIN; a <= ADDR_DYNAMIC_MAX; ++a) {
+        if (!m_taken.test(a))
+            return (uint8_t)a;
+    }
+    return ADDR_NULL;
+}
+
+void J1939::handleClaim(uint8_t sa, uint64_t name)
+{
+    if (name == m_cfg.name)
+        return;                 // Լػ
+
+    if (sa < ADDR_NULL)
+        m_taken.set(sa);
+
+    if (sa != m_address || m_address == ADDR_NULL)
+        return;
+
+    if (m_cfg.name < name) {
+        // ǵ NAME ȣ
+        sendClaim(m_address);
+        return;
+    }
+
+    // ʧܣNAME  63 λʾõַһеַ Cannot Claim
+    uint8_t next = ADDR_NULL;
+    if (m_cfg.name >> 63)
+        next = pickAddress();
+    sendClaim(next);
+    BusLog::instance().post(BusErr_State, 0, (next == ADDR_NULL) ? "j1939 cannot claim" : "j1939 address changed");
+}
+
+void J1939::handleRequest(uint8_t da, uint32_t pgn)
+{
+    if (pgn == PGN_ADDRESS_CLAIMED && (da == ADDR_GLOBAL || da == m_address))
+        sendClaim(m_address);
+}
+
+bool J1939::handleFrame(const Can::Frame& frame, Message& msg, uint64_t now)
+{
+    if (!frame.isExtended || frame.isRTR)
+        return false;
+
+    uint32_t pgn      = pgnOf(frame.id);
+    uint8_t  sa       = saOf(frame.id);
+    uint8_t  da       = daOf(frame.id);
+    uint8_t  priority = priorityOf(frame.id);
+
+    if (pgn == PGN_ADDRESS_CLAIMED && frame.dlc >= 8) {
+        handleClaim(sa, readName(frame.data));
+        return false;
+    }
+
+    if (da != ADDR_GLOBAL && da != m_address)
+        return false;
+
+    if (pgn == PGN_REQUEST && frame.dlc >= 3) {
+        handleRequest(da, readPgn(frame.data));
+        // ҲߣӦûӦ PGN
+    } else if (pgn == PGN_TP_CM && frame.dlc >= 8) {
+        handleTpCm(sa, da, priority, frame.data, now);
+        return false;
+    } else if (pgn == PGN_TP_DT && frame.dlc >= 8) {
+        return handleTpDt(sa, da, frame.data, msg, now);
+    }
+
+    memcpy(m_rx, frame.data, frame.dlc);
+    msg.pgn      = pgn;
+    msg.priority = priority;
+    msg.sa       = sa;
+    msg.da       = da;
+    msg.length   = frame.dlc;
+    msg.data     = m_rx;
+    return true;
+}
+
+BusStatus J1939::receiveKernel(Message& msg)
+{
+#if BUS_HAVE_J1939_SOCKET
+    int timeoutMs = m_can.config().recvTimeoutMs;
+
+    for (;;) {
+        if (timeoutMs > 0) {
+            fd_set rfds;
+            FD_ZERO(&rfds);
+            FD_SET(m_sock, &rfds);
+            struct timeval tv;
+            tv.tv_sec  = timeoutMs / 1000;
+            tv.tv_usec = (timeoutMs % 1000) * 1000;
+            int ret = select(m_sock + 1, &rfds, nullptr, nullptr, &tv);
+            if (ret < 0) {
+                if (errno == EINTR)
+                    continue;
+                return busFail(BusErr_Io, errno, "select j1939");
+            }
+            if (ret == 0)
+                return busError(BusErr_Timeout, "j1939 receive");
+        }
+
+        struct sockaddr_can src;
+        memset(&src, 0, sizeof(src));
+
+        struct iovec iov;
+        iov.iov_base = m_rx;
+        iov.iov_len  = sizeof(m_rx);
+
+        char ctrl[CMSG_SPACE(sizeof(uint8_t)) * 2 + CMSG_SPACE(sizeof(uint64_t))];
+        struct msghdr mh;
+        memset(&mh, 0, sizeof(mh));
+        mh.msg_name       = &src;
+        mh.msg_namelen    = sizeof(src);
+        mh.msg_iov        = &iov;
+        mh.msg_iovlen     = 1;
+        mh.msg_control    = ctrl;
+        mh.msg_controllen = sizeof(ctrl);
+
+        ssize_t n = ::recvmsg(m_sock, &mh, 0);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return busFail(BusErr_Io, errno, "recvmsg j1939");
+        }
+
+        msg.pgn      = src.can_addr.j1939.pgn;
+        msg.sa       = src.can_addr.j1939.addr;
+        msg.da       = ADDR_GLOBAL;
+        msg.priority = 6;
+        msg.length   = (uint16_t)n;
+        msg.data     = m_rx;
+
+        for (struct cmsghdr* cm = CMSG_FIRSTHDR(&mh); cm != nullptr; cm = CMSG_NXTHDR(&mh, cm)) {
+            if (cm->cmsg_level != SOL_CAN_J1939)
+                continue;
+            if (cm->cmsg_type == SCM_J1939_DEST_ADDR)
+                msg.da = *(const uint8_t*)CMSG_DATA(cm);
+            else if (cm->cmsg_type == SCM_J1939_PRIO)
+                msg.priority = *(const uint8_t*)CMSG_DATA(cm);
+        }
+
+        if (msg.pgn == PGN_ADDRESS_CLAIMED && n >= 8) {
+            handleClaim(msg.sa, readName(m_rx));
+            continue;
+        }
+        if (msg.pgn == PGN_REQUEST && n >= 3)
+            handleRequest(msg.da, readPgn(m_rx));
+        return BusStatus();
+    }
+#else
+    (void)msg;
+    return busError(BusErr_NotOpen, "j1939 kernel socket");
+#endif
+}
+
+BusStatus J1939::receive(Message& msg)
+{
+    releaseDelivered();
+
+    if (m_sock >= 0)
+        return receiveKernel(msg);
+
+    for (;;) {
+        Can::Frame frame;
+        BusStatus  st  = m_can.receive(frame);
+        uint64_t   now = nowMs();
+
+        expireSessions(now);
+        if (!st)
+            return st;
+        if (handleFrame(frame, msg, now))
+            return BusStatus();
+    }
+}
+/******************************** FILE END ********************************/
@@ -0,0 +1,167 @@
+/***************************************************************************
+ * CopyRight(c)		YoPlore	, All rights reserved
+ *
+ * File			: J1939.h
+ * Author		: Fan Fei
+ * Description	: SAE J1939 Э㣺PGN/SA/DA Э飨BAM / RTS-CTS
+ *				  顢ַ
+ * Comments		: ں֧ CAN_J1939 ʱֱ j1939 ׽֣ںɷְ飻
+ *				   Can ԭʼ׽ɱû̬
+ * Date			: 2026-10-19
+ *
+ * Revision Control
+ *  Ver | yyyy-mm-dd  | Who  | Description of changes
+ * -----|-------------|------|--------------------------------------------
+ * 		|			  |		 |
+ * 		|			  |		 |
+ **************************************************************************/
+#pragma once
+
+/***************************************************************************
+ 							include files
+***************************************************************************/
+#include <stdint.h>
+#include "etl/bitset.h"
+#include "Can.h"
+#include "BusError.h"
+
+/***************************************************************************
+ 						macro definition
+***************************************************************************/
+#define J1939_MAX_DATA   1785   // Эĳȣ255  * 7 ֽ
+#define J1939_TP_SLOTS   8      // ͬʱеỰ
+
+/***************************************************************************
+ 						class declaration
+***************************************************************************/
+class J1939 {
+public:
+    enum {
+        PGN_REQUEST         = 0x0EA00,
+        PGN_ADDRESS_CLAIMED = 0x0EE00,
+        PGN_TP_CM           = 0x0EC00,
+        PGN_TP_DT           = 0x0EB00
+    };
+
+    enum {
+        ADDR_NULL   = 0xFE,     // δȡõַCannot Claim
+        ADDR_GLOBAL = 0xFF
+    };
+
+    struct Config {
+        Config()
+            : name(0)
+            , preferredAddress(0x80)
+            , useKernel(1)
+        {
+        }
+
+        uint64_t name;              // 64 λ NAMEֵԽСַʱȼԽ
+        uint8_t  preferredAddress;
+        int      useKernel;         //  0 ʱʹں CAN_J1939 ׽
+    };
+
+    // һ J1939 ģdata ָڲ壬´ receive() ǰЧ
+    struct Message {
+        uint32_t       pgn;
+        uint8_t        priority;
+        uint8_t        sa;
+        uint8_t        da;
+        uint16_t       length;
+        const uint8_t* data;
+    };
+
+    // 29 λչ ID ֶβװ
+    static uint32_t pgnOf(uint32_t id);
+    static uint8_t  saOf(uint32_t id)       { return (uint8_t)(id & 0xFF); }
+    static uint8_t  daOf(uint32_t id);      // PDU2 ʽ ADDR_GLOBAL
+    static uint8_t  priorityOf(uint32_t id) { return (uint8_t)((id >> 26) & 0x7); }
+    static uint32_t makeId(uint8_t priority, uint32_t pgn, uint8_t sa, uint8_t da);
+
+    // can Ľճʱ receive() ĳʱںģʽֻĽӿͳʱ
+    J1939(Can& can, const Config& cfg);
+    ~J1939();
+
+    // 򿪲ַ250 ms üΪȡõַ
+    BusStatus open();
+    void close();
+    bool usingKernel() const { return m_sock >= 0; }
+
+    uint8_t address() const { return m_address; }
+    bool addressClaimed() const;
+
+    // len <= 8 ֡ͣlen > 8 ҷȫֵַʱ BAM 50 ms
+    // û̬ģʽ²֧򵥸ڵ RTS/CTS ͣ BusErr_State
+    BusStatus send(uint32_t pgn, uint8_t da, const uint8_t* data, uint16_t len, uint8_t priority = 6);
+
+    // յһڵȫֵģЭ͵ַ֡ڲ
+    BusStatus receive(Message& msg);
+
+    uint32_t tpCompleted() const { return m_tpCompleted; }
+    uint32_t tpAborted() const   { return m_tpAborted; }
+    uint32_t tpTimeouts() const  { return m_tpTimeouts; }
+    uint32_t tpNoSlot() const    { return m_tpNoSlot; }
+
+private:
+    enum SessionState {
+        Session_Idle,
+        Session_Bam,
+        Session_Cmdt,
+        Session_Delivered       // ѽߣ´ receive() ʱͷ
+    };
+
+    struct Session {
+        uint8_t  state;
+        uint8_t  sa;
+        uint8_t  da;
+        uint8_t  priority;
+        uint32_t pgn;
+        uint16_t size;
+        uint8_t  packets;
+        uint8_t  nextSeq;
+        uint8_t  windowEnd;     // CMDTǰ CTS һ
+        uint8_t  maxWindow;     // CMDTͷ RTS иÿ CTS 
+        uint64_t deadlineMs;
+        uint8_t  data[J1939_MAX_DATA];
+    };
+
+    J1939(const J1939&);
+    J1939& operator=(const J1939&);
+
+    static uint64_t nowMs();
+
+    BusStatus openKernel();
+    BusStatus receiveKernel(Message& msg);
+    BusStatus sendKernel(uint8_t priority, uint32_t pgn, uint8_t da, const uint8_t* data, uint16_t len);
+    BusStatus sendFrame(uint8_t priority, uint32_t pgn, uint8_t da, const uint8_t* data, uint8_t len);
+    BusStatus sendClaim(uint8_t address);
+    BusStatus sendBam(uint32_t pgn, const uint8_t* data, uint16_t len, uint8_t priority);
+    void      sendTpCm(uint8_t da, uint8_t ctrl, uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint32_t pgn);
+
+    bool handleFrame(const Can::Frame& frame, Message& msg, uint64_t now);
+    bool handleTpCm(uint8_t sa, uint8_t da, uint8_t priority, const uint8_t* d, uint64_t now);
+    bool handleTpDt(uint8_t sa, uint8_t da, const uint8_t* d, Message& msg, uint64_t now);
+    void handleClaim(uint8_t sa, uint64_t name);
+    void handleRequest(uint8_t da, uint32_t pgn);
+    void expireSessions(uint64_t now);
+    void releaseDelivered();
+    Session* findSession(uint8_t sa, uint8_t da);
+    Session* allocSession();
+    uint8_t  pickAddress() const;
+
+    Can&     m_can;
+    Config   m_cfg;
+    int      m_sock;            // ں j1939 ׽֣-1 ʾû̬ģʽ
+    uint8_t  m_address;
+    uint64_t m_claimMs;         // һηַʱ
+    etl::bitset<256> m_taken;   // ѱڵĵַ
+
+    Session  m_sessions[J1939_TP_SLOTS];
+    uint8_t  m_rx[J1939_MAX_DATA];
+
+    uint32_t m_tpCompleted;
+    uint32_t m_tpAborted;
+    uint32_t m_tpTimeouts;
+    uint32_t m_tpNoSlot;
+};
+/******************************** FILE END ********************************/
@@ -18,6 +18,7 @@
  							include files
 ***************************************************************************/
 #include "Uart.h"
+#include "BusLog.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -26,6 +27,9 @@
 #include <errno.h>
 #include <termios.h>
 #include <sys/select.h>
+#include <sys/uio.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
 
 /***************************************************************************
  						class definition
@@ -33,13 +37,17 @@
 Uart::Uart()
     : m_fd(-1)
     , m_cfg()
+    , m_openSeq(0)
 {
+    memset(&m_health, 0, sizeof(m_health));
 }
 
 Uart::Uart(const Config& cfg)
     : m_fd(-1)
     , m_cfg(cfg)
+    , m_openSeq(0)
 {
+    memset(&m_health, 0, sizeof(m_health));
 }
 
 Uart::~Uart()
@@ -70,15 +78,15 @@ int Uart::baudToConstant(int baud)
     }
 }
 
-bool Uart::applyTermios()
+BusStatus Uart::applyTermios()
 {
     if (m_fd < 0)
-        return false;
+        return busError(BusErr_NotOpen, "uart termios");
 
     struct termios tio;
     if (tcgetattr(m_fd, &tio) != 0) {
-        perror("tcgetattr");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Config, errno, "tcgetattr");
     }
 
     // ò
@@ -137,33 +145,36 @@ bool Uart::applyTermios()
     tcflush(m_fd, TCIFLUSH);
 
     if (tcsetattr(m_fd, TCSANOW, &tio) != 0) {
-        perror("tcsetattr");
-        return false;
+        m_stats.addError(errno);
+        return busFail(BusErr_Config, errno, "tcsetattr");
     }
 
-    return true;
+    return BusStatus();
 }
 
-bool Uart::open()
+BusStatus Uart::open()
 {
     if (isOpen())
-        return true;
+        return BusStatus();
 
-    if (m_cfg.device.empty()) {
-        fprintf(stderr, "uart device is empty\n");
-        return false;
-    }
+    if (m_cfg.device.empty())
+        return busFail(BusErr_InvalidArg, 0, "uart device is empty");
 
     // 򿪣ⱻ modem ź֮࿨ס
-    m_fd = ::open(m_cfg.device.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
-    if (m_fd < 0) {
-        perror("open uart");
-        return false;
+    int fd = ::open(m_cfg.device.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) {
+        m_stats.addError(errno);
+        return busFail(BusErr_Open, errno, "open uart");
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_fdLock);
+        m_fd = fd;
     }
 
-    if (!applyTermios()) {
+    BusStatus st = applyTermios();
+    if (!st) {
         close();
-        return false;
+        return st;
     }
 
     // лģʽĳʱ select أ
@@ -173,52 +184,62 @@ bool Uart::open()
         fcntl(m_fd, F_SETFL, flags);
     }
 
-    return true;
+    // ´򿪺󽡿½ߣ߹߳Уֻ֪ͨ
+    m_openSeq.fetch_add(1, etl::memory_order_relaxed);
+    return BusStatus();
 }
 
 void Uart::close()
 {
+    std::lock_guard<std::mutex> lock(m_fdLock);
     if (m_fd >= 0) {
         ::close(m_fd);
         m_fd = -1;
     }
 }
 
-bool Uart::reconfigure(const Config& cfg)
+BusStatus Uart::reconfigure(const Config& cfg)
 {
-    m_cfg = cfg;
+    {
+        std::lock_guard<std::mutex> lock(m_fdLock);
+        m_cfg = cfg;
+    }
 
     if (!isOpen())
-        return true;
+        return BusStatus();
 
     return applyTermios();
 }
 
-int Uart::write(const uint8_t* data, int len)
+BusCount Uart::write(const uint8_t* data, int len)
 {
-    if (m_fd < 0 || data == nullptr || len <= 0)
-        return -1;
+    if (m_fd < 0)
+        return busError(BusErr_NotOpen, "uart write");
+    if (data == nullptr || len <= 0)
+        return busError(BusErr_InvalidArg, "uart write");
 
     int total = 0;
     while (total < len) {
+        m_stats.addSyscall();
         int ret = (int)::write(m_fd, data + total, (size_t)(len - total));
         if (ret < 0) {
             if (errno == EINTR)
                 // дбźжϣ POSIX ԼԼ
                 continue;
-            perror("uart write");
-            return -1;
+            m_stats.addError(errno);
+            return busFail(BusErr_Io, errno, "uart write");
         }
+        if (ret < len - total)
+            m_stats.addShortWrite();
         total += ret;
+        m_stats.addBytesOut((uint32_t)ret);
     }
     return total;
 }
 
-int Uart::read(uint8_t* buf, int maxLen, int readTimeoutMs)
+//  1 ʾɶ0 ʾʱźŴ
+BusCount Uart::waitReadable(int readTimeoutMs, uint64_t callStart)
 {
-    if (m_fd < 0 || buf == nullptr || maxLen <= 0)
-        return -1;
-
     fd_set readfds;
     FD_ZERO(&readfds);
     FD_SET(m_fd, &readfds);
@@ -232,26 +253,44 @@ int Uart::read(uint8_t* buf, int maxLen, int readTimeoutMs)
         ptv = &tv;
     }
 
+    m_stats.addSyscall();
     int ret = ::select(m_fd + 1, &readfds, nullptr, nullptr, ptv);
     if (ret < 0) {
         if (errno == EINTR)
             // select ͬΪź˳ʱֱӷ 0 ʾδ
             return 0;
-        perror("select uart");
-        return -1;
+        m_stats.addError(errno);
+        return busFail(BusErr_Io, errno, "select uart");
     } else if (ret == 0) {
+        m_stats.addTimeout();
+        m_stats.endCall(callStart);
         return 0;
     }
+    return 1;
+}
+
+BusCount Uart::read(uint8_t* buf, int maxLen, int readTimeoutMs)
+{
+    if (m_fd < 0)
+        return busError(BusErr_NotOpen, "uart read");
+    if (buf == nullptr || maxLen <= 0)
+        return busError(BusErr_InvalidArg, "uart read");
+
+    uint64_t t0 = m_stats.beginCall();
+    BusCount ready = waitReadable(readTimeoutMs, t0);
+    if (!ready || *ready == 0)
+        return ready;
 
     int n = 0;
     while (n < maxLen) {
-        ret = (int)::read(m_fd, buf + n, (size_t)(maxLen - n));
+        m_stats.addSyscall();
+        int ret = (int)::read(m_fd, buf + n, (size_t)(maxLen - n));
         if (ret < 0) {
             if (errno == EINTR)
                 // read źŴʱжΪ
                 continue;
-            perror("uart read");
-            return -1;
+            m_stats.addError(errno);
+            return busFail(BusErr_Io, errno, "uart read");
         }
         if (ret == 0) {
             // ޸ݣֱӷصǰȡ
@@ -259,7 +298,177 @@ int Uart::read(uint8_t* buf, int maxLen, int readTimeoutMs)
         }
         n += ret;
     }
+    m_stats.endCall(t0);
 
+    if (n < maxLen)
+        m_stats.addShortRead();
+    m_stats.addBytesIn((uint32_t)n);
     return n;
 }
+
+BusCount Uart::writev(BusGather segs)
+{
+    if (m_fd < 0)
+        return busError(BusErr_NotOpen, "uart writev");
+    if (segs.size() > BUS_IOV_MAX)
+        return busError(BusErr_InvalidArg, "uart writev");
+
+    struct iovec  iovs[BUS_IOV_MAX];
+    struct iovec* iov   = iovs;
+    int           count = busToIovec(segs, iovs);
+    if (count == 0)
+        return busError(BusErr_InvalidArg, "uart writev");
+
+    uint64_t t0 = m_stats.beginCall();
+    int total = 0;
+    while (count > 0) {
+        m_stats.addSyscall();
+        int ret = (int)::writev(m_fd, iov, count);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            m_stats.addError(errno);
+            return busFail(BusErr_Io, errno, "uart writev");
+        }
+        total += ret;
+        m_stats.addBytesOut((uint32_t)ret);
+        count = busAdvanceIovec(iov, count, (size_t)ret);
+        if (count > 0)
+            m_stats.addShortWrite();
+    }
+    m_stats.endCall(t0);
+    return total;
+}
+
+BusCount Uart::readv(BusScatter segs, int readTimeoutMs)
+{
+    if (m_fd < 0)
+        return busError(BusErr_NotOpen, "uart readv");
+    if (segs.size() > BUS_IOV_MAX)
+        return busError(BusErr_InvalidArg, "uart readv");
+
+    struct iovec iovs[BUS_IOV_MAX];
+    int          count = busToIovec(segs, iovs);
+    if (count == 0)
+        return busError(BusErr_InvalidArg, "uart readv");
+
+    uint64_t t0 = m_stats.beginCall();
+    BusCount ready = waitReadable(readTimeoutMs, t0);
+    if (!ready || *ready == 0)
+        return ready;
+
+    int ret;
+    do {
+        m_stats.addSyscall();
+        ret = (int)::readv(m_fd, iovs, count);
+    } while (ret < 0 && errno == EINTR);
+    m_stats.endCall(t0);
+    if (ret < 0) {
+        m_stats.addError(errno);
+        return busFail(BusErr_Io, errno, "uart readv");
+    }
+
+    m_stats.addBytesIn((uint32_t)ret);
+    return ret;
+}
+
+// ÿַռõλʼλ + λ + Уλ + ֹͣλ
+int Uart::bitsPerChar() const
+{
+    return 1 + m_cfg.dataBits + (m_cfg.parity != Parity_None ? 1 : 0) + m_cfg.stopBits;
+}
+
+BusStatus Uart::sampleHealth(LineHealth& out)
+{
+    memset(&out, 0, sizeof(out));
+
+    //  ioctl ȡʣڼ fd ᱻ close() رպ󱻱ļ
+    struct serial_icounter_struct ic;
+    memset(&ic, 0, sizeof(ic));
+    int inq  = 0;
+    int outq = 0;
+    int baud;
+    int bits;
+    {
+        std::lock_guard<std::mutex> lock(m_fdLock);
+        if (m_fd < 0)
+            return busError(BusErr_NotOpen, "uart health");
+
+        out.icountValid = (ioctl(m_fd, TIOCGICOUNT, &ic) == 0) ? 1 : 0;
+        if (ioctl(m_fd, TIOCINQ, &inq) < 0) {
+            m_stats.addError(errno);
+            return busFail(BusErr_Io, errno, "ioctl TIOCINQ");
+        }
+        if (ioctl(m_fd, TIOCOUTQ, &outq) < 0) {
+            m_stats.addError(errno);
+            return busFail(BusErr_Io, errno, "ioctl TIOCOUTQ");
+        }
+        baud = m_cfg.baudrate;
+        bits = bitsPerChar();
+    }
+    out.inQueue  = inq;
+    out.outQueue = outq;
+
+    BusStats::Snapshot snap;
+    m_stats.snapshot(snap);
+    uint64_t now = BusStats::nowNs();
+
+    const double bitsPerSec = (double)(baud > 0 ? baud : 1);
+    out.readerLagUs = (uint32_t)((double)inq * bits * 1e6 / bitsPerSec);
+
+    HealthBase& b = m_health;
+    uint32_t seq = m_openSeq.load(etl::memory_order_relaxed);
+    if (b.openSeq != seq) {
+        memset(&b, 0, sizeof(b));
+        b.openSeq = seq;
+    }
+    if (b.ns != 0) {
+        out.intervalNs = now - b.ns;
+        out.consumed   = (uint32_t)(snap.bytesIn - b.bytesIn);
+
+        //  int޷Ųֵ
+        uint32_t rxBytes;
+        uint32_t txBytes;
+        if (out.icountValid) {
+            out.rx         = (uint32_t)(ic.rx - b.rx);
+            out.tx         = (uint32_t)(ic.tx - b.tx);
+            out.overrun    = (uint32_t)(ic.overrun - b.overrun);
+            out.frame      = (uint32_t)(ic.frame - b.frame);
+            out.parity     = (uint32_t)(ic.parity - b.parity);
+            out.brk        = (uint32_t)(ic.brk - b.brk);
+            out.bufOverrun = (uint32_t)(ic.buf_overrun - b.bufOverrun);
+            rxBytes = out.rx;
+            txBytes = out.tx;
+        } else {
+            // ûʱյ =  + б仯 = д - Ͷб仯
+            int64_t rxEst = (int64_t)out.consumed + inq - b.inQueue;
+            rxBytes = rxEst > 0 ? (uint32_t)rxEst : 0;
+            txBytes = (uint32_t)(snap.bytesOut - b.bytesOut);
+        }
+
+        double lineBytes = bitsPerSec / bits * (double)out.intervalNs / 1e9;
+        if (lineBytes > 0.0) {
+            out.rxUtilization = (double)rxBytes / lineBytes;
+            out.txUtilization = (double)txBytes / lineBytes;
+        }
+
+        b.growth = (inq > b.inQueue) ? b.growth + 1 : 0;
+    }
+
+    out.inQueueGrowth = b.growth;
+    out.slowReader    = (inq >= UART_HEALTH_INQ_WARN || b.growth >= UART_HEALTH_GROWTH_WARN) ? 1 : 0;
+
+    b.ns         = now;
+    b.bytesIn    = snap.bytesIn;
+    b.bytesOut   = snap.bytesOut;
+    b.rx         = ic.rx;
+    b.tx         = ic.tx;
+    b.overrun    = ic.overrun;
+    b.frame      = ic.frame;
+    b.parity     = ic.parity;
+    b.brk        = ic.brk;
+    b.bufOverrun = ic.buf_overrun;
+    b.inQueue    = inq;
+    return BusStatus();
+}
 /******************************** FILE END ********************************/
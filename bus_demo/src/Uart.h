@@ -19,7 +19,12 @@
  							include files
 ***************************************************************************/
 #include <stdint.h>
+#include <mutex>
 #include "etl/string.h"
+#include "etl/atomic.h"
+#include "BusStats.h"
+#include "BusError.h"
+#include "BusBuffer.h"
 
 /***************************************************************************
  						macro definition
@@ -27,6 +32,9 @@
 #define UART2_DEVICE "/dev/ttyS2"
 #define UART3_DEVICE "/dev/ttyS3"
 
+#define UART_HEALTH_INQ_WARN      2048  // նгֽΪ߸ϣN_TTY Ϊ 4096
+#define UART_HEALTH_GROWTH_WARN   3     // նĲﵽֵҲΪ
+
 /***************************************************************************
  						class declaration
 ***************************************************************************/
@@ -61,28 +69,91 @@ public:
     Uart(const Config& cfg);
     ~Uart();
 
-    bool open();
+    BusStatus open();
     void close();
     bool isOpen() const { return m_fd >= 0; }
 
-    bool reconfigure(const Config& cfg);
+    BusStatus reconfigure(const Config& cfg);
     const Config& config() const { return m_cfg; }
 
-    // дֽʧܷ -1
-    int write(const uint8_t* data, int len);
+    // дֽʧʱش
+    BusCount write(const uint8_t* data, int len);
 
     // ȡ maxLen ֽڣ
     // >0  : ʵʶȡֽ
     //  0  : ʱ readTimeoutMs ûκݣ
-    // <0  : ʧ
+    // ʧʱش
     // readTimeoutMs read ʱʱ䣬룬<=0 ʾʱ
-    int read(uint8_t* buf, int maxLen, int readTimeoutMs);
+    BusCount read(uint8_t* buf, int maxLen, int readTimeoutMs);
+
+    // span ʽͬ
+    BusCount write(BusConstBuf data) { return write(data.data(), (int)data.size()); }
+    BusCount read(BusBuf buf, int readTimeoutMs) { return read(buf.data(), (int)buf.size(), readTimeoutMs); }
+
+    // ۼдwritev һдΣдʱӶϵֽ
+    // ɢȵɶһ readv Σֽ0 ʾʱ
+    //  BUS_IOV_MAXʱκ I/O BusErr_InvalidArg
+    BusCount writev(BusGather segs);
+    BusCount readv(BusScatter segs, int readTimeoutMs);
+
+    // · sampleHealth() ֮뵱ǰ
+    struct LineHealth {
+        uint64_t intervalNs;        // ϴβʱ䣬״βΪ 0
+        int      icountValid;       // ֧ TIOCGICOUNTpty USB ڲ֧֣
+        uint32_t rx;                // ΪTIOCGICOUNT
+        uint32_t tx;
+        uint32_t overrun;           // Ӳ FIFO ж/DMA ȡ
+        uint32_t frame;             // ֡󣺲ʲƥ·
+        uint32_t parity;
+        uint32_t brk;
+        uint32_t bufOverrun;        // tty Ӧö̫Ѷ
+        int      inQueue;           // TIOCINQյδߵֽ
+        int      outQueue;          // TIOCOUTQдδֽ
+        uint32_t consumed;          // Ӧʵʶߵֽڣ BusStatsͳƹرʱΪ 0
+        double   rxUtilization;     // շ·ռʣ0~1
+        double   txUtilization;
+        uint32_t readerLagUs;       // inQueue ǰĻѹʱ
+        int      inQueueGrowth;     // նĲ
+        int      slowReader;        // ߸ϣѹ UART_HEALTH_INQ_WARN 
+    };
+
+    // ·ɼ߳ڵãд̡߳open() / close() / reconfigure() ȫ
+    // ڼ m_fdLockfd ᱻرջã
+    // ״εúÿ open() ״εֻߣռΪ 0
+    BusStatus sampleHealth(LineHealth& out);
+
+    // ͳƿգBUS_STATS_ENABLE=0 ʱΪ 0̵߳
+    void statsSnapshot(BusStats::Snapshot& out) const { m_stats.snapshot(out); }
+    void resetStats() { m_stats.reset(); }
 
 private:
+    friend class BusRing;   // io_uring ֱ m_fd ύд
+
     int    m_fd;
     Config m_cfg;
+    BusStats m_stats;
+
+    // һνĻߣֻڲ߳зʣ
+    // open() ֻ m_openSeqɲ̷߳ű仯Լջ
+    struct HealthBase {
+        uint32_t openSeq;
+        uint64_t ns;
+        uint64_t bytesIn;
+        uint64_t bytesOut;
+        int      rx, tx, overrun, frame, parity, brk, bufOverrun;
+        int      inQueue;
+        int      growth;
+    };
+    HealthBase m_health;
+    etl::atomic<uint32_t> m_openSeq;
+
+    //  m_fd ĸֵ/ر m_cfg 滻 sampleHealth()  open() / close() / reconfigure() ⣻
+    // д·վɲ÷Ͳڶдйرմڣ
+    std::mutex m_fdLock;
 
-    bool   applyTermios();
+    BusStatus applyTermios();
+    BusCount  waitReadable(int readTimeoutMs, uint64_t callStart);
+    int       bitsPerChar() const;
     int    baudToConstant(int baud); //  B115200 Ⱥ꣬Ӧ int
 };
 /******************************** FILE END ********************************/
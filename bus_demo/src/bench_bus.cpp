@@ -0,0 +1,917 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "etl/vector.h"
+
+#include "Uart.h"
+#include "Can.h"
+#include "Gpio.h"
+#include "CanSignal.h"
+#include "BusRing.h"
+#include "CanGateway.h"
+#include "BusLog.h"
+
+// ÷bus_bench [-o out.json] [-c vcan0] [-g pin] [-n ]
+//  JSON  stdout -o ָļĴϢ stderr
+
+#define BENCH_MAX_SAMPLES     20000
+#define BENCH_UART_TOTAL      (4 * 1024 * 1024)
+#define BENCH_UART_CHUNK      4096
+#define BENCH_UART_MSG        16
+#define BENCH_CAN_TOTAL       200000
+#define BENCH_DBC_FRAMES      256
+#define BENCH_RING_PORTS      4
+#define BENCH_RING_TOTAL      (1024 * 1024)   // ÿ˿
+#define BENCH_DBC_ROUNDS      20000
+#define BENCH_GW_FRAMES       200000
+#define BENCH_GW_BAUD         921600
+
+typedef etl::vector<uint32_t, BENCH_MAX_SAMPLES> Samples;
+
+struct Latency {
+    uint32_t count;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t p999;
+    uint32_t max;
+    double   mean;
+};
+
+struct UartResult {
+    const char* status;
+    double      bytesPerSec;
+    Latency     rtt;
+};
+
+struct CanResult {
+    const char* status;
+    double      framesPerSec;
+    uint32_t    sent;
+    uint32_t    received;
+    Latency     latency;
+};
+
+struct DbcResult {
+    const char* status;
+    int         signals;
+    double      loopNsPerFrame;     // λѭ
+    double      compiledNsPerFrame; // CanSignal ڽ
+};
+
+struct RingPath {
+    double   bytesPerSec;
+    uint64_t syscalls;
+    double   syscallsPerMB;
+};
+
+struct RingResult {
+    const char* status;
+    int         ports;
+    RingPath    select;     // ÿ˿һ̣߳Uart::readselect + read
+    RingPath    uring;      // ߳ BusRing::poll ȫ˿
+    int         multishot;
+};
+
+struct GatewayResult {
+    const char* status;
+    int         baudrate;
+    double      naiveBytesPerFrame;     // ֡д 16 ֽ struct can_frame
+    double      wireBytesPerFrame;      //  +  + COBS + CRC ֮
+    double      naiveFramesPerSec;      // ʣ10 λ/ֽڣɳص֡
+    double      wireFramesPerSec;
+    double      encodeNsPerFrame;
+    double      decodeNsPerFrame;
+};
+
+struct GpioResult {
+    const char* status;
+    double      togglesPerSec;
+    double      readsPerSec;
+};
+
+static Samples s_samples;
+
+static uint64_t nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static Latency summarize(Samples& samples)
+{
+    Latency lat;
+    memset(&lat, 0, sizeof(lat));
+    if (samples.empty())
+        return lat;
+
+    std::sort(samples.begin(), samples.end());
+
+    const size_t n = samples.size();
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i)
+        sum += samples[i];
+
+    lat.count = (uint32_t)n;
+    lat.p50   = samples[(n * 500) / 1000];
+    lat.p99   = samples[(n * 990) / 1000];
+    lat.p999  = samples[(n * 999) / 1000];
+    lat.max   = samples[n - 1];
+    lat.mean  = sum / (double)n;
+    return lat;
+}
+
+/***************************************************************************
+ 						UARTpty ػ
+***************************************************************************/
+static bool readFull(int fd, uint8_t* buf, int len)
+{
+    int n = 0;
+    while (n < len) {
+        int ret = (int)::read(fd, buf + n, (size_t)(len - n));
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        if (ret == 0)
+            return false;
+        n += ret;
+    }
+    return true;
+}
+
+static bool writeFull(int fd, const uint8_t* buf, int len)
+{
+    int n = 0;
+    while (n < len) {
+        int ret = (int)::write(fd, buf + n, (size_t)(len - n));
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        n += ret;
+    }
+    return true;
+}
+
+static UartResult benchUart(int iterations)
+{
+    UartResult res;
+    memset(&res, 0, sizeof(res));
+    res.status = "skipped";
+
+    // master ɱֱӶдslave ˽ Uart 
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        if (master >= 0)
+            ::close(master);
+        return res;
+    }
+
+    Uart::Config cfg;
+    cfg.device   = ptsname(master);
+    cfg.baudrate = 921600;
+
+    Uart uart(cfg);
+    if (!uart.open()) {
+        ::close(master);
+        res.status = "open_failed";
+        return res;
+    }
+
+    // £Uart д̨߳ master 
+    static uint8_t chunk[BENCH_UART_CHUNK];
+    for (int i = 0; i < BENCH_UART_CHUNK; ++i)
+        chunk[i] = (uint8_t)i;
+
+    volatile bool readerOk = true;
+    uint64_t t0 = nowNs();
+    std::thread reader([&]() {
+        static uint8_t sink[BENCH_UART_CHUNK];
+        int left = BENCH_UART_TOTAL;
+        while (left > 0) {
+            int ret = (int)::read(master, sink, sizeof(sink));
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0) {
+                readerOk = false;
+                break;
+            }
+            left -= ret;
+        }
+    });
+
+    bool writerOk = true;
+    for (int sent = 0; sent < BENCH_UART_TOTAL; sent += BENCH_UART_CHUNK) {
+        BusCount wr = uart.write(chunk, BENCH_UART_CHUNK);
+        if (!wr || wr.value() != BENCH_UART_CHUNK) {
+            writerOk = false;
+            break;
+        }
+    }
+    if (!writerOk) {
+        // дʧʱر master ö߳˳
+        ::close(master);
+        master = -1;
+    }
+    reader.join();
+    uint64_t t1 = nowNs();
+
+    if (!writerOk || !readerOk) {
+        if (master >= 0)
+            ::close(master);
+        uart.close();
+        res.status = "io_failed";
+        return res;
+    }
+    res.bytesPerSec = (double)BENCH_UART_TOTAL * 1e9 / (double)(t1 - t0);
+
+    // ʱӣUart д -> master  -> master д -> Uart 
+    uint8_t msg[BENCH_UART_MSG];
+    uint8_t echo[BENCH_UART_MSG];
+    s_samples.clear();
+    for (int i = 0; i < iterations && !s_samples.full(); ++i) {
+        memset(msg, i & 0xFF, sizeof(msg));
+
+        uint64_t start = nowNs();
+        BusCount wr = uart.write(msg, (int)sizeof(msg));
+        if (!wr || wr.value() != (int)sizeof(msg))
+            break;
+        if (!readFull(master, echo, (int)sizeof(echo)))
+            break;
+        if (!writeFull(master, echo, (int)sizeof(echo)))
+            break;
+
+        int got = 0;
+        while (got < (int)sizeof(echo)) {
+            BusCount rd = uart.read(echo + got, (int)sizeof(echo) - got, 1000);
+            if (!rd || rd.value() <= 0)
+                break;
+            got += rd.value();
+        }
+        if (got != (int)sizeof(echo))
+            break;
+
+        s_samples.push_back((uint32_t)(nowNs() - start));
+    }
+    res.rtt    = summarize(s_samples);
+    res.status = (res.rtt.count == (uint32_t)iterations) ? "ok" : "partial";
+
+    uart.close();
+    ::close(master);
+    return res;
+}
+
+/***************************************************************************
+ 						CANvcan շ
+***************************************************************************/
+static CanResult benchCan(const char* ifName, int iterations)
+{
+    CanResult res;
+    memset(&res, 0, sizeof(res));
+    res.status = "skipped";
+
+    //  socket ͬһӿϣtx ֡ں˻ػ͵ rx
+    Can::Config cfg{};
+    cfg.ifName        = ifName;
+    cfg.loopback      = 1;
+    cfg.recvOwn       = 0;
+    cfg.recvTimeoutMs = 200;
+
+    Can tx(cfg);
+    Can rx(cfg);
+    if (!tx.open() || !rx.open())
+        return res;
+
+    Can::Frame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.id  = 0x100;
+    frame.dlc = 8;
+
+    // ʱӣ֡Яʱ֡շ
+    s_samples.clear();
+    for (int i = 0; i < iterations && !s_samples.full(); ++i) {
+        uint64_t start = nowNs();
+        memcpy(frame.data, &start, sizeof(start));
+        if (!tx.send(frame))
+            continue;
+
+        Can::Frame in;
+        if (!rx.receive(in))
+            continue;
+
+        uint64_t stamp;
+        memcpy(&stamp, in.data, sizeof(stamp));
+        s_samples.push_back((uint32_t)(nowNs() - stamp));
+    }
+    res.latency = summarize(s_samples);
+
+    // £߳ȫٷ߳յʱΪֹ
+    volatile uint32_t sent = 0;
+    uint64_t t0 = nowNs();
+    std::thread sender([&]() {
+        Can::Frame f;
+        memset(&f, 0, sizeof(f));
+        f.id  = 0x200;
+        f.dlc = 8;
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < BENCH_CAN_TOTAL; ++i) {
+            memcpy(f.data, &i, sizeof(i));
+            // Ͷʱó CPU 
+            int retries = 1000;
+            while (!tx.send(f) && --retries > 0)
+                usleep(50);
+            if (retries == 0)
+                break;  // /ӿѲãټ
+            ++n;
+        }
+        sent = n;
+    });
+
+    uint32_t received = 0;
+    uint64_t tLast = t0;
+    Can::Frame in;
+    while (received < BENCH_CAN_TOTAL && rx.receive(in)) {
+        ++received;
+        tLast = nowNs();
+    }
+    sender.join();
+
+    res.sent         = sent;
+    res.received     = received;
+    res.framesPerSec = (tLast > t0) ? (double)received * 1e9 / (double)(tLast - t0) : 0.0;
+    res.status       = (received == sent && res.latency.count == (uint32_t)iterations) ? "ok" : "partial";
+
+    tx.close();
+    rx.close();
+    return res;
+}
+
+/***************************************************************************
+ 						GPIOתȡ
+***************************************************************************/
+static GpioResult benchGpio(int pin, int iterations)
+{
+    GpioResult res;
+    memset(&res, 0, sizeof(res));
+    res.status = "skipped";
+
+    if (pin < 0)
+        return res;
+
+    Gpio::Config cfg;
+    cfg.pin       = pin;
+    cfg.direction = Gpio::Direction_Out;
+
+    Gpio gpio(cfg);
+    if (!gpio.open()) {
+        res.status = "open_failed";
+        return res;
+    }
+
+    int done = 0;
+    uint64_t t0 = nowNs();
+    for (; done < iterations; ++done) {
+        if (!gpio.setValue((done & 1) ? Gpio::Value_High : Gpio::Value_Low))
+            break;
+    }
+    uint64_t t1 = nowNs();
+    if (done > 0)
+        res.togglesPerSec = (double)done * 1e9 / (double)(t1 - t0);
+
+    if (gpio.setDirection(Gpio::Direction_In)) {
+        done = 0;
+        t0 = nowNs();
+        for (; done < iterations; ++done) {
+            if (!gpio.getValue())
+                break;
+        }
+        t1 = nowNs();
+        if (done > 0)
+            res.readsPerSec = (double)done * 1e9 / (double)(t1 - t0);
+    }
+
+    res.status = (res.togglesPerSec > 0.0 && res.readsPerSec > 0.0) ? "ok" : "partial";
+    gpio.close();
+    return res;
+}
+
+/***************************************************************************
+ 						· UART գselect ߳ vs io_uring ߳
+***************************************************************************/
+struct RingPort {
+    int  master;
+    Uart uart;
+    int  received;
+};
+
+static bool openRingPorts(RingPort* ports)
+{
+    for (int i = 0; i < BENCH_RING_PORTS; ++i) {
+        ports[i].master   = -1;
+        ports[i].received = 0;
+    }
+    for (int i = 0; i < BENCH_RING_PORTS; ++i) {
+        int master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+            if (master >= 0)
+                ::close(master);
+            return false;
+        }
+        ports[i].master = master;
+
+        Uart::Config cfg;
+        cfg.device   = ptsname(master);
+        cfg.baudrate = 921600;
+        if (!ports[i].uart.reconfigure(cfg) || !ports[i].uart.open())
+            return false;
+    }
+    return true;
+}
+
+static void closeRingPorts(RingPort* ports)
+{
+    for (int i = 0; i < BENCH_RING_PORTS; ++i) {
+        ports[i].uart.close();
+        if (ports[i].master >= 0)
+            ::close(ports[i].master);
+        ports[i].master = -1;
+    }
+}
+
+//  master ÿ˿ڹ
+static void feedRingPorts(RingPort* ports)
+{
+    static uint8_t chunk[BENCH_UART_CHUNK];
+    for (int i = 0; i < BENCH_UART_CHUNK; ++i)
+        chunk[i] = (uint8_t)i;
+
+    for (int sent = 0; sent < BENCH_RING_TOTAL; sent += BENCH_UART_CHUNK) {
+        for (int p = 0; p < BENCH_RING_PORTS; ++p) {
+            if (!writeFull(ports[p].master, chunk, BENCH_UART_CHUNK))
+                return;
+        }
+    }
+}
+
+static void onRingUart(void* ctx, Uart&, const uint8_t*, int len)
+{
+    *(int*)ctx += len;
+}
+
+static RingResult benchRing()
+{
+    RingResult res;
+    memset(&res, 0, sizeof(res));
+    res.status = "skipped";
+    res.ports  = BENCH_RING_PORTS;
+
+    static RingPort ports[BENCH_RING_PORTS];
+    const double total = (double)BENCH_RING_TOTAL * BENCH_RING_PORTS;
+
+    // select ·ÿ˿һ߳
+    if (!openRingPorts(ports)) {
+        closeRingPorts(ports);
+        return res;
+    }
+    for (int i = 0; i < BENCH_RING_PORTS; ++i)
+        ports[i].uart.resetStats();
+
+    uint64_t t0 = nowNs();
+    std::thread feeder(feedRingPorts, ports);
+    std::thread readers[BENCH_RING_PORTS];
+    for (int i = 0; i < BENCH_RING_PORTS; ++i) {
+        readers[i] = std::thread([i]() {
+            static uint8_t buf[BENCH_RING_PORTS][BENCH_UART_CHUNK];
+            RingPort& p = ports[i];
+            while (p.received < BENCH_RING_TOTAL) {
+                BusCount rd = p.uart.read(buf[i], BENCH_UART_CHUNK, 1000);
+                if (!rd || rd.value() <= 0)
+                    break;
+                p.received += rd.value();
+            }
+        });
+    }
+    for (int i = 0; i < BENCH_RING_PORTS; ++i)
+        readers[i].join();
+    uint64_t t1 = nowNs();
+
+    bool ok = true;
+    for (int i = 0; i < BENCH_RING_PORTS; ++i) {
+        BusStats::Snapshot snap;
+        ports[i].uart.statsSnapshot(snap);
+        res.select.syscalls += snap.syscalls;
+        ok = ok && (ports[i].received == BENCH_RING_TOTAL);
+    }
+    if (!ok) {
+        // ߳ǰ˳ʱص slave ˣùݵ߳дʧ˳
+        for (int i = 0; i < BENCH_RING_PORTS; ++i)
+            ports[i].uart.close();
+    }
+    feeder.join();
+    res.select.bytesPerSec   = total * 1e9 / (double)(t1 - t0);
+    res.select.syscallsPerMB = (double)res.select.syscalls * 1048576.0 / total;
+    closeRingPorts(ports);
+    if (!ok) {
+        res.status = "io_failed";
+        return res;
+    }
+
+    // io_uring ·һ̡߳һ ring ȫ˿
+    BusRing ring;
+    if (!ring.open()) {
+        res.status = "no_io_uring";
+        return res;
+    }
+    if (!openRingPorts(ports)) {
+        closeRingPorts(ports);
+        res.status = "open_failed";
+        return res;
+    }
+    for (int i = 0; i < BENCH_RING_PORTS; ++i)
+        ring.addUart(ports[i].uart, onRingUart, &ports[i].received);
+
+    t0 = nowNs();
+    feeder = std::thread(feedRingPorts, ports);
+    //  10 s ûΪʧܣpoll  0 ֻոڲ󣬲ʱ
+    uint64_t deadline = t0 + 10000000000ull;
+    int done = 0;
+    while (done < BENCH_RING_PORTS && nowNs() < deadline) {
+        BusCount n = ring.poll(1000);
+        if (!n)
+            break;
+        done = 0;
+        for (int i = 0; i < BENCH_RING_PORTS; ++i)
+            done += (ports[i].received >= BENCH_RING_TOTAL) ? 1 : 0;
+    }
+    t1 = nowNs();
+    if (done < BENCH_RING_PORTS) {
+        ring.close();
+        for (int i = 0; i < BENCH_RING_PORTS; ++i)
+            ports[i].uart.close();
+    }
+    feeder.join();
+
+    BusRing::Counters c;
+    ring.counters(c);
+    res.uring.syscalls      = c.enters;
+    res.uring.bytesPerSec   = total * 1e9 / (double)(t1 - t0);
+    res.uring.syscallsPerMB = (double)c.enters * 1048576.0 / total;
+    res.multishot           = ring.multishot() ? 1 : 0;
+    res.status              = (done == BENCH_RING_PORTS) ? "ok" : "partial";
+
+    ring.close();
+    closeRingPorts(ports);
+    return res;
+}
+
+/***************************************************************************
+ 						DBC źŽ룺λѭ vs չ
+***************************************************************************/
+// һԱģIntel/Motorola/޷šһ 4 λÿش 4 ź
+CAN_SIGNAL(SigSpeed,    0, 16, CAN_SIG_INTEL,    CAN_SIG_UNSIGNED, 0.01,  0);
+CAN_SIGNAL(SigTorque,  16, 12, CAN_SIG_INTEL,    CAN_SIG_SIGNED,   0.5,   0);
+CAN_SIGNAL(SigTemp,    28,  8, CAN_SIG_INTEL,    CAN_SIG_UNSIGNED, 1.0, -40);
+CAN_SIGNAL(SigFlagA,   36,  1, CAN_SIG_INTEL,    CAN_SIG_UNSIGNED, 1.0,   0);
+CAN_SIGNAL(SigFlagB,   37,  1, CAN_SIG_INTEL,    CAN_SIG_UNSIGNED, 1.0,   0);
+CAN_SIGNAL(SigPress,   39, 10, CAN_SIG_MOTOROLA, CAN_SIG_UNSIGNED, 0.25,  0);
+CAN_SIGNAL(SigAngle,   47, 14, CAN_SIG_MOTOROLA, CAN_SIG_SIGNED,   0.1,   0);
+CAN_SIGNAL(SigMux,     60,  4, CAN_SIG_INTEL,    CAN_SIG_UNSIGNED, 1.0,   0);
+CAN_MUX_SIGNAL(SigM0,  SigMux, 0, 49, 11, CAN_SIG_INTEL, CAN_SIG_UNSIGNED, 1.0, 0);
+CAN_MUX_SIGNAL(SigM1,  SigMux, 1, 49, 11, CAN_SIG_INTEL, CAN_SIG_SIGNED,   2.0, 0);
+CAN_MUX_SIGNAL(SigM2,  SigMux, 2, 49,  8, CAN_SIG_INTEL, CAN_SIG_UNSIGNED, 0.5, 0);
+CAN_MUX_SIGNAL(SigM3,  SigMux, 3, 57,  3, CAN_SIG_INTEL, CAN_SIG_UNSIGNED, 1.0, 0);
+
+typedef CanMessageLayout<SigSpeed, SigTorque, SigTemp, SigFlagA, SigFlagB, SigPress,
+                         SigAngle, SigMux, SigM0, SigM1, SigM2, SigM3> BenchLayout;
+
+// ԭдʱλȡֵ
+struct LoopSignal {
+    int    start;
+    int    length;
+    int    intel;
+    int    isSigned;
+    double factor;
+    double offset;
+    int    mux;         // -1 ʾǸź
+};
+
+static const LoopSignal s_loopSignals[] = {
+    {  0, 16, 1, 0, 0.01,  0, -1 },
+    { 16, 12, 1, 1, 0.5,   0, -1 },
+    { 28,  8, 1, 0, 1.0, -40, -1 },
+    { 36,  1, 1, 0, 1.0,   0, -1 },
+    { 37,  1, 1, 0, 1.0,   0, -1 },
+    { 39, 10, 0, 0, 0.25,  0, -1 },
+    { 47, 14, 0, 1, 0.1,   0, -1 },
+    { 60,  4, 1, 0, 1.0,   0, -1 },
+    { 49, 11, 1, 0, 1.0,   0,  0 },
+    { 49, 11, 1, 1, 2.0,   0,  1 },
+    { 49,  8, 1, 0, 0.5,   0,  2 },
+    { 57,  3, 1, 0, 1.0,   0,  3 },
+};
+
+static const int s_loopMuxIndex = 7;
+
+static int64_t loopRaw(const uint8_t* d, const LoopSignal& s)
+{
+    uint64_t v = 0;
+    int bit = s.start;
+    for (int i = 0; i < s.length; ++i) {
+        uint64_t b = (d[bit / 8] >> (bit % 8)) & 1u;
+        if (s.intel) {
+            v |= b << i;
+            ++bit;
+        } else {
+            v |= b << (s.length - 1 - i);
+            // Motorola ݱţֽλߣһֽһֽڵ bit7
+            bit = (bit % 8 == 0) ? bit + 15 : bit - 1;
+        }
+    }
+    if (s.isSigned && s.length < 64 && (v >> (s.length - 1)) & 1u)
+        v |= ~0ull << s.length;
+    return (int64_t)v;
+}
+
+static uint64_t loopDecode(const uint8_t* d, double* out)
+{
+    const int n = (int)(sizeof(s_loopSignals) / sizeof(s_loopSignals[0]));
+    int64_t   mux   = loopRaw(d, s_loopSignals[s_loopMuxIndex]);
+    uint64_t  valid = 0;
+    for (int i = 0; i < n; ++i) {
+        const LoopSignal& s = s_loopSignals[i];
+        if (s.mux >= 0 && s.mux != mux)
+            continue;
+        out[i] = (double)loopRaw(d, s) * s.factor + s.offset;
+        valid |= 1ull << i;
+    }
+    return valid;
+}
+
+static DbcResult benchDbc()
+{
+    DbcResult res;
+    res.status             = "ok";
+    res.signals            = BenchLayout::count;
+    res.loopNsPerFrame     = 0.0;
+    res.compiledNsPerFrame = 0.0;
+
+    static uint8_t frames[BENCH_DBC_FRAMES][8];
+    uint32_t seed = 0x12345678u;
+    for (int i = 0; i < BENCH_DBC_FRAMES; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            seed = seed * 1664525u + 1013904223u;
+            frames[i][j] = (uint8_t)(seed >> 24);
+        }
+    }
+
+    // Ⱥ˶ֽһ
+    double   a[BenchLayout::count];
+    double   b[BenchLayout::count];
+    for (int i = 0; i < BENCH_DBC_FRAMES; ++i) {
+        uint64_t va = loopDecode(frames[i], a);
+        uint64_t vb = BenchLayout::decode(frames[i], b, 0);
+        if (va != vb) {
+            res.status = "mismatch";
+            return res;
+        }
+        for (int k = 0; k < BenchLayout::count; ++k) {
+            if (((va >> k) & 1u) && a[k] != b[k]) {
+                res.status = "mismatch";
+                return res;
+            }
+        }
+    }
+
+    // ȫۼӵ volatileֹ뱻Ż
+    volatile double sink = 0.0;
+    uint64_t t0 = nowNs();
+    for (int r = 0; r < BENCH_DBC_ROUNDS; ++r) {
+        for (int i = 0; i < BENCH_DBC_FRAMES; ++i) {
+            loopDecode(frames[i], a);
+            double acc = 0.0;
+            for (int k = 0; k < BenchLayout::count; ++k)
+                acc += a[k];
+            sink = sink + acc;
+        }
+    }
+    uint64_t t1 = nowNs();
+    for (int r = 0; r < BENCH_DBC_ROUNDS; ++r) {
+        for (int i = 0; i < BENCH_DBC_FRAMES; ++i) {
+            BenchLayout::decode(frames[i], b, 0);
+            double acc = 0.0;
+            for (int k = 0; k < BenchLayout::count; ++k)
+                acc += b[k];
+            sink = sink + acc;
+        }
+    }
+    uint64_t t2 = nowNs();
+
+    const double total = (double)BENCH_DBC_ROUNDS * BENCH_DBC_FRAMES;
+    res.loopNsPerFrame     = (double)(t1 - t0) / total;
+    res.compiledNsPerFrame = (double)(t2 - t1) / total;
+    return res;
+}
+
+/***************************************************************************
+ 						CAN <-> أ·ֽ뿪
+***************************************************************************/
+static GatewayResult benchGateway()
+{
+    GatewayResult res;
+    memset(&res, 0, sizeof(res));
+    res.status             = "ok";
+    res.baudrate           = BENCH_GW_BAUD;
+    res.naiveBytesPerFrame = CAN_RAW_FRAME_SIZE;
+
+    // ģͳߣ16 ڱת֡Լ 250 us
+    static Can::Frame frames[BENCH_GW_FRAMES];
+    static uint64_t   stamps[BENCH_GW_FRAMES];
+    static uint8_t    wire[BENCH_GW_FRAMES * CAN_RAW_FRAME_SIZE];
+    uint32_t seed = 0x2468ace0u;
+    uint64_t ts   = 1000000000ull;
+    for (int i = 0; i < BENCH_GW_FRAMES; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        Can::Frame& f = frames[i];
+        f.id         = 0x100 + (uint32_t)(i % 16) * 0x10;
+        f.isExtended = 0;
+        f.isRTR      = 0;
+        f.dlc        = 8;
+        for (int k = 0; k < 8; ++k)
+            f.data[k] = (uint8_t)(seed >> (k * 3));
+        ts += 200000 + (seed >> 26) * 1000;
+        stamps[i] = ts;
+    }
+
+    CanGwEncoder enc;
+    int wireLen = 0;
+    uint64_t t0 = nowNs();
+    for (int i = 0; i < BENCH_GW_FRAMES; ++i) {
+        if (!enc.add(frames[i], stamps[i])) {
+            wireLen += enc.finish(wire + wireLen);
+            enc.add(frames[i], stamps[i]);
+        }
+        if (enc.full())
+            wireLen += enc.finish(wire + wireLen);
+    }
+    wireLen += enc.finish(wire + wireLen);
+    uint64_t t1 = nowNs();
+
+    CanGwDecoder dec;
+    int got = 0;
+    int off = 0;
+    while (off < wireLen) {
+        off += dec.feed(wire + off, wireLen - off);
+        if (!dec.ready())
+            continue;
+        for (int k = 0; k < dec.count() && got < BENCH_GW_FRAMES; ++k, ++got) {
+            const Can::Frame& a = frames[got];
+            const Can::Frame& b = dec.frames()[k];
+            if (a.id != b.id || a.dlc != b.dlc || memcmp(a.data, b.data, 8) != 0 ||
+                dec.stampsNs()[k] / 1000 != stamps[got] / 1000)
+                res.status = "mismatch";
+        }
+    }
+    uint64_t t2 = nowNs();
+    if (got != BENCH_GW_FRAMES)
+        res.status = "mismatch";
+
+    const double lineBytesPerSec = (double)BENCH_GW_BAUD / 10.0;
+    res.wireBytesPerFrame = (double)wireLen / BENCH_GW_FRAMES;
+    res.naiveFramesPerSec = lineBytesPerSec / res.naiveBytesPerFrame;
+    res.wireFramesPerSec  = lineBytesPerSec / res.wireBytesPerFrame;
+    res.encodeNsPerFrame  = (double)(t1 - t0) / BENCH_GW_FRAMES;
+    res.decodeNsPerFrame  = (double)(t2 - t1) / BENCH_GW_FRAMES;
+    return res;
+}
+
+/***************************************************************************
+ 						JSON 
+***************************************************************************/
+static void printLatency(FILE* fp, const char* name, const Latency& lat)
+{
+    fprintf(fp,
+            "    \"%s\": {\"count\": %u, \"p50\": %u, \"p99\": %u, \"p999\": %u, \"max\": %u, \"mean\": %.1f}",
+            name, lat.count, lat.p50, lat.p99, lat.p999, lat.max, lat.mean);
+}
+
+static void printJson(FILE* fp, const UartResult& uart, const CanResult& can, const GpioResult& gpio,
+                      const DbcResult& dbc, const RingResult& ring, const GatewayResult& gw)
+{
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"schema\": 1,\n");
+    fprintf(fp, "  \"unit\": {\"latency\": \"ns\"},\n");
+
+    fprintf(fp, "  \"uart\": {\n");
+    fprintf(fp, "    \"status\": \"%s\",\n", uart.status);
+    fprintf(fp, "    \"bytes_per_sec\": %.0f,\n", uart.bytesPerSec);
+    printLatency(fp, "rtt", uart.rtt);
+    fprintf(fp, "\n  },\n");
+
+    fprintf(fp, "  \"can\": {\n");
+    fprintf(fp, "    \"status\": \"%s\",\n", can.status);
+    fprintf(fp, "    \"frames_per_sec\": %.0f,\n", can.framesPerSec);
+    fprintf(fp, "    \"sent\": %u,\n", can.sent);
+    fprintf(fp, "    \"received\": %u,\n", can.received);
+    printLatency(fp, "latency", can.latency);
+    fprintf(fp, "\n  },\n");
+
+    fprintf(fp, "  \"gpio\": {\n");
+    fprintf(fp, "    \"status\": \"%s\",\n", gpio.status);
+    fprintf(fp, "    \"toggles_per_sec\": %.0f,\n", gpio.togglesPerSec);
+    fprintf(fp, "    \"reads_per_sec\": %.0f\n", gpio.readsPerSec);
+    fprintf(fp, "  },\n");
+
+    fprintf(fp, "  \"dbc\": {\n");
+    fprintf(fp, "    \"status\": \"%s\",\n", dbc.status);
+    fprintf(fp, "    \"signals\": %d,\n", dbc.signals);
+    fprintf(fp, "    \"loop_ns_per_frame\": %.1f,\n", dbc.loopNsPerFrame);
+    fprintf(fp, "    \"compiled_ns_per_frame\": %.1f\n", dbc.compiledNsPerFrame);
+    fprintf(fp, "  },\n");
+
+    fprintf(fp, "  \"uart_ring\": {\n");
+    fprintf(fp, "    \"status\": \"%s\",\n", ring.status);
+    fprintf(fp, "    \"ports\": %d,\n", ring.ports);
+    fprintf(fp, "    \"multishot\": %d,\n", ring.multishot);
+    fprintf(fp, "    \"select\": {\"bytes_per_sec\": %.0f, \"syscalls\": %llu, \"syscalls_per_mb\": %.1f},\n",
+            ring.select.bytesPerSec, (unsigned long long)ring.select.syscalls, ring.select.syscallsPerMB);
+    fprintf(fp, "    \"io_uring\": {\"bytes_per_sec\": %.0f, \"syscalls\": %llu, \"syscalls_per_mb\": %.1f}\n",
+            ring.uring.bytesPerSec, (unsigned long long)ring.uring.syscalls, ring.uring.syscallsPerMB);
+    fprintf(fp, "  },\n");
+
+    fprintf(fp, "  \"can_gateway\": {\n");
+    fprintf(fp, "    \"status\": \"%s\",\n", gw.status);
+    fprintf(fp, "    \"baudrate\": %d,\n", gw.baudrate);
+    fprintf(fp, "    \"naive\": {\"bytes_per_frame\": %.2f, \"frames_per_sec\": %.0f},\n",
+            gw.naiveBytesPerFrame, gw.naiveFramesPerSec);
+    fprintf(fp, "    \"batched\": {\"bytes_per_frame\": %.2f, \"frames_per_sec\": %.0f},\n",
+            gw.wireBytesPerFrame, gw.wireFramesPerSec);
+    fprintf(fp, "    \"encode_ns_per_frame\": %.1f,\n", gw.encodeNsPerFrame);
+    fprintf(fp, "    \"decode_ns_per_frame\": %.1f\n", gw.decodeNsPerFrame);
+    fprintf(fp, "  }\n");
+
+    fprintf(fp, "}\n");
+}
+
+int main(int argc, char* argv[])
+{
+    const char* outPath    = nullptr;
+    const char* canIf      = "vcan0";
+    int         gpioPin    = -1;    // Ĭϲ GPIOʵ
+    int         iterations = 10000;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            canIf = argv[++i];
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            gpioPin = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [-o out.json] [-c vcan0] [-g pin] [-n iterations]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    if (iterations <= 0)
+        iterations = 1;
+    if (iterations > BENCH_MAX_SAMPLES)
+        iterations = BENCH_MAX_SAMPLES;
+
+    BusLog::instance().start();
+
+    UartResult uart = benchUart(iterations);
+    CanResult  can  = benchCan(canIf, iterations);
+    GpioResult gpio = benchGpio(gpioPin, iterations);
+    DbcResult  dbc  = benchDbc();
+    RingResult ring = benchRing();
+    GatewayResult gw = benchGateway();
+
+    FILE* fp = stdout;
+    if (outPath != nullptr) {
+        fp = fopen(outPath, "w");
+        if (fp == nullptr) {
+            perror("open bench output");
+            return -1;
+        }
+    }
+
+    printJson(fp, uart, can, gpio, dbc, ring, gw);
+
+    if (fp != stdout)
+        fclose(fp);
+    return 0;
+}
@@ -3,9 +3,13 @@
 #include <string.h>
 
 #include "Can.h"
+#include "BusLog.h"
 
 int main(void)
 {
+    // Ĵɺ̨߳ stderr
+    BusLog::instance().start();
+
     Can::Config cfg{};
 
     // CAN ӿϵͳ ip link ʵTODO:can0  can1
@@ -51,7 +55,8 @@ int main(void)
     Can::Frame rx;
     memset(&rx, 0, sizeof(rx));
 
-    if (can.receive(rx)) {
+    BusStatus st = can.receive(rx);
+    if (st) {
         int i;
         printf("[CAN] RX id=0x%X %s %s dlc=%u data=[",
                (unsigned int)rx.id,
@@ -63,8 +68,10 @@ int main(void)
             if (i + 1 < rx.dlc) printf(" ");
         }
         printf("]\n");
+    } else if (st.error().code == BusErr_Timeout) {
+        printf("[CAN] no frame received (timeout)\n");
     } else {
-        printf("[CAN] no frame received (timeout or error)\n");
+        printf("[CAN] receive failed: %s\n", busErrcName(st.error().code));
     }
 
     can.close();
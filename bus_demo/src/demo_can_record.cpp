@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <thread>
+
+#include "Can.h"
+#include "CanRecorder.h"
+#include "BusLog.h"
+
+// ÿͨһץ̣߳һ Can + һ CanRecorder
+static void captureLoop(const char* ifName, uint8_t channel, const char* path, int seconds)
+{
+    Can::Config cfg{};
+    cfg.ifName        = ifName;
+    cfg.recvTimeoutMs = 100;
+    cfg.timestamp     = 1;     // ʹں˽ʱ
+
+    CanRecorder::Config rcfg;
+    rcfg.path           = path;
+    rcfg.recordsPerFile = 1u << 18;
+    rcfg.fileCount      = 4;
+
+    Can         can(cfg);
+    CanRecorder rec(rcfg);
+    if (!can.open() || !rec.open()) {
+        printf("[REC] %s open failed\n", ifName);
+        return;
+    }
+
+    time_t end = time(nullptr) + seconds;
+    while (time(nullptr) < end) {
+        BusCount n = rec.capture(can, channel);
+        if (!n && n.error().code != BusErr_Timeout)
+            break;
+    }
+
+    printf("[REC] %s: %llu frames, last file %s, rotate failures %u\n",
+           ifName, (unsigned long long)rec.recorded(), rec.currentPath().c_str(), rec.rotateFailures());
+}
+
+int main(int argc, char** argv)
+{
+    BusLog::instance().start();
+
+    if (argc >= 2 && strcmp(argv[1], "rec") == 0) {
+        int seconds = (argc >= 3) ? atoi(argv[2]) : 10;
+        std::thread t0(captureLoop, CAN0_DEVICE, 0, "/tmp/can0.canlog", seconds);
+        std::thread t1(captureLoop, CAN1_DEVICE, 1, "/tmp/can1.canlog", seconds);
+        t0.join();
+        t1.join();
+        return 0;
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "play") == 0) {
+        double speed = (argc >= 4) ? atof(argv[3]) : 1.0;
+
+        CanReplayer player;
+        if (!player.open(argv[2])) {
+            printf("[PLAY] open %s failed\n", argv[2]);
+            return -1;
+        }
+
+        Can::Config cfg{};
+        cfg.ifName = CAN0_DEVICE;
+        Can can(cfg);
+        if (!can.open()) {
+            printf("[PLAY] open %s failed\n", cfg.ifName.c_str());
+            return -1;
+        }
+
+        BusCount n = player.replay(can, speed);
+        if (n)
+            printf("[PLAY] sent %d of %u frames\n", n.value(), (unsigned int)player.count());
+        else
+            printf("[PLAY] replay failed: %s\n", busErrcName(n.error().code));
+        return 0;
+    }
+
+    printf("usage: %s rec [seconds] | play <file> [speed]\n", argv[0]);
+    return -1;
+}
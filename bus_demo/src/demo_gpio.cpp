@@ -4,9 +4,13 @@
 #include <unistd.h>
 
 #include "Gpio.h"
+#include "BusLog.h"
 
 int main(void)
 {
+    // Ĵɺ̨߳ stderr
+    BusLog::instance().start();
+
     // GPIOΪģʽ
     Gpio::Config cfg_output;
     cfg_output.pin = 143;  // ʹGPIO143Ϊ
@@ -49,11 +53,11 @@ int main(void)
     if (gpio_out.setDirection(Gpio::Direction_In)) {
         printf("[GPIO] GPIO%d changed to INPUT mode\n", cfg_output.pin);
         
-        int value = gpio_out.getValue();
-        if (value >= 0) {
+        Gpio::ValueResult value = gpio_out.getValue();
+        if (value) {
             printf("[GPIO] GPIO%d read value: %s\n", 
                    cfg_output.pin, 
-                   (value == Gpio::Value_High) ? "HIGH" : "LOW");
+                   (value.value() == Gpio::Value_High) ? "HIGH" : "LOW");
         }
     } else {
         printf("[GPIO] Failed to change GPIO%d direction\n", cfg_output.pin);
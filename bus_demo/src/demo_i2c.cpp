@@ -3,9 +3,13 @@
 #include <string.h>
 
 #include "I2c.h"
+#include "BusLog.h"
 
 int main(void)
 {
+    // Ĵɺ̨߳ stderr
+    BusLog::instance().start();
+
     I2c::Config cfg{};
 
     // ʵӲ޸ߺ
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "BusRuntime.h"
+#include "BusLog.h"
+
+// ÷rt_demo [cpu] [priority]
+//  I/O ̵߳òһλʱӣʽ cyclictest 
+
+static BusRuntime::WakeupStats s_stats;     // ϴ󣬷ž̬ǰԤȱҳ
+
+static void ioThread(void* ctx)
+{
+    BusRuntime* rt = (BusRuntime*)ctx;
+    (void)rt;
+
+    BusStatus st = BusRuntime::measureWakeup(1000, 10000, s_stats);
+    if (!st) {
+        printf("[RT] measure failed: %s\n", busErrcName(st.error().code));
+        return;
+    }
+
+    printf("T: 0 Interval: 1000 us Loops: %u Min: %u Avg: %.0f Max: %u (ns) P99: %u us Overflow: %u\n",
+           s_stats.loops, s_stats.minNs, s_stats.avgNs, s_stats.maxNs, s_stats.p99Us, s_stats.overflow);
+}
+
+int main(int argc, char** argv)
+{
+    BusLog::instance().start();
+
+    // cpuMask ֻ 64 λCPU ŻҪڱΧ
+    int cpu = (argc >= 2) ? atoi(argv[1]) : -1;
+    if (argc >= 2) {
+        long cpus = sysconf(_SC_NPROCESSORS_CONF);
+        if (cpu < 0 || cpu >= 64 || cpu >= CPU_SETSIZE || (cpus > 0 && cpu >= cpus)) {
+            printf("[RT] invalid cpu %s (0-%ld)\n", argv[1], ((cpus > 0 && cpus < 64) ? cpus : 64) - 1);
+            return 1;
+        }
+    }
+
+    BusRuntime::Config cfg;
+    cfg.io.cpuMask    = (cpu >= 0) ? (1ull << cpu) : 0;
+    cfg.io.rtPriority = (argc >= 3) ? atoi(argv[2]) : 80;
+    cfg.lockMemory    = 1;
+
+    // ʵĿȫ豸磺
+    //   Uart::Config u; u.device = UART2_DEVICE; cfg.uarts.push_back(u);
+    //   Can::Config c{}; c.ifName = CAN0_DEVICE; cfg.cans.push_back(c);
+
+    BusRuntime rt(cfg);
+    BusStatus st = rt.open();
+    if (!st)
+        printf("[RT] open: %s (continue without it)\n", busErrcName(st.error().code));
+
+    BusRuntime::prefault(&s_stats, sizeof(s_stats));
+
+    rt.startThread(ioThread, &rt);
+    rt.joinThreads();
+    rt.close();
+    return 0;
+}
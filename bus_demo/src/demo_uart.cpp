@@ -3,9 +3,13 @@
 #include <string.h>
 
 #include "Uart.h"
+#include "BusLog.h"
 
 int main(void)
 {
+    // Ĵɺ̨߳ stderr
+    BusLog::instance().start();
+
     Uart::Config cfg_s9;
     Uart::Config cfg_s2;
 
@@ -26,20 +30,25 @@ int main(void)
     printf("[UART] opened %s\n", cfg_s9.device.c_str());
     printf("[UART] opened %s\n", cfg_s2.device.c_str());
 
+    // ·β֮㣬շǰ
+    Uart::LineHealth health;
+    uart_s2.sampleHealth(health);
+
     // һЩ
     const uint8_t txData[] = { 0x11, 0x22, 0x33, 0x44 };
-    int n = uart_s9.write(txData, (int)sizeof(txData));
-    if (n < 0) {
-        printf("[UART] write failed\n");
+    BusCount wr = uart_s9.write(txData, (int)sizeof(txData));
+    if (!wr) {
+        printf("[UART] write failed: %s\n", busErrcName(wr.error().code));
     } else {
-        printf("[UART] TX %d bytes: [0x11 0x22 0x33 0x44]\n", n);
+        printf("[UART] TX %d bytes: [0x11 0x22 0x33 0x44]\n", wr.value());
     }
 
     // 
     uint8_t rxBuf[256];
     memset(rxBuf, 0, sizeof(rxBuf));
 
-    n = uart_s2.read(rxBuf, (int)sizeof(rxBuf), 500);
+    BusCount rd = uart_s2.read(rxBuf, (int)sizeof(rxBuf), 500);
+    int n = rd ? rd.value() : -1;
     if (n > 0) {
         int i;
         printf("[UART] RX %d bytes: [", n);
@@ -51,7 +60,17 @@ int main(void)
     } else if (n == 0) {
         printf("[UART] no data (timeout)\n");
     } else {
-        printf("[UART] read failed\n");
+        printf("[UART] read failed: %s\n", busErrcName(rd.error().code));
+    }
+
+    // ·շڼռ
+    if (uart_s2.sampleHealth(health)) {
+        printf("[UART] health: %.1fms inq=%d outq=%d lag=%uus rx_util=%.3f consumed=%u",
+               health.intervalNs / 1e6, health.inQueue, health.outQueue, health.readerLagUs,
+               health.rxUtilization, health.consumed);
+        if (health.icountValid)
+            printf(" rx=%u overrun=%u frame=%u parity=%u", health.rx, health.overrun, health.frame, health.parity);
+        printf("\n");
     }
 
     uart_s9.close();
@@ -0,0 +1,225 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "CanTxArbiter.h"
+#include "BusLog.h"
+
+// ԣҪ CAN 豸 CanTxArbiter  transmit() ɼ¼֡
+// ÷can_tx_arbiter_testȫͨ 0
+
+static int s_failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            printf("[FAIL] %s:%d: %s\n", __FILE__, __LINE__, #cond);        \
+            ++s_failures;                                                   \
+        }                                                                   \
+    } while (0)
+
+class RecordingArbiter : public CanTxArbiter {
+public:
+    explicit RecordingArbiter(Can& can, const Config& cfg = Config())
+        : CanTxArbiter(can, cfg)
+        , m_hold(false)
+        , m_holding(false)
+        , m_fail(false)
+        , m_trackInFlight(false)
+        , m_inFlight(0)
+    {
+    }
+
+    ~RecordingArbiter() { stop(); }
+
+    std::atomic<bool>       m_hold;      // λʱ transmit() ͣڵһ֡ú֡ڻѻ
+    std::atomic<bool>       m_holding;
+    std::atomic<bool>       m_fail;      // λʱģں˷Ͷ
+    std::atomic<bool>       m_trackInFlight;    // λʱÿһ֡;һɲ߳ģⷢ
+    std::atomic<int>        m_inFlight;
+    std::vector<Can::Frame> m_frames;    // ֻٲ߳дstop() ֮ٶ
+
+protected:
+    virtual bool txReady() const { return true; }
+
+    virtual BusStatus transmit(const Can::Frame& frame)
+    {
+        while (m_hold.load()) {
+            m_holding.store(true);
+            usleep(100);
+        }
+
+        if (m_fail.load()) {
+            BusError err = { BusErr_Full, ENOBUFS, "test transmit" };
+            return etl::unexpected<BusError>(err);
+        }
+
+        m_frames.push_back(frame);
+        if (m_trackInFlight.load())
+            m_inFlight.fetch_add(1);
+        return BusStatus();
+    }
+
+    virtual int txInFlight() { return m_inFlight.load(); }
+};
+
+static Can::Frame makeFrame(uint32_t id, int extended, uint8_t source, uint8_t seq)
+{
+    Can::Frame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.id         = id;
+    frame.isExtended = extended;
+    frame.dlc        = 2;
+    frame.data[0]    = source;
+    frame.data[1]    = seq;
+    return frame;
+}
+
+static void waitFor(const std::atomic<bool>& flag)
+{
+    while (!flag.load())
+        usleep(100);
+}
+
+// ̲߳ submit()ٲ̱߳밴ٲüС󷢳ͬ ID ָ֡Եύ˳
+static void testOrderingUnderConcurrentSubmit()
+{
+    const int Threads   = 4;
+    const int PerThread = 50;
+
+    Can              can;
+    RecordingArbiter arbiter(can);
+
+    arbiter.m_hold.store(true);
+    CHECK(arbiter.start());
+    CHECK(arbiter.submit(makeFrame(0x7FF, 0, 0xFF, 0)));
+    waitFor(arbiter.m_holding);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < Threads; ++t) {
+        threads.push_back(std::thread([&arbiter, t]() {
+            for (int i = 0; i < PerThread; ++i) {
+                // ߳ 3 չ֡ID ȡֵصͬ ID Ƚȳ
+                uint32_t id = (uint32_t)((i * 37 + t * 11) % 64);
+                if (t == 3)
+                    id = (id << 18) | (uint32_t)i;
+                BusStatus st = arbiter.submit(makeFrame(id, t == 3, (uint8_t)t, (uint8_t)i));
+                if (!st)
+                    printf("[FAIL] submit rejected\n");
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+
+    arbiter.m_hold.store(false);
+    while (arbiter.sent() < (uint32_t)(Threads * PerThread + 1))
+        usleep(100);
+    arbiter.stop();
+
+    CHECK(arbiter.m_frames.size() == (size_t)(Threads * PerThread + 1));
+    CHECK(arbiter.dropped() == 0);
+
+    // һ֡ȷȥ֡֡ȫڶӦϸٲ˳
+    bool ordered = true;
+    int  lastSeq[Threads][64];
+    memset(lastSeq, -1, sizeof(lastSeq));
+    for (size_t i = 2; i < arbiter.m_frames.size(); ++i) {
+        if (CanTxArbiter::arbitrationKey(arbiter.m_frames[i - 1]) > CanTxArbiter::arbitrationKey(arbiter.m_frames[i]))
+            ordered = false;
+    }
+    for (size_t i = 1; i < arbiter.m_frames.size(); ++i) {
+        const Can::Frame& f = arbiter.m_frames[i];
+        int src = f.data[0];
+        int key = (int)((f.isExtended ? (f.id >> 18) : f.id) & 63);
+        if (f.data[1] <= lastSeq[src][key] && !f.isExtended)
+            ordered = false;
+        lastSeq[src][key] = f.data[1];
+    }
+    CHECK(ordered);
+}
+
+// stop() ʱδ֡ dropped() start() 󲻻Ჹ
+static void testStopDropsPending()
+{
+    Can              can;
+    RecordingArbiter arbiter(can);
+
+    arbiter.m_fail.store(true);
+    CHECK(arbiter.start());
+    for (int i = 0; i < 10; ++i)
+        CHECK(arbiter.submit(makeFrame((uint32_t)(0x100 + i), 0, 0, (uint8_t)i)));
+    usleep(20000);
+    arbiter.stop();
+
+    CHECK(arbiter.sent() == 0);
+    CHECK(arbiter.dropped() == 10);
+
+    arbiter.m_fail.store(false);
+    CHECK(arbiter.start());
+    usleep(20000);
+    arbiter.stop();
+
+    CHECK(arbiter.sent() == 0);
+    CHECK(arbiter.m_frames.empty());
+    CHECK(arbiter.dropped() == 10);
+}
+
+// ;֡ﵽ maxInFlight ֡ھѣN ֡ȼ֮ύĸȼ֡
+// ֻѽǼ֮֡ȼ֡
+static void testInFlightLimitKeepsPriority()
+{
+    const int Bulk  = 10;
+    const int Limit = 2;
+
+    CanTxArbiter::Config cfg;
+    cfg.maxInFlight = Limit;
+
+    Can              can;
+    RecordingArbiter arbiter(can, cfg);
+
+    arbiter.m_trackInFlight.store(true);
+    CHECK(arbiter.start());
+    for (int i = 0; i < Bulk; ++i)
+        CHECK(arbiter.submit(makeFrame((uint32_t)(0x500 + i), 0, 0, (uint8_t)i)));
+    while (arbiter.sent() < (uint32_t)Limit)
+        usleep(100);
+
+    // ţ֡Ӧѹ
+    usleep(20000);
+    CHECK(arbiter.sent() == (uint32_t)Limit);
+
+    CHECK(arbiter.submit(makeFrame(0x010, 0, 1, 0)));
+    usleep(20000);
+
+    // ֡ģⷢ
+    while (arbiter.sent() < (uint32_t)(Bulk + 1)) {
+        if (arbiter.m_inFlight.load() > 0)
+            arbiter.m_inFlight.fetch_sub(1);
+        usleep(1000);
+    }
+    arbiter.stop();
+
+    CHECK(arbiter.m_frames.size() == (size_t)(Bulk + 1));
+    CHECK(arbiter.m_frames.size() > (size_t)Limit && arbiter.m_frames[Limit].id == 0x010);
+    for (int i = 0; i < Limit; ++i)
+        CHECK(arbiter.m_frames[i].id == (uint32_t)(0x500 + i));
+}
+
+int main()
+{
+    BusLog::instance().start();
+
+    testOrderingUnderConcurrentSubmit();
+    testStopDropsPending();
+    testInFlightLimitKeepsPriority();
+
+    printf("%s: %d failure(s)\n", s_failures ? "FAILED" : "OK", s_failures);
+    return s_failures ? 1 : 0;
+}